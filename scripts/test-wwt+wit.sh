@@ -13,7 +13,8 @@ then
     cat <<- ---EOT---
 
 	This script expect as parameters names of ISO files. ISO files are PLAIN,
-	CISO, WBFS, WDF, WIA or GCZ. Each source file is subject of this test suite.
+	CISO, WBFS, WDF, WIA, RVZ or GCZ. Each source file is subject of this test
+	suite.
 
 	Tests:
 
@@ -23,7 +24,11 @@ then
 	    - ADD from PIPE
 
 	  * wit COPY
-	    - convert to PLAIN ISO, CISO, WDF, WIA, GCZ, WBFS
+	    - convert to PLAIN ISO, CISO, WDF, WIA, RVZ, GCZ, WBFS
+
+	  * RVZ with small chunks, if 'dolphin-tool' is found
+	    - convert to RVZ with 128 KiB chunks by dolphin-tool and compare
+	    - convert an RVZ of wit to ISO by dolphin-tool and compare
 
 	Usage:  $myname [option]... iso_file...
 
@@ -42,6 +47,8 @@ then
 
 	  --wia        : enable WIA compression tests (default)
 	  --no-wia     : disable WIA compression tests
+	  --rvz        : enable RVZ compression tests (default)
+	  --no-rvz     : disable RVZ compression tests
 	  --gcz        : enable GCZ compression tests (default)
 	  --no-gcz     : disable GCZ compression tests
 	  --raw        : enable raw mode
@@ -76,6 +83,10 @@ then
     exit 2
 fi
 
+# optional: dolphin-tool for RVZ interoperability tests
+DOLPHIN="${DOLPHIN_TOOL:-dolphin-tool}"
+which "$DOLPHIN" >/dev/null 2>&1 && HAVE_DOLPHIN=1 || HAVE_DOLPHIN=0
+
 #
 #------------------------------------------------------------------------------
 # timer function
@@ -156,8 +167,9 @@ WBFS="$tempdir/$WBFS_FILE"
 
 #WIALIST=$(echo $($WIT compr | sed 's/^/wia-/'))
 WIALIST=$($WIT compr | sed 's/^/wia-/')
+RVZLIST=$($WIT compr | grep -vx PURGE | sed 's/^/rvz-/')
 WDFLIST=$($WIT features wdf1 wdf2 | awk '/^+/ {print $2}' | tr 'A-Z\n' 'a-z ')
-MODELIST="iso $WDFLIST $WIALIST ciso gcz wbfs"
+MODELIST="iso $WDFLIST $WIALIST $RVZLIST ciso gcz wbfs"
 BASEMODE="wdf1"
 
 FAST_MODELIST="$WDFLIST"
@@ -168,6 +180,7 @@ NOFST=0
 NOPIPE=1
 NOEDIT=0
 NOWIA=0
+NORVZ=0
 NOGCZ=0
 RAW=
 IO=
@@ -256,7 +269,7 @@ function test_suite()
     do
 	mode="${xmode%%-*}"
 	#echo "|$mode|$xmode|"
-	[[ $mode = wia ]] && continue
+	[[ $mode = wia || $mode = rvz ]] && continue
 	[[ $mode = gcz ]] && ((NOGCZ)) && continue
 
 	dest="$tempdir/image.$mode"
@@ -291,6 +304,7 @@ function test_suite()
 	mode="${xmode%%-*}"
 	[[ $xmode = ${xmode/-} ]] && compr="" || compr="--compr ${xmode#*-}"
 	[[ $mode = wia ]] && ((NOWIA)) && continue
+	[[ $mode = rvz ]] && ((NORVZ)) && continue
 	[[ $mode = gcz ]] && ((NOGCZ)) && continue
 	[[ $mode = wbfs && $RAW != "" ]] && continue
 
@@ -312,6 +326,42 @@ function test_suite()
     rm -f "$dest"
 
 
+    #----- test RVZ with small chunks and dolphin-tool
+
+    if (( !NORVZ && HAVE_DOLPHIN ))
+    then
+	src="$tempdir/dolphin.iso"
+	dest="$tempdir/dolphin.rvz"
+
+	test_function "COPY-iso" "wit COPY to iso" \
+	    $WIT_CP "$tempdir/image.$BASEMODE" "$src" --iso \
+	    || return $ERROR
+
+	test_function "DOLPHIN-RVZ" "dolphin-tool to rvz@128k" \
+	    "$DOLPHIN" convert -i "$src" -o "$dest" -f rvz -b 131072 -c zstd -l 5 \
+	    || return $ERROR
+
+	test_function "CMP" "wit CMP dolphin rvz" \
+	    $WIT $RAW -ql CMP "$dest" "$1" \
+	    || return $STAT_DIFF
+
+	test_function "COPY-rvz" "wit COPY to rvz" \
+	    $WIT_CP "$dest" "$tempdir/copy.rvz" --rvz \
+	    || return $ERROR
+
+	rm -f "$src" "$dest"
+	test_function "DOLPHIN-ISO" "dolphin-tool to iso" \
+	    "$DOLPHIN" convert -i "$tempdir/copy.rvz" -o "$src" -f iso \
+	    || return $ERROR
+
+	test_function "CMP" "wit CMP dolphin iso" \
+	    $WIT $RAW -ql CMP "$src" "$1" \
+	    || return $STAT_DIFF
+
+	rm -f "$src" "$tempdir/copy.rvz"
+    fi
+
+
     #----- test WIT extract
 
     if ((!NOFST))
@@ -561,6 +611,22 @@ do
 	continue
     fi
 
+    if [[ $src == --rvz ]]
+    then
+	NORVZ=0
+	((opts++)) || printf "\n"
+	printf "## --rvz : compress RVZ tests enabled\n"
+	continue
+    fi
+
+    if [[ $src == --no-rvz ]]
+    then
+	NORVZ=1
+	((opts++)) || printf "\n"
+	printf "## ---no-rvz : compress RVZ tests disabled\n"
+	continue
+    fi
+
     if [[ $src == --gcz ]]
     then
 	NOGCZ=0
@@ -30,6 +30,13 @@ then
     defines="$defines -DHAVE_ZLIB=1"
 fi
 
+have_zstd=0
+if [[ $NO_ZSTD != 1 && -r /usr/include/zstd.h || -r /usr/local/include/zstd.h ]]
+then
+    have_zstd=1
+    defines="$defines -DHAVE_ZSTD=1"
+fi
+
 if [[ $M32 = 1 ]]
 then
     force_m32=1
@@ -103,6 +110,7 @@ cat <<- ---EOT--- >Makefile.setup
 	FORCE_M32	:= $force_m32
 	HAVE_FUSE	:= $have_fuse
 	HAVE_ZLIB	:= $have_zlib
+	HAVE_ZSTD	:= $have_zstd
 	STATIC		:= $STATIC
 	XFLAGS		+= $xflags
 	DEFINES1	:= $defines
@@ -40,6 +40,33 @@
 #include "crypto/wit-sha.h"
 #define SHA1 WIT_SHA1
 
+// multi buffer SHA1: hash 'n' independent buffers of equal size at once
+typedef enum enumSHA1MB
+{
+	SHA1MB_AUTO,		// select the fastest available mode
+	SHA1MB_GENERIC,		// one buffer after the other by WIT_SHA1()
+	SHA1MB_SSE2,		// 4 buffers in parallel using SSE2 lanes
+	SHA1MB_AVX2,		// 8 buffers in parallel using AVX2 lanes
+	SHA1MB_SHANI,		// one buffer after the other using SHA-NI
+
+	SHA1MB__N
+
+} enumSHA1MB;
+
+void WIT_SHA1_MB
+(
+    const unsigned char	* const * data,	// list with 'n' data pointers
+    size_t		size,		// size of each data buffer
+    unsigned char	* const * md,	// list with 'n' hash destinations
+    unsigned int	n		// number of buffers
+);
+
+int WIT_SHA1_MB_Mode ( int mode );	  // set mode if >=0, return active mode
+int WIT_SHA1_MB_Available ( int mode );  // true if 'mode' is supported
+const char * WIT_SHA1_MB_Name ( int mode );
+
+#define SHA1_MB WIT_SHA1_MB
+
 // random functions
 void RandomFill ( void * buf, size_t size );
 #define RANDOM_FILL RandomFill
@@ -0,0 +1,444 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+// multi buffer SHA1: calculate many hashes of independent buffers at once
+
+#include <string.h>
+#include <stdint.h>
+
+#if ( defined(__x86_64__) || defined(__i386__) ) && defined(__GNUC__) \
+	&& !defined(NO_SHA1_MB)
+    #define HAVE_SHA1_MB 1
+    #include <cpuid.h>
+    #include <immintrin.h>
+#else
+    #define HAVE_SHA1_MB 0
+#endif
+
+// include this after <immintrin.h>, because of the malloc() protection
+#include "crypt.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			mode management			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static int sha1_mb_avail = -1;			// bit field of available modes
+static int sha1_mb_mode  = SHA1MB_AUTO;		// selected mode
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int sha1_mb_available()
+{
+    if ( sha1_mb_avail < 0 )
+    {
+	int avail = 1 << SHA1MB_GENERIC;
+
+     #if HAVE_SHA1_MB
+	unsigned int eax, ebx, ecx, edx;
+	if ( __get_cpuid(1,&eax,&ebx,&ecx,&edx) )
+	{
+	    if ( edx & bit_SSE2 )
+		avail |= 1 << SHA1MB_SSE2;
+
+	    const int have_sse41 = ( ecx & bit_SSE4_1 ) && ( ecx & bit_SSSE3 );
+	    int have_ymm = 0;
+	    if ( ecx & bit_OSXSAVE )
+	    {
+		// OS must save the YMM registers on context switches
+		unsigned int xcr0_lo, xcr0_hi;
+		__asm__ ( "xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0) );
+		have_ymm = ( xcr0_lo & 6 ) == 6;
+	    }
+
+	    if ( __get_cpuid_max(0,0) >= 7 )
+	    {
+		__cpuid_count(7,0,eax,ebx,ecx,edx);
+		if ( have_ymm && ebx & bit_AVX2 )
+		    avail |= 1 << SHA1MB_AVX2;
+		if ( have_sse41 && ebx & bit_SHA )
+		    avail |= 1 << SHA1MB_SHANI;
+	    }
+	}
+     #endif
+	sha1_mb_avail = avail;
+    }
+    return sha1_mb_avail;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int sha1_mb_active()
+{
+    const int avail = sha1_mb_available();
+    if ( sha1_mb_mode > SHA1MB_AUTO && avail & 1 << sha1_mb_mode )
+	return sha1_mb_mode;
+
+    int mode;
+    for ( mode = SHA1MB__N - 1; mode > SHA1MB_GENERIC; mode-- )
+	if ( avail & 1 << mode )
+	    return mode;
+    return SHA1MB_GENERIC;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int WIT_SHA1_MB_Mode ( int mode )
+{
+    if ( mode >= SHA1MB_AUTO && mode < SHA1MB__N )
+	sha1_mb_mode = mode;
+    return sha1_mb_active();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int WIT_SHA1_MB_Available ( int mode )
+{
+    return mode == SHA1MB_AUTO
+	|| ( mode > SHA1MB_AUTO && mode < SHA1MB__N
+		&& sha1_mb_available() & 1 << mode );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const char * WIT_SHA1_MB_Name ( int mode )
+{
+    static const char * tab[SHA1MB__N] =
+    {
+	"auto",
+	"generic",
+	"SSE2 x4",
+	"AVX2 x8",
+	"SHA-NI",
+    };
+
+    return mode >= 0 && mode < SHA1MB__N ? tab[mode] : "?";
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			SIMD lanes			///////////////
+///////////////////////////////////////////////////////////////////////////////
+#if HAVE_SHA1_MB
+
+// All buffers of a call have the same size, so the block count and the
+// padding is the same for all lanes. Each lane hashes its own buffer using
+// the GCC vector extensions; the lane count is set by the vector size.
+
+#define SHA1_K0 0x5a827999
+#define SHA1_K1 0x6ed9eba1
+#define SHA1_K2 0x8f1bbcdc
+#define SHA1_K3 0xca62c1d6
+
+#define SHA1_BE32(p) \
+	( (uint32_t)(p)[0] << 24 | (uint32_t)(p)[1] << 16 \
+	| (uint32_t)(p)[2] <<  8 | (uint32_t)(p)[3] )
+
+#define SHA1_ROTL(x,n) ( (x) << (n) | (x) >> (32-(n)) )
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define DEFINE_SHA1_LANES(name,attr,vtype,NL)				\
+									\
+typedef uint32_t vtype __attribute__((vector_size(NL*4)));		\
+									\
+attr void name##_blocks							\
+(									\
+    vtype		* state,	/* 5 vectors */			\
+    const uint8_t	* const * ptr,	/* NL block pointers */		\
+    size_t		n_blocks	/* number of blocks */		\
+)									\
+{									\
+    vtype a = state[0], b = state[1], c = state[2],			\
+	  d = state[3], e = state[4];					\
+    size_t off;								\
+    for ( off = 0; n_blocks-- > 0; off += 64 )				\
+    {									\
+	vtype w[16], t;							\
+	int i, l;							\
+	for ( i = 0; i < 16; i++ )					\
+	    for ( l = 0; l < NL; l++ )					\
+		w[i][l] = SHA1_BE32(ptr[l]+off+4*i);			\
+									\
+	const vtype sa = a, sb = b, sc = c, sd = d, se = e;		\
+	for ( i = 0; i < 80; i++ )					\
+	{								\
+	    if ( i >= 16 )						\
+	    {								\
+		t = w[(i-3)&15] ^ w[(i-8)&15] ^ w[(i-14)&15] ^ w[i&15];	\
+		w[i&15] = SHA1_ROTL(t,1);				\
+	    }								\
+	    if ( i < 20 )						\
+		t = ( (b&c) | (~b&d) ) + SHA1_K0;			\
+	    else if ( i < 40 )						\
+		t = ( b ^ c ^ d ) + SHA1_K1;				\
+	    else if ( i < 60 )						\
+		t = ( (b&c) | (b&d) | (c&d) ) + SHA1_K2;		\
+	    else							\
+		t = ( b ^ c ^ d ) + SHA1_K3;				\
+									\
+	    t += SHA1_ROTL(a,5) + e + w[i&15];				\
+	    e = d;							\
+	    d = c;							\
+	    c = SHA1_ROTL(b,30);					\
+	    b = a;							\
+	    a = t;							\
+	}								\
+	a += sa; b += sb; c += sc; d += sd; e += se;			\
+    }									\
+    state[0] = a; state[1] = b; state[2] = c; state[3] = d; state[4] = e;	\
+}									\
+									\
+attr void name								\
+(									\
+    const uint8_t	* const * data,	/* NL data pointers */		\
+    size_t		size,		/* size of each buffer */	\
+    uint8_t		* const * md	/* NL hash destinations */	\
+)									\
+{									\
+    vtype state[5];							\
+    int i, l;								\
+    for ( l = 0; l < NL; l++ )						\
+    {									\
+	state[0][l] = 0x67452301;					\
+	state[1][l] = 0xefcdab89;					\
+	state[2][l] = 0x98badcfe;					\
+	state[3][l] = 0x10325476;					\
+	state[4][l] = 0xc3d2e1f0;					\
+    }									\
+									\
+    const size_t n_blocks = size / 64;					\
+    if (n_blocks)							\
+	name##_blocks(state,data,n_blocks);				\
+									\
+    /* equal sizes => equal padding for all lanes */			\
+    const size_t rest = size % 64;					\
+    const size_t tail_size = rest < 56 ? 64 : 128;			\
+    uint8_t tail[NL][128];						\
+    const uint8_t * tptr[NL];						\
+    const uint64_t bits = (uint64_t)size << 3;				\
+    for ( l = 0; l < NL; l++ )						\
+    {									\
+	uint8_t * t = tail[l];						\
+	memcpy(t,data[l]+n_blocks*64,rest);				\
+	t[rest] = 0x80;							\
+	memset(t+rest+1,0,tail_size-rest-1-8);				\
+	for ( i = 0; i < 8; i++ )					\
+	    t[tail_size-1-i] = bits >> 8*i;				\
+	tptr[l] = t;							\
+    }									\
+    name##_blocks(state,tptr,tail_size/64);				\
+									\
+    for ( l = 0; l < NL; l++ )						\
+    {									\
+	uint8_t * dest = md[l];						\
+	for ( i = 0; i < 5; i++, dest += 4 )				\
+	{								\
+	    const uint32_t v = state[i][l];				\
+	    dest[0] = v >> 24;						\
+	    dest[1] = v >> 16;						\
+	    dest[2] = v >> 8;						\
+	    dest[3] = v;						\
+	}								\
+    }									\
+}
+
+DEFINE_SHA1_LANES( sha1_sse2_x4, static __attribute__((target("sse2"))), sha1_v4_t, 4 )
+DEFINE_SHA1_LANES( sha1_avx2_x8, static __attribute__((target("avx2"))), sha1_v8_t, 8 )
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			SHA-NI				///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define SHANI_FUNC static __attribute__((target("sha,sse4.1")))
+
+// 4 rounds of group 'r' (0..19). Message words are rotated in msg[0..3],
+// 'e[r&1]' is the current E and 'e[~r&1]' receives ABCD for the next group.
+
+#define SHANI_ROUNDS(r)							\
+{									\
+    if ( r < 4 )							\
+	msg[r] = _mm_shuffle_epi8(					\
+		_mm_loadu_si128((const __m128i*)(data+16*r)), mask );	\
+    if ( r == 0 )							\
+	e[0] = _mm_add_epi32(e[0],msg[0]);				\
+    else								\
+	e[r&1] = _mm_sha1nexte_epu32(e[r&1],msg[r&3]);			\
+    e[~r&1] = abcd;							\
+    if ( r >= 3 && r <= 18 )						\
+	msg[(r+1)&3] = _mm_sha1msg2_epu32(msg[(r+1)&3],msg[r&3]);	\
+    abcd = _mm_sha1rnds4_epu32(abcd,e[r&1],r/5);			\
+    if ( r >= 1 && r <= 16 )						\
+	msg[(r+3)&3] = _mm_sha1msg1_epu32(msg[(r+3)&3],msg[r&3]);	\
+    if ( r >= 2 && r <= 17 )						\
+	msg[(r+2)&3] = _mm_xor_si128(msg[(r+2)&3],msg[r&3]);		\
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SHANI_FUNC void shani_blocks
+(
+    uint32_t		* state,	// 5 words
+    const uint8_t	* data,		// data
+    size_t		n_blocks	// number of 64 byte blocks
+)
+{
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL,0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state),0x1b);
+    __m128i e0 = _mm_set_epi32(state[4],0,0,0);
+
+    for ( ; n_blocks > 0; n_blocks--, data += 64 )
+    {
+	__m128i msg[4], e[2];
+	const __m128i save_abcd = abcd, save_e = e0;
+	e[0] = e0;
+
+	SHANI_ROUNDS(0);  SHANI_ROUNDS(1);  SHANI_ROUNDS(2);  SHANI_ROUNDS(3);
+	SHANI_ROUNDS(4);  SHANI_ROUNDS(5);  SHANI_ROUNDS(6);  SHANI_ROUNDS(7);
+	SHANI_ROUNDS(8);  SHANI_ROUNDS(9);  SHANI_ROUNDS(10); SHANI_ROUNDS(11);
+	SHANI_ROUNDS(12); SHANI_ROUNDS(13); SHANI_ROUNDS(14); SHANI_ROUNDS(15);
+	SHANI_ROUNDS(16); SHANI_ROUNDS(17); SHANI_ROUNDS(18); SHANI_ROUNDS(19);
+
+	e0   = _mm_sha1nexte_epu32(e[0],save_e);
+	abcd = _mm_add_epi32(abcd,save_abcd);
+    }
+
+    _mm_storeu_si128((__m128i*)state,_mm_shuffle_epi32(abcd,0x1b));
+    state[4] = _mm_extract_epi32(e0,3);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SHANI_FUNC void shani_sha1
+(
+    const uint8_t	* data,		// data
+    size_t		size,		// size of data
+    uint8_t		* md		// hash destination
+)
+{
+    uint32_t state[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+    const size_t n_blocks = size / 64;
+    if (n_blocks)
+	shani_blocks(state,data,n_blocks);
+
+    const size_t rest = size % 64;
+    const size_t tail_size = rest < 56 ? 64 : 128;
+    uint8_t tail[128];
+    memcpy(tail,data+n_blocks*64,rest);
+    tail[rest] = 0x80;
+    memset(tail+rest+1,0,tail_size-rest-1-8);
+    const uint64_t bits = (uint64_t)size << 3;
+    int i;
+    for ( i = 0; i < 8; i++ )
+	tail[tail_size-1-i] = bits >> 8*i;
+    shani_blocks(state,tail,tail_size/64);
+
+    for ( i = 0; i < 5; i++, md += 4 )
+    {
+	md[0] = state[i] >> 24;
+	md[1] = state[i] >> 16;
+	md[2] = state[i] >> 8;
+	md[3] = state[i];
+    }
+}
+
+#endif // HAVE_SHA1_MB
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			WIT_SHA1_MB()			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void WIT_SHA1_MB
+(
+    const unsigned char	* const * data,	// list with 'n' data pointers
+    size_t		size,		// size of each data buffer
+    unsigned char	* const * md,	// list with 'n' hash destinations
+    unsigned int	n		// number of buffers
+)
+{
+    unsigned int i = 0;
+
+ #if HAVE_SHA1_MB
+
+    const int mode = sha1_mb_active();
+    if ( mode == SHA1MB_SHANI )
+    {
+	for ( ; i < n; i++ )
+	    shani_sha1(data[i],size,md[i]);
+	return;
+    }
+
+    if ( mode == SHA1MB_AVX2 || mode == SHA1MB_SSE2 )
+    {
+	const unsigned int NL = mode == SHA1MB_AVX2 ? 8 : 4;
+
+	for ( ; i + NL <= n; i += NL )
+	    if ( NL == 8 )
+		sha1_avx2_x8(data+i,size,md+i);
+	    else
+		sha1_sse2_x4(data+i,size,md+i);
+
+	if ( i < n )
+	{
+	    // fill the unused lanes with a copy of the last buffer
+	    const unsigned char * dlist[8];
+	    unsigned char * mlist[8], dummy[20];
+	    unsigned int l;
+	    for ( l = 0; l < NL; l++ )
+	    {
+		const unsigned int idx = i + l < n ? i + l : n - 1;
+		dlist[l] = data[idx];
+		mlist[l] = i + l < n ? md[idx] : dummy;
+	    }
+
+	    if ( NL == 8 )
+		sha1_avx2_x8(dlist,size,mlist);
+	    else
+		sha1_sse2_x4(dlist,size,mlist);
+	}
+	return;
+    }
+
+ #endif // HAVE_SHA1_MB
+
+    for ( ; i < n; i++ )
+	WIT_SHA1(data[i],size,md[i]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -2287,7 +2287,13 @@ void ResetFST ( WiiFst_t * fst )
 	FREE(fst->part);
     }
     ResetIM(&fst->im);
-    FREE(fst->cache);
+    if (fst->cache)
+    {
+	uint i;
+	for ( i = 0; i < fst->cache_size; i++ )
+	    FREE(fst->cache[i].data);
+	FREE(fst->cache);
+    }
 
     wd_close_disc(fst->disc);
 
@@ -2651,6 +2657,194 @@ void DumpFilesFST
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			CreateFST()...			///////////////
+///////////////////////////////////////////////////////////////////////////////
+// If multi threading is enabled, the calling thread reads and decrypts
+// the files in FST order (usually sorted by offset) and a pool of worker
+// threads creates and writes small files. Larger files are written
+// directly by the calling thread.
+
+#define EXTRACT_MAX_FILE_SIZE	IOBUF_SIZE	// max size of a file for a job
+#define EXTRACT_MAX_PENDING	(64*MiB)	// max data size of pending jobs
+#define EXTRACT_MAX_JOBS	256		// max number of pending jobs
+
+typedef struct ExtractJob_t
+{
+    ThreadJob_t		tjob;		// job of thread pool, must be first member
+    struct ExtractJob_t	* next;		// next job in queue
+    const WiiFstInfo_t	* wfi;		// related info, read only for the worker
+
+    File_t		fo;		// destination file, initialized by the caller
+    ccp			path;		// alloced path of destination file
+    u8			* data;		// file data, alloced together with the job
+    u32			size;		// size of 'data'
+
+    enumError		err;		// result of the job
+    int			syserr;		// 'errno' of the failed operation
+    bool		not_created;	// true: file not created
+}
+ExtractJob_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void extract_job_func ( ThreadJob_t * tjob )
+{
+    // 'job->fo' is setup by add_extract_job() with disabled error messages,
+    // because only the calling thread is allowed to print errors.
+
+    ExtractJob_t * job = (ExtractJob_t*)tjob;
+    DASSERT(job);
+    const WiiFstInfo_t * wfi = job->wfi;
+    DASSERT(wfi);
+
+    File_t * fo = &job->fo;
+    job->err = CreateFile( fo, job->path, IOM_NO_STREAM, wfi->overwrite );
+    if (job->err)
+	job->not_created = true;
+    else
+    {
+	job->err = WriteF(fo,job->data,job->size);
+	if (!job->err)
+	    job->err = CloseFile(fo,false); // rename the temp file
+	if ( !job->err && wfi->set_time )
+	    SetFileTime(fo,wfi->set_time);
+    }
+
+    if (job->err)
+	job->syserr = errno;
+    ResetFile( fo, job->err != ERR_OK );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void finish_extract_job ( WiiFstInfo_t *wfi )
+{
+    // wait for the first pending job and collect the results
+
+    DASSERT(wfi);
+    ExtractJob_t * job = wfi->job_first;
+    DASSERT(job);
+
+    WaitThreadJob(wfi->tpool,&job->tjob);
+    if (job->err)
+    {
+	ERROR( job->syserr, job->err,
+		job->err == ERR_ALREADY_EXISTS	? "File already exists: %s\n"
+		: job->err == ERR_WRONG_FILE_TYPE	? "Not a plain file: %s\n"
+		: job->err == ERR_CANT_CREATE		? "Can't create file: %s\n"
+		:					  "Write to file failed: %s\n",
+		job->path );
+
+	if (job->not_created)
+	    wfi->not_created_count++;
+	else if (!wfi->job_err)
+	    wfi->job_err = job->err;
+    }
+
+    wfi->job_first = job->next;
+    if (!wfi->job_first)
+	wfi->job_last = 0;
+    wfi->n_jobs--;
+    wfi->job_size -= job->size;
+
+    FREE((char*)job->path);
+    FREE(job);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError finish_extract_jobs ( WiiFstInfo_t *wfi )
+{
+    // wait for all pending jobs and return the first error
+
+    DASSERT(wfi);
+    while (wfi->job_first)
+	finish_extract_job(wfi);
+    return wfi->job_err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError add_extract_job
+(
+    WiiFstInfo_t	*wfi,		// valid extraction info with pool
+    ccp			dest,		// destination path
+    WiiFstFile_t	*file		// file to extract, not larger than
+					// EXTRACT_MAX_FILE_SIZE
+)
+{
+    DASSERT(wfi);
+    DASSERT(wfi->tpool);
+    DASSERT(dest);
+    DASSERT(file);
+    DASSERT( file->size <= EXTRACT_MAX_FILE_SIZE );
+
+    WiiFstPart_t * part = wfi->part;
+    DASSERT(part);
+
+    // 'created_files' is not thread safe and 'CreatePath()'
+    // prints error messages => do it here
+
+    if ( ignore_count < 1 )
+	CheckCreated(dest,false,ERR_WARNING);
+    if (CreatePath(dest))
+    {
+	wfi->not_created_count++;
+	return ERR_OK;
+    }
+
+    ExtractJob_t * job = MALLOC( sizeof(*job) + file->size );
+    memset(job,0,sizeof(*job));
+    InitializeFile(&job->fo);
+    job->fo.disable_errors = true;
+    job->fo.already_created_mode = 0;
+    job->wfi  = wfi;
+    job->data = (u8*)(job+1);
+    job->size = file->size;
+
+    enumError err = ERR_OK;
+    if ( file->icm == WD_ICM_DATA )
+	memcpy(job->data,file->data,file->size);
+    else if (file->size)
+	err = file->icm == WD_ICM_FILE
+		? wd_read_part(part->part,file->offset4,job->data,file->size,false)
+		: wd_read_raw(part->part->disc,file->offset4,job->data,file->size,0);
+
+    if (err)
+    {
+	FREE(job);
+	return err;
+    }
+
+    //----- progress
+
+    if ( file->icm != WD_ICM_DATA )
+    {
+	wfi->done_size += file->size;
+	if ( wfi->sf && wfi->sf->show_progress )
+	    PrintProgressSF(wfi->done_size,wfi->total_size,wfi->sf);
+    }
+
+    //----- append job and limit the memory usage
+
+    job->path = STRDUP(dest);
+    if (wfi->job_last)
+	wfi->job_last->next = job;
+    else
+	wfi->job_first = job;
+    wfi->job_last = job;
+    wfi->n_jobs++;
+    wfi->job_size += job->size;
+    AddThreadJob(wfi->tpool,&job->tjob,extract_job_func,job);
+
+    while ( wfi->job_first
+	&& ( wfi->n_jobs > EXTRACT_MAX_JOBS || wfi->job_size > EXTRACT_MAX_PENDING ))
+    {
+	finish_extract_job(wfi);
+    }
+
+    return wfi->job_err;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 enumError CreateFST ( WiiFstInfo_t *wfi, ccp dest_path )
@@ -2696,6 +2890,15 @@ enumError CreateFST ( WiiFstInfo_t *wfi, ccp dest_path )
     }
 
 
+    //----- setup writer threads
+
+    if ( GetThreadCount() > 1 && !wfi->tpool )
+    {
+	wfi->tpool = MALLOC(sizeof(*wfi->tpool));
+	InitializeThreadPool(wfi->tpool,0);
+    }
+
+
     //----- iterate partitions
 
     enumError err = ERR_OK;
@@ -2704,6 +2907,13 @@ enumError CreateFST ( WiiFstInfo_t *wfi, ccp dest_path )
 	err = CreatePartFST(wfi,dest_path);
     wfi->part = 0;
 
+    if (wfi->tpool)
+    {
+	ResetThreadPool(wfi->tpool);
+	FREE(wfi->tpool);
+	wfi->tpool = 0;
+    }
+
     if ( wfi->copy_image && wfi->sf && wfi->sf->disc1 )
     {
 	DASSERT( wfi->sf->disc1->disc_type == WD_DT_GAMECUBE );
@@ -2800,6 +3010,16 @@ enumError CreatePartFST ( WiiFstInfo_t *wfi, ccp dest_path )
 	    err = CreateFileFST(wfi,path,file);
 
 
+    //----- wait for pending write jobs
+
+    if (wfi->tpool)
+    {
+	const enumError job_err = finish_extract_jobs(wfi);
+	if (!err)
+	    err = job_err;
+    }
+
+
     //----- write include.list
 
     StringCat2E(path_dest,path_end,part->path,FST_INCLUDE_FILE);
@@ -2912,6 +3132,10 @@ enumError CreateFileFST ( WiiFstInfo_t *wfi, ccp dest_path, WiiFstFile_t * file
 	WiiFstFile_t * last = wfi->last_file;
 	if ( last && last->offset4 == file->offset4 && last->size == file->size )
 	{
+	    // the link source may be written by a pending job
+	    if (wfi->tpool)
+		finish_extract_jobs(wfi);
+
 	    char * source_end = source + sizeof(source);
 	    char * source_part = StringCat2E(source,source_end,dest_path,part->path);
 	    StringCopyE(source_part,source_end,last->path);
@@ -2976,6 +3200,9 @@ enumError CreateFileFST ( WiiFstInfo_t *wfi, ccp dest_path, WiiFstFile_t * file
 		file->icm == WD_ICM_DATA ? "write  " : "extract", file->size, dest );
     }
 
+    if ( wfi->tpool && file->size <= EXTRACT_MAX_FILE_SIZE )
+	return add_extract_job(wfi,dest,file);
+
     File_t fo;
     InitializeFile(&fo);
     fo.create_directory = true;
@@ -3002,7 +3229,7 @@ enumError CreateFileFST ( WiiFstInfo_t *wfi, ccp dest_path, WiiFstFile_t * file
 	while ( size > 0 )
 	{
 	    const u32 read_size = size < sizeof(iobuf) ? size : sizeof(iobuf);
-	    err = ReadFileFST4(part,file,off4,iobuf,read_size);
+	    err = ReadFileFST4(0,part,file,off4,iobuf,read_size);
 	    if (err)
 		break;
 
@@ -3071,6 +3298,7 @@ enumError CreateFileFST ( WiiFstInfo_t *wfi, ccp dest_path, WiiFstFile_t * file
 
 enumError ReadFileFST4
 (
+    wd_read_ctx_t	* ctx,	// NULL or private read context of the thread
     WiiFstPart_t	* part,	// valid fst partition pointer
     const WiiFstFile_t	*file,	// valid fst file pointer
     u32			off4,	// file offset/4
@@ -3096,7 +3324,8 @@ enumError ReadFileFST4
 		mode = 'F';
 		break;
 	    }
-	    return wd_read_part( part->part, file->offset4 + off4, buf, size, false );
+	    return wd_read_part_ctx( ctx, part->part, file->offset4 + off4,
+					buf, size, false );
 
 	case WD_ICM_COPY:
 	    if ( (off4<<2) + size > file->size )
@@ -3133,6 +3362,7 @@ enumError ReadFileFST4
 
 enumError ReadFileFST
 (
+    wd_read_ctx_t	* ctx,	// NULL or private read context of the thread
     WiiFstPart_t	* part,	// valid fst partition pointer
     const WiiFstFile_t	*file,	// valid fst file pointer
     u64			off,	// file offset
@@ -3142,7 +3372,7 @@ enumError ReadFileFST
 {
     const uint skip = (uint)off & 3;
     if (!skip)
-	return ReadFileFST4(part,file,off>>2,buf,size);
+	return ReadFileFST4(ctx,part,file,off>>2,buf,size);
 
     DASSERT(part);
     DASSERT(part->part);
@@ -3154,7 +3384,7 @@ enumError ReadFileFST
 		off, size, file->icm, file->offset4<<2, file->size );
 
     char temp[4];
-    const enumError err = ReadFileFST4(part,file,off>>2,temp,sizeof(temp));
+    const enumError err = ReadFileFST4(ctx,part,file,off>>2,temp,sizeof(temp));
     if (err)
 	return err;
 
@@ -3165,7 +3395,7 @@ enumError ReadFileFST
 
     memcpy(buf,temp+skip,pre_read);
     buf = (char*)buf + pre_read;
-    return ReadFileFST4(part,file,(off+skip)>>2,buf,size-pre_read);
+    return ReadFileFST4(ctx,part,file,(off+skip)>>2,buf,size-pre_read);
 }
 
 //
@@ -4400,13 +4630,14 @@ enumError SetupReadFST ( SuperFile_t * sf )
     }
 
 
-    //----- setup work+cache buffer of WII_GROUP_SIZE
+    //----- setup cache list, each element caches WII_GROUP_SIZE bytes
     //		== WII_N_ELEMENTS_H1 * WII_N_ELEMENTS_H2 * WII_SECTOR_SIZE
+    //		The data buffers are allocated on demand.
 
     ASSERT(!fst->cache);
-    ASSERT(!fst->cache_part);
-    fst->cache = MALLOC(WII_GROUP_SIZE);
-    TRACE("CACHE= %x/hex = %u bytes\n",WII_GROUP_SIZE,WII_GROUP_SIZE);
+    fst->cache_size = opt_fst_cache ? opt_fst_cache : FST_DEF_CACHE;
+    fst->cache = CALLOC(fst->cache_size,sizeof(*fst->cache));
+    TRACE("CACHE= %u * %x/hex bytes\n",fst->cache_size,WII_GROUP_SIZE);
 
 
     //----- setup mapping
@@ -4459,7 +4690,9 @@ enumError UpdateSignatureFST ( WiiFst_t * fst )
 	return ERR_OK;
 
     // invalidate cache
-    fst->cache_part = 0;
+    uint i;
+    for ( i = 0; i < fst->cache_size; i++ )
+	fst->cache[i].part = 0;
 
     // iterate partitions
     WiiFstPart_t *part, *part_end = fst->part + fst->part_used;
@@ -4586,6 +4819,108 @@ enumError ReadFST ( SuperFile_t * sf, off_t off, void * buf, size_t count )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+u32 opt_fst_cache = 0;
+
+//-----------------------------------------------------------------------------
+
+int ScanOptFSTCache ( ccp arg )
+{
+    if (!arg)
+	return 0;
+
+    u32 num;
+    enumError stat = ScanSizeOptU32(
+		&num,			// u32 * num
+		arg,			// ccp source
+		1,			// default_factor1
+		0,			// int force_base
+		"fst-cache",		// ccp opt_name
+		0,			// u64 min
+		FST_MAX_CACHE,		// u64 max
+		0,			// u32 multiple
+		0,			// u32 pow2
+		true			// bool print_err
+		) != ERR_OK;
+
+    if (!stat)
+	opt_fst_cache = num;
+    return stat;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PrintCacheStatFST ( FILE *f, int indent, const WiiFst_t * fst )
+{
+    DASSERT(f);
+    if ( !fst || !fst->cache )
+	return;
+
+    uint i, n_alloced = 0;
+    for ( i = 0; i < fst->cache_size; i++ )
+	if (fst->cache[i].data)
+	    n_alloced++;
+
+    const u64 total = fst->cache_hits + fst->cache_misses;
+    fprintf(f,"%*sFST cache: %u/%u groups used, %llu hits (%4.1f%%), %llu misses\n",
+		indent, "", n_alloced, fst->cache_size,
+		fst->cache_hits, total ? 100.0 * fst->cache_hits / total : 0.0,
+		fst->cache_misses );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError GetGroupFST
+(
+    SuperFile_t		* sf,		// valid file
+    WiiFstPart_t	* part,		// valid partition
+    u32			group,		// group index of 'part'
+    const u8		** data		// store pointer to encrypted group here
+)
+{
+    // find 'group' in the LRU cache or compose it into the
+    // least recently used element
+
+    DASSERT(sf);
+    DASSERT(sf->fst);
+    DASSERT(part);
+    DASSERT(data);
+
+    WiiFst_t * fst = sf->fst;
+    WiiFstCache_t *c, *found = 0, *end = fst->cache + fst->cache_size;
+    for ( c = fst->cache; c < end; c++ )
+    {
+	if ( c->part == part && c->group == group )
+	{
+	    fst->cache_hits++;
+	    c->lru = ++fst->lru_counter;
+	    *data = c->data;
+	    return ERR_OK;
+	}
+
+	if ( !found
+		|| found->part && ( !c->part || (s32)( c->lru - found->lru ) < 0 ))
+	    found = c;
+    }
+
+    DASSERT(found);
+    fst->cache_misses++;
+    if (!found->data)
+	found->data = MALLOC(WII_GROUP_SIZE);
+
+    found->part = 0;
+    const enumError err = ReadPartGroupFST(sf,part,group,found->data,1);
+    if (err)
+	return err;
+
+    found->part  = part;
+    found->group = group;
+    found->lru   = ++fst->lru_counter;
+    *data = found->data;
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError ReadPartFST ( SuperFile_t * sf, WiiFstPart_t * part,
 			off_t off, void * buf, size_t count )
 {
@@ -4597,9 +4932,8 @@ enumError ReadPartFST ( SuperFile_t * sf, WiiFstPart_t * part,
     ASSERT(sf->fst->cache);
     ASSERT(part);
 
-    WiiFst_t * fst = sf->fst;
     char *dest = buf;
-    TRACE("CACHE=%p, buf=%p, dest=%p\n",fst->cache,buf,dest);
+    TRACE("CACHE=%p, buf=%p, dest=%p\n",sf->fst->cache,buf,dest);
 
     u32 group = off/WII_GROUP_SIZE;
     const off_t skip = off - group * (off_t)WII_GROUP_SIZE;
@@ -4607,14 +4941,10 @@ enumError ReadPartFST ( SuperFile_t * sf, WiiFstPart_t * part,
     {
 	TRACE("READ/skip=%llx off=%llx dest=+%zx\n",(u64)skip,(u64)off,dest-(ccp)buf);
 
-	if ( fst->cache_part != part || fst->cache_group != group )
-	{
-	    const enumError err = ReadPartGroupFST(sf,part,group,fst->cache,1);
-	    if (err)
-		return err;
-	    fst->cache_part  = part;
-	    fst->cache_group = group;
-	}
+	const u8 *data;
+	const enumError err = GetGroupFST(sf,part,group,&data);
+	if (err)
+	    return err;
 
 	ASSERT( skip < WII_GROUP_SIZE );
 	u32 copy_len = WII_GROUP_SIZE - skip;
@@ -4622,7 +4952,7 @@ enumError ReadPartFST ( SuperFile_t * sf, WiiFstPart_t * part,
 	     copy_len = count;
 
 	TRACE("COPY/len=%x\n",copy_len);
-	memcpy(dest,fst->cache+skip,copy_len);
+	memcpy(dest,data+skip,copy_len);
 	TRACELINE;
 	dest  += copy_len;
 	count -= copy_len;
@@ -4650,16 +4980,12 @@ enumError ReadPartFST ( SuperFile_t * sf, WiiFstPart_t * part,
 	ASSERT( count < WII_GROUP_SIZE );
 	TRACE("READ/count=%zx off=%llx dest=+%zx\n",count,(u64)off,dest-(ccp)buf);
 
-	if ( fst->cache_part != part || fst->cache_group != group )
-	{
-	    const enumError err = ReadPartGroupFST(sf,part,group,fst->cache,1);
-	    if (err)
-		return err;
-	    fst->cache_part  = part;
-	    fst->cache_group = group;
-	}
+	const u8 *data;
+	const enumError err = GetGroupFST(sf,part,group,&data);
+	if (err)
+	    return err;
 	TRACE("COPY/len=%zx\n",count);
-	memcpy(dest,fst->cache,count);
+	memcpy(dest,data,count);
     }
 
     return ERR_OK;
@@ -4929,6 +5255,9 @@ void EncryptSectorGroup
   #define WATCH_BLOCK 0
 #endif
 
+// decrypted group + encrypted group, because inplace decryption is not possible
+#define VERIFY_GBUF_SIZE (2*WII_GROUP_SIZE)
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void InitializeVerify ( Verify_t * ver, SuperFile_t * sf )
@@ -5014,46 +5343,33 @@ static enumError PrintVerifyMessage ( Verify_t * ver, ccp msg )
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static enumError VerifyHash
-	( Verify_t * ver, ccp msg, u8 * data, size_t data_len, u8 * ref )
+static enumError PrintVerifyHash
+(
+    Verify_t		* ver,		// valid verify data
+    ccp			msg,		// message, e.g. "!H0-ERR"
+    const u8		* gbuf,		// group buffer with decrypted data
+    const u8		* data,		// hashed data
+    size_t		data_len,	// size of 'data'
+    const u8		* ref,		// reference hash
+    const u8		* hash		// calculated hash
+)
 {
     DASSERT(ver);
     DASSERT(ver->part);
 
- #if WATCH_BLOCK && 0
-    {
-	const u32 delta_off = (ccp)data - iobuf;
-	const u32 delta_blk = delta_off / WII_SECTOR_SIZE;
-	const u64 offset    = ver->part->part_offset
-			    + ver->part->pc->data_off
-			    + ver->group * (u64)WII_GROUP_SIZE
-			    + delta_off;
-	const u32 block	    = offset / WII_SECTOR_SIZE;
-
-	if ( block == WATCH_BLOCK )
-	    printf("WB: %s: delta=%x->%x, cmp(%02x,%02x)\n",
-			msg, delta_off, delta_blk, *hash, *ref );
-    }
- #endif
-
-    u8 hash[WII_HASH_SIZE];
-    SHA1(data,data_len,hash);
-    if (!memcmp(hash,ref,WII_HASH_SIZE))
-	return ERR_OK;
-
     PrintVerifyMessage(ver,msg);
     if ( ver->verbose >= -1 && ver->long_count > 0 )
     {
 	bool flush = false;
 
-	const u32 delta_off	= (ccp)data - iobuf;
+	const u32 delta_off	= data - gbuf;
 	const u32 delta_blk	= delta_off / WII_SECTOR_SIZE;
 	const u64 offset	= ( (u64)ver->part->data_off4 << 2 )
 				+ ver->group * (u64)WII_GROUP_SIZE
 				+ delta_off;
 	const int ref_delta	= ref - data; 
 
-	if ( (ccp)ref >= iobuf && (ccp)ref <= iobuf + sizeof(iobuf) )
+	if ( ref >= gbuf && ref <= gbuf + VERIFY_GBUF_SIZE )
 	{
 	    const u32 block	= offset / WII_SECTOR_SIZE;
 	    const u32 block_off	= offset - block * (u64)WII_SECTOR_SIZE;
@@ -5087,6 +5403,298 @@ static enumError VerifyHash
     return ERR_DIFFER;
 }
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			verify jobs			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The sector groups of a partition are read by the main thread and then
+// decrypted and checked by worker threads. A worker doesn't print anything,
+// but collects events. The events are printed by the main thread in group
+// order, so the output is the same as for a single threaded verification.
+
+typedef struct verify_event_t
+{
+    ccp			msg;		// message, e.g. "!H0-ERR"
+    const u8		* data;		// NULL or hashed data
+    size_t		data_len;	// size of 'data'
+    const u8		* ref;		// reference hash
+    u8			hash[WII_HASH_SIZE];
+					// calculated hash
+} verify_event_t;
+
+//-----------------------------------------------------------------------------
+
+typedef struct verify_job_t
+{
+    ThreadJob_t		tjob;		// thread job, must be first member
+    Verify_t		* ver;		// related verify data
+    const aes_key_t	* akey;		// aes key of the partition
+    bool		active;		// true: job started, events not printed
+
+    u32			group;		// index of sector group
+    u32			block;		// first block of the group
+    u32			block_end;	// end of partition blocks
+    u8			* gbuf;		// group buffer, VERIFY_GBUF_SIZE bytes
+
+    verify_event_t	* event;	// list with events
+    uint		n_event;	// number of used events
+    uint		max_event;	// number of allocated events
+
+} verify_job_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void add_verify_event
+(
+    verify_job_t	* job,		// valid job
+    ccp			msg,		// message, e.g. "!H0-ERR"
+    const u8		* data,		// NULL or hashed data
+    size_t		data_len,	// size of 'data'
+    const u8		* ref,		// NULL or reference hash
+    const u8		* hash		// NULL or calculated hash
+)
+{
+    DASSERT(job);
+    if ( job->n_event == job->max_event )
+    {
+	job->max_event = job->max_event ? 2 * job->max_event : 16;
+	job->event = REALLOC(job->event,job->max_event*sizeof(*job->event));
+    }
+
+    verify_event_t * ev = job->event + job->n_event++;
+    ev->msg	 = msg;
+    ev->data	 = data;
+    ev->data_len = data_len;
+    ev->ref	 = ref;
+    if (hash)
+	memcpy(ev->hash,hash,sizeof(ev->hash));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool verify_hash
+(
+    verify_job_t	* job,		// valid job
+    ccp			msg,		// message, e.g. "!H0-ERR"
+    const u8		* data,		// data to hash
+    size_t		data_len,	// size of 'data'
+    const u8		* ref		// reference hash
+)
+{
+    u8 hash[WII_HASH_SIZE];
+    SHA1(data,data_len,hash);
+    if (!memcmp(hash,ref,WII_HASH_SIZE))
+	return false;
+
+    add_verify_event(job,msg,data,data_len,ref,hash);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void verify_group_job
+(
+    ThreadJob_t		* tjob		// valid job, embedded in verify_job_t
+)
+{
+    verify_job_t * job = (verify_job_t*)tjob;
+    DASSERT(job);
+    Verify_t * ver = job->ver;
+    DASSERT(ver);
+    wd_part_t * part = ver->part;
+    DASSERT(part);
+
+    const u8 usage_tab_marker = part->usage_id | WD_USAGE_F_CRYPT;
+    job->n_event = 0;
+
+    u32 blk = job->block;
+    wd_part_sector_t * sect_h2 = 0;
+    int i2; // iterate through H2 elements
+    for ( i2 = 0; i2 < WII_N_ELEMENTS_H2 && blk < job->block_end; i2++ )
+    {
+	wd_part_sector_t * sect_h1 = 0;
+	int i1; // iterate through H1 elements
+	for ( i1 = 0; i1 < WII_N_ELEMENTS_H1 && blk < job->block_end; i1++, blk++ )
+	{
+	    if ( ver->usage_tab[blk] != usage_tab_marker )
+		continue;
+
+	    //----- we have found a used blk -----
+
+	    wd_part_sector_t *sect	= (wd_part_sector_t*)job->gbuf
+					+ i2 * WII_N_ELEMENTS_H1 + i1;
+
+	    if ( part->is_encrypted )
+		wd_decrypt_sectors(0,job->akey,sect+WII_GROUP_SECTORS,sect,0,1);
+
+
+	    //----- check H0 -----
+
+	    const u8 *dlist[WII_N_ELEMENTS_H0];
+	    u8 h0[WII_N_ELEMENTS_H0][WII_HASH_SIZE], *hlist[WII_N_ELEMENTS_H0];
+	    int i0;
+	    for ( i0 = 0; i0 < WII_N_ELEMENTS_H0; i0++ )
+	    {
+		dlist[i0] = sect->data[i0];
+		hlist[i0] = h0[i0];
+	    }
+	    SHA1_MB(dlist,WII_H0_DATA_SIZE,hlist,WII_N_ELEMENTS_H0);
+
+	    for ( i0 = 0; i0 < WII_N_ELEMENTS_H0; i0++ )
+		if (memcmp(h0[i0],sect->h0[i0],WII_HASH_SIZE))
+		    add_verify_event(job,"!H0-ERR",sect->data[i0],WII_H0_DATA_SIZE,
+					sect->h0[i0],h0[i0]);
+
+	    //----- check H1 -----
+
+	    if (verify_hash(job,"!H1-ERR",*sect->h0,sizeof(sect->h0),sect->h1[i1]))
+		continue;
+
+	    //----- check first H1 -----
+
+	    if (!sect_h1)
+	    {
+		// first valid H1 sector
+		sect_h1 = sect;
+
+		//----- check H1 -----
+
+		verify_hash(job,"!H2-ERR",*sect->h1,sizeof(sect->h1),sect->h2[i2]);
+	    }
+	    else if (memcmp(sect->h1,sect_h1->h1,sizeof(sect->h1)))
+		add_verify_event(job,"!H1-DIFF",0,0,0,0);
+
+	    //----- check first H2 -----
+
+	    if (!sect_h2)
+	    {
+		// first valid H2 sector
+		sect_h2 = sect;
+
+		//----- check H3 -----
+
+		const u8 * h3 = part->h3 + job->group * WII_HASH_SIZE;
+		verify_hash(job,"!H3-ERR",*sect->h2,sizeof(sect->h2),h3);
+	    }
+	    else if (memcmp(sect->h2,sect_h2->h2,sizeof(sect->h2)))
+		add_verify_event(job,"!H2-DIFF",0,0,0,0);
+	}
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool print_verify_events
+(
+    verify_job_t	* job,		// valid and finished job
+    int			* differ_count,	// pointer to differ counter
+    int			max_differ_count // abort if reached
+)
+{
+    // returns true, if 'max_differ_count' is reached
+
+    DASSERT(job);
+    DASSERT(differ_count);
+    Verify_t * ver = job->ver;
+    DASSERT(ver);
+
+    ver->group = job->group;
+    const verify_event_t *ev = job->event, *ev_end = ev + job->n_event;
+    for ( ; ev < ev_end; ev++ )
+    {
+	if (ev->data)
+	    PrintVerifyHash(ver,ev->msg,job->gbuf,ev->data,ev->data_len,ev->ref,ev->hash);
+	else
+	    PrintVerifyMessage(ver,ev->msg);
+
+	if ( ++*differ_count >= max_differ_count )
+	    return true;
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool finish_verify_job
+(
+    ThreadPool_t	* tpool,	// valid thread pool
+    verify_job_t	* job,		// valid job
+    int			* differ_count,	// NULL or pointer to differ counter
+					// NULL: wait only, don't print events
+    int			max_differ_count // abort if reached
+)
+{
+    // returns true, if 'max_differ_count' is reached
+
+    DASSERT(tpool);
+    DASSERT(job);
+
+    if (!job->active)
+	return false;
+
+    WaitThreadJob(tpool,&job->tjob);
+    job->active = false;
+    return differ_count && print_verify_events(job,differ_count,max_differ_count);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static uint setup_verify_jobs
+(
+    Verify_t		* ver,		// valid verify data
+    ThreadPool_t	* tpool,	// valid thread pool
+    verify_job_t	** job_list,	// store the job list here
+    const aes_key_t	* akey		// aes key of the partition
+)
+{
+    // one more job than threads => the main thread can read
+    // the next group while all workers are busy
+
+    uint n_jobs = tpool->n_threads + 1;
+    const u64 mem_limit = GetMemLimit() / 2;
+    if (mem_limit) // 0: memory limit unknown
+	while ( n_jobs > 1 && n_jobs * (u64)VERIFY_GBUF_SIZE > mem_limit )
+	    n_jobs--;
+
+    verify_job_t * job = CALLOC(n_jobs,sizeof(*job));
+    *job_list = job;
+
+    uint i;
+    for ( i = 0; i < n_jobs; i++, job++ )
+    {
+	job->ver	= ver;
+	job->akey	= akey;
+	job->gbuf	= MALLOC(VERIFY_GBUF_SIZE);
+    }
+    PRINT("VERIFY: %u threads, %u jobs\n",tpool->n_threads,n_jobs);
+    return n_jobs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void reset_verify_jobs
+(
+    verify_job_t	* job_list,	// NULL or list with jobs
+    uint		n_jobs		// number of jobs
+)
+{
+    if (job_list)
+    {
+	uint i;
+	for ( i = 0; i < n_jobs; i++ )
+	{
+	    DASSERT(!job_list[i].active);
+	    FREE(job_list[i].gbuf);
+	    FREE(job_list[i].event);
+	}
+	FREE(job_list);
+    }
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			verify partitions		///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
 enumError VerifyPartition ( Verify_t * ver )
@@ -5104,10 +5712,6 @@ enumError VerifyPartition ( Verify_t * ver )
     printf("WB: WATCH BLOCK %x = %u\n",WATCH_BLOCK,WATCH_BLOCK);
  #endif
 
-    DASSERT( sizeof(iobuf) >= 2*WII_GROUP_SIZE );
-    if ( sizeof(iobuf) < WII_GROUP_SIZE )
-	return ERROR0(ERR_INTERNAL,0);
-
     ver->indent = NormalizeIndent(ver->indent);
 
     if (  ver->verbose > 0
@@ -5175,8 +5779,28 @@ enumError VerifyPartition ( Verify_t * ver )
     aes_key_t akey;
     wd_aes_set_key(&akey,part->key);
 
-    for ( ver->group = 0; block < block_end; ver->group++, block += WII_GROUP_SECTORS )
+    ThreadPool_t local_pool, *tpool = ver->tpool;
+    if (!tpool)
     {
+	tpool = &local_pool;
+	InitializeThreadPool(tpool,0);
+    }
+
+    verify_job_t * job_list;
+    const uint n_jobs = setup_verify_jobs(ver,tpool,&job_list,&akey);
+    uint next_job = 0;
+    bool abort_verify = false;
+    enumError err = ERR_OK;
+
+    u32 group;
+    for ( group = 0; block < block_end; group++, block += WII_GROUP_SECTORS )
+    {
+	if (SIGINT_level>1)
+	{
+	    err = ERR_INTERRUPT;
+	    break;
+	}
+
 	//----- preload data
 
      #if WATCH_BLOCK
@@ -5214,115 +5838,52 @@ enumError VerifyPartition ( Verify_t * ver )
 	    continue;
 	}
 
+	//----- get a free job, print the events of the previous group
+
+	verify_job_t * job = job_list + next_job;
+	next_job = ( next_job + 1 ) % n_jobs;
+	if (finish_verify_job(tpool,job,&differ_count,max_differ_count))
+	{
+	    abort_verify = true;
+	    break;
+	}
+
 	const u64 read_off = (block+found) * (u64)WII_SECTOR_SIZE;
-	wd_part_sector_t * read_sect = (wd_part_sector_t*)iobuf + found;
+	wd_part_sector_t * read_sect = (wd_part_sector_t*)job->gbuf + found;
 	if ( part->is_encrypted )
 	    read_sect += WII_GROUP_SECTORS; // inplace decryption not possible
-	const enumError err
-	    = ReadSF( ver->sf, read_off, read_sect, (found_end-found)*WII_SECTOR_SIZE );
+	err = ReadSF( ver->sf, read_off, read_sect, (found_end-found)*WII_SECTOR_SIZE );
 	if (err)
-	    return err;
-
-	//----- iterate through preloaded data
-
-	blk = block;
-	wd_part_sector_t * sect_h2 = 0;
-	int i2; // iterate through H2 elements
-	for ( i2 = 0; i2 < WII_N_ELEMENTS_H2 && blk < block_end; i2++ )
-	{
-	    wd_part_sector_t * sect_h1 = 0;
-	    int i1; // iterate through H1 elements
-	    for ( i1 = 0; i1 < WII_N_ELEMENTS_H1 && blk < block_end; i1++, blk++ )
-	    {
-		if (SIGINT_level>1)
-		    return ERR_INTERRUPT;
-
-		if ( ver->usage_tab[blk] != usage_tab_marker )
-		    continue;
-
-		//----- we have found a used blk -----
-
-		wd_part_sector_t *sect	= (wd_part_sector_t*)iobuf
-					+ i2 * WII_N_ELEMENTS_H1 + i1;
-
-		if ( part->is_encrypted )
-		    wd_decrypt_sectors(0,&akey,sect+WII_GROUP_SECTORS,sect,0,1);
-
-
-		//----- check H0 -----
-
-		int i0;
-		for ( i0 = 0; i0 < WII_N_ELEMENTS_H0; i0++ )
-		{
-		    if (VerifyHash(ver,"!H0-ERR",sect->data[i0],WII_H0_DATA_SIZE,sect->h0[i0]))
-		    {
-			if ( ++differ_count >= max_differ_count )
-			    goto abort;
-		    }
-		}
-
-		//----- check H1 -----
-
-		if (VerifyHash(ver,"!H1-ERR",*sect->h0,sizeof(sect->h0),sect->h1[i1]))
-		{
-		    if ( ++differ_count >= max_differ_count )
-			goto abort;
-		    continue;
-		}
-
-		//----- check first H1 -----
-
-		if (!sect_h1)
-		{
-		    // first valid H1 sector
-		    sect_h1 = sect;
+	    break;
 
-		    //----- check H1 -----
+	//----- decrypt and check the group by a worker
 
-		    if (VerifyHash(ver,"!H2-ERR",*sect->h1,sizeof(sect->h1),sect->h2[i2]))
-		    {
-			if ( ++differ_count >= max_differ_count )
-			    goto abort;
-		    }
-		}
-		else
-		{
-		    if (memcmp(sect->h1,sect_h1->h1,sizeof(sect->h1)))
-		    {
-			PrintVerifyMessage(ver,"!H1-DIFF");
-			if ( ++differ_count >= max_differ_count )
-			    goto abort;
-		    }
-		}
+	job->group	= group;
+	job->block	= block;
+	job->block_end	= block_end;
+	job->active	= true;
+	AddThreadJob(tpool,&job->tjob,verify_group_job,0);
+    }
 
-		//----- check first H2 -----
+    //----- finish pending jobs in group order
 
-		if (!sect_h2)
-		{
-		    // first valid H2 sector
-		    sect_h2 = sect;
+    uint i;
+    for ( i = 0; i < n_jobs; i++ )
+    {
+	verify_job_t * job = job_list + ( next_job + i ) % n_jobs;
+	if (finish_verify_job( tpool, job,
+			abort_verify || err ? 0 : &differ_count, max_differ_count ))
+	    abort_verify = true;
+    }
 
-		    //----- check H3 -----
+    reset_verify_jobs(job_list,n_jobs);
+    if ( tpool == &local_pool )
+	ResetThreadPool(tpool);
 
-		    u8 * h3 = part->h3 + ver->group * WII_HASH_SIZE;
-		    if (VerifyHash(ver,"!H3-ERR",*sect->h2,sizeof(sect->h2),h3))
-		    {
-			if ( ++differ_count >= max_differ_count )
-			    goto abort;
-		    }
-		}
-		else
-		{
-		    if (memcmp(sect->h2,sect_h2->h2,sizeof(sect->h2)))
-		    {
-			PrintVerifyMessage(ver,"!H2-DIFF");
-			if ( ++differ_count >= max_differ_count )
-			    goto abort;
-		    }
-		}
-	    }
-	}
-    }
+    if (err)
+	return err;
+    if (abort_verify)
+	goto abort;
 
     //----- check H4 -----
 
@@ -39,6 +39,7 @@
 
 #include "types.h"
 #include "lib-sf.h"
+#include "lib-thread.h"
 #include "patch.h"
 #include "dclib-utf8.h"
 #include "match-pattern.h"
@@ -102,6 +103,62 @@ typedef struct WDiscList_t
 
 } WDiscList_t;
 
+//-----------------------------------------------------------------------------
+// [[DiscCache_t]]
+
+typedef struct DiscCacheItem_t
+{
+    WDiscListItem_t	item;		// cached data, 'title' and 'fname' are NULL
+    char		fname_suffix[12]; // appended to the source path, e.g. "/#03"
+    char		rpath_suffix[12]; // appended to the real path, e.g. "/#3"
+    bool		have_path;	// true: the source path is the real filename
+
+} DiscCacheItem_t;
+
+//-----------------------------------------------------------------------------
+
+typedef struct DiscCacheEntry_t
+{
+    ccp			path;		// real path of the source file, alloced
+    u64			dev;		// device of the source file
+    u64			ino;		// inode of the source file
+    u64			size;		// size of the source file
+    u64			mtime_sec;	// mtime of the source file, seconds
+    u32			mtime_nsec;	// mtime of the source file, nanoseconds
+    bool		valid;		// false: entry removed or outdated
+
+    DiscCacheItem_t	* item;		// list with 'n_item' cached discs
+    uint		n_item;		// number of used elements of 'item'
+    uint		item_size;	// number of alloced elements of 'item'
+
+} DiscCacheEntry_t;
+
+//-----------------------------------------------------------------------------
+
+typedef struct DiscCache_t
+{
+    ccp			fname;		// filename of the cache file, alloced
+    ParamField_t	index;		// map real path -> index of 'list'
+    DiscCacheEntry_t	* list;		// list of entries
+    uint		used;		// number of used elements of 'list'
+    uint		size;		// number of alloced elements of 'list'
+    bool		dirty;		// true: cache must be written
+
+    // a source file, that is scanned because of a cache miss
+
+    bool		pending;	// true: 'pend' is active
+    bool		pend_failed;	// true: 'pend' can't be cached
+    uint		pend_expected;	// expected number of discs of 'pend'
+    ccp			pend_arg;	// the source path as given by the user
+    DiscCacheEntry_t	pend;		// the new entry
+
+    // statistics
+
+    uint		n_hit;		// number of files found in the cache
+    uint		n_miss;		// number of files not found in the cache
+
+} DiscCache_t;
+
 
 //
 ///////////////////////////////////////////////////////////////////////////////
@@ -278,6 +335,8 @@ enumError Dump_PATCH
 
 struct Iterator_t;
 typedef enumError (*IteratorFunc) ( SuperFile_t * sf, struct Iterator_t * it );
+typedef enumError (*IteratorCacheFunc)
+	( struct Iterator_t * it, const WDiscListItem_t * item, ccp fname, ccp path );
 extern int opt_source_auto;
 
 //-----------------------------------------------------------------------------
@@ -356,6 +415,9 @@ typedef struct Iterator_t
 	u64		sum;		// any summary value
 	WDiscList_t	* wlist;	// pointer to WDiscList_t to collect data
 	struct WBFS_t	* wbfs;		// open WBFS
+	DiscCache_t	* disc_cache;	// NULL or disc info cache, needs 'cache_func'
+	IteratorCacheFunc cache_func;	// call back function for cached discs
+	ThreadPool_t	* tpool;	// NULL or thread pool for parallel jobs
 	dev_t		open_dev;	// dev_t of open output file
 	ino_t		open_ino;	// ino_t of open output file
 
@@ -606,6 +668,24 @@ typedef struct WiiFstPart_t
 
 //-----------------------------------------------------------------------------
 
+#define FST_DEF_CACHE	8	// default number of cached groups
+#define FST_MAX_CACHE	256	// max number of cached groups
+
+extern u32 opt_fst_cache;	// number of cached groups, 0: FST_DEF_CACHE
+
+int ScanOptFSTCache ( ccp arg );
+
+typedef struct WiiFstCache_t
+{
+	WiiFstPart_t	*part;			// NULL or partition of cached group
+	u32		group;			// partition group of cached data
+	u32		lru;			// value of 'lru_counter' at last usage
+	u8		*data;			// NULL or alloced WII_GROUP_SIZE bytes
+
+} WiiFstCache_t;
+
+//-----------------------------------------------------------------------------
+
 typedef struct WiiFst_t
 {
 	//--- wd interface
@@ -638,9 +718,11 @@ typedef struct WiiFst_t
 	wd_header_t	dhead;			// disc header
 	wd_region_t	region;			// region settings
 
-	u8		*cache;			// cache with WII_GROUP_SECTORS elements
-	WiiFstPart_t	*cache_part;		// partition of valid cache data
-	u32		cache_group;		// partition group of cache data
+	WiiFstCache_t	*cache;			// LRU cache of encrypted groups
+	uint		cache_size;		// number of elements in 'cache'
+	u32		lru_counter;		// incremented on each cache access
+	u64		cache_hits;		// number of groups found in the cache
+	u64		cache_misses;		// number of groups composed on demand
 
 	enumEncoding	encoding;		// the encoding mode
 
@@ -670,6 +752,14 @@ typedef struct WiiFstInfo_t
 
 	ParamField_t	align_info;		// store align infos here
 
+	// parallel extraction: small files are written by worker threads
+	ThreadPool_t	* tpool;		// NULL or pool of writer threads
+	struct ExtractJob_t * job_first;	// first pending write job
+	struct ExtractJob_t * job_last;		// last pending write job
+	uint		n_jobs;			// number of pending write jobs
+	u64		job_size;		// data size of pending write jobs
+	enumError	job_err;		// first error of a finished job
+
 } WiiFstInfo_t;
 
 //-----------------------------------------------------------------------------
@@ -730,6 +820,7 @@ enumError CreateFileFST	( WiiFstInfo_t *wfi, ccp dest_path, WiiFstFile_t * file
 
 enumError ReadFileFST4
 (
+    wd_read_ctx_t	* ctx,	// NULL or private read context of the thread
     WiiFstPart_t	* part,	// valid fst partition pointer
     const WiiFstFile_t	*file,	// valid fst file pointer
     u32			off4,	// file offset/4
@@ -739,6 +830,7 @@ enumError ReadFileFST4
 
 enumError ReadFileFST
 (
+    wd_read_ctx_t	* ctx,	// NULL or private read context of the thread
     WiiFstPart_t	* part,	// valid fst partition pointer
     const WiiFstFile_t	*file,	// valid fst file pointer
     u64			off,	// file offset
@@ -776,6 +868,7 @@ enumError ReadPartFST ( SuperFile_t * sf, WiiFstPart_t * part,
 			off_t off, void * buf, size_t count );
 enumError ReadPartGroupFST ( SuperFile_t * sf, WiiFstPart_t * part,
 				u32 group_no, void * buf, u32 n_groups );
+void PrintCacheStatFST ( FILE *f, int indent, const WiiFst_t * fst );
 
 void EncryptSectorGroup
 (
@@ -804,6 +897,8 @@ typedef struct Verify_t
 	int			verbose;	// general verbosity level
 	int			long_count;	// verbosity for each message
 	int			max_err_msg;	// max message per partition
+	ThreadPool_t		* tpool;	// NULL or thread pool for all partitions
+						// NULL: use a local pool for each partition
 
 	// statistical values, used for messages
 
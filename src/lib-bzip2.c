@@ -68,6 +68,7 @@ ccp GetMessageBZIP2
 	case BZ_DATA_ERROR_MAGIC:	return "DATA ERROR MAGIC";
 	case BZ_IO_ERROR:		return "IO ERROR";
 	case BZ_MEM_ERROR:		return "MEM ERROR";
+	case BZ_OUTBUFF_FULL:		return "OUTBUFF FULL";
 	case BZ_PARAM_ERROR:		return "PARAM ERROR";
 	case BZ_SEQUENCE_ERROR:		return "SEQUENCE ERROR";
 	case BZ_STREAM_END:		return "STREAM END";
@@ -334,6 +335,74 @@ enumError EncBZIP2buf
 
 ///////////////////////////////////////////////////////////////////////////////
 
+enumError EncBZIP2_List2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const DataArea_t	*area,		// source list, terminated with data==NULL
+    int			compr_level	// valid are 1..9 / 0: use default value
+)
+{
+    // Create a raw bzip2 stream (without size prefix) like EncBZIP2_Write().
+    // This function doesn't use any global data, so it is usable by threads,
+    // if 'error_object' is NULL.
+
+    DASSERT(dest);
+    DASSERT(dest_written);
+    DASSERT(area);
+
+    bz_stream strm;
+    memset(&strm,0,sizeof(strm));
+    int bzerror = BZ2_bzCompressInit(&strm,CalcCompressionLevelBZIP2(compr_level),0,0);
+    if ( bzerror != BZ_OK )
+	return !error_object ? ERR_BZIP2 : ERROR0(ERR_BZIP2,
+		"Error while opening bzip2 stream: %s\n-> bzip2 error: %s\n",
+		error_object, GetMessageBZIP2(bzerror,"?") );
+
+    strm.next_out  = dest;
+    strm.avail_out = dest_size;
+
+    bzerror = BZ_RUN_OK;
+    for ( ; area->data && bzerror == BZ_RUN_OK; area++ )
+    {
+	strm.next_in  = (char*)area->data;
+	strm.avail_in = area->size;
+	while ( strm.avail_in && strm.avail_out )
+	{
+	    bzerror = BZ2_bzCompress(&strm,BZ_RUN);
+	    if ( bzerror != BZ_RUN_OK )
+		break;
+	}
+	if ( strm.avail_in )
+	    bzerror = BZ_OUTBUFF_FULL;
+    }
+
+    if ( bzerror == BZ_RUN_OK )
+    {
+	do
+	    bzerror = BZ2_bzCompress(&strm,BZ_FINISH);
+	while ( bzerror == BZ_FINISH_OK && strm.avail_out );
+	if ( bzerror == BZ_FINISH_OK )
+	    bzerror = BZ_OUTBUFF_FULL;
+    }
+
+    *dest_written = dest_size - strm.avail_out;
+    BZ2_bzCompressEnd(&strm);
+
+    if ( bzerror != BZ_STREAM_END )
+	return !error_object ? ERR_BZIP2 : ERROR0(ERR_BZIP2,
+		"Error while compressing data: %s\n-> bzip2 error: %s\n",
+		error_object, GetMessageBZIP2(bzerror,"?") );
+
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError EncBZIP2
 (
     u8			**dest_ptr,	// result: store destination buffer addr
@@ -412,6 +481,43 @@ enumError DecBZIP2buf
 
 ///////////////////////////////////////////////////////////////////////////////
 
+enumError DecBZIP2_Buf2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const void		*src,		// source: raw bzip2 stream
+    uint		src_size	// size of source buffer
+)
+{
+    // Decode a raw bzip2 stream (without size prefix) like DecBZIP2_Read().
+    // This function doesn't use any global data, so it is usable by threads,
+    // if 'error_object' is NULL.
+
+    DASSERT(dest);
+    DASSERT(dest_written);
+    DASSERT(src);
+
+    *dest_written = dest_size;
+    int bzerror = BZ2_bzBuffToBuffDecompress ( (char*)dest, dest_written,
+				(char*)src, src_size, 0, 0 );
+
+    if ( bzerror != BZ_OK )
+    {
+	*dest_written = 0;
+	return !error_object ? ERR_BZIP2 : ERROR0(ERR_BZIP2,
+		"Error while decompressing data: %s\n-> bzip2 error: %s\n",
+		error_object, GetMessageBZIP2(bzerror,"?") );
+    }
+
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError DecBZIP2
 (
     u8			**dest_ptr,	// result: store destination buffer addr
@@ -163,6 +163,20 @@ enumError EncBZIP2buf
 
 //-----------------------------------------------------------------------------
 
+enumError EncBZIP2_List2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const DataArea_t	*area,		// source list, terminated with data==NULL
+    int			compr_level	// valid are 1..9 / 0: use default value
+);
+
+//-----------------------------------------------------------------------------
+
 enumError EncBZIP2
 (
     u8			**dest_ptr,	// result: store destination buffer addr
@@ -189,6 +203,20 @@ enumError DecBZIP2buf
 
 //-----------------------------------------------------------------------------
 
+enumError DecBZIP2_Buf2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const void		*src,		// source: raw bzip2 stream
+    uint		src_size	// size of source buffer
+);
+
+//-----------------------------------------------------------------------------
+
 enumError DecBZIP2
 (
     u8			**dest_ptr,	// result: store destination buffer addr
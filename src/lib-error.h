@@ -77,6 +77,7 @@ typedef enum enumError
 	ERR_WIA_INVALID,
 	ERR_BZIP2,
 	ERR_LZMA,
+	ERR_ZSTD,
 
 	ERR_ALREADY_EXISTS,
 	ERR_CANT_OPEN,
@@ -41,6 +41,8 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 
 #include <fcntl.h>
 #include <errno.h>
@@ -61,6 +63,7 @@
 #include "lib-std.h"
 #include "lib-sf.h"
 #include "wbfs-interface.h"
+#include "lib-uring.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -89,6 +92,12 @@
   #define O_DIRECT 0
 #endif
 
+#if defined(__linux__) || defined(__FreeBSD__)
+  #define HAVE_PREADV 1
+#else
+  #define HAVE_PREADV 0
+#endif
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////                   file support                  ///////////////
@@ -102,9 +111,11 @@ enumIOMode opt_iomode = IOM__IS_DEFAULT | IOM_FORCE_STREAM;
 void ScanIOMode ( ccp arg )
 {
     const enumIOMode new_io = strtol(optarg,0,0); // [[2do]] error handling
-    opt_iomode = new_io & IOM__IS_MASK;
+    opt_iomode = new_io & ( IOM__IS_MASK | IOM_URING | IOM_MMAP );
     if ( verbose > 0 || opt_iomode != new_io )
 	printf("IO mode set to %#0x.\n",opt_iomode);
+    if ( opt_iomode & IOM_URING && !IsURingAvailable() && verbose >= 0 )
+	printf("io_uring is not supported by the system => use standard IO.\n");
     opt_iomode |= IOM_FORCE_STREAM;
 }
 
@@ -299,12 +310,16 @@ void InitializeFile ( File_t * f )
     f->slot = -1;
     f->already_created_mode = 2;
 
-    // normalize 'opt_iomode'
-    opt_iomode = opt_iomode & IOM__IS_MASK | IOM_FORCE_STREAM;
+    // normalize 'opt_iomode', but write it only if changed,
+    // so that threads can initialize files without data race
 
+    enumIOMode iomode
+	= opt_iomode & ( IOM__IS_MASK | IOM_URING | IOM_MMAP ) | IOM_FORCE_STREAM;
  #ifdef __CYGWIN__
-    opt_iomode |= IOM_IS_WBFS_PART;
+    iomode |= IOM_IS_WBFS_PART;
  #endif
+    if ( opt_iomode != iomode )
+	opt_iomode = iomode;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -398,6 +413,7 @@ enumError XCloseFile ( XPARM File_t * f, bool remove_file )
 
     //----- close file
 
+    UnmapF(f);
     bool close_err = false;
     if ( f->fp )
 	close_err = fclose(f->fp) != 0;
@@ -766,7 +782,7 @@ enumError XCreateFile
 
     if (!stat(fname,&f->st))
     {
-	if ( overwrite < 0 || f->disable_errors )
+	if ( overwrite < 0 || !overwrite && f->disable_errors )
 	    return ERR_ALREADY_EXISTS;
 
 	if ( S_ISBLK(f->st.st_mode) || S_ISCHR(f->st.st_mode) )
@@ -784,8 +800,10 @@ enumError XCreateFile
 	else
 	{
 	    if (!S_ISREG(f->st.st_mode))
-		return PrintError( XERROR0, ERR_WRONG_FILE_TYPE,
-		    "Not a plain file: %s\n", fname );
+		return f->disable_errors
+		    ? ERR_WRONG_FILE_TYPE
+		    : PrintError( XERROR0, ERR_WRONG_FILE_TYPE,
+			"Not a plain file: %s\n", fname );
 
 	    if (!overwrite)
 		return PrintError( XERROR0, ERR_ALREADY_EXISTS,
@@ -1268,6 +1286,11 @@ const OFT_info_t oft_info[OFT__N+1] =
 	IOM_IS_COMPRESSED,
 	"WIA", "--wia", ".wia", 0, "Compressed Wii ISO Archive" },
 
+    { OFT_RVZ,
+	OFT_A_READ|OFT_A_CREATE|OFT_A_COMPR,
+	IOM_IS_COMPRESSED,
+	"RVZ", "--rvz", ".rvz", 0, "Dolphins Revolution Zip" },
+
     { OFT_GCZ,
 	OFT_A_READ|OFT_A_CREATE|OFT_A_COMPR,
 	IOM_IS_COMPRESSED,
@@ -1295,6 +1318,7 @@ const CommandTab_t ImageTypeTab[] =
     { OFT_CISO,		"CISO",	0,		0 },
     { OFT_WBFS,		"WBFS",	0,		0 },
     { OFT_WIA,		"WIA",	0,		0 },
+    { OFT_RVZ,		"RVZ",	0,		0 },
     { OFT_GCZ,		"GCZ",	"DOLPHIN",	0 },
     { OFT_FST,		"FST",	0,		1 },
     { 0,0,0,0 }
@@ -1319,6 +1343,9 @@ enumOFT CalcOFT ( enumOFT force, ccp fname_dest, ccp fname_src, enumOFT def )
 	    if ( !strcasecmp(fname+len-4,".wia") )
 		return OFT_WIA;
 
+	    if ( !strcasecmp(fname+len-4,".rvz") )
+		return OFT_RVZ;
+
 	    if ( !strcasecmp(fname+len-4,".gcz") )
 		return OFT_GCZ;
 
@@ -1523,6 +1550,11 @@ enumError XSetupSplitFile ( XPARM File_t *f, enumOFT oft, off_t split_size )
     first->cache = 0;
     first->cur_cache = 0;
 
+    // the mapping is moved to 'first'
+    f->map_done = false;
+    f->map_data = 0;
+    f->map_size = 0;
+
     const bool have_stream = f->fp != 0;
     f->fp =  0;
     f->fd = -1;
@@ -2092,9 +2124,11 @@ enumError XTellF ( XPARM File_t * f )
 
     f->file_off = f->fp
 		    ? ftello(f->fp)
-		    : f->fd != -1
-			? lseek(f->fd,(off_t)0,SEEK_CUR)
-			: (off_t)-1;
+		    : f->fd == -1
+			? (off_t)-1
+			: f->fpos_dirty
+			    ? f->file_off
+			    : lseek(f->fd,(off_t)0,SEEK_CUR);
 
     if ( f->file_off == (off_t)-1 )
     {
@@ -2134,6 +2168,7 @@ enumError ExecSeekF ( File_t * f, off_t off )
     {
 	const off_t res = lseek(f->fd,off,SEEK_SET);
 	failed = res != off;
+	f->fpos_dirty = false;
 	noPRINT("ExecSeekF(%llx)/lseek() -> off=%llx, errno=%d, failed=%d\n",
 		(u64)off, (u64)res, errno, failed );
     }
@@ -2153,7 +2188,7 @@ enumError XSeekF ( XPARM File_t * f, off_t off )
     f->cur_off = f->file_off;
 
     // if we are already at off and pure reading or pure writing -> all done
-    if ( off == f->file_off && f->is_writing != f->is_reading )
+    if ( off == f->file_off && f->is_writing != f->is_reading && !f->fpos_dirty )
 	return f->last_error = ERR_OK;
 
     if (f->is_caching)
@@ -2364,6 +2399,293 @@ enumError XPreallocateF
 
 ///////////////////////////////////////////////////////////////////////////////
 
+enumError XSyncF ( XPARM File_t * f )
+{
+    // flush all written data to the device (write barrier)
+
+    DASSERT(f);
+    if (f->split_f)
+    {
+	int i;
+	for ( i = 0; i < f->split_used; i++ )
+	{
+	    const enumError err = XSyncF( XCALL f->split_f[i] );
+	    if (err)
+		return err;
+	}
+	return ERR_OK;
+    }
+
+    if ( f->fp && fflush(f->fp) || f->fd != -1 && fdatasync(f->fd) )
+    {
+	f->last_error = ERR_WRITE_FAILED;
+	if ( f->max_error < f->last_error )
+	    f->max_error = f->last_error;
+	if (!f->disable_errors)
+	    PrintError( XERROR1, f->last_error,
+			"Sync file failed [%c=%d]: %s\n",
+			GetFT(f), GetFD(f), f->fname );
+	return f->last_error;
+    }
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define MAP_ADVISE_SIZE (16*MiB) // size of madvise(WILLNEED) areas
+
+//-----------------------------------------------------------------------------
+
+static bool MapHelper ( File_t * f )
+{
+    // map the whole file, if not already tried
+
+    DASSERT(f);
+    if (!f->map_done)
+    {
+	f->map_done = true;
+	if ( opt_iomode & IOM_MMAP
+	    && f->fd != -1
+	    && !f->fp
+	    && f->is_reading
+	    && !f->is_writing
+	    && !f->split_f
+	    && S_ISREG(f->st.st_mode)
+	    && f->st.st_size > 0
+	    && (off_t)(size_t)f->st.st_size == f->st.st_size )
+	{
+	    void * data = mmap(0,f->st.st_size,PROT_READ,MAP_SHARED,f->fd,0);
+	    if ( data != MAP_FAILED )
+	    {
+		PRINT("MMAP %s: %p, size=%llx\n",f->fname,data,(u64)f->st.st_size);
+		madvise(data,f->st.st_size,MADV_SEQUENTIAL);
+		f->map_data	= data;
+		f->map_size	= f->st.st_size;
+		f->map_advised	= 0;
+	    }
+	}
+    }
+    return f->map_data != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const u8 * GetMappedF ( File_t * f, off_t off, size_t count )
+{
+    DASSERT(f);
+    if ( !MapHelper(f) || off < 0 || off + (off_t)count > f->map_size )
+	return 0;
+
+    const off_t end = off + count;
+    if ( end > f->map_advised || off + MAP_ADVISE_SIZE/2 < f->map_advised - MAP_ADVISE_SIZE )
+    {
+	// tell the kernel, which pages are needed next
+
+	const off_t page_size = sysconf(_SC_PAGESIZE);
+	const off_t start = off & -page_size;
+	off_t adv_end = end + MAP_ADVISE_SIZE;
+	if ( adv_end > f->map_size )
+	    adv_end = f->map_size;
+	madvise(f->map_data+start,adv_end-start,MADV_WILLNEED);
+	f->map_advised = adv_end;
+    }
+
+    f->read_count++;
+    f->bytes_read += count;
+    f->cur_off = f->file_off = end;
+    f->fpos_dirty = true;
+    if ( f->max_off < end )
+	f->max_off = end;
+    return f->map_data + off;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UnmapF ( File_t * f )
+{
+    DASSERT(f);
+    if (f->map_data)
+    {
+	munmap(f->map_data,f->map_size);
+	f->map_data = 0;
+	f->map_size = 0;
+    }
+    f->map_done = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool UseURing ( const File_t * f )
+{
+    // true: 'f' is a plain file, that can be read and written by io_uring
+
+    DASSERT(f);
+    return opt_iomode & IOM_URING
+	&& f->fd != -1
+	&& !f->fp
+	&& f->seek_allowed
+	&& !f->is_caching
+	&& !f->split_f
+	&& !f->read_behind_eof
+	&& !( f->active_open_flags & O_DIRECT )
+	&& IsURingAvailable();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError XExecURingF
+(
+    XPARM				// XPARM
+    File_t		** flist,	// list with 'n' files, 1 for each request
+    URingIO_t		* io,		// list with 'n' requests
+    uint		n		// number of requests
+)
+{
+    // submit all requests with a single system call
+    // and update the status of the files like XReadF() and XWriteF()
+
+    DASSERT( flist || !n );
+    DASSERT( io || !n );
+
+    uint i;
+    for ( i = 0; i < n; i++ )
+	if ( io[i].write && !flist[i]->prealloc_done )
+	    PreallocHelper(flist[i]);
+
+    ExecURing(io,n);
+
+    enumError max_err = ERR_OK;
+    for ( i = 0; i < n; i++ )
+    {
+	File_t * f = flist[i];
+	URingIO_t * r = io + i;
+	if ( r->result != r->size )
+	{
+	    const enumError err = r->write ? ERR_WRITE_FAILED : ERR_READ_FAILED;
+	    errno = r->result < 0 ? -r->result : 0;
+	    if ( !f->disable_errors && f->last_error != err )
+		PrintError( XERROR1, err,
+			"%s failed [%c=%d,%llu+%zu,URING]: %s\n",
+			r->write ? "Write" : "Read",
+			GetFT(f), GetFD(f), (u64)r->off, r->size, f->fname );
+
+	    f->cur_off = f->file_off = (off_t)-1ll;
+	    f->fpos_dirty = true;
+	    if ( f->max_error < err )
+		 f->max_error = err;
+	    f->last_error = err;
+	    if ( max_err < err )
+		max_err = err;
+	    continue;
+	}
+
+	if (r->write)
+	{
+	    f->write_count++;
+	    f->bytes_written += r->size;
+	}
+	else
+	{
+	    f->read_count++;
+	    f->bytes_read += r->size;
+	}
+	f->cur_off = f->file_off = r->off + r->size;
+	f->fpos_dirty = true;
+	if ( f->max_off < f->file_off )
+	    f->max_off = f->file_off;
+    }
+    return max_err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool XSplitURingF
+(
+    XPARM				// XPARM
+    File_t		* f,		// valid split file
+    void		* iobuf,	// data buffer
+    size_t		count,		// number of bytes to read or write
+    bool		write,		// false: read, true: write
+    enumError		* status	// store status here, if true is returned
+)
+{
+    // Read or write all affected split files by one io_uring submission.
+    // Returns false, if this is not possible, then nothing is done.
+
+    DASSERT(f);
+    DASSERT(f->split_f);
+    DASSERT(status);
+
+    if ( !( opt_iomode & IOM_URING ) || !IsURingAvailable() )
+	return false;
+
+    File_t * flist[URING_ENTRIES];
+    URingIO_t io[URING_ENTRIES];
+    uint n = 0;
+
+    File_t ** ptr = f->split_f;
+    off_t off = f->cur_off;
+    size_t remain = count;
+    char * buf = iobuf;
+
+    while ( remain > 0 )
+    {
+	if (!*ptr)
+	{
+	    if (!write)
+		return false; // read behind last split file: use standard path
+
+	    const enumError err = XCreateSplitFile( XCALL f, ptr-f->split_f );
+	    if (err)
+	    {
+		*status = err;
+		return true;
+	    }
+	}
+
+	File_t * cur = *ptr++;
+	DASSERT(cur);
+	if ( off < cur->split_filesize )
+	{
+	    if ( n >= URING_ENTRIES || !UseURing(cur) )
+		return false;
+
+	    const off_t max_count = cur->split_filesize - off;
+	    const size_t size = remain < max_count ? remain : (size_t)max_count;
+
+	    flist[n] = cur;
+	    URingIO_t * r = io + n++;
+	    r->fd	= cur->fd;
+	    r->write	= write;
+	    r->off	= off;
+	    r->buf	= buf;
+	    r->size	= size;
+
+	    buf    += size;
+	    remain -= size;
+	    off     = 0;
+	}
+	else
+	    off -= cur->split_filesize;
+    }
+
+    const enumError err = XExecURingF(XCALL flist,io,n);
+    if (!err)
+    {
+	if (write)
+	    f->bytes_written += count;
+	else
+	    f->bytes_read += count;
+	f->cur_off += count;
+	if ( f->max_off < f->cur_off )
+	    f->max_off = f->cur_off;
+    }
+    *status = err;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError XReadF ( XPARM File_t * f, void * iobuf, size_t count )
 {
     ASSERT(f);
@@ -2441,6 +2763,10 @@ enumError XReadF ( XPARM File_t * f, void * iobuf, size_t count )
 		GetFD(f), GetFP(f), (u64)f->cur_off, (u64)f->cur_off+count, count,
 		f->cur_off < f->max_off ? " <" : "" );
 
+	enumError err;
+	if (XSplitURingF(XCALL f,iobuf,count,false,&err))
+	    return err;
+
 	File_t ** ptr = f->split_f;
 	off_t off = f->cur_off;
 	f->cur_off = 0;
@@ -2548,6 +2874,8 @@ enumError XReadF ( XPARM File_t * f, void * iobuf, size_t count )
 	err = read_count < count && errno;
 	iobuf = (void*)( (char*)iobuf + read_count );
     }
+    else if ( f->fpos_dirty && ExecSeekF(f,f->file_off) )
+	err = true;
     else
     {
 	err = false;
@@ -2699,6 +3027,10 @@ enumError XWriteF ( XPARM File_t * f, const void * iobuf, size_t count )
 		GetFD(f), GetFP(f), (u64)f->cur_off, (u64)f->cur_off+count, count,
 		f->cur_off < f->max_off ? " <" : "" );
 
+	enumError err;
+	if (XSplitURingF(XCALL f,(void*)iobuf,count,true,&err))
+	    return err;
+
 	File_t ** ptr = f->split_f;
 	off_t off = f->cur_off;
 	f->cur_off = 0;
@@ -2707,7 +3039,7 @@ enumError XWriteF ( XPARM File_t * f, const void * iobuf, size_t count )
 	{
 	    if (!*ptr)
 	    {
-		enumError err = XCreateSplitFile( XCALL f, ptr-f->split_f );
+		err = XCreateSplitFile( XCALL f, ptr-f->split_f );
 		if (err)
 		    return err;
 	    }
@@ -2757,6 +3089,8 @@ enumError XWriteF ( XPARM File_t * f, const void * iobuf, size_t count )
     bool err;
     if (f->fp)
 	err = count && fwrite(iobuf,count,1,f->fp) != 1;
+    else if ( f->fpos_dirty && ExecSeekF(f,f->file_off) )
+	err = true;
     else if ( f->fd != -1 )
     {
      #if SUPPORT_DIRECT
@@ -2822,12 +3156,149 @@ enumError XReadAtF ( XPARM File_t * f, off_t off, void * iobuf, size_t count )
     noTRACE("#F# ReadAtF(fd=%d,o:%llx,%p,n:%zx)\n",f->fd,(u64)off,iobuf,count);
     f->cache_info_off  = off;
     f->cache_info_size = count;
+
+    if ( count && !f->is_caching )
+    {
+	const u8 * data = GetMappedF(f,off,count);
+	if (data)
+	{
+	    memcpy(iobuf,data,count);
+	    return ERR_OK;
+	}
+    }
+
+    if ( count && UseURing(f) )
+    {
+	URingIO_t io = { f->fd, false, off, iobuf, count };
+	return XExecURingF(XCALL &f,&io,1);
+    }
+
     const enumError stat = XSeekF(XCALL f,off);
     return stat ? stat : XReadF(XCALL f,iobuf,count);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+enumError XReadVecAtF
+(
+    XPARM				// XPARM
+    File_t		* f,		// valid file
+    off_t		off,		// file offset of the first buffer
+    const struct iovec	* iov,		// list with 'iovcnt' buffers
+    int			iovcnt		// number of buffers, <= READ_VEC_MAX
+)
+{
+    // Read contiguous file data into a list of buffers. Plain files are read
+    // by a single preadv() or io_uring submission, all others by XReadAtF().
+
+    ASSERT(f);
+    DASSERT( iov || !iovcnt );
+    DASSERT( iovcnt <= READ_VEC_MAX );
+
+    size_t count = 0;
+    int i;
+    for ( i = 0; i < iovcnt; i++ )
+	count += iov[i].iov_len;
+    noTRACE("#F# ReadVecAtF(fd=%d,o:%llx,n:%d,%zx)\n",f->fd,(u64)off,iovcnt,count);
+
+    // cached areas are only used for the headers => check for an overlap
+    const bool cached = f->is_caching && XCacheHelper(XCALL f,off,count);
+    if (f->last_error)
+	return f->last_error;
+
+    const bool plain = iovcnt > 1
+	&& f->fd != -1
+	&& !f->fp
+	&& f->seek_allowed
+	&& !cached
+	&& !f->split_f
+	&& !f->read_behind_eof
+	&& !f->map_data
+	&& !( f->active_open_flags & O_DIRECT );
+
+    if ( plain && UseURing(f) )
+    {
+	File_t * flist[READ_VEC_MAX];
+	URingIO_t io[READ_VEC_MAX];
+	for ( i = 0; i < iovcnt; i++ )
+	{
+	    flist[i] = f;
+	    io[i] = (URingIO_t){ f->fd, false, off, iov[i].iov_base, iov[i].iov_len };
+	    off += iov[i].iov_len;
+	}
+	f->cache_info_off  = io->off;
+	f->cache_info_size = count;
+	return XExecURingF(XCALL flist,io,iovcnt);
+    }
+
+ #if HAVE_PREADV
+    if (plain)
+    {
+	f->cache_info_off  = off;
+	f->cache_info_size = count;
+
+	struct iovec vec[READ_VEC_MAX];
+	memcpy(vec,iov,iovcnt*sizeof(*vec));
+	struct iovec * v = vec;
+	size_t done = 0;
+
+	while ( done < count )
+	{
+	    const ssize_t rstat = preadv(f->fd,v,iovcnt,off+done);
+	    if ( rstat <= 0 )
+	    {
+		if ( rstat < 0 && errno == EINTR )
+		    continue;
+		if ( !f->disable_errors && f->last_error != ERR_READ_FAILED )
+		    PrintError( XERROR1, ERR_READ_FAILED,
+			"Read failed [%c=%d,%llu+%zu,VEC]: %s\n",
+			GetFT(f), GetFD(f), (u64)off, count, f->fname );
+
+		f->cur_off = f->file_off = (off_t)-1ll;
+		f->fpos_dirty = true;
+		if ( f->max_error < ERR_READ_FAILED )
+		     f->max_error = ERR_READ_FAILED;
+		return f->last_error = ERR_READ_FAILED;
+	    }
+
+	    // skip completed buffers after a short read
+	    done += rstat;
+	    size_t skip = rstat;
+	    while ( iovcnt > 0 && skip >= v->iov_len )
+	    {
+		skip -= v->iov_len;
+		v++;
+		iovcnt--;
+	    }
+	    if (skip)
+	    {
+		v->iov_base = (char*)v->iov_base + skip;
+		v->iov_len -= skip;
+	    }
+	}
+
+	f->read_count++;
+	f->bytes_read += count;
+	f->cur_off = f->file_off = off + count;
+	f->fpos_dirty = true;
+	if ( f->max_off < f->file_off )
+	    f->max_off = f->file_off;
+	return ERR_OK;
+    }
+ #endif
+
+    for ( i = 0; i < iovcnt; i++ )
+    {
+	const enumError err = XReadAtF(XCALL f,off,iov[i].iov_base,iov[i].iov_len);
+	if (err)
+	    return err;
+	off += iov[i].iov_len;
+    }
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError XWriteAtF ( XPARM File_t * f, off_t off, const void * iobuf, size_t count )
 {
     ASSERT(f);
@@ -2838,6 +3309,12 @@ enumError XWriteAtF ( XPARM File_t * f, off_t off, const void * iobuf, size_t co
 	return XWriteDirectAtF(XCALL f,off,iobuf,count,directbuf,sizeof(directbuf));
  #endif
 
+    if ( count && UseURing(f) )
+    {
+	URingIO_t io = { f->fd, true, off, (void*)iobuf, count };
+	return XExecURingF(XCALL &f,&io,1);
+    }
+
     const enumError stat = XSeekF(XCALL f,off);
     return stat ? stat : XWriteF(XCALL f,iobuf,count);
 }
@@ -3138,6 +3615,65 @@ enumError CreatePath ( ccp fname )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool GetCachePath
+(
+    // Store the path of a cache file into 'buf' and return true on success.
+    // The directory is defined by the environment variable 'env_name'
+    // or by 'XDG_CACHE_HOME/wit' or by 'HOME/.cache/wit'.
+    // An empty variable 'env_name' disables the cache.
+
+    char		* buf,		// result buffer
+    uint		buf_size,	// size of 'buf'
+    ccp			env_name,	// name of the environment variable
+    ccp			fname		// filename of the cache file
+)
+{
+    DASSERT(buf);
+    DASSERT(env_name);
+    DASSERT(fname);
+
+    ccp dir = getenv(env_name), sub = "";
+    if (dir)
+    {
+	if (!*dir)
+	    return false;
+    }
+    else
+    {
+	dir = getenv("XDG_CACHE_HOME");
+	if ( dir && *dir )
+	    sub = "/wit";
+	else
+	{
+	    dir = getenv("HOME");
+	    if ( !dir || !*dir )
+		return false;
+	    sub = "/.cache/wit";
+	}
+    }
+
+    snprintf(buf,buf_size,"%s%s/%s",dir,sub,fname);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CreateCacheDir ( ccp path )
+{
+    // create the directories of a cache file silently
+
+    char temp[PATH_MAX], *ptr;
+    StringCopyS(temp,sizeof(temp),path);
+    for ( ptr = strchr(temp+1,'/'); ptr; ptr = strchr(ptr+1,'/') )
+    {
+	*ptr = 0;
+	mkdir(temp,0777);
+	*ptr = '/';
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 s64 GetFileSize
 (
     ccp			path1,		// NULL or part 1 of path
@@ -52,6 +52,7 @@
 
 bool opt_gcz_zip	= false;
 u32  opt_gcz_block_size	= GCZ_DEF_BLOCK_SIZE;
+u32  opt_gcz_cache	= 0;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -79,6 +80,32 @@ int ScanOptGCZBlock ( ccp arg )
     return stat;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+int ScanOptGCZCache ( ccp arg )
+{
+    if (!arg)
+	return 0;
+
+    u32 num;
+    enumError stat = ScanSizeOptU32(
+		&num,			// u32 * num
+		arg,			// ccp source
+		1,			// default_factor1
+		0,			// int force_base
+		"gcz-cache",		// ccp opt_name
+		0,			// u64 min
+		GCZ_MAX_CACHE,		// u64 max
+		0,			// u32 multiple
+		0,			// u32 pow2
+		true			// bool print_err
+		) != ERR_OK;
+
+    if (!stat)
+	opt_gcz_cache = num;
+    return stat;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			    Helpers			///////////////
@@ -265,6 +292,20 @@ void ResetGCZ( GCZ_t *gcz )
 {
     if (gcz)
     {
+	if (gcz->tpool)
+	{
+	    ResetThreadPool(gcz->tpool);
+	    FREE(gcz->tpool);
+	}
+
+	if (gcz->cache)
+	{
+	    uint i;
+	    for ( i = 0; i < gcz->cache_size; i++ )
+		FREE(gcz->cache[i].data);
+	    FREE(gcz->cache);
+	}
+
 	FREE(gcz->offset);
 	FREE(gcz->data);
 	FREE(gcz->zero_data);
@@ -272,6 +313,28 @@ void ResetGCZ( GCZ_t *gcz )
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+void PrintCacheStatGCZ
+(
+    FILE		*f,		// destination file
+    int			indent,		// indention
+    const GCZ_t		*gcz		// NULL or valid GCZ
+)
+{
+    DASSERT(f);
+    if ( !gcz || !gcz->cache )
+	return;
+
+    const u64 total = gcz->cache_hits + gcz->cache_misses;
+    fprintf(f,"%*sGCZ cache: %u blocks of %s, %llu hits (%4.1f%%),"
+		" %llu misses, %llu decompressed ahead\n",
+		indent, "",
+		gcz->cache_size, wd_print_size_1024(0,0,gcz->head.block_size,false),
+		gcz->cache_hits, total ? 100.0 * gcz->cache_hits / total : 0.0,
+		gcz->cache_misses, gcz->ahead_count );
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		    GCZ: File_t level reading		///////////////
@@ -306,9 +369,37 @@ enumError LoadHeadGCZ
     if (stat)
 	return stat;
 
-    gcz->block = M1(gcz->block);
-    gcz->data  = MALLOC(2*gcz->head.block_size);
-    gcz->cdata = gcz->data + gcz->head.block_size;
+    //--- setup cache
+
+    const uint block_size = gcz->head.block_size;
+    uint n = opt_gcz_cache ? opt_gcz_cache : GCZ_DEF_CACHE;
+    const uint max = GCZ_MAX_CACHE_MEM / ( 2 * block_size );
+    if ( n > max )
+	n = max;
+    if ( n < 2 )
+	n = 2;
+
+    gcz->cache_size = n;
+    gcz->cache = CALLOC(n,sizeof(*gcz->cache));
+    uint i;
+    for ( i = 0; i < n; i++ )
+    {
+	GCZ_Cache_t * c = gcz->cache + i;
+	c->gcz   = gcz;
+	c->block = M1(c->block);
+	c->data  = MALLOC(2*block_size);
+	c->cdata = c->data + block_size;
+    }
+    gcz->block = gcz->last_block = M1(gcz->block);
+
+    // decompress blocks ahead only, if multi threading is enabled
+    const uint n_threads = GetThreadCount();
+    if ( n_threads > 1 )
+    {
+	gcz->read_ahead = 2 * n_threads;
+	if ( gcz->read_ahead > n/2 )
+	     gcz->read_ahead = n/2;
+    }
 
     return ERR_OK;
  #endif
@@ -316,6 +407,289 @@ enumError LoadHeadGCZ
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifdef HAVE_ZLIB
+
+ static enumError read_block
+ (
+    GCZ_t		*gcz,		// valid GCZ
+    File_t		*f,		// source file
+    u32			block,		// block to read, < num_blocks
+    u8			*data,		// buffer for uncompressed data
+    u8			*cdata,		// buffer for compressed data
+    bool		*raw,		// store true, if data is stored uncompressed
+    u32			*size		// store the size of the stored data
+ )
+ {
+    // read the stored data of 'block' into 'data' (raw) or 'cdata'
+
+    DASSERT(gcz);
+    DASSERT(f);
+    DASSERT( block < gcz->head.num_blocks );
+
+    s64 read_off  = le64(gcz->offset+block);
+    u32 read_size = ( block == gcz->head.num_blocks - 1
+			? gcz->head.compr_size
+			: le64(gcz->offset+block+1) ) - read_off;
+
+    if ( read_size > gcz->head.block_size )
+    {
+	if (!f->disable_errors)
+	    ERROR0(ERR_GCZ_INVALID,
+		    "Invalid block size for block #%u/%u (size 0x%x): %s\n",
+		    block, gcz->head.num_blocks, read_size, f->fname );
+	return ERR_GCZ_INVALID;
+    }
+
+    *raw  = read_off < 0;
+    *size = read_size;
+    read_off = ( read_off & 0x7fffffffffffffffllu ) + gcz->data_offset;
+    noPRINT("GCZ/%s: b=%x, read=%llx + %x\n",
+		*raw ? "RAW" : "UNZIP", block, read_off, read_size );
+    return ReadAtF( f, read_off, *raw ? data : cdata, read_size );
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static enumError unpack_block
+ (
+    GCZ_t		*gcz,		// valid GCZ
+    File_t		*f,		// NULL (silent & thread safe) or file for messages
+    u32			block,		// related block
+    u8			*data,		// buffer for uncompressed data
+    const u8		*cdata,		// compressed data
+    bool		raw,		// true: data is already stored in 'data'
+    u32			size		// size of stored data
+ )
+ {
+    // verify the checksum and decompress 'cdata' into 'data'
+
+    DASSERT(gcz);
+    DASSERT(data);
+    DASSERT(cdata);
+
+    const u32 adler32 = le32(gcz->checksum+block);
+    if (f)
+    {
+	const enumError err
+		= CheckAdler32( f, block, adler32, raw ? data : cdata, size );
+	if (err)
+	    return err;
+    }
+    else if ( CalcAdler32( raw ? data : cdata, size ) != adler32 )
+	return ERR_GCZ_INVALID;
+
+    if (!raw)
+    {
+	z_stream zs;
+	memset(&zs,0,sizeof(zs));
+	zs.next_in   = (u8*)cdata;
+	zs.avail_in  = size;
+	zs.next_out  = data;
+	zs.avail_out = gcz->head.block_size;
+	noPRINT("Z: in=%p+%x, out=%p+%x\n",
+		zs.next_in, zs.avail_in, zs.next_out, zs.avail_out );
+	int stat = inflateInit(&zs);
+	if ( stat < 0 )
+	{
+	 inflate_err:
+	    if ( f && !f->disable_errors )
+		ERROR0(ERR_GCZ_INVALID,
+			"Error while uncompressing block #%u (zlib-err=%d): %s\n",
+			block, stat, f->fname );
+	    return ERR_GCZ_INVALID;
+	}
+	stat = inflate(&zs,Z_FULL_FLUSH);
+	if ( stat != Z_STREAM_END )
+	{
+	    inflateEnd(&zs);
+	    goto inflate_err;
+	}
+
+	size = gcz->head.block_size - zs.avail_out;
+	stat = inflateEnd(&zs);
+	if ( stat < 0 )
+	    goto inflate_err;
+	noPRINT("block %u, read=%x, cksum %08x %08x\n",
+		block, size, (u32)zs.adler, adler32 );
+    }
+
+    if ( size < gcz->head.block_size )
+	memset( data + size, 0, gcz->head.block_size - size );
+    return ERR_OK;
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static void unpack_job ( ThreadJob_t * job )
+ {
+    GCZ_Cache_t *c = (GCZ_Cache_t*)job;
+    DASSERT(c);
+    DASSERT(c->gcz);
+    c->err = unpack_block(c->gcz,0,c->block,c->data,c->cdata,c->raw,c->csize);
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static void finish_cache_job ( GCZ_t *gcz, GCZ_Cache_t *c )
+ {
+    DASSERT(gcz);
+    DASSERT(c);
+
+    if (c->pending)
+    {
+	WaitThreadJob(gcz->tpool,&c->tjob);
+	c->pending = false;
+	if (c->err)
+	    c->block = M1(c->block); // load it again to get error messages
+    }
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static GCZ_Cache_t * find_cache ( GCZ_t *gcz, u32 block )
+ {
+    DASSERT(gcz);
+
+    GCZ_Cache_t *c, *end = gcz->cache + gcz->cache_size;
+    for ( c = gcz->cache; c < end; c++ )
+	if ( c->block == block )
+	    return c;
+    return 0;
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static GCZ_Cache_t * get_free_cache ( GCZ_t *gcz, u32 keep_block )
+ {
+    // return an unused or the least recently used entry, that is neither
+    // pending nor holding 'keep_block'; return NULL if none is available
+
+    DASSERT(gcz);
+
+    GCZ_Cache_t *c, *found = 0, *end = gcz->cache + gcz->cache_size;
+    for ( c = gcz->cache; c < end; c++ )
+    {
+	if (c->pending)
+	    continue;
+	if (IS_M1(c->block))
+	    return c;
+	if ( c->block == keep_block )
+	    continue;
+	if ( !found || (s32)( c->lru - found->lru ) < 0 )
+	    found = c;
+    }
+    return found;
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static void start_read_ahead ( GCZ_t *gcz, File_t *f, u32 block )
+ {
+    // read the blocks behind 'block' and decompress them by worker threads
+
+    DASSERT(gcz);
+    DASSERT(f);
+
+    if (!gcz->tpool)
+    {
+	gcz->tpool = MALLOC(sizeof(*gcz->tpool));
+	InitializeThreadPool(gcz->tpool,0);
+    }
+
+    u32 end = block + 1 + gcz->read_ahead;
+    if ( end > gcz->head.num_blocks )
+	end = gcz->head.num_blocks;
+
+    const bool disable_errors = f->disable_errors;
+    f->disable_errors = true;
+
+    while ( ++block < end )
+    {
+	if (find_cache(gcz,block))
+	    continue;
+
+	GCZ_Cache_t *c = get_free_cache(gcz,gcz->last_block);
+	if (!c)
+	    break;
+
+	// on errors stop here; the synchronous read reports them later
+	c->block = M1(c->block);
+	if (read_block(gcz,f,block,c->data,c->cdata,&c->raw,&c->csize))
+	    break;
+
+	c->block   = block;
+	c->lru     = ++gcz->lru_counter;
+	c->pending = true;
+	gcz->ahead_count++;
+	AddThreadJob(gcz->tpool,&c->tjob,unpack_job,c);
+    }
+
+    f->disable_errors = disable_errors;
+ }
+
+///////////////////////////////////////////////////////////////////////////////
+
+ static enumError get_block
+ (
+    GCZ_t		*gcz,		// valid GCZ
+    File_t		*f,		// source file
+    u32			block,		// wanted block, < num_blocks
+    const u8		**data		// store pointer to decompressed data here
+ )
+ {
+    DASSERT(gcz);
+    DASSERT(f);
+    DASSERT(data);
+
+    GCZ_Cache_t *c = find_cache(gcz,block);
+    if (c)
+    {
+	finish_cache_job(gcz,c);
+	if (IS_M1(c->block))
+	    c = 0;
+    }
+
+    if (c)
+	gcz->cache_hits++;
+    else
+    {
+	gcz->cache_misses++;
+	c = get_free_cache(gcz,M1(block));
+	if (!c)
+	{
+	    // all entries are pending => wait for them
+	    GCZ_Cache_t *ptr, *end = gcz->cache + gcz->cache_size;
+	    for ( ptr = gcz->cache; ptr < end; ptr++ )
+		finish_cache_job(gcz,ptr);
+	    c = get_free_cache(gcz,M1(block));
+	    DASSERT(c);
+	}
+
+	c->block = M1(c->block);
+	enumError err = read_block(gcz,f,block,c->data,c->cdata,&c->raw,&c->csize);
+	if (!err)
+	    err = unpack_block(gcz,f,block,c->data,c->cdata,c->raw,c->csize);
+	if (err)
+	    return err;
+	c->block = block;
+    }
+
+    c->lru = ++gcz->lru_counter;
+    *data = c->data;
+
+    // sequential access => decompress the next blocks in parallel
+    const bool sequential = block == gcz->last_block + 1;
+    gcz->last_block = block;
+    if ( sequential && gcz->read_ahead )
+	start_read_ahead(gcz,f,block);
+
+    return ERR_OK;
+ }
+
+#endif // HAVE_ZLIB
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError LoadDataGCZ
 (
     GCZ_t		*gcz,		// pointer to data, will be initalized
@@ -333,7 +707,7 @@ enumError LoadDataGCZ
     return ZLIB_MISSING(f);
  #else
 
-    if ( !f || !gcz )
+    if ( !f || !gcz || !gcz->cache )
 	return ERROR0(ERR_INTERNAL,0);
 
     u8 *dest = buf;
@@ -345,97 +719,22 @@ enumError LoadDataGCZ
 	if ( copy_size > count )
 	    copy_size = count;
 
-	noPRINT("off=%llx -> %d,%d\n",(u64)off,block,gcz->block);
+	noPRINT("off=%llx -> %d,%d\n",(u64)off,block,gcz->last_block);
 	if ( block >= gcz->head.num_blocks )
 	{
 	    noPRINT("GCZ/ZERO: b=%x, copy=%x +%x\n",block,copy_delta,copy_size);
 	    memset(dest,0,copy_size);
 	}
-	else if ( block != gcz->block )
+	else
 	{
-	    gcz->block = M1(gcz->block);
-	    s64 read_off  = le64(gcz->offset+block);
-	    u32 read_size = ( block == gcz->head.num_blocks - 1
-				? gcz->head.compr_size
-				: le64(gcz->offset+block+1) ) - read_off;
-
-	    if ( read_size > gcz->head.block_size )
-	    {
-		if (!f->disable_errors)
-		    ERROR0(ERR_GCZ_INVALID,
-			    "Invalid block size for block #%u/%u (size 0x%x): %s\n",
-			    block, gcz->head.num_blocks, read_size, f->fname );
-		return ERR_GCZ_INVALID;
-	    }
+	    const u8 *data;
+	    const enumError err = get_block(gcz,f,block,&data);
+	    if (err)
+		return err;
 
-	    if ( read_off < 0 )
-	    {
-		//--- uncompressed
-
-		read_off &= 0x7fffffffffffffffllu;
-		read_off += gcz->data_offset;
-		noPRINT("GCZ/RAW: b=%x, read=%llx + %x, copy=%x +%x\n",
-			block, read_off, read_size, copy_delta, copy_size );
-		enumError err = ReadAtF(f,read_off,gcz->data,read_size);
-		if (!err)
-		    err = CheckAdler32( f, block, le32(gcz->checksum+block),
-					gcz->data, read_size );
-		if (err)
-		    return err;
-	    }
-	    else
-	    {
-		//--- compressed
-
-		read_off += gcz->data_offset;
-		noPRINT("GCZ/UNZIP: b=%x, read=%llx + %x, copy=%x +%x\n",
-			block, read_off, read_size, copy_delta, copy_size );
-		enumError err = ReadAtF(f,read_off,gcz->cdata,read_size);
-		if (!err)
-		    err = CheckAdler32( f, block, le32(gcz->checksum+block),
-					gcz->cdata, read_size );
-		if (err)
-		    return err;
-
-		z_stream zs;
-		memset(&zs,0,sizeof(zs));
-		zs.next_in   = gcz->cdata;
-		zs.avail_in  = read_size;
-		zs.next_out  = gcz->data;
-		zs.avail_out = gcz->head.block_size;
-		noPRINT("Z: in=%p+%x, out=%p+%x\n",
-			zs.next_in, zs.avail_in, zs.next_out, zs.avail_out );
-		int stat = inflateInit(&zs);
-		if ( stat < 0 )
-		{
-		 inflate_err:
-		    if (!f->disable_errors)
-			ERROR0(ERR_GCZ_INVALID,
-				"Error while uncompressing block #%u (zlib-err=%d): %s\n",
-				block, stat, f->fname );
-		    return ERR_GCZ_INVALID;
-		}
-		stat = inflate(&zs,Z_FULL_FLUSH);
-		if ( stat != Z_STREAM_END )
-		{
-		    inflateEnd(&zs);
-		    goto inflate_err;
-		}
-
-		read_size = gcz->head.block_size - zs.avail_out;
-		stat = inflateEnd(&zs);
-		if ( stat < 0 )
-		    goto inflate_err;
-		PRINT("block %u, read=%x, cksum %08x %08x\n",
-			block, read_size, (u32)zs.adler, le32(gcz->checksum+block) );
-	    }
-	    if ( read_size < gcz->head.block_size )
-		memset( gcz->data + read_size, 0, gcz->head.block_size - read_size );
-	    gcz->block = block;
+	    noPRINT("GCZ/COPY: b=%x, copy=%x +%x/%zx\n",block,copy_delta,copy_size,count);
+	    memcpy(dest,data+copy_delta,copy_size);
 	}
-
-	noPRINT("GCZ/COPY: b=%x, copy=%x +%x/%zx\n",block,copy_delta,copy_size,count);
-	memcpy(dest,gcz->data+copy_delta,copy_size);
 	dest  += copy_size;
 	off   += copy_size;
 	count -= copy_size;
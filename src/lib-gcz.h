@@ -39,6 +39,7 @@
 
 #include "types.h"
 #include "lib-std.h"
+#include "lib-thread.h"
 
 //
 ///////////////////////////////////////////////////////////////////////////////
@@ -65,6 +66,9 @@
 #define GCZ_MAGIC_NUM		0xb10bc001
 #define GCZ_TYPE		1
 #define GCZ_DEF_BLOCK_SIZE	0x4000
+#define GCZ_DEF_CACHE		32		// default number of cached blocks
+#define GCZ_MAX_CACHE		4096		// max number of cached blocks
+#define GCZ_MAX_CACHE_MEM	(64*MiB)	// max memory used by the cache
 
 //
 ///////////////////////////////////////////////////////////////////////////////
@@ -89,6 +93,27 @@ __attribute__ ((packed)) GCZ_Head_t;
 ///////////////////////////////////////////////////////////////////////////////
 
 struct wd_disc_t;
+struct GCZ_t;
+
+typedef struct GCZ_Cache_t
+{
+    ThreadJob_t		tjob;		// read ahead job, must be the first member
+    struct GCZ_t	*gcz;		// related GCZ
+
+    u32			block;		// cached block, ~0: unused
+    u32			lru;		// value of 'lru_counter' at last usage
+    bool		pending;	// true: read ahead job not finished yet
+
+    bool		raw;		// read ahead: data stored uncompressed
+    u32			csize;		// read ahead: size of stored data
+    enumError		err;		// read ahead: status of job
+
+    u8			*data;		// decompressed block, alloced
+    u8			*cdata;		// compressed block, part of 'data' alloc
+}
+GCZ_Cache_t;
+
+//-----------------------------------------------------------------------------
 
 typedef struct GCZ_t // little endian
 {
@@ -102,12 +127,25 @@ typedef struct GCZ_t // little endian
     struct wd_disc_t	*disc;		// NULL or pointer to source disc
     bool		fast;		// enable fast mode, only true if 'disc' avaialable
 
-    //--- current block and data
+    //--- current block and data (writing)
 
     u32			block;		// block of 'data', ~0: invalid
     u8			*data;		// last decompressed block, alloced
     u8			*cdata;		// space for compressed data, *NOT* alloced
 
+    //--- LRU cache of decompressed blocks (reading)
+
+    GCZ_Cache_t		*cache;		// list with 'cache_size' entries, alloced
+    uint		cache_size;	// number of cache entries
+    u32			lru_counter;	// incremented on each block access
+    u32			last_block;	// last accessed block, ~0: none
+    uint		read_ahead;	// max number of blocks to decompress ahead
+    ThreadPool_t	*tpool;		// NULL or pool for read ahead, alloced
+
+    u64			cache_hits;	// number of blocks found in the cache
+    u64			cache_misses;	// number of blocks decompressed on demand
+    u64			ahead_count;	// number of blocks decompressed ahead
+
     //--- data of a zero block
 
     u8			*zero_data;	// NULL or alloced
@@ -123,7 +161,9 @@ GCZ_t;
 
 extern bool opt_gcz_zip;
 extern u32  opt_gcz_block_size;
+extern u32  opt_gcz_cache;
 int ScanOptGCZBlock ( ccp arg );
+int ScanOptGCZCache ( ccp arg );
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -139,6 +179,13 @@ bool IsValidGCZ
 
 void ResetGCZ ( GCZ_t *gcz );
 
+void PrintCacheStatGCZ
+(
+    FILE		*f,		// destination file
+    int			indent,		// indention
+    const GCZ_t		*gcz		// NULL or valid GCZ
+);
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			SuperFile_t interface		///////////////
@@ -0,0 +1,304 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#define _GNU_SOURCE 1
+
+#include "lib-std.h"
+#include "lib-lfg.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////		    lagged fibonacci generator		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// The generator outputs the upper byte of each word and the bits 18..23
+// instead of 16..23. This is done once for the whole buffer after the
+// initialization. The XOR steps of ForwardLFG() are independent of this
+// transformation and of the byte order.
+
+static void forward_lfg ( LFG_t * lfg )
+{
+    DASSERT(lfg);
+
+    u32 *buf = lfg->buf;
+    uint i;
+    for ( i = 0; i < LFG_J; i++ )
+	buf[i] ^= buf[i+LFG_K-LFG_J];
+    for ( ; i < LFG_K; i++ )
+	buf[i] ^= buf[i-LFG_J];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void backward_lfg ( LFG_t * lfg, uint end )
+{
+    // revert forward_lfg() for the words 0 .. end-1
+
+    DASSERT(lfg);
+    DASSERT( end <= LFG_K );
+
+    u32 *buf = lfg->buf;
+    uint i;
+    for ( i = end; i > LFG_J; i-- )
+	buf[i-1] ^= buf[i-1-LFG_J];
+    for ( i = end < LFG_J ? end : LFG_J; i > 0; i-- )
+	buf[i-1] ^= buf[i-1+LFG_K-LFG_J];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SetSeedLFG
+(
+    LFG_t		* lfg,		// valid generator
+    const void		* seed		// LFG_SEED_SIZE big endian u32 values
+)
+{
+    DASSERT(lfg);
+    DASSERT(seed);
+
+    u32 *buf = lfg->buf;
+    const u8 *src = seed;
+    uint i;
+    for ( i = 0; i < LFG_SEED_SIZE; i++, src += 4 )
+	buf[i] = be32(src);
+
+    for ( ; i < LFG_K; i++ )
+	buf[i] = buf[i-17] << 23 ^ buf[i-16] >> 9 ^ buf[i-1];
+
+    for ( i = 0; i < LFG_K; i++ )
+	buf[i] = htonl( buf[i] & 0xff00ffff | buf[i] >> 2 & 0x00ff0000 );
+
+    for ( i = 0; i < 4; i++ )
+	forward_lfg(lfg);
+    lfg->pos = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ForwardLFG
+(
+    LFG_t		* lfg,		// valid generator
+    uint		n_bytes		// number of bytes to skip
+)
+{
+    DASSERT(lfg);
+
+    lfg->pos += n_bytes;
+    while ( lfg->pos >= LFG_BUF_SIZE )
+    {
+	forward_lfg(lfg);
+	lfg->pos -= LFG_BUF_SIZE;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void GetBytesLFG
+(
+    LFG_t		* lfg,		// valid generator
+    void		* dest,		// destination buffer
+    uint		size		// number of bytes to generate
+)
+{
+    DASSERT(lfg);
+    DASSERT( dest || !size );
+
+    u8 *d = dest;
+    while ( size > 0 )
+    {
+	uint len = LFG_BUF_SIZE - lfg->pos;
+	if ( len > size )
+	    len = size;
+	memcpy( d, (u8*)lfg->buf + lfg->pos, len );
+	d += len;
+	size -= len;
+	lfg->pos += len;
+	if ( lfg->pos == LFG_BUF_SIZE )
+	{
+	    forward_lfg(lfg);
+	    lfg->pos = 0;
+	}
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint CountMatchesLFG
+(
+    LFG_t		* lfg,		// valid generator
+    const void		* data,		// data to compare
+    uint		size		// size of 'data'
+)
+{
+    DASSERT(lfg);
+    DASSERT( data || !size );
+
+    const u8 *d = data;
+    uint count = 0;
+    while ( count < size )
+    {
+	uint len = LFG_BUF_SIZE - lfg->pos;
+	if ( len > size - count )
+	    len = size - count;
+
+	const u8 *src = (u8*)lfg->buf + lfg->pos;
+	if (memcmp(d,src,len))
+	{
+	    uint i = 0;
+	    while ( d[i] == src[i] )
+		i++;
+	    lfg->pos += i;
+	    return count + i;
+	}
+
+	d += len;
+	count += len;
+	lfg->pos += len;
+	if ( lfg->pos == LFG_BUF_SIZE )
+	{
+	    forward_lfg(lfg);
+	    lfg->pos = 0;
+	}
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint CheckJunkLFG
+(
+    const void		* data,		// data to analyze
+    uint		size		// size of 'data'
+)
+{
+    // The output bits 22..23 are copies of the bits 24..25. A null word is
+    // possible, but rejected to avoid expensive checks of null data.
+
+    DASSERT( data || !size );
+
+    const u8 *src = data, *end = src + ( size & ~3 );
+    for ( ; src < end; src += 4 )
+    {
+	const u32 x = be32(src);
+	if ( !x || ( x & 0x00c00000 ) != ( x >> 2 & 0x00c00000 ) )
+	    break;
+    }
+    return src - (u8*)data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint DetectJunkLFG
+(
+    void		* seed,		// store LFG_SEED_SIZE big endian u32 values
+    const void		* data,		// data to analyze
+    uint		size,		// size of 'data'
+    uint		data_offset	// offset of 'data' behind the seed point,
+					// must be a multiple of 4
+)
+{
+    // This is the reverse of SetSeedLFG(): Rewind the generator to its
+    // initial state, restore the seed and verify it by the recurrence.
+
+    DASSERT(seed);
+    DASSERT(data);
+
+    if ( size < LFG_BUF_SIZE || data_offset & 3 )
+	return 0;
+
+    if ( CheckJunkLFG(data,LFG_BUF_SIZE) < LFG_BUF_SIZE )
+	return 0;
+
+    //--- load the state and rewind it to the initialization
+
+    const u8 *src = data;
+    uint i;
+    LFG_t lfg;
+    u32 *buf = lfg.buf;
+    const uint word_off = data_offset / 4;
+    const uint mod_k = word_off % LFG_K;
+    const uint div_k = word_off / LFG_K;
+
+    // the first 'mod_k' words belong already to the next forward step
+    memcpy( buf + mod_k, src, ( LFG_K - mod_k ) * 4 );
+    memcpy( buf, src + ( LFG_K - mod_k ) * 4, mod_k * 4 );
+    backward_lfg(&lfg,mod_k);
+    for ( i = 0; i < div_k + 4; i++ )
+	backward_lfg(&lfg,LFG_K);
+
+    //--- restore the seed
+    // The bits 16..17 are lost by the output transformation. They are
+    // recalculated by the recurrence, except for word 0, where they are
+    // not relevant for the output.
+
+    for ( i = 0; i < LFG_K; i++ )
+	buf[i] = ntohl(buf[i]);
+
+    for ( i = 0; i < LFG_SEED_SIZE; i++ )
+	buf[i] = buf[i] & 0xff00ffff
+	       | buf[i] << 2 & 0x00fc0000
+	       | ( buf[i+16] ^ buf[i+15] ) << 9 & 0x00030000;
+
+    //--- verify the remaining words by the recurrence
+
+    for ( ; i < LFG_K; i++ )
+    {
+	const u32 calc = buf[i-17] << 23 ^ buf[i-16] >> 9 ^ buf[i-1];
+	const u32 have = buf[i] & 0xff00ffff | buf[i] << 2 & 0x00fc0000;
+	if ( ( calc & 0xfffcffff ) != have )
+	    return 0;
+	buf[i] = calc;
+    }
+
+    u8 *dest = seed;
+    for ( i = 0; i < LFG_SEED_SIZE; i++, dest += 4 )
+    {
+	const u32 val = htonl(buf[i]);
+	memcpy(dest,&val,sizeof(val));
+    }
+
+    //--- regenerate and count the matching bytes
+
+    SetSeedLFG(&lfg,seed);
+    ForwardLFG(&lfg,data_offset);
+    const uint count = CountMatchesLFG(&lfg,data,size);
+    return count >= LFG_BUF_SIZE ? count : 0;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
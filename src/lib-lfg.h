@@ -0,0 +1,137 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef WIT_LIB_LFG_H
+#define WIT_LIB_LFG_H 1
+
+#include "types.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////		    lagged fibonacci generator		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// The padding of GameCube and Wii discs ("junk data") is created by a lagged
+// fibonacci generator with the parameters K=521 and J=32. RVZ images store
+// only the seed of junk data. The generator is compatible with Dolphin.
+// The generator is reseeded for each block of WII_SECTOR_SIZE bytes.
+// DetectJunkLFG() recovers the seed from at least LFG_BUF_SIZE bytes of
+// generator output.
+
+#define LFG_K		521		// long lag of the generator
+#define LFG_J		 32		// short lag of the generator
+#define LFG_SEED_SIZE	 17		// number of u32 seed words
+#define LFG_BUF_SIZE	(LFG_K*4)	// size of the generator buffer in bytes
+
+//-----------------------------------------------------------------------------
+
+typedef struct LFG_t
+{
+    u32			buf[LFG_K];	// state, stored in output byte order
+    uint		pos;		// current byte position within 'buf'
+
+} LFG_t;
+
+//-----------------------------------------------------------------------------
+
+void SetSeedLFG
+(
+    LFG_t		* lfg,		// valid generator
+    const void		* seed		// LFG_SEED_SIZE big endian u32 values
+);
+
+//-----------------------------------------------------------------------------
+
+void ForwardLFG
+(
+    LFG_t		* lfg,		// valid generator
+    uint		n_bytes		// number of bytes to skip
+);
+
+//-----------------------------------------------------------------------------
+
+void GetBytesLFG
+(
+    LFG_t		* lfg,		// valid generator
+    void		* dest,		// destination buffer
+    uint		size		// number of bytes to generate
+);
+
+//-----------------------------------------------------------------------------
+
+uint CountMatchesLFG
+(
+    // Compare 'data' with the generator output and advance the generator.
+    // Return the number of leading bytes of 'data' matching the output.
+
+    LFG_t		* lfg,		// valid generator
+    const void		* data,		// data to compare
+    uint		size		// size of 'data'
+);
+
+//-----------------------------------------------------------------------------
+
+uint CheckJunkLFG
+(
+    // Fast check of u32 words. Return the number of leading bytes of 'data'
+    // (a multiple of 4), that may be output of any generator.
+
+    const void		* data,		// data to analyze, u32 aligned to the generator
+    uint		size		// size of 'data'
+);
+
+//-----------------------------------------------------------------------------
+
+uint DetectJunkLFG
+(
+    // Try to find the seed of the junk data at the beginning of 'data'.
+    // On success, the seed is stored and the number of leading bytes of
+    // 'data' matching the generator output is returned (>=LFG_BUF_SIZE).
+    // Otherwise 0 is returned. Null data is never detected as junk.
+
+    void		* seed,		// store LFG_SEED_SIZE big endian u32 values
+    const void		* data,		// data to analyze
+    uint		size,		// size of 'data'
+    uint		data_offset	// offset of 'data' behind the seed point,
+					// must be a multiple of 4
+);
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // WIT_LIB_LFG_H 1
+
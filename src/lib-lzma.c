@@ -297,6 +297,31 @@ static size_t sz_write_file ( void *pp, const void *data, size_t size )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+typedef struct sz_outbuf_t
+{
+    ISeqOutStream	func;
+    u8			* buf;
+    size_t		buf_size;
+    u32			bytes_written;
+
+} sz_outbuf_t;
+
+//-----------------------------------------------------------------------------
+
+static size_t sz_write_buf ( void *pp, const void *data, size_t size )
+{
+    DASSERT(pp);
+    sz_outbuf_t * obuf = pp;
+    noPRINT("$$$ sz_write_buf(%p,%p,%zx=%zu)\n",obuf,data,size,size);
+    if ( SIGINT_level>1 || obuf->bytes_written + size > obuf->buf_size )
+	return 0;
+    memcpy(obuf->buf+obuf->bytes_written,data,size);
+    obuf->bytes_written += size;
+    return size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 typedef struct sz_progress_t
 {
     ICompressProgress	func;	    // progress function
@@ -336,14 +361,15 @@ SRes sz_progress ( void *pp, UInt64 in_size, UInt64 out_size )
 enumError EncLZMA_Open
 (
     EncLZMA_t		* lzma,		// object, will be initialized
-    ccp			error_object,	// object name for error messages
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
     int			compr_level,	// valid are 1..9 / 0: use default value
     bool		write_endmark	// true: write end marker at end of stream
 )
 {
     DASSERT(lzma);
     memset(lzma,0,sizeof(*lzma));
-    lzma->error_object = error_object ? error_object : "?";
+    lzma->error_object = error_object;
 
  #if LOG_ALLOC
      alloc_count = 0;
@@ -356,7 +382,7 @@ enumError EncLZMA_Open
 
     lzma->handle = LzmaEnc_Create(&lzma_alloc);
     if (!lzma->handle)
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while opening LZMA stream: %s\n-> LZMA error: %s\n",
 		lzma->error_object, GetMessageLZMA(SZ_ERROR_MEM,"?") );
 
@@ -373,7 +399,7 @@ enumError EncLZMA_Open
     if ( res != SZ_OK )
     {
 	EncLZMA_Close(lzma);
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while setup LZMA properties: %s\n-> LZMA error: %s\n",
 		lzma->error_object, GetMessageLZMA(res,"?") );
     }
@@ -387,7 +413,7 @@ enumError EncLZMA_Open
     if ( res != SZ_OK )
     {
 	EncLZMA_Close(lzma);
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while writing LZMA properties: %s\n-> LZMA error: %s\n",
 		lzma->error_object, GetMessageLZMA(res,"?") );
     }
@@ -466,7 +492,7 @@ enumError EncLZMA_WriteList2File
     if ( res != SZ_OK )
     {
 	EncLZMA_Close(lzma);
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while writing LZMA stream: %s\n-> LZMA error: %s\n",
 		lzma->error_object, GetMessageLZMA(res,"?") );
     }
@@ -554,6 +580,64 @@ enumError EncLZMA_List2File // open + write + close lzma stream
     return EncLZMA_Close(lzma);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+enumError EncLZMA_List2Buf // open + write + close lzma stream
+(
+    EncLZMA_t		* lzma,		// if NULL: use internal structure
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    int			compr_level,	// valid are 1..9 / 0: use default value
+    bool		write_props,	// true: write encoding properties
+    bool		write_endmark,	// true: write end marker at end of stream
+    DataList_t		* data_list,	// NULL or data list (modified)
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written	// not NULL: store written bytes
+)
+{
+    // This function doesn't use any global data and no progress support.
+    // So it is usable by worker threads, if 'error_object' is NULL.
+
+    DASSERT(buf);
+
+    EncLZMA_t internal_lzma;
+    if (!lzma)
+	lzma = &internal_lzma;
+
+    enumError err = EncLZMA_Open(lzma,error_object,compr_level,write_endmark);
+    if (err)
+	return err;
+
+    sz_outbuf_t outbuf;
+    outbuf.func.Write = sz_write_buf;
+    outbuf.buf = buf;
+    outbuf.buf_size = buf_size;
+    outbuf.bytes_written = 0;
+
+    if (write_props)
+	outbuf.func.Write(&outbuf,lzma->enc_props,lzma->enc_props_len);
+
+    sz_inbuf_t inbuf;
+    inbuf.func.Read = sz_read_buf;
+    inbuf.data = data_list;
+    inbuf.bytes_read = 0;
+
+    SRes res = LzmaEnc_Encode(	lzma->handle,
+				(ISeqOutStream*)&outbuf,
+				(ISeqInStream*)&inbuf,
+				0, &lzma_alloc, &lzma_alloc );
+    EncLZMA_Close(lzma);
+    if ( res != SZ_OK )
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
+		"Error while writing LZMA stream: %s\n-> LZMA error: %s\n",
+		lzma->error_object, GetMessageLZMA(res,"?") );
+
+    if (bytes_written)
+	*bytes_written = outbuf.bytes_written;
+    return ERR_OK;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		LZMA decoding (decompression)		///////////////
@@ -685,6 +769,79 @@ enumError DecLZMA_File2Buf // open + read + close lzma stream
     return err;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+enumError DecLZMA_Buf2Buf // open + decode + close lzma stream, thread safe
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    const void		* src,		// source buffer with compressed data
+    size_t		src_size,	// size of source buffer
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written,// not NULL: store bytes written to buf
+    const u8		* enc_props	// valid encoding properties
+)
+{
+    // This function doesn't use any global data, so it is usable by threads,
+    // if 'error_object' is NULL.
+
+    DASSERT(src);
+    DASSERT(buf);
+    DASSERT(enc_props);
+
+    CLzmaDec lzma;
+    LzmaDec_Construct(&lzma);
+    SRes res = LzmaDec_Allocate(&lzma,enc_props,LZMA_PROPS_SIZE,&lzma_alloc);
+    if ( res != SZ_OK )
+	return !error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
+		"Error while setup LZMA properties: %s\n-> LZMA error: %s\n",
+		error_object, GetMessageLZMA(res,"?") );
+
+    const u8 * in = src;
+    u8 * dest = buf;
+    u32 written = 0;
+
+    LzmaDec_Init(&lzma);
+    for(;;)
+    {
+	size_t in_len  = src_size;
+	size_t out_len = buf_size;
+	ELzmaStatus status;
+
+	res = LzmaDec_DecodeToBuf(&lzma,dest,&out_len,in,&in_len,LZMA_FINISH_END,&status);
+	noPRINT("DECODED, res=%s, stat=%d, in=%zu/%zu out=%zu/%zu\n",
+		GetMessageLZMA(res,"?"), status,
+		in_len, src_size, out_len, buf_size );
+
+	if ( res == SZ_OK && !in_len && !out_len && status != LZMA_STATUS_FINISHED_WITH_MARK )
+	    res = SZ_ERROR_DATA;
+
+	if ( res != SZ_OK )
+	{
+	    LzmaDec_Free(&lzma,&lzma_alloc);
+	    return !error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
+		"Error while reading LZMA stream: %s\n-> LZMA error: %s\n",
+		error_object, GetMessageLZMA(res,"?") );
+	}
+
+	written  += out_len;
+	dest	 += out_len;
+	buf_size -= out_len;
+	in	 += in_len;
+	src_size -= in_len;
+
+	if ( status == LZMA_STATUS_FINISHED_WITH_MARK || !src_size )
+	    break;
+    }
+
+    LzmaDec_Free(&lzma,&lzma_alloc);
+
+    if (bytes_written)
+	*bytes_written = written;
+    return ERR_OK;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		  LZMA2 encoding (compression)		///////////////
@@ -693,14 +850,15 @@ enumError DecLZMA_File2Buf // open + read + close lzma stream
 enumError EncLZMA2_Open
 (
     EncLZMA_t		* lzma,		// object, will be initialized
-    ccp			error_object,	// object name for error messages
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
     int			compr_level,	// valid are 1..9 / 0: use default value
     bool		write_endmark	// true: write end marker at end of stream
 )
 {
     DASSERT(lzma);
     memset(lzma,0,sizeof(*lzma));
-    lzma->error_object = error_object ? error_object : "?";
+    lzma->error_object = error_object;
 
  #if LOG_ALLOC
      alloc_count = 0;
@@ -713,7 +871,7 @@ enumError EncLZMA2_Open
 
     lzma->handle = Lzma2Enc_Create(&lzma_alloc,&lzma_alloc);
     if (!lzma->handle)
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while opening LZMA2 stream: %s\n-> LZMA2 error: %s\n",
 		lzma->error_object, GetMessageLZMA(SZ_ERROR_MEM,"?") );
 
@@ -730,7 +888,7 @@ enumError EncLZMA2_Open
     if ( res != SZ_OK )
     {
 	EncLZMA2_Close(lzma);
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while setup LZMA2 properties: %s\n-> LZMA2 error: %s\n",
 		lzma->error_object, GetMessageLZMA(res,"?") );
     }
@@ -817,7 +975,7 @@ enumError EncLZMA2_WriteList2File
     if ( res != SZ_OK )
     {
 	EncLZMA2_Close(lzma);
-	return ERROR0(ERR_LZMA,
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
 		"Error while writing LZMA2 stream: %s\n-> LZMA2 error: %s\n",
 		lzma->error_object, GetMessageLZMA(res,"?") );
     }
@@ -905,6 +1063,64 @@ enumError EncLZMA2_List2File // open + write + close lzma stream
     return EncLZMA2_Close(lzma);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+enumError EncLZMA2_List2Buf // open + write + close lzma stream
+(
+    EncLZMA_t		* lzma,		// if NULL: use internal structure
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    int			compr_level,	// valid are 1..9 / 0: use default value
+    bool		write_props,	// true: write encoding properties
+    bool		write_endmark,	// true: write end marker at end of stream
+    DataList_t		* data_list,	// NULL or data list (modified)
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written	// not NULL: store written bytes
+)
+{
+    // This function doesn't use any global data and no progress support.
+    // So it is usable by worker threads, if 'error_object' is NULL.
+
+    DASSERT(buf);
+
+    EncLZMA_t internal_lzma;
+    if (!lzma)
+	lzma = &internal_lzma;
+
+    enumError err = EncLZMA2_Open(lzma,error_object,compr_level,write_endmark);
+    if (err)
+	return err;
+
+    sz_outbuf_t outbuf;
+    outbuf.func.Write = sz_write_buf;
+    outbuf.buf = buf;
+    outbuf.buf_size = buf_size;
+    outbuf.bytes_written = 0;
+
+    if (write_props)
+	outbuf.func.Write(&outbuf,lzma->enc_props,lzma->enc_props_len);
+
+    sz_inbuf_t inbuf;
+    inbuf.func.Read = sz_read_buf;
+    inbuf.data = data_list;
+    inbuf.bytes_read = 0;
+
+    SRes res = Lzma2Enc_Encode( lzma->handle,
+				(ISeqOutStream*)&outbuf,
+				(ISeqInStream*)&inbuf,
+				0 );
+    EncLZMA2_Close(lzma);
+    if ( res != SZ_OK )
+	return !lzma->error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
+		"Error while writing LZMA2 stream: %s\n-> LZMA2 error: %s\n",
+		lzma->error_object, GetMessageLZMA(res,"?") );
+
+    if (bytes_written)
+	*bytes_written = outbuf.bytes_written;
+    return ERR_OK;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		LZMA2 decoding (decompression)		///////////////
@@ -1036,6 +1252,79 @@ enumError DecLZMA2_File2Buf // open + read + close lzma stream
     return err;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+enumError DecLZMA2_Buf2Buf // open + decode + close lzma stream, thread safe
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    const void		* src,		// source buffer with compressed data
+    size_t		src_size,	// size of source buffer
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written,// not NULL: store bytes written to buf
+    const u8		* enc_props	// valid encoding properties
+)
+{
+    // This function doesn't use any global data, so it is usable by threads,
+    // if 'error_object' is NULL.
+
+    DASSERT(src);
+    DASSERT(buf);
+    DASSERT(enc_props);
+
+    CLzma2Dec lzma;
+    Lzma2Dec_Construct(&lzma);
+    SRes res = Lzma2Dec_Allocate(&lzma,*enc_props,&lzma_alloc);
+    if ( res != SZ_OK )
+	return !error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
+		"Error while setup LZMA2 properties: %s\n-> LZMA2 error: %s\n",
+		error_object, GetMessageLZMA(res,"?") );
+
+    const u8 * in = src;
+    u8 * dest = buf;
+    u32 written = 0;
+
+    Lzma2Dec_Init(&lzma);
+    for(;;)
+    {
+	size_t in_len  = src_size;
+	size_t out_len = buf_size;
+	ELzmaStatus status;
+
+	res = Lzma2Dec_DecodeToBuf(&lzma,dest,&out_len,in,&in_len,LZMA_FINISH_END,&status);
+	noPRINT("DECODED, res=%s, stat=%d, in=%zu/%zu out=%zu/%zu\n",
+		GetMessageLZMA(res,"?"), status,
+		in_len, src_size, out_len, buf_size );
+
+	if ( res == SZ_OK && !in_len && !out_len && status != LZMA_STATUS_FINISHED_WITH_MARK )
+	    res = SZ_ERROR_DATA;
+
+	if ( res != SZ_OK )
+	{
+	    Lzma2Dec_Free(&lzma,&lzma_alloc);
+	    return !error_object ? ERR_LZMA : ERROR0(ERR_LZMA,
+		"Error while reading LZMA2 stream: %s\n-> LZMA2 error: %s\n",
+		error_object, GetMessageLZMA(res,"?") );
+	}
+
+	written  += out_len;
+	dest	 += out_len;
+	buf_size -= out_len;
+	in	 += in_len;
+	src_size -= in_len;
+
+	if ( status == LZMA_STATUS_FINISHED_WITH_MARK || !src_size )
+	    break;
+    }
+
+    Lzma2Dec_Free(&lzma,&lzma_alloc);
+
+    if (bytes_written)
+	*bytes_written = written;
+    return ERR_OK;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			    END				///////////////
@@ -53,7 +53,8 @@ typedef struct EncLZMA_t
     u8			enc_props[8];	// encoded properties
     size_t		enc_props_len;	// used length of 'enc_props'
     int			compr_level;	// active compression level
-    ccp			error_object;	// object name for error messages
+    ccp			error_object;	// NULL or object name for error messages
+					// NULL: don't print error messages
 
 } EncLZMA_t;
 
@@ -106,7 +107,8 @@ u32 CalcMemoryUsageLZMA2
 enumError EncLZMA_Open
 (
     EncLZMA_t		* lzma,		// object, will be initialized
-    ccp			error_object,	// object name for error messages
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
     int			compr_level,	// valid are 1..9 / 0: use default value
     bool		write_endmark	// true: write end marker at end of stream
 );
@@ -172,6 +174,22 @@ enumError EncLZMA_List2File // open + write + close lzma stream
     u32			* bytes_written	// not NULL: store written bytes
 );
 
+//-----------------------------------------------------------------------------
+
+enumError EncLZMA_List2Buf // open + write + close lzma stream, thread safe
+(
+    EncLZMA_t		* lzma,		// if NULL: use internal structure
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    int			compr_level,	// valid are 1..9 / 0: use default value
+    bool		write_props,	// true: write encoding properties
+    bool		write_endmark,	// true: write end marker at end of stream
+    DataList_t		* data_list,	// NULL or data list (modified)
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written	// not NULL: store written bytes
+);
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		 LZMA decoding (decompression)		///////////////
@@ -189,6 +207,20 @@ enumError DecLZMA_File2Buf // open + read + close lzma stream
 					// If NULL: read it from file
 );
 
+//-----------------------------------------------------------------------------
+
+enumError DecLZMA_Buf2Buf // open + decode + close lzma stream, thread safe
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    const void		* src,		// source buffer with compressed data
+    size_t		src_size,	// size of source buffer
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written,// not NULL: store bytes written to buf
+    const u8		* enc_props	// valid encoding properties
+);
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		   LZMA2 encoding (compression)		///////////////
@@ -197,7 +229,8 @@ enumError DecLZMA_File2Buf // open + read + close lzma stream
 enumError EncLZMA2_Open
 (
     EncLZMA_t		* lzma,		// object, will be initialized
-    ccp			error_object,	// object name for error messages
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
     int			compr_level,	// valid are 1..9 / 0: use default value
     bool		write_endmark	// true: write end marker at end of stream
 );
@@ -263,6 +296,22 @@ enumError EncLZMA2_List2File // open + write + close lzma stream
     u32			* bytes_written	// not NULL: store written bytes
 );
 
+//-----------------------------------------------------------------------------
+
+enumError EncLZMA2_List2Buf // open + write + close lzma stream, thread safe
+(
+    EncLZMA_t		* lzma,		// if NULL: use internal structure
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    int			compr_level,	// valid are 1..9 / 0: use default value
+    bool		write_props,	// true: write encoding properties
+    bool		write_endmark,	// true: write end marker at end of stream
+    DataList_t		* data_list,	// NULL or data list (modified)
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written	// not NULL: store written bytes
+);
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////		 LZMA2 decoding (decompression)		///////////////
@@ -280,6 +329,20 @@ enumError DecLZMA2_File2Buf // open + read + close lzma stream
 					// If NULL: read it from file
 );
 
+//-----------------------------------------------------------------------------
+
+enumError DecLZMA2_Buf2Buf // open + decode + close lzma stream, thread safe
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    const void		* src,		// source buffer with compressed data
+    size_t		src_size,	// size of source buffer
+    void		* buf,		// destination buffer
+    size_t		buf_size,	// size of destination buffer
+    u32			* bytes_written,// not NULL: store bytes written to buf
+    const u8		* enc_props	// valid encoding properties
+);
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////				END			///////////////
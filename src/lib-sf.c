@@ -43,6 +43,9 @@
 #include <arpa/inet.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
 
 #include "debug.h"
 #include "libwbfs.h"
@@ -50,6 +53,7 @@
 #include "wbfs-interface.h"
 #include "titles.h"
 #include "cert.h"
+#include "lib-thread.h"
 
 //
 ///////////////////////////////////////////////////////////////////////////////
@@ -105,6 +109,8 @@ void CleanSF ( SuperFile_t * sf )
     {
 	TRACE("#S# close GCZ %s id=%s=%s\n",
 		sf->f.fname, sf->f.id6_src, sf->f.id6_dest );
+	if ( verbose > 2 && sf->gcz->cache_hits + sf->gcz->cache_misses )
+	    PrintCacheStatGCZ(stdout,2,sf->gcz);
 	ResetGCZ(sf->gcz);
 	FREE(sf->gcz);
 	sf->gcz = 0;
@@ -114,6 +120,8 @@ void CleanSF ( SuperFile_t * sf )
     {
 	TRACE("#S# close FST %s id=%s=%s\n",
 		sf->f.fname, sf->f.id6_src, sf->f.id6_dest );
+	if ( verbose > 2 && sf->fst->cache_hits + sf->fst->cache_misses )
+	    PrintCacheStatFST(stdout,2,sf->fst);
 	ResetFST(sf->fst);
 	FREE(sf->fst);
 	sf->fst = 0;
@@ -261,6 +269,7 @@ enumError ResetSF ( SuperFile_t * sf, FileAttrib_t * set_time_ref )
     sf->progress_start_time	= GetTimerMSec();
     sf->progress_last_view_sec	= 0;
     sf->progress_max_wd		= 0;
+    memset(&sf->copy_stat,0,sizeof(sf->copy_stat));
 
     return err;
 }
@@ -355,6 +364,7 @@ enumOFT SetupIOD ( SuperFile_t * sf, enumOFT force, enumOFT def )
 	    break;
 
 	case OFT_WIA:
+	case OFT_RVZ:
 	    sf->iod.read_func		= ReadWIA;
 	    sf->iod.data_block_func	= DataBlockWIA;
 	    sf->iod.file_map_func	= 0;			// not supported
@@ -451,7 +461,7 @@ enumError SetupReadSF ( SuperFile_t * sf )
     if ( sf->f.ftype & FT_M_WDF )
 	return SetupReadWDF(sf);
 
-    if ( sf->f.ftype & FT_A_WIA )
+    if ( sf->f.ftype & (FT_A_WIA|FT_A_RVZ) )
 	return SetupReadWIA(sf);
 
     if ( sf->f.ftype & FT_A_CISO )
@@ -716,6 +726,7 @@ enumError SetupWriteSF
 	    return SetupWriteWDF(sf);
 
 	case OFT_WIA:
+	case OFT_RVZ:
 	    return SetupWriteWIA(sf,0);
 
 	case OFT_GCZ:
@@ -1594,7 +1605,8 @@ enumError ReadSwitchSF
     {
 	case OFT_WDF1:
 	case OFT_WDF2:	return ReadWDF(sf,off,buf,count);
-	case OFT_WIA:	return ReadWIA(sf,off,buf,count);
+	case OFT_WIA:
+	case OFT_RVZ:	return ReadWIA(sf,off,buf,count);
 	case OFT_GCZ:	return ReadGCZ(sf,off,buf,count);
 	case OFT_CISO:	return ReadCISO(sf,off,buf,count);
 	case OFT_WBFS:	return ReadWBFS(sf,off,buf,count);
@@ -1615,7 +1627,8 @@ enumError WriteSwitchSF
 	case OFT_PLAIN:	return WriteISO(sf,off,buf,count);
 	case OFT_WDF1:
 	case OFT_WDF2:	return WriteWDF(sf,off,buf,count);
-	case OFT_WIA:	return WriteWIA(sf,off,buf,count);
+	case OFT_WIA:
+	case OFT_RVZ:	return WriteWIA(sf,off,buf,count);
 	case OFT_GCZ:	return WriteGCZ(sf,off,buf,count);
 	case OFT_CISO:	return WriteCISO(sf,off,buf,count);
 	case OFT_WBFS:	return WriteWBFS(sf,off,buf,count);
@@ -1635,7 +1648,8 @@ enumError WriteSparseSwitchSF
 	case OFT_PLAIN:	return WriteSparseISO(sf,off,buf,count);
 	case OFT_WDF1:
 	case OFT_WDF2:	return WriteSparseWDF(sf,off,buf,count);
-	case OFT_WIA:	return WriteSparseWIA(sf,off,buf,count);
+	case OFT_WIA:
+	case OFT_RVZ:	return WriteSparseWIA(sf,off,buf,count);
 	case OFT_GCZ:	return WriteGCZ(sf,off,buf,count);
 	case OFT_CISO:	return WriteSparseCISO(sf,off,buf,count);
 	case OFT_WBFS:	return WriteWBFS(sf,off,buf,count); // no sparse support
@@ -1654,7 +1668,8 @@ enumError WriteZeroSwitchSF ( SuperFile_t * sf, off_t off, size_t count )
 	case OFT_PLAIN:	return WriteZeroISO(sf,off,count);
 	case OFT_WDF1:
 	case OFT_WDF2:	return WriteZeroWDF(sf,off,count);
-	case OFT_WIA:	return WriteZeroWIA(sf,off,count);
+	case OFT_WIA:
+	case OFT_RVZ:	return WriteZeroWIA(sf,off,count);
 	case OFT_GCZ:	return WriteZeroGCZ(sf,off,count);
 	case OFT_CISO:	return WriteZeroCISO(sf,off,count);
 	case OFT_WBFS:	return WriteZeroWBFS(sf,off,count);
@@ -1687,6 +1702,32 @@ enumError ReadISO
 
 ///////////////////////////////////////////////////////////////////////////////
 
+const void * GetMappedSF ( SuperFile_t * sf, off_t off, size_t count )
+{
+    ASSERT(sf);
+    if ( !( opt_iomode & IOM_MMAP ) )
+	return 0;
+
+    if ( sf->iod.read_func == ReadWDF )
+	return GetMappedWDF(sf,off,count);
+
+    if ( sf->iod.read_func != ReadISO )
+	return 0;
+
+    const void * data = GetMappedF(&sf->f,off,count);
+    if (data)
+    {
+	off += count;
+	if ( sf->max_virt_off < off )
+	     sf->max_virt_off = off;
+	if ( sf->file_size < off )
+	     sf->file_size = off;
+    }
+    return data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError WriteISO
 	( SuperFile_t * sf, off_t off, const void * buf, size_t count )
 {
@@ -1778,6 +1819,7 @@ enumError SetSizeSF ( SuperFile_t * sf, off_t off )
 	case OFT_WDF1:
 	case OFT_WDF2:
 	case OFT_WIA:
+	case OFT_RVZ:
 	case OFT_GCZ:
 	case OFT_CISO:
 	case OFT_WBFS:	return ERR_OK;
@@ -1845,6 +1887,14 @@ enumError ReadWBFS ( SuperFile_t * sf, off_t off, void * buf, size_t count )
     u32 bl = (u32)( off / w->wbfs_sec_sz );
     u32 bl_off = (u32)( off - (u64)bl * w->wbfs_sec_sz );
 
+    // Blocks at consecutive WBFS blocks form a physical extent and are read
+    // by one vectored read, even if holes of the disc lie between them.
+    // The buffers of the holes are cleared.
+
+    struct iovec iov[READ_VEC_MAX];
+    int n_iov = 0;
+    off_t ext_off = 0, ext_end = 0;
+
     while ( count > 0 )
     {
 	u32 max_count = w->wbfs_sec_sz - bl_off;
@@ -1859,11 +1909,27 @@ enumError ReadWBFS ( SuperFile_t * sf, off_t off, void * buf, size_t count )
 
 	if (wlba)
 	{
-	    enumError err = ReadAtF( &sf->f,
-				     (off_t)w->wbfs_sec_sz * wlba + bl_off,
-				     buf, max_count);
-	    if (err)
-		return err;
+	    const off_t phys_off = (off_t)w->wbfs_sec_sz * wlba + bl_off;
+	    if ( n_iov && ( phys_off != ext_end || n_iov == READ_VEC_MAX ) )
+	    {
+		const enumError err = ReadVecAtF(&sf->f,ext_off,iov,n_iov);
+		if (err)
+		    return err;
+		n_iov = 0;
+	    }
+
+	    if (!n_iov)
+		ext_off = ext_end = phys_off;
+
+	    if ( n_iov && (char*)iov[n_iov-1].iov_base + iov[n_iov-1].iov_len == buf )
+		iov[n_iov-1].iov_len += max_count;
+	    else
+	    {
+		iov[n_iov].iov_base = buf;
+		iov[n_iov].iov_len  = max_count;
+		n_iov++;
+	    }
+	    ext_end += max_count;
 	}
 	else
 	    memset(buf,0,max_count);
@@ -1874,7 +1940,7 @@ enumError ReadWBFS ( SuperFile_t * sf, off_t off, void * buf, size_t count )
 	buf = (char*)buf + max_count;
     }
 
-    return ERR_OK;
+    return n_iov ? ReadVecAtF(&sf->f,ext_off,iov,n_iov) : ERR_OK;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2006,6 +2072,14 @@ enumError WriteWBFS
 	    wlba_tab[bl] = htons(wlba);
 	    disc->is_dirty = 1;
 	}
+	else if ( wlba < w->n_wbfs_sec && w->used_block[wlba] > 1 )
+	{
+	    // block is shared by a deduplicated WBFS => copy on write
+	    const enumError err = UnshareBlockWBFS(sf->wbfs,disc,bl);
+	    if (err)
+		return err;
+	    wlba = ntohs(wlba_tab[bl]);
+	}
 
 	if ( disc->is_creating && off < sizeof(disc->header->dhead) )
 	{
@@ -2260,6 +2334,22 @@ void ClearProgressLineSF ( SuperFile_t * sf )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static double copy_overlap_percent ( const CopyStat_t * cs )
+{
+    // part of the shorter side, that runs parallel to the other side
+
+    DASSERT(cs);
+    const u64 min = cs->read_usec < cs->write_usec ? cs->read_usec : cs->write_usec;
+    const u64 sum = cs->read_usec + cs->write_usec;
+    if ( !min || sum <= cs->total_usec )
+	return 0.0;
+
+    const double percent = 100.0 * ( sum - cs->total_usec ) / min;
+    return percent < 100.0 ? percent : 100.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void PrintSummarySF ( SuperFile_t * sf )
 {
     if ( !sf || !sf->show_progress && !sf->show_summary )
@@ -2309,6 +2399,21 @@ void PrintSummarySF ( SuperFile_t * sf )
 		printf("compression-percent=%4.2f\n",
 			100.0 * (double)sf->f.max_off / sf->source_size);
 
+	    const CopyStat_t * cs = &sf->copy_stat;
+	    if (cs->total_usec)
+		printf(
+		    "overlap-percent=%4.2f\n"
+		    "read-msec=%llu\n"
+		    "read-stall-msec=%llu\n"
+		    "write-msec=%llu\n"
+		    "write-stall-msec=%llu\n"
+		    ,copy_overlap_percent(cs)
+		    ,cs->read_usec / 1000
+		    ,cs->read_stall_usec / 1000
+		    ,cs->write_usec / 1000
+		    ,cs->write_stall_usec / 1000
+		    );
+
 	    putchar('\n');
 	}
 	else if (total)
@@ -2328,6 +2433,14 @@ void PrintSummarySF ( SuperFile_t * sf )
 	    printf("%-*s\n",sf->progress_max_wd,buf);
 	else
 	    printf("%s\n",buf);
+
+	const CopyStat_t * cs = &sf->copy_stat;
+	if ( sf->show_summary && sf->show_progress && cs->total_usec )
+	    printf("%*s%4.1f%% read/write overlap:"
+		" read %4.2fs (%4.2fs stalled), write %4.2fs (%4.2fs stalled)\n",
+		sf->indent,"", copy_overlap_percent(cs),
+		cs->read_usec  / 1e6, cs->read_stall_usec  / 1e6,
+		cs->write_usec / 1e6, cs->write_stall_usec / 1e6 );
     }
     fflush(stdout);
 }
@@ -2606,6 +2719,15 @@ enumFileType AnalyzeFT ( File_t * f )
 		? FT_ID_GC_ISO  | FT_A_ISO | FT_A_GC_ISO  | FT_A_WIA
 		: FT_ID_WII_ISO | FT_A_ISO | FT_A_WII_ISO | FT_A_WIA;
     }
+    else if (IsRVZ(buf1,sizeof(buf1),id6,&disc_type,0))
+    {
+	SetPatchFileID(f,id6,6);
+	PRINT("RVZ found, dt=%d, id=%s,%s: %s\n",
+		disc_type, f->id6_src, f->id6_dest, f->fname );
+	ft |= disc_type == WD_DT_GAMECUBE
+		? FT_ID_GC_ISO  | FT_A_ISO | FT_A_GC_ISO  | FT_A_RVZ
+		: FT_ID_WII_ISO | FT_A_ISO | FT_A_WII_ISO | FT_A_RVZ;
+    }
     else
     {
      #ifdef DEBUG
@@ -2823,7 +2945,7 @@ enumFileType AnalyzeMemFT ( const void * preload_buf, off_t file_size )
 
     //----- test WBFS
 
-    if (!memcmp(data,"WBFS",4))
+    if (wbfs_is_head_magic(be32(data)))
 	return FT_ID_WBFS;
 
     int i;
@@ -3037,6 +3159,10 @@ enumError XPrintErrorFT ( XPARM File_t * f, enumFileType err_mask )
 	stat = PrintError( XERROR0, ERR_WRONG_FILE_TYPE,
 		"WIA expected: %s\n", f->fname );
 
+    else if ( nand_mask & FT_A_RVZ )
+	stat = PrintError( XERROR0, ERR_WRONG_FILE_TYPE,
+		"RVZ expected: %s\n", f->fname );
+
     else if ( nand_mask & FT_A_CISO )
 	stat = PrintError( XERROR0, ERR_WRONG_FILE_TYPE,
 		"CISO expected: %s\n", f->fname );
@@ -3086,6 +3212,7 @@ ccp GetNameFT ( enumFileType ftype, int ignore )
 	    return ftype & FT_A_WDF1 ? "WDF1/GC"
 		 : ftype & FT_A_WDF2 ? "WDF2/GC"
 		 : ftype & FT_A_WIA  ? "WIA/GC"
+		 : ftype & FT_A_RVZ  ? "RVZ/GC"
 		 : ftype & FT_A_CISO ? "CISO/GC"
 		 : ftype & FT_A_GCZ  ? "GCZ/GC"
 		 : "ISO/GC";
@@ -3094,6 +3221,7 @@ ccp GetNameFT ( enumFileType ftype, int ignore )
 	    return ftype & FT_A_WDF1 ? "WDF1/WII"
 		 : ftype & FT_A_WDF2 ? "WDF2/WII"
 		 : ftype & FT_A_WIA  ? "WIA/WII"
+		 : ftype & FT_A_RVZ  ? "RVZ/WII"
 		 : ftype & FT_A_CISO ? "CISO/WII"
 		 : ftype & FT_A_GCZ  ? "GCZ/WII"
 		 : "ISO/WII";
@@ -3128,6 +3256,7 @@ ccp GetNameFT ( enumFileType ftype, int ignore )
 		: ftype & FT_A_WDF1 ? "WDF1/*"
 		: ftype & FT_A_WDF2 ? "WDF2/*"
 		: ftype & FT_A_WIA  ? "WIA/*"
+		: ftype & FT_A_RVZ  ? "RVZ/*"
 		: ftype & FT_A_CISO ? "CISO/*"
 		: ftype & FT_A_GCZ  ? "GCZ/*"
 		: "OTHER";
@@ -3155,6 +3284,9 @@ enumOFT FileType2OFT ( enumFileType ftype )
     if ( ftype & FT_A_WIA )
 	return OFT_WIA;
 
+    if ( ftype & FT_A_RVZ )
+	return OFT_RVZ;
+
     if ( ftype & FT_A_GCZ )
 	return OFT_GCZ;
 
@@ -3416,6 +3548,336 @@ enumError ExtractImage
 ///////////////			copy functions			///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+#define COPY_OVERLAP_BUFS 2
+
+typedef struct copy_buf_t
+{
+    char		* buf;		// buffer, got by GetIOBuf()
+    const char		* data;		// data to write: 'buf' or file mapping
+    off_t		write_off;	// destination offset of data
+    u32			size;		// size of data
+    bool		full;		// true: filled by reader, waiting for writer
+
+} copy_buf_t;
+
+//-----------------------------------------------------------------------------
+
+typedef struct copy_overlap_t
+{
+    SuperFile_t		* in;		// input file, only used by the reader
+    bool		read_raw;	// true: ReadAtF(&in->f), false: ReadSF(in)
+    CopyRegionFunc	next_region;	// get next region, only used by the reader
+    void		* param;	// parameter of 'next_region'
+
+    pthread_mutex_t	mutex;		// protect 'cbuf[].full', 'eof' and 'abort'
+    pthread_cond_t	cond;		// signal: buffer state changed
+    copy_buf_t		cbuf[COPY_OVERLAP_BUFS];
+    u32			buf_size;	// size of each buffer
+    bool		eof;		// true: reader finished, 'read_err' is valid
+    bool		abort;		// true: writer requests termination
+    enumError		read_err;	// status of reader
+
+    u64			read_usec;	// time used by ReadSF()/ReadAtF()
+    u64			read_stall_usec;// time the reader waited for a free buffer
+
+} copy_overlap_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError copy_read
+(
+    copy_overlap_t	* co,		// valid data
+    copy_buf_t		* cb,		// buffer to fill, set 'cb->data'
+    off_t		off,		// source offset
+    size_t		size		// number of bytes to read
+)
+{
+    // use the file mapping without copying, if available
+
+    cb->data = co->read_raw
+		? (ccp)GetMappedF(&co->in->f,off,size)
+		: GetMappedSF(co->in,off,size);
+    if (cb->data)
+	return ERR_OK;
+
+    cb->data = cb->buf;
+    return co->read_raw
+		? ReadAtF(&co->in->f,off,cb->buf,size)
+		: ReadSF(co->in,off,cb->buf,size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void * copy_reader_thread ( void * arg )
+{
+    copy_overlap_t * co = arg;
+    DASSERT(co);
+
+    enumError err = ERR_OK;
+    CopyRegion_t reg;
+    uint idx = 0;
+
+    while ( co->next_region(co->param,&reg) )
+    {
+	while ( reg.size > 0 )
+	{
+	    copy_buf_t * cb = co->cbuf + idx;
+
+	    u64 start = GetTimerUSec();
+	    pthread_mutex_lock(&co->mutex);
+	    while ( cb->full && !co->abort )
+		pthread_cond_wait(&co->cond,&co->mutex);
+	    const bool abort = co->abort;
+	    pthread_mutex_unlock(&co->mutex);
+	    co->read_stall_usec += GetTimerUSec() - start;
+	    if (abort)
+		goto term;
+
+	    const u32 size = reg.size < co->buf_size ? (u32)reg.size : co->buf_size;
+	    start = GetTimerUSec();
+	    err = copy_read(co,cb,reg.read_off,size);
+	    co->read_usec += GetTimerUSec() - start;
+	    if (err)
+		goto term;
+
+	    cb->write_off  = reg.write_off;
+	    cb->size       = size;
+	    reg.read_off  += size;
+	    reg.write_off += size;
+	    reg.size      -= size;
+
+	    pthread_mutex_lock(&co->mutex);
+	    cb->full = true;
+	    pthread_cond_signal(&co->cond);
+	    pthread_mutex_unlock(&co->mutex);
+
+	    idx = ( idx + 1 ) % COPY_OVERLAP_BUFS;
+	}
+    }
+
+ term:
+    pthread_mutex_lock(&co->mutex);
+    co->read_err = err;
+    co->eof = true;
+    pthread_cond_signal(&co->cond);
+    pthread_mutex_unlock(&co->mutex);
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool allow_overlap ( SuperFile_t * in, SuperFile_t * out )
+{
+    DASSERT(in);
+    DASSERT(out);
+
+    // WIA uses the global 'tempbuf' for both reading and writing
+    return GetThreadCount() > 1 && !( in->wia && out->wia );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError OverlapCopySF
+(
+    SuperFile_t		* in,		// valid input file
+    SuperFile_t		* out,		// valid output file
+    bool		read_raw,	// true: ReadAtF(&in->f), false: ReadSF(in)
+    bool		sparse,		// true: WriteSparseSF(), false: WriteSF()
+    u64			pr_total,	// total for progress, if 'out->show_progress'
+    CopyRegionFunc	next_region,	// get next region to copy
+    void		* param		// user defined parameter of 'next_region'
+)
+{
+    DASSERT(in);
+    DASSERT(out);
+    DASSERT(next_region);
+
+    copy_overlap_t co;
+    memset(&co,0,sizeof(co));
+    co.in		= in;
+    co.read_raw		= read_raw;
+    co.next_region	= next_region;
+    co.param		= param;
+
+    enumError err = ERR_OK;
+    u64 pr_done = 0;
+
+    CopyStat_t * cs = &out->copy_stat;
+    memset(cs,0,sizeof(*cs));
+
+    if (!allow_overlap(in,out))
+    {
+	//--- copy without a reader thread
+
+	co.cbuf[0].buf = GetIOBuf(&co.buf_size);
+
+	CopyRegion_t reg;
+	while ( !err && next_region(param,&reg) )
+	{
+	    while ( reg.size > 0 )
+	    {
+		if ( SIGINT_level > 1 )
+		{
+		    err = ERR_INTERRUPT;
+		    break;
+		}
+
+		const u32 size = reg.size < co.buf_size ? (u32)reg.size : co.buf_size;
+		err = copy_read(&co,co.cbuf,reg.read_off,size);
+		if (err)
+		    break;
+
+		err = sparse
+			? WriteSparseSF(out,reg.write_off,co.cbuf[0].data,size)
+			: WriteSF(out,reg.write_off,co.cbuf[0].data,size);
+		if (err)
+		    break;
+
+		reg.read_off  += size;
+		reg.write_off += size;
+		reg.size      -= size;
+
+		if ( out->show_progress )
+		{
+		    pr_done += size;
+		    PrintProgressSF(pr_done,pr_total,out);
+		}
+	    }
+	}
+
+	PutIOBuf(co.cbuf[0].buf);
+	return err;
+    }
+
+
+    //--- setup buffers and start reader
+
+    const u64 start_usec = GetTimerUSec();
+
+    uint idx;
+    for ( idx = 0; idx < COPY_OVERLAP_BUFS; idx++ )
+	co.cbuf[idx].buf = GetIOBuf(&co.buf_size);
+
+    pthread_mutex_init(&co.mutex,0);
+    pthread_cond_init(&co.cond,0);
+
+    pthread_t thread;
+    if (pthread_create(&thread,0,copy_reader_thread,&co))
+    {
+	err = ERROR1(ERR_INTERNAL,"Can't create reader thread.\n");
+	goto abort;
+    }
+
+
+    //--- write buffers in order of reading
+
+    for ( idx = 0;; idx = ( idx + 1 ) % COPY_OVERLAP_BUFS )
+    {
+	copy_buf_t * cb = co.cbuf + idx;
+
+	u64 start = GetTimerUSec();
+	pthread_mutex_lock(&co.mutex);
+	while ( !cb->full && !co.eof )
+	    pthread_cond_wait(&co.cond,&co.mutex);
+	const bool full = cb->full;
+	if (!full)
+	    err = co.read_err;
+	pthread_mutex_unlock(&co.mutex);
+	cs->write_stall_usec += GetTimerUSec() - start;
+
+	if (!full)
+	    break;
+
+	if ( SIGINT_level > 1 )
+	{
+	    err = ERR_INTERRUPT;
+	    break;
+	}
+
+	start = GetTimerUSec();
+	err = sparse
+		? WriteSparseSF(out,cb->write_off,cb->data,cb->size)
+		: WriteSF(out,cb->write_off,cb->data,cb->size);
+	cs->write_usec += GetTimerUSec() - start;
+	if (err)
+	    break;
+
+	cs->n_blocks++;
+	if ( out->show_progress )
+	{
+	    pr_done += cb->size;
+	    PrintProgressSF(pr_done,pr_total,out);
+	}
+
+	pthread_mutex_lock(&co.mutex);
+	cb->full = false;
+	pthread_cond_signal(&co.cond);
+	pthread_mutex_unlock(&co.mutex);
+    }
+
+    pthread_mutex_lock(&co.mutex);
+    co.abort = true;
+    pthread_cond_signal(&co.cond);
+    pthread_mutex_unlock(&co.mutex);
+    pthread_join(thread,0);
+
+    cs->total_usec	= GetTimerUSec() - start_usec;
+    cs->read_usec	= co.read_usec;
+    cs->read_stall_usec	= co.read_stall_usec;
+
+ abort:
+    pthread_cond_destroy(&co.cond);
+    pthread_mutex_destroy(&co.mutex);
+    for ( idx = 0; idx < COPY_OVERLAP_BUFS; idx++ )
+	PutIOBuf(co.cbuf[idx].buf);
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct copy_usage_t
+{
+    int			idx;		// next index of 'wdisc_usage_tab'
+    int			max_sect;	// max number of sectors per region
+
+} copy_usage_t;
+
+//-----------------------------------------------------------------------------
+
+static bool copy_usage_region ( void * param, CopyRegion_t * reg )
+{
+    // copy runs of used sectors with the same usage id
+
+    copy_usage_t * cu = param;
+    DASSERT(cu);
+    DASSERT(reg);
+
+    int idx = cu->idx;
+    while ( idx < sizeof(wdisc_usage_tab) && !wdisc_usage_tab[idx] )
+	idx++;
+    if ( idx >= sizeof(wdisc_usage_tab) )
+    {
+	cu->idx = idx;
+	return false;
+    }
+
+    const u8 cur_id = wdisc_usage_tab[idx];
+    const int idx_end = idx + cu->max_sect < sizeof(wdisc_usage_tab)
+		      ? idx + cu->max_sect : sizeof(wdisc_usage_tab);
+    const int idx_begin = idx++;
+    while ( idx < idx_end && cur_id == wdisc_usage_tab[idx] )
+	idx++;
+    cu->idx = idx;
+
+    noPRINT("COPY: %5x .. %5x / %5x, n=%2x\n",idx_begin,idx,idx_end,idx-idx_begin);
+
+    reg->read_off = reg->write_off = (off_t)WII_SECTOR_SIZE * idx_begin;
+    reg->size = (u64)( idx - idx_begin ) * WII_SECTOR_SIZE;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 enumError CopySF ( SuperFile_t * in, SuperFile_t * out )
 {
     DASSERT(in);
@@ -3443,7 +3905,7 @@ enumError CopySF ( SuperFile_t * in, SuperFile_t * out )
 	    }
 
 	    int idx;
-	    u64 pr_done = 0, pr_total = 0;
+	    u64 pr_total = 0;
 	    if ( out->show_progress )
 	    {
 		for ( idx = 0; idx < sizeof(wdisc_usage_tab); idx++ )
@@ -3453,74 +3915,14 @@ enumError CopySF ( SuperFile_t * in, SuperFile_t * out )
 		PrintProgressSF(0,pr_total,out);
 	    }
 
- #if defined(TEST) && 0 // [[2do]] scheint nutzlos zu sein (test mit linux64)
-	    const int max_sect = sizeof(iobuf) / WII_SECTOR_SIZE;
-	    idx = 0;
-	    while ( idx < sizeof(wdisc_usage_tab) )
-	    {
-		const u8 cur_id = wdisc_usage_tab[idx];
-		if (!cur_id)
-		{
-		    idx++;
-		    continue;
-		}
-
-		if ( SIGINT_level > 1 )
-		    return ERR_INTERRUPT;
-
-		const int idx_end = idx + max_sect < sizeof(wdisc_usage_tab)
-				  ? idx + max_sect : sizeof(wdisc_usage_tab);
-		const int idx_begin = idx++;
-		while ( idx < idx_end && cur_id == wdisc_usage_tab[idx] )
-		    idx++;
-
-		noPRINT("COPY: %5x .. %5x / %5x, n=%2x\n",idx_begin,idx,idx_end,idx-idx_begin);
-
-		const off_t off = (off_t)WII_SECTOR_SIZE * idx_begin;
-		const size_t size = (size_t)( idx - idx_begin ) * WII_SECTOR_SIZE;
-		DASSERT( size <= sizeof(iobuf) );
-		enumError err = ReadSF(in,off,iobuf,size);
-		if (err)
-		    return err;
-
-		err = WriteSparseSF(out,off,iobuf,size);
-		if (err)
-		    return err;
-
-		if ( out->show_progress )
-		{
-		    pr_done += size;
-		    PrintProgressSF(pr_done,pr_total,out);
-		}
-	    }
- #else
-	    for ( idx = 0; idx < sizeof(wdisc_usage_tab); idx++ )
-	    {
-		const u8 cur_id = wdisc_usage_tab[idx];
-		if (cur_id)
-		{
-		    if ( SIGINT_level > 1 )
-			return ERR_INTERRUPT;
-
-		    noPRINT("COPY: %5x\n",idx);
-
-		    off_t off = (off_t)WII_SECTOR_SIZE * idx;
-		    enumError err = ReadSF(in,off,iobuf,WII_SECTOR_SIZE);
-		    if (err)
-			return err;
-
-		    err = WriteSparseSF(out,off,iobuf,WII_SECTOR_SIZE);
-		    if (err)
-			return err;
+	    copy_usage_t cu;
+	    cu.idx = 0;
+	    cu.max_sect = GetIOBufSize() / WII_SECTOR_SIZE;
+	    enumError err = OverlapCopySF( in, out, false, true, pr_total,
+						copy_usage_region, &cu );
+	    if (err)
+		return err;
 
-		    if ( out->show_progress )
-		    {
-			pr_done += WII_SECTOR_SIZE;
-			PrintProgressSF(pr_done,pr_total,out);
-		    }
-		}
-	    }
- #endif
 	    if ( out->show_progress || out->show_summary )
 		out->progress_summary = true; // delayed print after closing
 	    return ERR_OK;
@@ -3531,7 +3933,8 @@ enumError CopySF ( SuperFile_t * in, SuperFile_t * out )
     {
 	case OFT_WDF1:
 	case OFT_WDF2:	return CopyWDF(in,out);
-	case OFT_WIA:	return CopyWIA(in,out);
+	case OFT_WIA:
+	case OFT_RVZ:	return CopyWIA(in,out);
 	case OFT_WBFS:	return CopyWBFSDisc(in,out);
 	default:	return CopyRaw(in,out);
     }
@@ -3539,6 +3942,23 @@ enumError CopySF ( SuperFile_t * in, SuperFile_t * out )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static bool copy_raw_region ( void * param, CopyRegion_t * reg )
+{
+    off_t * copy_size = param;
+    DASSERT(copy_size);
+    DASSERT(reg);
+
+    if ( *copy_size <= 0 )
+	return false;
+
+    reg->read_off = reg->write_off = 0;
+    reg->size = *copy_size;
+    *copy_size = 0;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
 enumError CopyRaw ( SuperFile_t * in, SuperFile_t * out )
 {
     ASSERT(in);
@@ -3547,32 +3967,15 @@ enumError CopyRaw ( SuperFile_t * in, SuperFile_t * out )
     TRACE("+++ CopyRaw(%d,%d) +++\n",GetFD(&in->f),GetFD(&out->f));
 
     off_t copy_size = in->file_size;
-    off_t off       = 0;
-
     MarkMinSizeSF(out, opt_disc_size ? opt_disc_size : copy_size );
 
     if ( out->show_progress )
 	PrintProgressSF(0,in->file_size,out);
 
-    while ( copy_size > 0 )
-    {
-	if ( SIGINT_level > 1 )
-	    return ERR_INTERRUPT;
-
-	u32 size = sizeof(iobuf) < copy_size ? sizeof(iobuf) : (u32)copy_size;
-	enumError err = ReadSF(in,off,iobuf,size);
-	if (err)
-	    return err;
-
-	err = WriteSparseSF(out,off,iobuf,size);
-	if (err)
-	    return err;
-
-	copy_size -= size;
-	off       += size;
-	if ( out->show_progress )
-	    PrintProgressSF(off,in->file_size,out);
-    }
+    enumError err = OverlapCopySF( in, out, false, true, in->file_size,
+					copy_raw_region, &copy_size );
+    if (err)
+	return err;
 
     if ( out->show_progress || out->show_summary )
 	out->progress_summary = true;
@@ -3595,21 +3998,27 @@ enumError CopyRawData
     TRACE("+++ CopyRawData(%d,%d,%llx,%llx) +++\n",
 		GetFD(&in->f), GetFD(&out->f), (u64)off, (u64)copy_size );
 
+    u32 buf_size;
+    char * buf = GetIOBuf(&buf_size);
+    enumError err = ERR_OK;
+
     while ( copy_size > 0 )
     {
-	const u32 size = sizeof(iobuf) < copy_size ? sizeof(iobuf) : (u32)copy_size;
-	enumError err = ReadSF(in,off,iobuf,size);
+	const u32 size = buf_size < copy_size ? buf_size : (u32)copy_size;
+	err = ReadSF(in,off,buf,size);
 	if (err)
-	    return err;
+	    break;
 
-	err = WriteSF(out,off,iobuf,size);
+	err = WriteSF(out,off,buf,size);
 	if (err)
-	    return err;
+	    break;
 
 	copy_size -= size;
 	off       += size;
     }
-    return ERR_OK;
+
+    PutIOBuf(buf);
+    return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -3629,25 +4038,64 @@ enumError CopyRawData2
 		GetFD(&in->f), (u64)in_off,
 		GetFD(&out->f), (u64)out_off, (u64)copy_size );
 
+    u32 buf_size;
+    char * buf = GetIOBuf(&buf_size);
+    enumError err = ERR_OK;
+
     while ( copy_size > 0 )
     {
-	const u32 size = sizeof(iobuf) < copy_size ? (u32)sizeof(iobuf) : (u32)copy_size;
-	enumError err = ReadSF(in,in_off,iobuf,size);
+	const u32 size = buf_size < copy_size ? buf_size : (u32)copy_size;
+	err = ReadSF(in,in_off,buf,size);
 	if (err)
-	    return err;
+	    break;
+
+	err = WriteSF(out,out_off,buf,size);
+	if (err)
+	    break;
+
+	copy_size -= size;
+	in_off    += size;
+	out_off   += size;
+    }
+
+    PutIOBuf(buf);
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct copy_wdf_t
+{
+    wdf_controller_t	* wdf;		// valid WDF controller
+    int			chunk;		// index of next chunk
 
-	err = WriteSF(out,out_off,iobuf,size);
-	if (err)
-	    return err;
+} copy_wdf_t;
 
-	copy_size -= size;
-	in_off    += size;
-	out_off   += size;
+//-----------------------------------------------------------------------------
+
+static bool copy_wdf_region ( void * param, CopyRegion_t * reg )
+{
+    copy_wdf_t * cw = param;
+    DASSERT(cw);
+    DASSERT(reg);
+
+    while ( cw->chunk < cw->wdf->chunk_used )
+    {
+	wdf2_chunk_t *wc = cw->wdf->chunk + cw->chunk++;
+	if ( wc->data_size )
+	{
+	    TRACE("cp #%02d %09llx .. %09llx .. %09llx\n",
+			cw->chunk-1, wc->data_off, wc->data_size, wc->file_pos );
+	    reg->read_off  = wc->data_off;
+	    reg->write_off = wc->file_pos;
+	    reg->size      = wc->data_size;
+	    return true;
+	}
     }
-    return ERR_OK;
+    return false;
 }
 
-///////////////////////////////////////////////////////////////////////////////
+//-----------------------------------------------------------------------------
 
 enumError CopyWDF ( SuperFile_t * in, SuperFile_t * out )
 {
@@ -3665,7 +4113,7 @@ enumError CopyWDF ( SuperFile_t * in, SuperFile_t * out )
     if (err)
 	return err;
 
-    u64 pr_done = 0, pr_total = 0;
+    u64 pr_total = 0;
     if ( out->show_progress )
     {
 	int i;
@@ -3674,47 +4122,12 @@ enumError CopyWDF ( SuperFile_t * in, SuperFile_t * out )
 	PrintProgressSF(0,pr_total,out);
     }
 
-    int i;
-    for ( i = 0; i < wdf->chunk_used; i++ )
-    {
-	wdf2_chunk_t *wc = wdf->chunk + i;
-	if ( wc->data_size )
-	{
-	    u64 dest_off = wc->file_pos;
-	    u64 src_off  = wc->data_off;
-	    u64 size64   = wc->data_size;
-
-	    while ( size64 > 0 )
-	    {
-		if ( SIGINT_level > 1 )
-		    return ERR_INTERRUPT;
-
-		u32 size = sizeof(iobuf);
-		if ( size > size64 )
-		    size = (u32)size64;
-
-		TRACE("cp #%02d %09llx .. %07x .. %09llx\n",i,src_off,size,dest_off);
-
-		enumError err = ReadAtF(&in->f,src_off,iobuf,size);
-		if (err)
-		    return err;
-
-		err = WriteSF(out,dest_off,iobuf,size);
-		if (err)
-		    return err;
-
-		dest_off	+= size;
-		src_off		+= size;
-		size64		-= size;
-
-		if ( out->show_progress )
-		{
-		    pr_done += size;
-		    PrintProgressSF(pr_done,pr_total,out);
-		}
-	    }
-	}
-    }
+    copy_wdf_t cw;
+    cw.wdf   = wdf;
+    cw.chunk = 0;
+    err = OverlapCopySF(in,out,true,false,pr_total,copy_wdf_region,&cw);
+    if (err)
+	return err;
 
     if ( out->show_progress || out->show_summary )
 	out->progress_summary = true;
@@ -3749,6 +4162,45 @@ enumError CopyWIA ( SuperFile_t * in, SuperFile_t * out )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+typedef struct copy_wbfs_t
+{
+    wbfs_t		* wbfs;		// valid WBFS
+    u16			* wlba_tab;	// wlba table of disc
+    int			bl;		// next block index
+
+} copy_wbfs_t;
+
+//-----------------------------------------------------------------------------
+
+static bool copy_wbfs_region ( void * param, CopyRegion_t * reg )
+{
+    copy_wbfs_t * cw = param;
+    DASSERT(cw);
+    DASSERT(reg);
+
+    wbfs_t * w = cw->wbfs;
+    while ( cw->bl < w->n_wbfs_sec_per_disc )
+    {
+	const int bl = cw->bl++;
+	u32 wlba = ntohs(cw->wlba_tab[bl]);
+	if (wlba)
+	{
+	    reg->read_off  = (off_t)w->wbfs_sec_sz * wlba;
+	    reg->write_off = (off_t)w->wbfs_sec_sz * bl;
+
+	    // join blocks, that are contiguous on both sides
+	    while ( cw->bl < w->n_wbfs_sec_per_disc
+		    && ntohs(cw->wlba_tab[cw->bl]) == ++wlba )
+		cw->bl++;
+	    reg->size = (u64)w->wbfs_sec_sz * ( cw->bl - bl );
+	    return true;
+	}
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
 enumError CopyWBFSDisc ( SuperFile_t * in, SuperFile_t * out )
 {
     ASSERT(in);
@@ -3767,57 +4219,31 @@ enumError CopyWBFSDisc ( SuperFile_t * in, SuperFile_t * out )
     wbfs_t * w = in->wbfs->wbfs;
     ASSERT(w);
 
-    char * copybuf;
-    if ( w->wbfs_sec_sz <= sizeof(iobuf) )
-	 copybuf = iobuf;
-    else
-	copybuf = MALLOC(w->wbfs_sec_sz);
-
     MarkMinSizeSF(out, opt_disc_size ? opt_disc_size : in->file_size );
-    enumError err = ERR_OK;
 
-    u64 pr_done = 0, pr_total = 0;
+    u64 pr_total = 0;
     if ( out->show_progress )
     {
 	int bl;
 	for ( bl = 0; bl < w->n_wbfs_sec_per_disc; bl++ )
 	    if (ntohs(wlba_tab[bl]))
 		pr_total++;
-	pr_total *= WII_SECTOR_SIZE;
+	pr_total *= w->wbfs_sec_sz;
 	PrintProgressSF(0,pr_total,out);
     }
 
-    int bl;
-    for ( bl = 0; bl < w->n_wbfs_sec_per_disc; bl++ )
-    {
-	const u32 wlba = ntohs(wlba_tab[bl]);
-	if (wlba)
-	{
-	    err = ReadAtF( &in->f, (off_t)w->wbfs_sec_sz * wlba,
-				copybuf, w->wbfs_sec_sz );
-	    if (err)
-		goto abort;
-
-	    err = WriteSF( out, (off_t)w->wbfs_sec_sz * bl,
-				copybuf, w->wbfs_sec_sz );
-	    if (err)
-		goto abort;
-
-	    if ( out->show_progress )
-	    {
-		pr_done += WII_SECTOR_SIZE;
-		PrintProgressSF(pr_done,pr_total,out);
-	    }
-	}
-    }
+    copy_wbfs_t cw;
+    cw.wbfs	= w;
+    cw.wlba_tab	= wlba_tab;
+    cw.bl	= 0;
+    enumError err = OverlapCopySF(in,out,true,false,pr_total,copy_wbfs_region,&cw);
+    if (err)
+	return err;
 
     if ( out->show_progress || out->show_summary )
 	out->progress_summary = true;
 
- abort:
-    if ( copybuf != iobuf )
-	FREE(copybuf);
-    return err;
+    return ERR_OK;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -3830,22 +4256,28 @@ enumError AppendF
     TRACE("AppendF(%d,%d,%llx,%zx) +++\n",
 		GetFD(in), GetFD(&out->f), (u64)in_off, count );
 
+    u32 buf_size;
+    char * buf = GetIOBuf(&buf_size);
+    enumError err = ERR_OK;
+
     while ( count > 0 )
     {
-	const u32 size = sizeof(iobuf) < count ? sizeof(iobuf) : (u32)count;
-	enumError err = ReadAtF(in,in_off,iobuf,size);
-	TRACE_HEXDUMP16(3,in_off,iobuf,size<0x10?size:0x10);
+	const u32 size = buf_size < count ? buf_size : (u32)count;
+	err = ReadAtF(in,in_off,buf,size);
+	TRACE_HEXDUMP16(3,in_off,buf,size<0x10?size:0x10);
 	if (err)
-	    return err;
+	    break;
 
-	err = WriteSF(out,out->max_virt_off,iobuf,size);
+	err = WriteSF(out,out->max_virt_off,buf,size);
 	if (err)
-	    return err;
+	    break;
 
 	count  -= size;
 	in_off += size;
     }
-    return ERR_OK;
+
+    PutIOBuf(buf);
+    return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -3858,25 +4290,31 @@ enumError AppendSparseF
     TRACE("AppendSparseF(%d,%d,%llx,%zx) +++\n",
 		GetFD(in), GetFD(&out->f), (u64)in_off, count );
 
+    u32 buf_size;
+    char * buf = GetIOBuf(&buf_size);
+    enumError err = ERR_OK;
+
     while ( count > 0 )
     {
-	const u32 size = sizeof(iobuf) < count ? sizeof(iobuf) : (u32)count;
-	enumError err = ReadAtF(in,in_off,iobuf,size);
-	TRACE_HEXDUMP16(3,in_off,iobuf,size<0x10?size:0x10);
+	const u32 size = buf_size < count ? buf_size : (u32)count;
+	err = ReadAtF(in,in_off,buf,size);
+	TRACE_HEXDUMP16(3,in_off,buf,size<0x10?size:0x10);
 	if (err)
-	    return err;
+	    break;
 
 	noPRINT(" - %9llx -> %9llx, size=%8x/%9zx\n",
 		in_off, out->max_virt_off, size, count );
-	//err = WriteSparseSF(out,out->max_virt_off,iobuf,size); // [wdf-cat] [[obsolete]]
-	err = WriteSparseSF(out,out->file_size,iobuf,size);
+	//err = WriteSparseSF(out,out->max_virt_off,buf,size); // [wdf-cat] [[obsolete]]
+	err = WriteSparseSF(out,out->file_size,buf,size);
 	if (err)
-	    return err;
+	    break;
 
 	count  -= size;
 	in_off += size;
     }
-    return ERR_OK;
+
+    PutIOBuf(buf);
+    return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -3889,22 +4327,28 @@ enumError AppendSF
     TRACE("AppendSF(%d,%d,%llx,%zx) +++\n",
 		GetFD(&in->f), GetFD(&out->f), (u64)in_off, count );
 
+    u32 buf_size;
+    char * buf = GetIOBuf(&buf_size);
+    enumError err = ERR_OK;
+
     while ( count > 0 )
     {
-	const u32 size = sizeof(iobuf) < count ? sizeof(iobuf) : (u32)count;
-	enumError err = ReadSF(in,in_off,iobuf,size);
-	TRACE_HEXDUMP16(3,in_off,iobuf,size<0x10?size:0x10);
+	const u32 size = buf_size < count ? buf_size : (u32)count;
+	err = ReadSF(in,in_off,buf,size);
+	TRACE_HEXDUMP16(3,in_off,buf,size<0x10?size:0x10);
 	if (err)
-	    return err;
+	    break;
 
-	err = WriteSF(out,out->max_virt_off,iobuf,size);
+	err = WriteSF(out,out->max_virt_off,buf,size);
 	if (err)
-	    return err;
+	    break;
 
 	count  -= size;
 	in_off += size;
     }
-    return ERR_OK;
+
+    PutIOBuf(buf);
+    return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -4701,8 +5145,8 @@ enumError DiffSF
 	PrintProgressSF(0,pr_total,f2);
     }
 
-    ASSERT( sizeof(iobuf) >= 2*WII_SECTOR_SIZE );
-    char *iobuf1 = iobuf, *iobuf2 = iobuf + WII_SECTOR_SIZE;
+    char *iobuf1 = GetIOBuf(0), *iobuf2 = iobuf1 + WII_SECTOR_SIZE;
+    DASSERT( GetIOBufSize() >= 2*WII_SECTOR_SIZE );
 
     const int ptab_index1 = wd_get_ptab_sector(disc1);
     const int ptab_index2 = wd_get_ptab_sector(disc2);
@@ -4715,19 +5159,23 @@ enumError DiffSF
 	for ( idx = 0; idx < sizeof(wdisc_usage_tab); idx++ )
 	{
 	    if ( SIGINT_level > 1 )
+	    {
+		PutIOBuf(iobuf1);
 		return ERR_INTERRUPT;
+	    }
 
 	    if ( ( idx >= next_idx || have_mod_list ) && wdisc_usage_tab[idx] )
 	    {
 		off_t off = (off_t)WII_SECTOR_SIZE * idx;
 		TRACE(" - DIFF BLOCK #%u (off=%llx).\n",idx,(u64)off);
 		enumError err = ReadSF(f1,off,iobuf1,WII_SECTOR_SIZE);
+		if (!err)
+		    err = ReadSF(f2,off,iobuf2,WII_SECTOR_SIZE);
 		if (err)
+		{
+		    PutIOBuf(iobuf1);
 		    return err;
-
-		err = ReadSF(f2,off,iobuf2,WII_SECTOR_SIZE);
-		if (err)
-		    return err;
+		}
 
 		if ( idx >= next_idx )
 		{
@@ -4757,6 +5205,7 @@ enumError DiffSF
 	UpdateSignatureFST(f1->fst); // NULL allowed
 	UpdateSignatureFST(f2->fst); // NULL allowed
     }
+    PutIOBuf(iobuf1);
 
  abort:
     CloseDiffSource(diff,print_sections>0);
@@ -4805,9 +5254,12 @@ enumError DiffRawSF
 		? f1->file_size : f2->file_size;
     }
 
-    const size_t io_size = sizeof(iobuf)/2;
+    u32 buf_size;
+    char *iobuf1 = GetIOBuf(&buf_size);
+    const size_t io_size = buf_size/2;
     ASSERT( (io_size&511) == 0 );
-    char *iobuf1 = iobuf, *iobuf2 = iobuf + io_size;
+    char *iobuf2 = iobuf1 + io_size;
+    enumError err = ERR_OK;
 
     if ( f2->show_progress )
 	PrintProgressSF(0,max_off,f2);
@@ -4816,7 +5268,10 @@ enumError DiffRawSF
     for(;;)
     {
 	if (SIGINT_level>1)
-	    return ERR_INTERRUPT;
+	{
+	    err = ERR_INTERRUPT;
+	    break;
+	}
 
 	off = UnionDataBlockSF(f1,f2,off,HD_BLOCK_SIZE,0);
 	if ( off >= max_off )
@@ -4825,13 +5280,12 @@ enumError DiffRawSF
 	const off_t  max_size = max_off - off;
 	const size_t cmp_size = io_size < max_size ? io_size : (size_t)max_size;
 
-	enumError err;
 	err = ReadSF(f1,off,iobuf1,cmp_size);
 	if (err)
-	    return err;
+	    break;
 	err = ReadSF(f2,off,iobuf2,cmp_size);
 	if (err)
-	    return err;
+	    break;
 
 	if (!DiffData(diff,off,cmp_size,iobuf1,iobuf2,0))
 	    break;
@@ -4840,6 +5294,9 @@ enumError DiffRawSF
 	    PrintProgressSF(off,max_off,f2);
 	off = diff->next_off;
     }
+    PutIOBuf(iobuf1);
+    if (err)
+	return err;
 
 abort:
     CloseDiffSource(diff,print_sections>0);
@@ -4892,9 +5349,10 @@ enumError DiffFilesSF
 
     enumError err = ERR_OK;
 
-    const int BUF_SIZE = sizeof(iobuf) / 2;
-    char * buf1 = iobuf;
-    char * buf2 = iobuf + BUF_SIZE;
+    u32 buf_size;
+    char * buf1 = GetIOBuf(&buf_size);
+    const u32 BUF_SIZE = buf_size / 2;
+    char * buf2 = buf1 + BUF_SIZE;
 
     u64 done_count = 0, total_count = 0;
     f1->progress_verb = f2->progress_verb = "compared";
@@ -4986,7 +5444,10 @@ enumError DiffFilesSF
 	while ( file1 < end1 && file2 < end2 )
 	{
 	    if (SIGINT_level>1)
+	    {
+		PutIOBuf(buf1);
 		return ERR_INTERRUPT;
+	    }
 
 	    if ( f2->show_progress )
 		PrintProgressSF(done_count,total_count,f2);
@@ -5040,8 +5501,8 @@ enumError DiffFilesSF
 		while ( size > 0 )
 		{
 		    const u32 read_size = size < BUF_SIZE ? size : BUF_SIZE;
-		    if (   ReadFileFST(p1,file1,off,buf1,read_size)
-			|| ReadFileFST(p2,file2,off,buf2,read_size) )
+		    if (   ReadFileFST(0,p1,file1,off,buf1,read_size)
+			|| ReadFileFST(0,p2,file2,off,buf2,read_size) )
 		    {
 			err = ERR_READ_FAILED;
 			goto abort_source;
@@ -5076,6 +5537,7 @@ enumError DiffFilesSF
     }
 
 abort_source:
+    PutIOBuf(buf1);
     CloseDiffSource(diff,print_sections>0);
     ResetFST(&fst1);
     ResetFST(&fst2);
@@ -5594,8 +6056,8 @@ enumError oldDiffFilesSF
 		    while ( size > 0 )
 		    {
 			const u32 read_size = size < BUF_SIZE ? size : BUF_SIZE;
-			if (   ReadFileFST4(p1,file1,off4,buf1,read_size)
-			    || ReadFileFST4(p2,file2,off4,buf2,read_size) )
+			if (   ReadFileFST4(0,p1,file1,off4,buf1,read_size)
+			    || ReadFileFST4(0,p2,file2,off4,buf2,read_size) )
 			{
 			    err = ERR_READ_FAILED;
 			    goto abort;
@@ -5660,6 +6122,30 @@ static StringField_t dir_done_list;
 static StringField_t file_done_list;
 int opt_source_auto = 0;
 
+//-----------------------------------------------------------------------------
+// While scanning a directory, worker threads probe the next entries in
+// advance by stat() and by reading the file header. The scanner itself
+// works as before in the same order, but finds the data in the caches
+// of the operating system. This hides the latency of network file systems.
+
+#define SCAN_AHEAD_FACTOR	4	// number of entries per thread in advance
+#define SCAN_PROBE_SIZE	   0x10000	// number of bytes to read for a probe
+
+typedef struct ScanEntry_t
+{
+    ThreadJob_t		job;		// the probe job
+    bool		started;	// true: 'job' was added to the pool
+    bool		probe_dir;	// true: read directories too
+    volatile bool	scanned;	// true: scanner reached the entry, skip probe
+    char		path[];		// full path of the directory entry
+
+} ScanEntry_t;
+
+static ThreadPool_t scan_pool;
+static uint scan_ahead = 0;		// >0: number of entries to probe in advance
+static uint scan_users = 0;		// number of active source iterators
+static bool scan_pool_active = false;	// true: 'scan_pool' is initialized
+
 //-----------------------------------------------------------------------------
 
 void InitializeIterator ( Iterator_t * it )
@@ -5785,6 +6271,181 @@ static void IteratorProgress
 
 //-----------------------------------------------------------------------------
 
+static void ProbeScanEntry ( ThreadJob_t * job )
+{
+    DASSERT(job);
+    const ScanEntry_t * se = job->param;
+    DASSERT(se);
+
+    struct stat st;
+    if ( se->scanned || stat(se->path,&st) )
+	return;
+
+    if (S_ISREG(st.st_mode))
+    {
+	const int fd = open(se->path,O_RDONLY);
+	if ( fd >= 0 )
+	{
+	    char buf[SCAN_PROBE_SIZE];
+	    if ( !se->scanned && read(fd,buf,sizeof(buf)) < 0 )
+		TRACE("PROBE FAILED: %s\n",se->path);
+	    close(fd);
+	}
+    }
+    else if ( S_ISDIR(st.st_mode) && se->probe_dir )
+    {
+	DIR * dir = opendir(se->path);
+	if (dir)
+	{
+	    while ( !se->scanned && readdir(dir) )
+		;
+	    closedir(dir);
+	}
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static void StartScanProbes
+(
+    ScanEntry_t		** list,	// list of directory entries
+    uint		n_list,		// number of elements of 'list'
+    uint		idx,		// index of the entry to scan next
+    uint		* next_probe	// index of the next entry to probe
+)
+{
+    DASSERT(list);
+    DASSERT(next_probe);
+
+    if (!scan_ahead)
+	return;
+
+    if (!scan_pool_active)
+    {
+	scan_pool_active = true;
+	InitializeThreadPool(&scan_pool,GetScanThreadCount());
+    }
+
+    uint np = *next_probe;
+    if ( np <= idx )
+	np = idx + 1;
+    for ( ; np < n_list && np <= idx + scan_ahead; np++ )
+    {
+	ScanEntry_t * se = list[np];
+	se->started = true;
+	AddThreadJob(&scan_pool,&se->job,ProbeScanEntry,se);
+    }
+    *next_probe = np;
+}
+
+//-----------------------------------------------------------------------------
+
+static enumError SourceIteratorHelper
+	( Iterator_t * it, ccp path, bool collect_fnames );
+
+//-----------------------------------------------------------------------------
+
+static int CheckCachedDisc
+	( Iterator_t * it, const WDiscListItem_t * item, const struct stat * st )
+{
+    // Apply the filters of SourceIteratorHelper() to a cached disc.
+    // Return 1 to accept, 0 to ignore and -1 if a warning is needed.
+
+    ASSERT(it);
+    ASSERT(item);
+    ASSERT(st);
+
+    if ( it->act_open < ACT_ALLOW
+		&& st->st_dev == it->open_dev
+		&& st->st_ino == it->open_ino )
+	return -1;
+
+    enumAction action = ACT_ALLOW;
+    if ( item->ftype & FT_A_WDISC && it->act_wbfs_disc < ACT_ALLOW )
+	action = it->act_wbfs_disc;
+    else if ( item->ftype & FT__SPC_MASK )
+	action = it->act_non_iso > it->act_known ? it->act_non_iso : it->act_known;
+    else if ( item->ftype & FT_ID_GC_ISO )
+	action = it->act_gc;
+    else if (!*item->id6)
+	action = item->ftype & FT_ID_WBFS ? it->act_wbfs : it->act_non_iso;
+
+    return action >= ACT_ALLOW ? 1 : action == ACT_WARN ? -1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+static enumError SourceIteratorCache
+	( Iterator_t * it, ccp path, const struct stat * st )
+{
+    // Call 'it->cache_func' for each cached disc of a regular file.
+    // If the file is not cached, scan it and record its discs.
+
+    ASSERT(it);
+    ASSERT(it->cache_func);
+    ASSERT(path);
+    ASSERT(st);
+
+    DiscCache_t * dc = it->disc_cache;
+    ASSERT(dc);
+
+    char real_path[PATH_MAX];
+    if (!realpath(path,real_path))
+	StringCopyS(real_path,sizeof(real_path),path);
+
+    const DiscCacheEntry_t * e = FindDiscCache(dc,real_path,st);
+    const DiscCacheItem_t *ci, *ci_end = e ? e->item + e->n_item : 0;
+    if (e)
+    {
+	// rescan the file, if any message must be printed
+	for ( ci = e->item; ci < ci_end; ci++ )
+	    if ( CheckCachedDisc(it,&ci->item,st) < 0 )
+	    {
+		e = 0;
+		break;
+	    }
+    }
+
+    if (!e)
+    {
+	dc->n_miss++;
+	BeginDiscCache(dc,path,real_path,st);
+	it->num_of_scans--; // counted again by SourceIteratorHelper()
+	const enumError err = SourceIteratorHelper(it,path,false);
+	EndDiscCache(dc);
+	return err;
+    }
+
+    dc->n_hit++;
+    enumError err = ERR_OK;
+    for ( ci = e->item;
+	  !err && ci < ci_end && SIGINT_level < 2 && it->num_of_files < job_limit;
+	  ci++ )
+    {
+	const WDiscListItem_t * item = &ci->item;
+	if (!CheckCachedDisc(it,item,st))
+	    continue;
+
+	char fname[PATH_MAX+20], rpath[PATH_MAX+20];
+	StringCat2S(fname,sizeof(fname),path,ci->fname_suffix);
+	StringCat2S(rpath,sizeof(rpath),real_path,ci->rpath_suffix);
+
+	if ( InsertStringField(&file_done_list,rpath,false)
+	    && ( !*item->id6 || !IsExcluded(item->id6) ))
+	{
+	    it->real_path = rpath;
+	    it->num_of_files++;
+	    IteratorProgress(it,false,0);
+	    err = it->cache_func(it,item,fname,ci->have_path?path:0);
+	    it->real_path = 0;
+	}
+    }
+
+    return err ? err : SIGINT_level ? ERR_INTERRUPT : ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
 static enumError SourceIteratorHelper
 	( Iterator_t * it, ccp path, bool collect_fnames )
 {
@@ -5859,6 +6520,32 @@ static enumError SourceIteratorHelper
 		if ( dest > buf && dest[-1] != '/' )
 		    *dest++ = '/';
 
+		// read the whole directory first to probe entries in advance
+		ScanEntry_t ** list = 0;
+		uint idx, n_list = 0, list_size = 0, next_probe = 0;
+		for(;;)
+		{
+		    struct dirent * dent = readdir(dir);
+		    if (!dent)
+			break;
+		    if ( dent->d_name[0] != '.' )
+		    {
+			if ( n_list == list_size )
+			{
+			    list_size = 2 * list_size + 100;
+			    list = REALLOC(list,list_size*sizeof(*list));
+			}
+			StringCopyE(dest,bufend,dent->d_name);
+			const uint len = strlen(buf) + 1;
+			ScanEntry_t * se = MALLOC(sizeof(*se)+len);
+			memset(se,0,sizeof(*se));
+			memcpy(se->path,buf,len);
+			se->probe_dir = it->depth + 1 < it->max_depth;
+			list[n_list++] = se;
+		    }
+		}
+		closedir(dir);
+
 		it->depth++;
 
 		const enumAction act_non_exist	= it->act_non_exist;
@@ -5869,24 +6556,28 @@ static enumError SourceIteratorHelper
 		if ( it->act_gc == ACT_WARN )
 		     it->act_gc = ACT_IGNORE;
 
-		while ( !err && SIGINT_level < 2 && it->num_of_files < job_limit )
+		for ( idx = 0;
+		      idx < n_list && !err && SIGINT_level < 2 && it->num_of_files < job_limit;
+		      idx++ )
 		{
-		    struct dirent * dent = readdir(dir);
-		    if (!dent)
-			break;
-		    ccp n = dent->d_name;
-		    if ( n[0] != '.' )
-		    {
-			StringCopyE(dest,bufend,dent->d_name);
-			err = SourceIteratorHelper(it,buf,collect_fnames);
-		    }
+		    StartScanProbes(list,n_list,idx,&next_probe);
+		    list[idx]->scanned = true;
+		    err = SourceIteratorHelper(it,list[idx]->path,collect_fnames);
 		}
-		closedir(dir);
 
 		it->act_non_exist = act_non_exist;
 		it->act_non_iso   = act_non_iso;
 		it->act_gc	  = act_gc;
 		it->depth--;
+
+		for ( idx = 0; idx < n_list; idx++ )
+		{
+		    list[idx]->scanned = true;
+		    if (list[idx]->started)
+			WaitThreadJob(&scan_pool,&list[idx]->job);
+		    FREE(list[idx]);
+		}
+		FREE(list);
 	    }
 	}
 	ResetSF(&sf,0);
@@ -5895,6 +6586,14 @@ static enumError SourceIteratorHelper
 
     //----- file part
 
+    if ( it->disc_cache && !it->disc_cache->pending
+	&& !collect_fnames && !it->scan_progress && S_ISREG(sf.f.st.st_mode) )
+    {
+	const struct stat st = sf.f.st;
+	ResetSF(&sf,0);
+	return SourceIteratorCache(it,path,&st);
+    }
+
  check_file:
     sf.f.disable_errors = it->act_non_exist != ACT_WARN;
     err = OpenSF(&sf,path,it->act_non_iso||it->act_wbfs>=ACT_ALLOW,it->open_modify);
@@ -6012,6 +6711,16 @@ static enumError SourceIteratorHelper
 				: MALLOC(sizeof(discbuf));
 	    memcpy(disc_table,wbfs.wbfs->head->disc_table,max_disc);
 
+	    if ( it->disc_cache && it->disc_cache->pending )
+	    {
+		// all discs of the WBFS are recorded as one cache entry
+		uint n = 0;
+		for ( slot = 0; slot < max_disc; slot++ )
+		    if (disc_table[slot])
+			n++;
+		it->disc_cache->pend_expected = n;
+	    }
+
 	    ResetWBFS(&wbfs);
 	    ResetSF(&sf,0);
 
@@ -6131,6 +6840,12 @@ enumError SourceIterator
     InitializeStringField(&dir_done_list);
     InitializeStringField(&file_done_list);
 
+    if (!scan_users++)
+    {
+	const uint n_threads = GetScanThreadCount();
+	scan_ahead = n_threads > 1 ? n_threads * SCAN_AHEAD_FACTOR : 0;
+    }
+
     ccp *ptr, *end;
     enumError err = ERR_OK;
 
@@ -6187,6 +6902,12 @@ enumError SourceIterator
     ResetStringField(&dir_done_list);
     ResetStringField(&file_done_list);
 
+    if ( !--scan_users && scan_pool_active )
+    {
+	ResetThreadPool(&scan_pool);
+	scan_pool_active = false;
+    }
+
     return warning_mode > 0
 		? SourceIteratorWarning(it,err,warning_mode==1)
 		: err;
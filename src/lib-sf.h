@@ -89,6 +89,22 @@ typedef struct IOData_t
 
 } IOData_t;
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			struct CopyStat_t		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct CopyStat_t
+{
+    u64		total_usec;		// elapsed time of copy, 0: not overlapped
+    u64		read_usec;		// time used by the reader
+    u64		write_usec;		// time used by the writer
+    u64		read_stall_usec;	// time the reader waited for a free buffer
+    u64		write_stall_usec;	// time the writer waited for data
+    u32		n_blocks;		// number of copied blocks
+
+} CopyStat_t;
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			struct SuperFile_t		///////////////
@@ -126,6 +142,7 @@ typedef struct SuperFile_t
 	u64  progress_last_total;	// last p_total value of PrintProgressSF() call
 	u64  progress_data_size;	// value of DefineProgressChunkSF() call
 	u64  progress_chunk_size;	// value of DefineProgressChunkSF() call
+	CopyStat_t copy_stat;		// statistics of last OverlapCopySF() call
 
 	// internal values: file handling
 
@@ -326,6 +343,10 @@ enumError ReadDirectSF	( SuperFile_t * sf, off_t off, void * buf, size_t count )
 enumError ReadISO	( SuperFile_t * sf, off_t off, void * buf, size_t count );
 enumError ReadWBFS	( SuperFile_t * sf, off_t off, void * buf, size_t count );
 
+// zero copy alternative to ReadSF() for unpatched ISO and WDF images:
+// returns a pointer into the file mapping (option --io 32) or NULL
+const void * GetMappedSF ( SuperFile_t * sf, off_t off, size_t count );
+
 enumError WriteSF	( SuperFile_t * sf, off_t off, const void * buf, size_t count );
 enumError WriteSparseSF	( SuperFile_t * sf, off_t off, const void * buf, size_t count );
 enumError WriteISO	( SuperFile_t * sf, off_t off, const void * buf, size_t count );
@@ -491,6 +512,34 @@ enumError ExtractImage
     bool		preserve	// true: copy time to extracted files
 );
 
+// overlapped copy: a reader thread fills the next buffer
+// while the main thread writes the current one
+
+typedef struct CopyRegion_t
+{
+    off_t	read_off;		// source offset
+    off_t	write_off;		// destination offset
+    u64		size;			// size, split into blocks of GetIOBufSize()
+
+} CopyRegion_t;
+
+typedef bool (*CopyRegionFunc)
+(
+    void		* param,	// user defined parameter
+    CopyRegion_t	* region	// store the next region here
+);					// returns false if no more regions
+
+enumError OverlapCopySF
+(
+    SuperFile_t		* in,		// valid input file
+    SuperFile_t		* out,		// valid output file
+    bool		read_raw,	// true: ReadAtF(&in->f), false: ReadSF(in)
+    bool		sparse,		// true: WriteSparseSF(), false: WriteSF()
+    u64			pr_total,	// total for progress, if 'out->show_progress'
+    CopyRegionFunc	next_region,	// get next region to copy
+    void		* param		// user defined parameter of 'next_region'
+);
+
 // copy functions
 enumError CopySF  ( SuperFile_t * in, SuperFile_t * out );
 enumError CopyRaw ( SuperFile_t * in, SuperFile_t * out );
@@ -45,6 +45,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 
 #if defined(__CYGWIN__)
   #include <cygwin/fs.h>
@@ -60,6 +61,7 @@
 #include "lib-sf.h"
 #include "lib-bzip2.h"
 #include "lib-lzma.h"
+#include "lib-zstd.h"
 #include "wbfs-interface.h"
 #include "crypt.h"
 #include "titles.h"
@@ -663,6 +665,7 @@ void SetupLib ( int argc, char ** argv, ccp p_progname, enumProgID prid )
 void CloseAll()
 {
     CloseWBFSCache();
+    ResetIOBufPool();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -768,6 +771,7 @@ ccp GetErrorName ( int stat )
 	case ERR_WIA_INVALID:		return "INVALID WIA";
 	case ERR_BZIP2:			return "BZIP2 ERROR";
 	case ERR_LZMA:			return "LZMA ERROR";
+	case ERR_ZSTD:			return "ZSTD ERROR";
 
 	case ERR_ALREADY_EXISTS:	return "FILE ALREADY EXISTS";
 	case ERR_CANT_OPEN:		return "CAN'T OPEN FILE";
@@ -835,6 +839,7 @@ ccp GetErrorText ( int stat )
 	case ERR_WIA_INVALID:		return "File is an invalid WIA";
 	case ERR_BZIP2:			return "A bzip2 error occurred";
 	case ERR_LZMA:			return "A lzma error occurred";
+	case ERR_ZSTD:			return "A zstd error occurred";
 
 	case ERR_ALREADY_EXISTS:	return "File already exists";
 	case ERR_CANT_OPEN:		return "Can't open file";
@@ -1129,6 +1134,20 @@ u32 GetTimerMSec()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+u64 GetTimerUSec()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+
+    static time_t timebase = 0;
+    if (!timebase)
+	timebase = ts.tv_sec;
+
+    return (u64)( ts.tv_sec - timebase ) * 1000000 + ts.tv_nsec/1000;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 ccp PrintMSec ( char * buf, int bufsize, u32 msec, bool PrintMSec )
 {
     if (PrintMSec)
@@ -2696,6 +2715,7 @@ static wd_compression_t ScanCompression_helper
 	{ WD_COMPR_BZIP2,	"BZIP2",	"BZ2",	0 },
 	{ WD_COMPR_LZMA,	"LZMA",		"LZ",	0 },
 	{ WD_COMPR_LZMA2,	"LZMA2",	"LZ2",	0 },
+	{ WD_COMPR_ZSTD,	"ZSTD",		"ZST",	0 },
 
 	{ WD_COMPR__DEFAULT,	"DEFAULT",	"D",	0 },
 	{ WD_COMPR__FAST,	"FAST",		"F",	0x300 + 10 },
@@ -2903,6 +2923,14 @@ wd_compression_t ScanCompression
 	    case WD_COMPR_LZMA2:
 		*level = CalcCompressionLevelLZMA(*level);
 		break;
+
+	    case WD_COMPR_ZSTD:
+	     #ifdef HAVE_ZSTD
+		*level = CalcCompressionLevelZSTD(*level);
+	     #else
+		*level = 0;
+	     #endif
+		break;
 	}
     }
 
@@ -2933,6 +2961,20 @@ int ScanOptCompression
     return 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+int CheckOptCompression()
+{
+    // called after all options are scanned
+
+    if ( output_file_type == OFT_RVZ && opt_compr_method == WD_COMPR_PURGE )
+    {
+	ERROR0(ERR_SYNTAX,"Compression method PURGE is not allowed for RVZ.\n");
+	return 1;
+    }
+    return 0;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			scan mem option			///////////////
@@ -3019,6 +3061,143 @@ u64 GetMemLimit()
     return opt_mem;
 }
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			I/O buffer pool			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 opt_iobuf_size = 0;
+
+typedef struct iobuf_head_t
+{
+    void		* alloc;	// pointer returned by MALLOC()
+    u32			size;		// size of buffer
+    struct iobuf_head_t	* next;		// next unused buffer of pool
+
+} iobuf_head_t;
+
+// the head is stored in front of the aligned buffer
+#define IOBUF_HEAD_SIZE ALIGN32(sizeof(iobuf_head_t),16)
+
+static pthread_mutex_t	iobuf_mutex = PTHREAD_MUTEX_INITIALIZER;
+static iobuf_head_t	* iobuf_pool = 0;	// list with unused buffers
+static uint		iobuf_pool_count = 0;	// number of buffers in 'iobuf_pool'
+
+///////////////////////////////////////////////////////////////////////////////
+
+int ScanOptIOBuf
+(
+    ccp			arg		// argument to scan
+)
+{
+    u64 num;
+    enumError err = ScanSizeOptU64
+			( &num,		// u64 * num,
+			  arg,		// ccp source,
+			  MiB,		// u64 default_factor1,
+			  0,		// int force_base,
+			  "iobuf",	// ccp opt_name,
+			  0,		// u64 min,
+			  IOBUF_MAX_SIZE,// u64 max,
+			  IOBUF_ALIGN,	// u32 multiple,
+			  0,		// u32 pow2,
+			  true		// bool print_err
+			);
+
+    if (err)
+	return 1;
+
+    opt_iobuf_size = num && num < IOBUF_MIN_SIZE ? IOBUF_MIN_SIZE : num;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+u32 GetIOBufSize()
+{
+    return opt_iobuf_size ? opt_iobuf_size : IOBUF_SIZE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void * GetIOBuf
+(
+    u32			* size		// not NULL: store the buffer size
+)
+{
+    const u32 buf_size = GetIOBufSize();
+    if (size)
+	*size = buf_size;
+
+    iobuf_head_t * head = 0;
+    pthread_mutex_lock(&iobuf_mutex);
+    while (iobuf_pool)
+    {
+	head = iobuf_pool;
+	iobuf_pool = head->next;
+	iobuf_pool_count--;
+	if ( head->size == buf_size )
+	    break;
+
+	// size changed => drop buffer
+	FREE(head->alloc);
+	head = 0;
+    }
+    pthread_mutex_unlock(&iobuf_mutex);
+
+    if (!head)
+    {
+	char * alloc = MALLOC( buf_size + IOBUF_HEAD_SIZE + IOBUF_ALIGN );
+	char * buf = (char*)ALIGN64( (u64)(uintptr_t)alloc + IOBUF_HEAD_SIZE, IOBUF_ALIGN );
+	head = (iobuf_head_t*)( buf - IOBUF_HEAD_SIZE );
+	head->alloc = alloc;
+	head->size  = buf_size;
+    }
+
+    head->next = 0;
+    return (char*)head + IOBUF_HEAD_SIZE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PutIOBuf
+(
+    void		* buf		// NULL or buffer returned by GetIOBuf()
+)
+{
+    if (buf)
+    {
+	iobuf_head_t * head = (iobuf_head_t*)( (char*)buf - IOBUF_HEAD_SIZE );
+	pthread_mutex_lock(&iobuf_mutex);
+	if ( iobuf_pool_count < IOBUF_POOL_MAX )
+	{
+	    head->next = iobuf_pool;
+	    iobuf_pool = head;
+	    iobuf_pool_count++;
+	    head = 0;
+	}
+	pthread_mutex_unlock(&iobuf_mutex);
+
+	if (head)
+	    FREE(head->alloc);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResetIOBufPool()
+{
+    pthread_mutex_lock(&iobuf_mutex);
+    while (iobuf_pool)
+    {
+	iobuf_head_t * head = iobuf_pool;
+	iobuf_pool = head->next;
+	FREE(head->alloc);
+    }
+    iobuf_pool_count = 0;
+    pthread_mutex_unlock(&iobuf_mutex);
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			 CommandTab_t			///////////////
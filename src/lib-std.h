@@ -169,9 +169,11 @@ enumError CheckEnvOptions ( ccp varname, check_opt_func );
  #define SeekF(f,o)		XSeekF		(__FUNCTION__,__FILE__,__LINE__,f,o)
  #define SetSizeF(f,s)		XSetSizeF	(__FUNCTION__,__FILE__,__LINE__,f,s)
  #define PreallocateF(f,o,s)	XPreallocateF	(__FUNCTION__,__FILE__,__LINE__,f,o,s)
+ #define SyncF(f)		XSyncF		(__FUNCTION__,__FILE__,__LINE__,f)
  #define ReadF(f,b,c)		XReadF		(__FUNCTION__,__FILE__,__LINE__,f,b,c)
  #define WriteF(f,b,c)		XWriteF		(__FUNCTION__,__FILE__,__LINE__,f,b,c)
  #define ReadAtF(f,o,b,c)	XReadAtF	(__FUNCTION__,__FILE__,__LINE__,f,o,b,c)
+ #define ReadVecAtF(f,o,v,n)	XReadVecAtF	(__FUNCTION__,__FILE__,__LINE__,f,o,v,n)
  #define WriteAtF(f,o,b,c)	XWriteAtF	(__FUNCTION__,__FILE__,__LINE__,f,o,b,c)
  #define WriteZeroAtF(f,o,c)	XWriteZeroAtF	(__FUNCTION__,__FILE__,__LINE__,f,o,c)
  #define ZeroAtF(f,o,c)		XZeroAtF	(__FUNCTION__,__FILE__,__LINE__,f,o,c)
@@ -208,9 +210,11 @@ enumError CheckEnvOptions ( ccp varname, check_opt_func );
  #define SeekF(f,o)		XSeekF		(f,o)
  #define SetSizeF(f,s)		XSetSizeF	(f,s)
  #define PreallocateF(f,o,s)	XPreallocateF	(f,o,s)
+ #define SyncF(f)		XSyncF		(f)
  #define ReadF(f,b,c)		XReadF		(f,b,c)
  #define WriteF(f,b,c)		XWriteF		(f,b,c)
  #define ReadAtF(f,o,b,c)	XReadAtF	(f,o,b,c)
+ #define ReadVecAtF(f,o,v,n)	XReadVecAtF	(f,o,v,n)
  #define WriteAtF(f,o,b,c)	XWriteAtF	(f,o,b,c)
  #define WriteZeroAtF(f,o,c)	XWriteZeroAtF	(f,o,c)
  #define ZeroAtF(f,o,c)		XZeroAtF	(f,o,c)
@@ -239,6 +243,7 @@ int GetTermWidthFD ( int fd, int default_value, int min_value );
 ///////////////////////////////////////////////////////////////////////////////
 
 u32 GetTimerMSec();
+u64 GetTimerUSec(); // monotonic, for measuring durations
 ccp PrintMSec ( char * buf, int bufsize, u32 msec, bool PrintMSec );
 
 //
@@ -331,7 +336,10 @@ typedef enum enumIOMode
 	IOM__IS_DEFAULT		= 0,
 
 	IOM_FORCE_STREAM	= IOM__IS_MASK + 1,
-	IOM_NO_STREAM		= 0
+	IOM_NO_STREAM		= 0,
+
+	IOM_URING		= 0x10, // use io_uring for plain files, if available
+	IOM_MMAP		= 0x20, // map plain files, that are only read
 
 } enumIOMode;
 
@@ -351,6 +359,7 @@ typedef enum enumOFT // open file mode
     OFT_CISO,			// CISO file
     OFT_WBFS,			// WBFS disc
     OFT_WIA,			// WIA file
+    OFT_RVZ,			// RVZ file
     OFT_GCZ,			// GCZ file
     OFT_FST,			// file system
 
@@ -598,6 +607,7 @@ typedef enum enumFileType
 	FT_A_SEEKABLE	= 0x10000000,  // flag: using of seek() is possible
 	FT_A_WRITING	= 0x20000000,  // is opened for writing
 	FT_A_PART_DIR	= 0x40000000,  // FST is a partition
+	FT_A_RVZ	= 0x80000000,  // flag: file is a packed RVZ
 
 	//--- special combinations
 
@@ -720,6 +730,8 @@ typedef struct File_t
 
     off_t	file_off;		// current real file offset
     off_t	cur_off;		// current virtual file offset
+    bool	fpos_dirty;		// true: position of 'fd' differs from 'file_off'
+					// because of positional I/O (io_uring)
     off_t	max_off;		// max file offset
     off_t	prealloc_size;		// if >0: size of preallocation
     int		read_behind_eof;	// 0: disallow
@@ -735,6 +747,14 @@ typedef struct File_t
     size_t	cache_info_size;	// info for cache missed message
 
 
+    //--- memory mapped reading (IOM_MMAP)
+
+    bool	map_done;		// true: mapping already tried
+    u8		* map_data;		// NULL or read only mapping of the whole file
+    off_t	map_size;		// size of mapping
+    off_t	map_advised;		// end of last madvise(WILLNEED) area
+
+
     //--- prealloc map
 
     bool	prealloc_done;		// true if preallocation was done
@@ -814,9 +834,23 @@ enumError XTellF	 ( XPARM File_t * f );
 enumError XSeekF	 ( XPARM File_t * f, off_t off );
 enumError XSetSizeF	 ( XPARM File_t * f, off_t size );
 enumError XPreallocateF	 ( XPARM File_t * f, off_t off, off_t size );
+enumError XSyncF	 ( XPARM File_t * f ); // fdatasync() as write barrier
 enumError XReadF	 ( XPARM File_t * f,                  void * iobuf, size_t count );
 enumError XWriteF	 ( XPARM File_t * f,            const void * iobuf, size_t count );
 enumError XReadAtF	 ( XPARM File_t * f, off_t off,       void * iobuf, size_t count );
+
+// Read contiguous file data into 'iovcnt' buffers. Plain files are read by
+// one preadv() call or one io_uring submission, other files by XReadAtF().
+#define READ_VEC_MAX 64	// max number of buffers for XReadVecAtF()
+struct iovec;
+enumError XReadVecAtF	 ( XPARM File_t * f, off_t off,
+			   const struct iovec * iov, int iovcnt );
+
+// If IOM_MMAP is set and the file is a plain file opened only for reading,
+// the data is served from a memory mapping of the file. The result is a pointer
+// into the mapping or NULL, if not available. The data is counted as read.
+const u8 * GetMappedF	 ( File_t * f, off_t off, size_t count );
+void UnmapF		 ( File_t * f );
 enumError XWriteAtF	 ( XPARM File_t * f, off_t off, const void * iobuf, size_t count );
 enumError XWriteZeroAtF	 ( XPARM File_t * f, off_t off,                     size_t count );
 enumError XZeroAtF	 ( XPARM File_t * f, off_t off,                     size_t count );
@@ -876,6 +910,8 @@ bool IsSplittedF ( const File_t * f );
 
 bool IsDirectory ( ccp fname, bool answer_if_empty );
 enumError CreatePath ( ccp fname );
+bool GetCachePath ( char * buf, uint buf_size, ccp env_name, ccp fname );
+void CreateCacheDir ( ccp path );
 
 typedef enum enumFileMode { FM_OTHER, FM_PLAIN, FM_BLKDEV, FM_CHRDEV } enumFileMode;
 enumFileMode GetFileMode ( mode_t mode );
@@ -1690,6 +1726,8 @@ int ScanOptCompression
     ccp			arg		// argument to scan
 );
 
+int CheckOptCompression(); // reject invalid combinations, returns 0 if ok
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			scan mem option			///////////////
@@ -1705,6 +1743,43 @@ int ScanOptMem
 
 u64 GetMemLimit();
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			I/O buffer pool			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// The copy and diff functions don't use the global 'iobuf', but get an own
+// aligned buffer for each operation from a thread safe pool. The size of the
+// buffers is defined by option --iobuf.
+
+#define IOBUF_ALIGN	DIRECTBUF_ALIGN	// alignment of pool buffers
+#define IOBUF_MIN_SIZE	0x40000		// minimal size of pool buffers
+#define IOBUF_MAX_SIZE	0x10000000	// maximal size of pool buffers
+#define IOBUF_POOL_MAX	16		// maximal number of unused pool buffers
+
+extern u32 opt_iobuf_size;		// = 0: use IOBUF_SIZE
+
+int ScanOptIOBuf
+(
+    ccp			arg		// argument to scan
+);
+
+u32 GetIOBufSize();			// size of pool buffers
+
+//-----------------------------------------------------------------------------
+
+void * GetIOBuf
+(
+    u32			* size		// not NULL: store the buffer size
+);
+
+void PutIOBuf
+(
+    void		* buf		// NULL or buffer returned by GetIOBuf()
+);
+
+void ResetIOBufPool();			// free all unused pool buffers
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			data area & list		///////////////
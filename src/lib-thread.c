@@ -0,0 +1,340 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#define _GNU_SOURCE 1
+
+#include <unistd.h>
+
+#include "debug.h"
+#include "lib-thread.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			thread options			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+u32 opt_threads = 0;
+u32 opt_scan_threads = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+int ScanOptThreads
+(
+    ccp			arg		// argument to scan
+)
+{
+    if (!arg)
+	return 0;
+
+    u32 num;
+    enumError stat = ScanSizeOptU32(
+		&num,			// u32 * num
+		arg,			// ccp source
+		1,			// default_factor1
+		0,			// int force_base
+		"threads",		// ccp opt_name
+		0,			// u64 min
+		MAX_THREADS,		// u64 max
+		0,			// u32 multiple
+		0,			// u32 pow2
+		true			// bool print_err
+		) != ERR_OK;
+
+    if (!stat)
+	opt_threads = num;
+    return stat;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+u32 GetThreadCount()
+{
+    static bool done = false;
+    if ( !done && !opt_threads )
+    {
+	done = true;
+
+	char * env = getenv("WIT_THREADS");
+	if ( env && *env )
+	{
+	    char * end;
+	    const long num = strtol(env,&end,10);
+	    if ( !*end && num > 0 )
+		opt_threads = num;
+	}
+
+	if (!opt_threads)
+	{
+	 #ifdef _SC_NPROCESSORS_ONLN
+	    const long num = sysconf(_SC_NPROCESSORS_ONLN);
+	    opt_threads = num > 0 ? num : 1;
+	 #else
+	    opt_threads = 1;
+	 #endif
+	}
+	TRACE("GetThreadCount() => %u\n",opt_threads);
+    }
+
+    return !opt_threads
+		? 1
+		: opt_threads < MAX_THREADS
+			? opt_threads
+			: MAX_THREADS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int ScanOptScanThreads
+(
+    ccp			arg		// argument to scan
+)
+{
+    if (!arg)
+	return 0;
+
+    u32 num;
+    enumError stat = ScanSizeOptU32(
+		&num,			// u32 * num
+		arg,			// ccp source
+		1,			// default_factor1
+		0,			// int force_base
+		"scan-threads",		// ccp opt_name
+		0,			// u64 min
+		MAX_THREADS,		// u64 max
+		0,			// u32 multiple
+		0,			// u32 pow2
+		true			// bool print_err
+		) != ERR_OK;
+
+    if (!stat)
+	opt_scan_threads = num;
+    return stat;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+u32 GetScanThreadCount()
+{
+    return opt_scan_threads ? opt_scan_threads : GetThreadCount();
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  ThreadPool_t			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static void * thread_pool_worker ( void * param )
+{
+    ThreadPool_t * tp = param;
+    DASSERT(tp);
+
+    pthread_mutex_lock(&tp->mutex);
+    for(;;)
+    {
+	while ( !tp->first && !tp->terminate )
+	    pthread_cond_wait(&tp->job_cond,&tp->mutex);
+
+	ThreadJob_t * job = tp->first;
+	if (!job)
+	    break; // terminate only if the queue is empty
+
+	tp->first = job->next;
+	if (!tp->first)
+	    tp->last = 0;
+	pthread_mutex_unlock(&tp->mutex);
+
+	job->func(job);
+
+	pthread_mutex_lock(&tp->mutex);
+	job->done = true;
+	DASSERT( tp->n_pending > 0 );
+	tp->n_pending--;
+	pthread_cond_broadcast(&tp->done_cond);
+    }
+    pthread_mutex_unlock(&tp->mutex);
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InitializeThreadPool
+(
+    ThreadPool_t	* tp,		// valid pool, will be initialized
+    uint		n_threads	// number of threads, 0: GetThreadCount()
+					// if the result is 1: don't use threads
+)
+{
+    DASSERT(tp);
+    memset(tp,0,sizeof(*tp));
+
+    if (!n_threads)
+	n_threads = GetThreadCount();
+    if ( n_threads > MAX_THREADS )
+	n_threads = MAX_THREADS;
+    if ( n_threads <= 1 )
+	return;
+
+    pthread_mutex_init(&tp->mutex,0);
+    pthread_cond_init(&tp->job_cond,0);
+    pthread_cond_init(&tp->done_cond,0);
+
+    tp->thread = CALLOC(n_threads,sizeof(*tp->thread));
+    while ( tp->n_threads < n_threads )
+    {
+	if (pthread_create(tp->thread+tp->n_threads,0,thread_pool_worker,tp))
+	    break;
+	tp->n_threads++;
+    }
+    PRINT("InitializeThreadPool(%p) %u/%u threads started\n",
+		tp, tp->n_threads, n_threads );
+
+    if (!tp->n_threads)
+    {
+	FREE(tp->thread);
+	tp->thread = 0;
+	pthread_cond_destroy(&tp->done_cond);
+	pthread_cond_destroy(&tp->job_cond);
+	pthread_mutex_destroy(&tp->mutex);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResetThreadPool
+(
+    ThreadPool_t	* tp		// NULL or valid pool
+					// wait for all jobs and terminate threads
+)
+{
+    if ( tp && tp->n_threads )
+    {
+	pthread_mutex_lock(&tp->mutex);
+	tp->terminate = true;
+	pthread_cond_broadcast(&tp->job_cond);
+	pthread_mutex_unlock(&tp->mutex);
+
+	uint i;
+	for ( i = 0; i < tp->n_threads; i++ )
+	    pthread_join(tp->thread[i],0);
+	FREE(tp->thread);
+
+	pthread_cond_destroy(&tp->done_cond);
+	pthread_cond_destroy(&tp->job_cond);
+	pthread_mutex_destroy(&tp->mutex);
+	memset(tp,0,sizeof(*tp));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void AddThreadJob
+(
+    ThreadPool_t	* tp,		// valid pool
+    ThreadJob_t		* job,		// valid job, must stay valid until done
+    ThreadJobFunc	func,		// job function
+    void		* param		// user defined parameter -> job->param
+)
+{
+    DASSERT(tp);
+    DASSERT(job);
+    DASSERT(func);
+
+    job->next	= 0;
+    job->func	= func;
+    job->param	= param;
+    job->done	= false;
+
+    if (!tp->n_threads)
+    {
+	// no worker threads => execute the job immediately
+	func(job);
+	job->done = true;
+	return;
+    }
+
+    pthread_mutex_lock(&tp->mutex);
+    if (tp->last)
+	tp->last->next = job;
+    else
+	tp->first = job;
+    tp->last = job;
+    tp->n_pending++;
+    pthread_cond_signal(&tp->job_cond);
+    pthread_mutex_unlock(&tp->mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void WaitThreadJob
+(
+    ThreadPool_t	* tp,		// valid pool
+    ThreadJob_t		* job		// valid job, wait until it is done
+)
+{
+    DASSERT(tp);
+    DASSERT(job);
+
+    if ( tp->n_threads )
+    {
+	pthread_mutex_lock(&tp->mutex);
+	while (!job->done)
+	    pthread_cond_wait(&tp->done_cond,&tp->mutex);
+	pthread_mutex_unlock(&tp->mutex);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void WaitThreadPool
+(
+    ThreadPool_t	* tp		// valid pool, wait until all jobs done
+)
+{
+    DASSERT(tp);
+
+    if ( tp->n_threads )
+    {
+	pthread_mutex_lock(&tp->mutex);
+	while (tp->n_pending)
+	    pthread_cond_wait(&tp->done_cond,&tp->mutex);
+	pthread_mutex_unlock(&tp->mutex);
+    }
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
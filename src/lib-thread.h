@@ -0,0 +1,171 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef WIT_LIB_THREAD_H
+#define WIT_LIB_THREAD_H 1
+
+#include <pthread.h>
+
+#include "types.h"
+#include "lib-std.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			thread options			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define MAX_THREADS		64	// maximal number of worker threads
+
+extern u32 opt_threads;			// = 0: use GetThreadCount()
+extern u32 opt_scan_threads;		// = 0: use GetThreadCount()
+
+//-----------------------------------------------------------------------------
+
+int ScanOptThreads
+(
+    ccp			arg		// argument to scan
+);
+
+//-----------------------------------------------------------------------------
+
+// Returns the number of threads to use for parallel jobs. If option --threads
+// is not set, the environment variable WIT_THREADS and then the number of
+// online processors is used. The result is always in the range 1..MAX_THREADS.
+// A value of 1 means: don't use worker threads at all.
+
+u32 GetThreadCount();
+
+//-----------------------------------------------------------------------------
+
+int ScanOptScanThreads
+(
+    ccp			arg		// argument to scan
+);
+
+// Returns the number of threads to probe directory entries in advance
+// while scanning source directories: --scan-threads or GetThreadCount().
+
+u32 GetScanThreadCount();
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  ThreadJob_t			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+struct ThreadJob_t;
+typedef void (*ThreadJobFunc) ( struct ThreadJob_t * job );
+
+//-----------------------------------------------------------------------------
+
+typedef struct ThreadJob_t
+{
+    struct ThreadJob_t	* next;		// next job in queue
+    ThreadJobFunc	func;		// job function, called by a worker
+    void		* param;	// user defined parameter
+    volatile bool	done;		// true: job finished
+
+} ThreadJob_t;
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  ThreadPool_t			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct ThreadPool_t
+{
+    pthread_t		* thread;	// NULL or list with 'n_threads' threads
+    uint		n_threads;	// number of running worker threads
+					//  0: jobs are executed by the caller
+
+    pthread_mutex_t	mutex;		// protect all members below
+    pthread_cond_t	job_cond;	// signal: new job or terminate
+    pthread_cond_t	done_cond;	// signal: job finished
+
+    ThreadJob_t		* first;	// first waiting job
+    ThreadJob_t		* last;		// last waiting job
+    uint		n_pending;	// number of waiting and running jobs
+    bool		terminate;	// true: terminate all worker threads
+
+} ThreadPool_t;
+
+//-----------------------------------------------------------------------------
+
+void InitializeThreadPool
+(
+    ThreadPool_t	* tp,		// valid pool, will be initialized
+    uint		n_threads	// number of threads, 0: GetThreadCount()
+					// if the result is 1: don't use threads
+);
+
+//-----------------------------------------------------------------------------
+
+void ResetThreadPool
+(
+    ThreadPool_t	* tp		// NULL or valid pool
+					// wait for all jobs and terminate threads
+);
+
+//-----------------------------------------------------------------------------
+
+void AddThreadJob
+(
+    ThreadPool_t	* tp,		// valid pool
+    ThreadJob_t		* job,		// valid job, must stay valid until done
+    ThreadJobFunc	func,		// job function
+    void		* param		// user defined parameter -> job->param
+);
+
+//-----------------------------------------------------------------------------
+
+void WaitThreadJob
+(
+    ThreadPool_t	* tp,		// valid pool
+    ThreadJob_t		* job		// valid job, wait until it is done
+);
+
+//-----------------------------------------------------------------------------
+
+void WaitThreadPool
+(
+    ThreadPool_t	* tp		// valid pool, wait until all jobs done
+);
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // WIT_LIB_THREAD_H
@@ -0,0 +1,403 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#define _GNU_SOURCE 1
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "debug.h"
+#include "lib-uring.h"
+
+#if defined(__linux__) && defined(__has_include)
+  #if __has_include(<linux/io_uring.h>)
+    #define HAVE_URING 1
+  #endif
+#endif
+
+#ifndef HAVE_URING
+  #define HAVE_URING 0
+#endif
+
+#if HAVE_URING
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <sys/uio.h>
+  #include <linux/io_uring.h>
+#endif
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  standard I/O			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static void exec_std_io ( URingIO_t * io )
+{
+    // complete request 'io' by pread() or pwrite(), continue at 'io->result'
+
+    DASSERT(io);
+    if ( io->result == -EAGAIN || io->result == -EINTR )
+	io->result = 0;
+
+    while ( io->result >= 0 && io->result < io->size )
+    {
+	char * buf = (char*)io->buf + io->result;
+	const size_t size = io->size - io->result;
+	const off_t off = io->off + io->result;
+
+	const ssize_t stat = io->write
+		? pwrite(io->fd,buf,size,off)
+		: pread(io->fd,buf,size,off);
+	if ( stat < 0 )
+	{
+	    if ( errno == EINTR )
+		continue;
+	    io->result = -errno;
+	}
+	else if (!stat)
+	    break;
+	else
+	    io->result += stat;
+    }
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			    io_uring			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if HAVE_URING
+
+typedef struct uring_t
+{
+    int			fd;		// ring file descriptor
+    bool		broken;		// true: submission failed, don't use ring
+
+    u32			* sq_head;	// submission queue
+    u32			* sq_tail;
+    u32			* sq_mask;
+    u32			* sq_array;
+    struct io_uring_sqe	* sqes;
+
+    u32			* cq_head;	// completion queue
+    u32			* cq_tail;
+    u32			* cq_mask;
+    struct io_uring_cqe	* cqes;
+
+    void		* sq_ptr;	// mapped memory
+    size_t		sq_size;
+    void		* cq_ptr;
+    size_t		cq_size;
+    size_t		sqes_size;
+
+} uring_t;
+
+static int		uring_state = 0;	// 0:unknown, 1:available, -1:not
+static pthread_once_t	uring_once  = PTHREAD_ONCE_INIT;
+static pthread_key_t	uring_key;		// ring of current thread
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void reset_uring ( uring_t * ring )
+{
+    DASSERT(ring);
+
+    if ( ring->sqes && ring->sqes != MAP_FAILED )
+	munmap(ring->sqes,ring->sqes_size);
+    if ( ring->cq_ptr && ring->cq_ptr != MAP_FAILED && ring->cq_ptr != ring->sq_ptr )
+	munmap(ring->cq_ptr,ring->cq_size);
+    if ( ring->sq_ptr && ring->sq_ptr != MAP_FAILED )
+	munmap(ring->sq_ptr,ring->sq_size);
+    if ( ring->fd >= 0 )
+	close(ring->fd);
+
+    memset(ring,0,sizeof(*ring));
+    ring->fd = -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool setup_uring ( uring_t * ring )
+{
+    DASSERT(ring);
+    memset(ring,0,sizeof(*ring));
+
+    struct io_uring_params par;
+    memset(&par,0,sizeof(par));
+    ring->fd = syscall(__NR_io_uring_setup,URING_ENTRIES,&par);
+    if ( ring->fd < 0 )
+    {
+	PRINT("io_uring_setup() failed, errno=%d\n",errno);
+	ring->fd = -1;
+	return false;
+    }
+
+    ring->sq_size = par.sq_off.array + par.sq_entries * sizeof(u32);
+    ring->cq_size = par.cq_off.cqes + par.cq_entries * sizeof(struct io_uring_cqe);
+    if ( par.features & IORING_FEAT_SINGLE_MMAP && ring->cq_size > ring->sq_size )
+	ring->sq_size = ring->cq_size;
+
+    ring->sq_ptr = mmap( 0, ring->sq_size, PROT_READ|PROT_WRITE,
+			MAP_SHARED|MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING );
+    if ( ring->sq_ptr == MAP_FAILED )
+	goto error;
+
+    if ( par.features & IORING_FEAT_SINGLE_MMAP )
+	ring->cq_ptr = ring->sq_ptr;
+    else
+    {
+	ring->cq_ptr = mmap( 0, ring->cq_size, PROT_READ|PROT_WRITE,
+			MAP_SHARED|MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING );
+	if ( ring->cq_ptr == MAP_FAILED )
+	    goto error;
+    }
+
+    ring->sqes_size = par.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap( 0, ring->sqes_size, PROT_READ|PROT_WRITE,
+			MAP_SHARED|MAP_POPULATE, ring->fd, IORING_OFF_SQES );
+    if ( ring->sqes == MAP_FAILED )
+	goto error;
+
+    u8 * sq = ring->sq_ptr;
+    ring->sq_head	= (u32*)( sq + par.sq_off.head );
+    ring->sq_tail	= (u32*)( sq + par.sq_off.tail );
+    ring->sq_mask	= (u32*)( sq + par.sq_off.ring_mask );
+    ring->sq_array	= (u32*)( sq + par.sq_off.array );
+
+    u8 * cq = ring->cq_ptr;
+    ring->cq_head	= (u32*)( cq + par.cq_off.head );
+    ring->cq_tail	= (u32*)( cq + par.cq_off.tail );
+    ring->cq_mask	= (u32*)( cq + par.cq_off.ring_mask );
+    ring->cqes		= (struct io_uring_cqe*)( cq + par.cq_off.cqes );
+    return true;
+
+ error:
+    PRINT("io_uring mmap() failed, errno=%d\n",errno);
+    reset_uring(ring);
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void free_uring ( void * ring )
+{
+    if (ring)
+    {
+	reset_uring(ring);
+	FREE(ring);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static uring_t * get_uring()
+{
+    // returns the ring of the current thread or NULL
+
+    uring_t * ring = pthread_getspecific(uring_key);
+    if ( ring && ring->broken )
+	return 0;
+    if (!ring)
+    {
+	ring = MALLOC(sizeof(*ring));
+	if (!setup_uring(ring))
+	{
+	    FREE(ring);
+	    return 0;
+	}
+	pthread_setspecific(uring_key,ring);
+    }
+    return ring;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void probe_uring()
+{
+    uring_state = -1;
+    if (pthread_key_create(&uring_key,free_uring))
+	return;
+
+    if (get_uring())
+	uring_state = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static uint exec_uring
+(
+    uring_t		* ring,		// valid ring
+    URingIO_t		* list,		// list of requests
+    uint		n,		// number of requests, <= URING_ENTRIES
+    struct iovec	* iov		// list with 'n' io vectors
+)
+{
+    // returns the number of submitted requests
+
+    DASSERT(ring);
+    DASSERT( n <= URING_ENTRIES );
+
+    //--- fill submission queue
+
+    u32 tail = *ring->sq_tail;
+    const u32 mask = *ring->sq_mask;
+
+    uint i;
+    for ( i = 0; i < n; i++, tail++ )
+    {
+	URingIO_t * io = list + i;
+	iov[i].iov_base = io->buf;
+	iov[i].iov_len  = io->size;
+
+	const u32 idx = tail & mask;
+	struct io_uring_sqe * sqe = ring->sqes + idx;
+	memset(sqe,0,sizeof(*sqe));
+	sqe->opcode	= io->write ? IORING_OP_WRITEV : IORING_OP_READV;
+	sqe->fd		= io->fd;
+	sqe->off	= io->off;
+	sqe->addr	= (uintptr_t)( iov + i );
+	sqe->len	= 1;
+	sqe->user_data	= i;
+	ring->sq_array[idx] = idx;
+    }
+    __atomic_store_n(ring->sq_tail,tail,__ATOMIC_RELEASE);
+
+
+    //--- submit and wait for completion
+
+    uint submitted = 0, done = 0;
+    while ( done < n )
+    {
+	const uint to_submit = ring->broken ? 0 : n - submitted;
+	const int stat = syscall( __NR_io_uring_enter, ring->fd, to_submit,
+				to_submit ? to_submit : 1,
+				IORING_ENTER_GETEVENTS, 0, 0 );
+	if ( stat < 0 )
+	{
+	    if ( errno == EINTR || errno == EAGAIN )
+		continue;
+
+	    // entries are left in the submission queue => disable the ring
+	    // after all submitted requests are finished
+
+	    PRINT("io_uring_enter() failed, errno=%d\n",errno);
+	    if ( ring->broken || done >= submitted )
+	    {
+		ring->broken = true;
+		break;
+	    }
+	    ring->broken = true;
+	    n = submitted;
+	    continue;
+	}
+	submitted += stat;
+
+	u32 head = *ring->cq_head;
+	while ( head != __atomic_load_n(ring->cq_tail,__ATOMIC_ACQUIRE) )
+	{
+	    struct io_uring_cqe * cqe = ring->cqes + ( head & *ring->cq_mask );
+	    if ( cqe->user_data < n )
+		list[cqe->user_data].result = cqe->res;
+	    head++;
+	    done++;
+	}
+	__atomic_store_n(ring->cq_head,head,__ATOMIC_RELEASE);
+    }
+
+    return submitted;
+}
+
+#endif // HAVE_URING
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			    interface			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool IsURingAvailable()
+{
+ #if HAVE_URING
+    pthread_once(&uring_once,probe_uring);
+    return uring_state > 0;
+ #else
+    return false;
+ #endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint ExecURing ( URingIO_t * list, uint n )
+{
+    DASSERT( list || !n );
+
+    uint i;
+    for ( i = 0; i < n; i++ )
+	list[i].result = 0;
+
+ #if HAVE_URING
+    uring_t * ring = IsURingAvailable() ? get_uring() : 0;
+    if (ring)
+    {
+	struct iovec iov[URING_ENTRIES];
+	URingIO_t * ptr = list, * end = list + n;
+	while ( ptr < end )
+	{
+	    const uint count = end - ptr < URING_ENTRIES ? end - ptr : URING_ENTRIES;
+	    const uint submitted = exec_uring(ring,ptr,count,iov);
+	    if ( !submitted || ring->broken )
+		break;
+	    ptr += submitted;
+	}
+    }
+ #endif
+
+    uint n_failed = 0;
+    for ( i = 0; i < n; i++ )
+    {
+	URingIO_t * io = list + i;
+	exec_std_io(io);
+	if ( io->result != io->size )
+	    n_failed++;
+    }
+    return n_failed;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,81 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef WIT_LIB_URING_H
+#define WIT_LIB_URING_H 1
+
+#include <sys/types.h>
+#include "types.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  io_uring support		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define URING_ENTRIES		32	// max number of requests per system call
+
+//-----------------------------------------------------------------------------
+
+typedef struct URingIO_t
+{
+    int			fd;		// file descriptor
+    bool		write;		// false: read, true: write
+    off_t		off;		// file offset
+    void		* buf;		// data buffer
+    size_t		size;		// number of bytes to transfer
+    ssize_t		result;		// result: number of transferred bytes
+					//	   or negative errno
+
+} URingIO_t;
+
+//-----------------------------------------------------------------------------
+
+// Returns true if io_uring is supported by the kernel.
+// The kernel is probed only once.
+bool IsURingAvailable();
+
+// Execute 'n' read and write requests. The requests are submitted to the ring
+// of the calling thread in batches of up to URING_ENTRIES with one system call.
+// Short transfers are completed by pread() and pwrite(), and without io_uring
+// all requests are done this way. Returns the number of incomplete requests.
+uint ExecURing ( URingIO_t * list, uint n );
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // WIT_LIB_URING_H
@@ -840,6 +840,25 @@ enumError ReadWDF ( SuperFile_t * sf, off_t off, void * buf, size_t count )
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+const void * GetMappedWDF ( SuperFile_t * sf, off_t off, size_t count )
+{
+    // zero copy alternative to ReadWDF(): returns a pointer into the mapped
+    // file, if the whole area is stored in one chunk, or NULL otherwise
+
+    DASSERT(sf);
+    wdf_controller_t *wdf = sf->wdf;
+    if ( !wdf || !( opt_iomode & IOM_MMAP ) || off + count > wdf->head.file_size )
+	return 0;
+
+    wdf2_chunk_t * wc = FindChunkWDF(wdf,off);
+    if ( !wc || off < wc->file_pos || off + count > wc->file_pos + wc->data_size )
+	return 0;
+
+    return GetMappedF(&sf->f,wc->data_off+off-wc->file_pos,count);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 off_t DataBlockWDF
@@ -39,7 +39,10 @@
 #include "debug.h"
 #include "iso-interface.h"
 #include "lib-bzip2.h"
+#include "lib-lfg.h"
 #include "lib-lzma.h"
+#include "lib-zstd.h"
+#include "lib-thread.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -58,6 +61,9 @@
 #define WATCH_GROUP -1		// -1: disabled
 #define WATCH_SUB_GROUP 0
 
+// max number of failed seed detections for one sector, if writing RVZ
+#define RVZ_MAX_SEED_TRIES 8
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #if 0
@@ -96,6 +102,10 @@ static wd_part_sector_t empty_decrypted_sector;
 ///////////////			    manage WIA			///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+static void reset_thread_jobs ( wia_controller_t * wia );
+
+///////////////////////////////////////////////////////////////////////////////
+
 void ResetWIA
 (
     wia_controller_t	* wia		// NULL or valid pointer
@@ -107,7 +117,11 @@ void ResetWIA
 	FREE(wia->part);
 	FREE(wia->raw_data);
 	FREE(wia->group);
+	FREE(wia->rvz_group);
 	FREE(wia->gdata);
+	FREE(wia->pdata);
+	FREE(wia->xlist);
+	reset_thread_jobs(wia);
 	wd_reset_memmap(&wia->memmap);
 
 	memset(wia,0,sizeof(*wia));
@@ -212,6 +226,12 @@ u32 CalcMemoryUsageWIA
 	case WD_COMPR_LZMA2:
 	    size += CalcMemoryUsageLZMA2(compr_level,is_writing);
 	    break;
+
+	case WD_COMPR_ZSTD:
+	 #ifdef HAVE_ZSTD
+	    size += CalcMemoryUsageZSTD(compr_level,is_writing);
+	 #endif
+	    break;
     }
 
     return size;
@@ -266,6 +286,15 @@ int CalcDefaultSettingsWIA
 	    level = CalcCompressionLevelLZMA(level);
 	    //clevel = WIA_DEF_CHUNK_FACTOR; // == default setting
 	    break;
+
+	case WD_COMPR_ZSTD:
+	 #ifdef HAVE_ZSTD
+	    level = CalcCompressionLevelZSTD(level);
+	 #else
+	    level = 0;
+	 #endif
+	    //clevel = WIA_DEF_CHUNK_FACTOR; // == default setting
+	    break;
     }
 
 
@@ -305,10 +334,11 @@ int CalcDefaultSettingsWIA
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool IsWIA
+static bool is_wia_helper
 (
     const void		* data,		// data to check
     size_t		data_size,	// size of data
+    ccp			magic,		// WIA_MAGIC or RVZ_MAGIC
     void		* id6_result,	// not NULL: store ID6 (6 bytes without null term)
     wd_disc_type_t	* disc_type,	// not NULL: store disc type
     wd_compression_t	* compression	// not NULL: store compression
@@ -318,7 +348,7 @@ bool IsWIA
     const wia_file_head_t * fhead = data;
     if ( data_size >= sizeof(wia_file_head_t) )
     {
-	if (!memcmp(fhead->magic,WIA_MAGIC,sizeof(fhead->magic)))
+	if (!memcmp(fhead->magic,magic,sizeof(fhead->magic)))
 	{
 	    sha1_hash_t hash;
 	    SHA1( (u8*)fhead, sizeof(*fhead)-sizeof(fhead->file_head_hash), hash );
@@ -356,6 +386,36 @@ bool IsWIA
     return is_wia;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+bool IsWIA
+(
+    const void		* data,		// data to check
+    size_t		data_size,	// size of data
+    void		* id6_result,	// not NULL: store ID6 (6 bytes without null term)
+    wd_disc_type_t	* disc_type,	// not NULL: store disc type
+    wd_compression_t	* compression	// not NULL: store compression
+)
+{
+    return is_wia_helper( data, data_size, WIA_MAGIC,
+				id6_result, disc_type, compression );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool IsRVZ
+(
+    const void		* data,		// data to check
+    size_t		data_size,	// size of data
+    void		* id6_result,	// not NULL: store ID6 (6 bytes without null term)
+    wd_disc_type_t	* disc_type,	// not NULL: store disc type
+    wd_compression_t	* compression	// not NULL: store compression
+)
+{
+    return is_wia_helper( data, data_size, RVZ_MAGIC,
+				id6_result, disc_type, compression );
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			read helpers			///////////////
@@ -403,9 +463,149 @@ static u64 calc_group_size
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static wd_compression_t get_group_compression
+(
+    const wia_controller_t * wia,	// valid controller
+    u32			group		// index of group
+)
+{
+    // RVZ stores groups uncompressed, if compression is not helpful
+
+    DASSERT(wia);
+    DASSERT( group < wia->group_used );
+
+    return wia->rvz_group
+	&& !( ntohl(wia->rvz_group[group].data_size) & RVZ_COMPRESSED )
+		? WD_COMPR_NONE
+		: (wd_compression_t)wia->disc.compression;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 get_packed_size
+(
+    const wia_controller_t * wia,	// valid controller
+    u32			group		// index of group
+)
+{
+    DASSERT(wia);
+    DASSERT( group < wia->group_used );
+
+    return wia->rvz_group ? ntohl(wia->rvz_group[group].packed_size) : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static u64 calc_rvz_data_offset
+(
+    const wia_controller_t * wia,	// valid controller
+    u32			group,		// index of group
+    int			part_index	// -1 or index of partition
+)
+{
+    // Return the base offset of the junk generator for 'group'. It is the
+    // disc offset for raw data and the offset within the decrypted data
+    // of the partition for partition data. Groups are based on the file
+    // chunk size, even if they are joined to larger internal chunks.
+
+    DASSERT(wia);
+
+    if ( part_index >= 0 )
+    {
+	DASSERT( part_index < wia->disc.n_part );
+	const wia_part_t * part = wia->part + part_index;
+	const u32 chunk_data_size
+		= wia->disc.chunk_size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE;
+
+	int id;
+	for ( id = 0; id < sizeof(part->pd)/sizeof(part->pd[0]); id++ )
+	{
+	    const wia_part_data_t * pd = part->pd + id;
+	    if ( group >= pd->group_index && group < pd->group_index + pd->n_groups )
+		return (u64)( pd->first_sector - part->pd[0].first_sector )
+				* WII_SECTOR_DATA_SIZE
+			+ (u64)( group - pd->group_index ) * chunk_data_size;
+	}
+    }
+    else
+    {
+	const wia_raw_data_t *rd, *rd_end = wia->raw_data + wia->raw_data_used;
+	for ( rd = wia->raw_data; rd < rd_end; rd++ )
+	{
+	    const u32 group_index = ntohl(rd->group_index);
+	    if ( group >= group_index && group < group_index + ntohl(rd->n_groups) )
+		return ntoh64(rd->raw_data_off) / WII_SECTOR_SIZE * WII_SECTOR_SIZE
+			+ (u64)( group - group_index ) * wia->disc.chunk_size;
+	}
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError unpack_rvz_data
+(
+    ccp			fname,		// NULL or filename for error messages
+					// NULL: don't print error messages
+    const u8		* src,		// packed data
+    u32			src_size,	// size of 'src'
+    u8			* dest,		// destination buffer
+    u32			dest_size,	// size of 'dest'
+    u64			data_offset	// base offset for the junk generator
+)
+{
+    // This function is used by ReadWIA() and by read ahead threads
+
+    DASSERT(src);
+    DASSERT(dest);
+
+    const u8 * src_end = src + src_size;
+    u8 * dest_end = dest + dest_size;
+
+    while ( dest < dest_end && src + 4 <= src_end )
+    {
+	u32 size = be32(src);
+	src += 4;
+	const bool is_junk = ( size & RVZ_JUNK ) != 0;
+	size &= ~RVZ_JUNK;
+	if ( size > dest_end - dest )
+	    break;
+
+	if (is_junk)
+	{
+	    if ( src + LFG_SEED_SIZE*4 > src_end )
+		break;
+
+	    LFG_t lfg;
+	    SetSeedLFG(&lfg,src);
+	    src += LFG_SEED_SIZE*4;
+	    ForwardLFG(&lfg,data_offset % WII_SECTOR_SIZE);
+	    GetBytesLFG(&lfg,dest,size);
+	}
+	else
+	{
+	    if ( size > src_end - src )
+		break;
+	    memcpy(dest,src,size);
+	    src += size;
+	}
+	dest += size;
+	data_offset += size;
+    }
+
+    if ( dest != dest_end || src != src_end )
+	return !fname ? ERR_WIA_INVALID : ERROR0(ERR_WIA_INVALID,
+		"Invalid RVZ packed data: %s\n",fname);
+
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static enumError expand_segments
 (
-    SuperFile_t		* sf,		// source file
+    ccp			fname,		// NULL or filename for error messages
+					// NULL: don't print error messages
     const wia_segment_t	* seg,		// source segment pointer
     void		* seg_end,	// end of segment space
     void		* dest_ptr,	// pointer to destination
@@ -434,8 +634,8 @@ static enumError expand_segments
 	{
 	    PRINT("seg=%p..%p, off=%x, size=%x, end=%x/%x\n",
 		seg, seg_end, offset, size, offset + size, dest_size );
-	    return ERROR0(ERR_WIA_INVALID,
-		"Invalid WIA data segment: %s\n",sf->f.fname);
+	    return !fname ? ERR_WIA_INVALID : ERROR0(ERR_WIA_INVALID,
+		"Invalid WIA data segment: %s\n",fname);
 	}
 
 	memcpy( dest + offset, seg->data, size );
@@ -450,6 +650,7 @@ static enumError expand_segments
 static enumError read_data
 (
     SuperFile_t		* sf,		// source file
+    wd_compression_t	compr,		// compression method of the data
     u64			file_offset,	// file offset
     u32			file_data_size,	// expected file data size
     bool		have_except,	// true: data contains exception list and
@@ -476,7 +677,7 @@ static enumError read_data
     u8  * dest    = have_except ? tempbuf : inbuf;
     u32 dest_size = have_except ? tempbuf_size : inbuf_size;
 
-    switch ((wd_compression_t)wia->disc.compression)
+    switch (compr)
     {
       //----------------------------------------------------------------------
 
@@ -524,7 +725,7 @@ static enumError read_data
 	const u32 except_size
 	    = have_except ? calc_except_size(tempbuf,wia->chunk_groups) + 3 & ~(u32)3 : 0;
 	wia_segment_t * seg = (wia_segment_t*)( tempbuf + except_size );
-	err = expand_segments( sf, seg, tempbuf+file_data_size,
+	err = expand_segments( sf->f.fname, seg, tempbuf+file_data_size,
 				inbuf, inbuf_size );
 	if (err)
 	    return err;
@@ -597,6 +798,28 @@ static enumError read_data
 
       //----------------------------------------------------------------------
 
+      case WD_COMPR_ZSTD:
+
+ #ifndef HAVE_ZSTD
+	return ERROR0(ERR_NOT_IMPLEMENTED,
+			"No WIA/ZSTD support for this release! Sorry!\n");
+ #else
+      {
+	u8 * src = MALLOC(file_data_size);
+	enumError err = ReadAtF( &sf->f, file_offset, src, file_data_size );
+	if (!err)
+	    err = DecZSTD_Buf2Buf( sf->f.fname, dest, dest_size,
+				&data_bytes_read, src, file_data_size );
+	FREE(src);
+	if (err)
+	    return err;
+      }
+      break;
+
+ #endif // HAVE_ZSTD
+
+      //----------------------------------------------------------------------
+
       // no default case defined
       //	=> compiler checks the existence of all enum values
 
@@ -628,10 +851,12 @@ static enumError read_data
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static enumError read_gdata
+static enumError read_group
 (
     SuperFile_t		* sf,		// source file
+    int			part_index,	// -1 or partition index
     u32			group,		// group index
+    u8			* dest,		// destination buffer
     u32			size,		// group size
     bool		have_except	// true: data contains exception list and
 					// the exception list is stored in tempbuf
@@ -639,70 +864,183 @@ static enumError read_gdata
 {
     DASSERT(sf);
     DASSERT(sf->wia);
+    DASSERT(dest);
     wia_controller_t * wia = sf->wia;
+    DASSERT( group < wia->group_used );
 
-    if ( group >= wia->group_used || size > wia->gdata_size )
+    const wia_group_t * grp = wia->group + group;
+    const u32 gsize = ntohl(grp->data_size);
+    if (!gsize)
+    {
+	memset(dest,0,size);
+	if (have_except)
+	    memset(tempbuf,0,wia->chunk_groups*sizeof(wia_except_list_t));
+	return ERR_OK;
+    }
+
+    const u64 file_offset = (u64)ntohl(grp->data_off4) << 2;
+    const wd_compression_t compr = get_group_compression(wia,group);
+    const u32 packed_size = get_packed_size(wia,group);
+    if (!packed_size)
+	return read_data( sf, compr, file_offset, gsize, have_except, dest, size );
+
+    if ( packed_size > 2 * tempbuf_size )
 	return ERROR0(ERR_WIA_INVALID,
-			"Access to invalid group: %s\n",sf->f.fname);
+	    "RVZ packed size too large: %s\n",sf->f.fname);
 
+    if ( wia->pdata_size < packed_size )
+    {
+	FREE(wia->pdata);
+	wia->pdata_size = packed_size;
+	wia->pdata = MALLOC(packed_size);
+    }
 
-    wia->gdata_group = group;
-    wia_group_t * grp = wia->group + group;
-    u32 gsize = ntohl(grp->data_size);
-    if (gsize)
+    enumError err = read_data( sf, compr, file_offset, gsize,
+				have_except, wia->pdata, packed_size );
+    return err ? err : unpack_rvz_data( sf->f.fname, wia->pdata, packed_size,
+				dest, size, calc_rvz_data_offset(wia,group,part_index) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError read_sub_gdata
+(
+    SuperFile_t		* sf,		// source file
+    int			part_index,	// -1 or partition index
+    u32			group,		// index of first group
+    u32			size,		// size of internal chunk
+    bool		have_except	// true: join the exception lists in tempbuf
+)
+{
+    // RVZ chunks smaller than WIA_BASE_CHUNK_SIZE are joined to internal
+    // chunks of WIA_BASE_CHUNK_SIZE. Each small chunk has its own exception
+    // list with offsets relative to the first sector of the chunk.
+
+    DASSERT(sf);
+    DASSERT(sf->wia);
+    wia_controller_t * wia = sf->wia;
+    DASSERT( wia->sub_chunks > 1 );
+    DASSERT( wia->chunk_groups == 1 );
+    DASSERT( wia->xlist );
+
+    const u32 sub_sectors = wia->disc.chunk_size / WII_SECTOR_SIZE;
+    const u32 sub_size = have_except
+			? sub_sectors * WII_SECTOR_DATA_SIZE
+			: wia->disc.chunk_size;
+
+    wia_except_list_t * xlist = wia->xlist;
+    u32 n_except = 0, off, sub;
+
+    for ( off = sub = 0; off < size; off += sub_size, sub++ )
     {
-	memset(wia->gdata+size,0,wia->gdata_size-size);
-	return read_data( sf, (u64)ntohl(grp->data_off4)<<2,
-			gsize, have_except, wia->gdata, size );
+	if ( group + sub >= wia->group_used )
+	    return ERROR0(ERR_WIA_INVALID,
+			"Access to invalid group: %s\n",sf->f.fname);
+
+	const u32 load_size = size - off < sub_size ? size - off : sub_size;
+	enumError err = read_group( sf, part_index, group+sub,
+				wia->gdata+off, load_size, have_except );
+	if (err)
+	    return err;
+
+	if (have_except)
+	{
+	    const wia_except_list_t * elist = (wia_except_list_t*)tempbuf;
+	    const u32 n = ntohs(elist->n_exceptions);
+	    if ( n_except + n > WII_N_HASH_GROUP )
+		return ERROR0(ERR_WIA_INVALID,
+			"Too many hash exceptions: %s\n",sf->f.fname);
+
+	    const u32 delta = sub * sub_sectors * WII_SECTOR_HASH_SIZE;
+	    const wia_exception_t * src = elist->exception;
+	    wia_exception_t * dest = xlist->exception + n_except;
+	    n_except += n;
+
+	    u32 i;
+	    for ( i = 0; i < n; i++, src++, dest++ )
+	    {
+		const u32 offset = ntohs(src->offset) + delta;
+		if ( offset + WII_HASH_SIZE > WII_GROUP_HASH_SIZE )
+		    return ERROR0(ERR_WIA_INVALID,
+			"Invalid hash exception: %s\n",sf->f.fname);
+		dest->offset = htons(offset);
+		memcpy(dest->hash,src->hash,sizeof(dest->hash));
+	    }
+	}
     }
-    
-    memset(wia->gdata,0,wia->gdata_size);
+
     if (have_except)
-	memset(tempbuf,0,sizeof(wia_except_list_t));
+    {
+	xlist->n_exceptions = htons(n_except);
+	memcpy( tempbuf, xlist,
+		sizeof(*xlist) + n_except * sizeof(*xlist->exception) );
+    }
     return ERR_OK;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static enumError read_part_gdata
+static enumError read_gdata
 (
     SuperFile_t		* sf,		// source file
-    u32			part_index,	// partition index
+    int			part_index,	// -1 or partition index
     u32			group,		// group index
-    u32			size		// group size
+    u32			size,		// group size
+    bool		have_except	// true: data contains exception list and
+					// the exception list is stored in tempbuf
 )
 {
     DASSERT(sf);
     DASSERT(sf->wia);
-
-    noPRINT("SIZE = %x -> %x\n", size, size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE );
-    enumError err = read_gdata( sf, group,
-				size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE, true );
-    if (err)
-	return err;
-    
     wia_controller_t * wia = sf->wia;
-    DASSERT( part_index < wia->disc.n_part );
-    if ( wia->gdata_part != part_index )
-    {
-	wia->gdata_part = part_index;
-	wd_aes_set_key(&wia->akey,wia->part[part_index].part_key);
-    }
+
+    if ( group >= wia->group_used || size > wia->gdata_size )
+	return ERROR0(ERR_WIA_INVALID,
+			"Access to invalid group: %s\n",sf->f.fname);
+
+
+    wia->gdata_group = group;
+    memset(wia->gdata+size,0,wia->gdata_size-size);
+
+    return wia->sub_chunks > 1
+	? read_sub_gdata(sf,part_index,group,size,have_except)
+	: read_group(sf,part_index,group,wia->gdata,size,have_except);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void join_part_data
+(
+    const wia_controller_t * wia,	// valid controller
+    u8			* gdata_ptr,	// group data, joined and encrypted in place
+    const aes_key_t	* akey,		// aes key of the partition
+    u8			* hbuf,		// buffer with exception list at the beginning
+    u32			hbuf_size,	// size of 'hbuf', hash tables stored at the end
+    int			group		// index of group, used for logging only
+)
+{
+    // This function is used by ReadWIA() and by read ahead threads
+    // => modify only 'gdata_ptr' and 'hbuf'
+
+    DASSERT(wia);
+    DASSERT(gdata_ptr);
+    DASSERT(akey);
+    DASSERT(hbuf);
 
 
     //----- process hash and exceptions
 
-    u8 * hashtab0 = tempbuf + tempbuf_size - WII_GROUP_HASH_SIZE * wia->chunk_groups;
+    u8 * hashtab0 = hbuf + hbuf_size - WII_GROUP_HASH_SIZE * wia->chunk_groups;
     u8 * hashtab = hashtab0;
 
     int g;
-    wia_except_list_t * except_list = (wia_except_list_t*)tempbuf;
-    u8 * gdata = wia->gdata;
+    wia_except_list_t * except_list = (wia_except_list_t*)hbuf;
+    u8 * gdata = gdata_ptr;
     for ( g = 0;
 	  g < wia->chunk_groups;
 	  g++, gdata += WII_GROUP_DATA_SIZE, hashtab += WII_GROUP_HASH_SIZE )
     {
-	DASSERT( hashtab + WII_GROUP_HASH_SIZE <= tempbuf + tempbuf_size );
+	DASSERT( hashtab + WII_GROUP_HASH_SIZE <= hbuf + hbuf_size );
 	memset(hashtab,0,WII_GROUP_HASH_SIZE);
 	wd_calc_group_hashes(gdata,hashtab,0,0);
 
@@ -711,7 +1049,7 @@ static enumError read_part_gdata
 	if (n_except)
 	{
 	 #if WATCH_GROUP >= 0 && defined(TEST)
-	    if ( wia->gdata_group == WATCH_GROUP && g == WATCH_SUB_GROUP )
+	    if ( group == WATCH_GROUP && g == WATCH_SUB_GROUP )
 	    {
 		FILE * f = fopen("pool/read.except.dump","wb");
 		if (f)
@@ -727,7 +1065,7 @@ static enumError read_part_gdata
 	    noPRINT("%u exceptions for group %u\n",n_except,group);
 	    for ( ; n_except > 0; n_except--, except++  )
 	    {
-		noPRINT_IF(wia->gdata_group == WATCH_GROUP && g == WATCH_SUB_GROUP,
+		noPRINT_IF(group == WATCH_GROUP && g == WATCH_SUB_GROUP,
 			    "EXCEPT: %4x: %02x %02x %02x %02x\n",
 			    ntohs(except->offset), except->hash[0],
 			    except->hash[1], except->hash[2], except->hash[3] );
@@ -738,10 +1076,10 @@ static enumError read_part_gdata
 	except_list = (wia_except_list_t*)except;
 	DASSERT( (u8*)except_list < hashtab0 );
     }
-    DASSERT( hashtab == tempbuf + tempbuf_size );
+    DASSERT( hashtab == hbuf + hbuf_size );
 
  #if WATCH_GROUP >= 0 && defined(TEST)
-    if ( wia->gdata_group == WATCH_GROUP )
+    if ( group == WATCH_GROUP )
     {
 	PRINT("##### WATCH GROUP #%u #####\n",WATCH_GROUP);
 	FILE * f = fopen("pool/read.calc.dump","wb");
@@ -757,12 +1095,12 @@ static enumError read_part_gdata
     //----- encrpyt and join data
 
  #if WATCH_GROUP >= 0 && defined(TEST)
-    if ( wia->gdata_group == WATCH_GROUP )
+    if ( group == WATCH_GROUP )
     {
 	FILE * f = fopen("pool/read.split.dump","wb");
 	if (f)
 	{
-	    HexDump(f,0,0,9,16,wia->gdata,WII_GROUP_DATA_SIZE*wia->chunk_groups);
+	    HexDump(f,0,0,9,16,gdata_ptr,WII_GROUP_DATA_SIZE*wia->chunk_groups);
 	    fclose(f);
 	}
 
@@ -776,66 +1114,611 @@ static enumError read_part_gdata
  #endif
 
     if ( wia->encrypt )
-	wd_encrypt_sectors(0,&wia->akey,wia->gdata,
-				hashtab0,wia->gdata,wia->chunk_sectors);
+	wd_encrypt_sectors(0,akey,gdata_ptr,
+				hashtab0,gdata_ptr,wia->chunk_sectors);
     else
-	wd_join_sectors(wia->gdata,hashtab0,wia->gdata,wia->chunk_sectors);
+	wd_join_sectors(gdata_ptr,hashtab0,gdata_ptr,wia->chunk_sectors);
 
 
  #if WATCH_GROUP >= 0 && defined(TEST)
-    if ( wia->gdata_group == WATCH_GROUP )
+    if ( group == WATCH_GROUP )
     {
 	FILE * f = fopen("pool/read.all.dump","wb");
 	if (f)
 	{
-	    HexDump(f,0,0,9,16,wia->gdata,wia->chunk_size);
+	    HexDump(f,0,0,9,16,gdata_ptr,wia->chunk_size);
 	    fclose(f);
 	}
     }
  #endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError read_part_gdata
+(
+    SuperFile_t		* sf,		// source file
+    u32			part_index,	// partition index
+    u32			group,		// group index
+    u32			size		// group size
+)
+{
+    DASSERT(sf);
+    DASSERT(sf->wia);
+
+    noPRINT("SIZE = %x -> %x\n", size, size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE );
+    enumError err = read_gdata( sf, part_index, group,
+				size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE, true );
+    if (err)
+	return err;
+    
+    wia_controller_t * wia = sf->wia;
+    DASSERT( part_index < wia->disc.n_part );
+    if ( wia->gdata_part != part_index )
+    {
+	wia->gdata_part = part_index;
+	wd_aes_set_key(&wia->akey,wia->part[part_index].part_key);
+    }
 
+    join_part_data(wia,wia->gdata,&wia->akey,tempbuf,tempbuf_size,group);
     return ERR_OK;
 }
 
 //
 ///////////////////////////////////////////////////////////////////////////////
-///////////////			    ReadWIA()			///////////////
+///////////////			    read ahead			///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-enumError ReadWIA 
-(
-    struct SuperFile_t	* sf,		// source file
-    off_t		off,		// file offset
-    void		* p_buf,	// destination buffer
-    size_t		count		// number of bytes to read
-)
+typedef struct wia_rjob_t
 {
-    ASSERT(sf);
-    ASSERT(sf->wia);
-
-    TRACE("#W# -----\n");
-    TRACE(TRACE_RDWR_FORMAT, "#W# ReadWIA()",
-		GetFD(&sf->f), GetFP(&sf->f),
-		(u64)off, (u64)off+count, count, "" );
+    ThreadJob_t		tjob;		// thread pool job, must be the first member
+    wia_controller_t	* wia;		// related controller, read only access
+
+    int			group;		// index of group, -1: job unused
+    int			part;		// -1 or index of partition
+    u32			size;		// size of group data
+    aes_key_t		akey;		// aes key of 'part'
+    wd_compression_t	compr;		// compression method of the group
+    u32			packed_size;	// >0: size of RVZ packed data
+    u64			data_offset;	// base offset for the RVZ junk generator
+
+    u8			* gdata;	// group data, swapped with 'wia->gdata'
+    u8			* hbuf;		// buffer for hash exceptions and tables
+    u32			hbuf_size;	// size of 'hbuf'
+    u8			* inbuf;	// NULL or buffer for compressed data
+    u32			inbuf_size;	// alloced size of 'inbuf'
+    u32			in_used;	// number of bytes read from file
+    enumError		err;		// result of decompression
+
+} wia_rjob_t;
 
-    char * buf = p_buf;
-    memset(buf,0,count);
+///////////////////////////////////////////////////////////////////////////////
 
-    if (SIGINT_level>1)
-	return ERR_INTERRUPT;
+static bool get_group_info
+(
+    const wia_controller_t * wia,	// valid controller
+    int			group,		// index of group
+    int			* part_index,	// store partition index, -1 for raw data
+    u32			* size		// store size of group data
+)
+{
+    // find the memmap item of 'group' and calculate the parameters
+    // exactly as ReadWIA() does.
 
-    wia_controller_t * wia = sf->wia;
-    if (!wia->is_valid)
-	return ERR_WIA_INVALID;
+    DASSERT(wia);
+    DASSERT(part_index);
+    DASSERT(size);
 
-    const u64 off2 = off + count;
     const wd_memmap_item_t * item = wia->memmap.item;
     const wd_memmap_item_t * item_end = item + wia->memmap.used;
 
-    for ( ; item < item_end && item->offset < off2; item++ )
+    for ( ; item < item_end; item++ )
     {
-      const u64 end = item->offset + item->size;
-      noTRACE("> off=%llx..%llx, item=%llx..%llx\n", (u64)off, off2, item->offset, end );
+	const u64 end = item->offset + item->size;
+	u64 base_off;
+	int ig;
+
+	switch (item->mode)
+	{
+	 case WIA_MM_RAW_GDATA:
+	    {
+		const wia_raw_data_t * rdata = wia->raw_data + item->index;
+		ig = group - (int)ntohl(rdata->group_index);
+		if ( ig < 0 || ig >= ntohl(rdata->n_groups) )
+		    continue;
+		base_off = item->offset / WII_SECTOR_SIZE * WII_SECTOR_SIZE
+			 + ig * (u64)wia->chunk_size;
+		*part_index = -1;
+	    }
+	    break;
+
+	 case WIA_MM_PART_GDATA_0:
+	 case WIA_MM_PART_GDATA_1:
+	    {
+		const wia_part_data_t * pd = wia->part[item->index].pd
+					   + ( item->mode - WIA_MM_PART_GDATA_0 );
+		ig = group - (int)pd->group_index;
+		if ( ig < 0 || ig >= pd->n_groups )
+		    continue;
+		base_off = item->offset + ig * (u64)wia->chunk_size;
+		*part_index = item->index;
+	    }
+	    break;
+
+	 default:
+	    continue;
+	}
+
+	u64 end_off = base_off + wia->chunk_size;
+	if ( end_off > end )
+	     end_off = end;
+	*size = end_off - base_off;
+	return true;
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setup_read_jobs
+(
+    wia_controller_t	* wia		// valid pointer
+)
+{
+    // Setup a pool of threads and a list of read ahead jobs.
+    // The number of jobs is limited by WIA_READ_AHEAD_MEM and
+    // by the half of the available memory (option --mem).
+
+    DASSERT(wia);
+    DASSERT(!wia->tpool);
+    DASSERT(!wia->rjob);
+
+    wia->ra_disabled = true;
+    uint n_threads = GetThreadCount();
+    if ( n_threads <= 1 || wia->sub_chunks > 1 )
+    {
+	// small RVZ chunks are joined by read_sub_gdata() => no read ahead
+	return;
+    }
+
+    const u32 hbuf_size = wia->chunk_groups
+			* ( WII_GROUP_SIZE + sizeof(wia_except_list_t)
+				+ WII_N_HASH_GROUP * sizeof(wia_exception_t) );
+    const u64 job_mem	= wia->gdata_size + hbuf_size
+			+ ( wia->disc.compression >= WD_COMPR__FIRST_REAL
+				? wia->chunk_size / 2 : 0 );
+    const u64 thread_mem = CalcMemoryUsageWIA( wia->disc.compression,
+				wia->disc.compr_level, wia->chunk_size, false )
+			 - wia->chunk_size;
+
+    u64 max_mem = GetMemLimit();
+    if (!max_mem) // memory limit unknown
+	max_mem = WIA_READ_AHEAD_MEM;
+    else
+	max_mem = max_mem > wia->memory_usage ? ( max_mem - wia->memory_usage ) / 2 : 0;
+    if ( max_mem > WIA_READ_AHEAD_MEM )
+	 max_mem = WIA_READ_AHEAD_MEM;
+
+    uint n_jobs = 2 * n_threads;
+    while ( n_jobs > 1 && n_jobs * job_mem + n_threads * thread_mem > max_mem )
+    {
+	n_jobs--;
+	if ( n_threads > n_jobs )
+	    n_threads = n_jobs;
+    }
+    if ( n_jobs < 2 )
+	return;
+
+    wia->tpool = MALLOC(sizeof(*wia->tpool));
+    InitializeThreadPool(wia->tpool,n_threads);
+    if (!wia->tpool->n_threads)
+    {
+	FREE(wia->tpool);
+	wia->tpool = 0;
+	return;
+    }
+
+    wia->n_rjobs = n_jobs;
+    wia->rjob = CALLOC(wia->n_rjobs,sizeof(*wia->rjob));
+
+    uint i;
+    for ( i = 0; i < wia->n_rjobs; i++ )
+    {
+	wia_rjob_t * job = wia->rjob + i;
+	job->wia	= wia;
+	job->group	= -1;
+	job->gdata	= MALLOC(wia->gdata_size);
+	job->hbuf_size	= hbuf_size;
+	job->hbuf	= MALLOC(hbuf_size);
+    }
+
+    wia->ra_disabled = false;
+    wia->memory_usage += n_jobs * job_mem + n_threads * thread_mem;
+    PRINT("WIA: %u read ahead threads, %u jobs, %llu MiB\n",
+		wia->tpool->n_threads, wia->n_rjobs,
+		( n_jobs * job_mem + n_threads * thread_mem ) / MiB );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void decompress_job
+(
+    ThreadJob_t		* tjob		// valid job, embedded in wia_rjob_t
+)
+{
+    // This function is executed by worker threads.
+    // Global data is accessed read only and no error is printed. An error
+    // is stored in 'job->err' and reported by load_gdata().
+
+    DASSERT(tjob);
+    wia_rjob_t * job = (wia_rjob_t*)tjob;
+    wia_controller_t * wia = job->wia;
+    DASSERT(wia);
+
+    bool have_except = job->part >= 0;
+    const u32 data_size = have_except
+			? job->size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE
+			: job->size;
+    memset(job->gdata+data_size,0,wia->gdata_size-data_size);
+
+    const bool use_hbuf = have_except || job->packed_size;
+    u8 * dest	  = use_hbuf ? job->hbuf : job->gdata;
+    u32 dest_size = use_hbuf ? job->hbuf_size : data_size;
+
+    bool align_except = false;
+    u32 data_bytes_read = 0;
+    enumError err = ERR_OK;
+
+    switch (job->compr)
+    {
+      case WD_COMPR_NONE:
+	// data is already read into 'dest'
+	data_bytes_read = job->in_used;
+	align_except = true;
+	break;
+
+      case WD_COMPR_PURGE:
+	{
+	    // data is already read into 'hbuf'
+	    u32 file_data_size = job->in_used - WII_HASH_SIZE;
+	    sha1_hash_t hash;
+	    SHA1(job->hbuf,file_data_size,hash);
+	    if (memcmp(hash,job->hbuf+file_data_size,WII_HASH_SIZE))
+	    {
+		err = ERR_WIA_INVALID;
+		break;
+	    }
+
+	    const u32 except_size = have_except
+		? calc_except_size(job->hbuf,wia->chunk_groups) + 3 & ~(u32)3 : 0;
+	    wia_segment_t * seg = (wia_segment_t*)( job->hbuf + except_size );
+	    err = expand_segments( 0, seg, job->hbuf+file_data_size,
+				job->gdata, data_size );
+	    data_bytes_read = data_size; // extraction is ok
+	    have_except = false; // no more exception handling needed
+	}
+	break;
+
+      case WD_COMPR_BZIP2:
+ #ifdef NO_BZIP2
+	err = ERR_NOT_IMPLEMENTED;
+ #else
+	err = DecBZIP2_Buf2Buf( 0, dest, dest_size, &data_bytes_read,
+				job->inbuf, job->in_used );
+ #endif
+	break;
+
+      case WD_COMPR_LZMA:
+	err = DecLZMA_Buf2Buf( 0, job->inbuf, job->in_used,
+			dest, dest_size, &data_bytes_read, wia->disc.compr_data );
+	break;
+
+      case WD_COMPR_LZMA2:
+	err = DecLZMA2_Buf2Buf( 0, job->inbuf, job->in_used,
+			dest, dest_size, &data_bytes_read, wia->disc.compr_data );
+	break;
+
+      case WD_COMPR_ZSTD:
+ #ifdef HAVE_ZSTD
+	err = DecZSTD_Buf2Buf( 0, dest, dest_size, &data_bytes_read,
+				job->inbuf, job->in_used );
+ #else
+	err = ERR_NOT_IMPLEMENTED;
+ #endif
+	break;
+
+      case WD_COMPR__N:
+	err = ERR_INTERNAL;
+    }
+
+    u32 except_size = 0;
+    if ( !err && have_except )
+    {
+	except_size = calc_except_size(dest,wia->chunk_groups);
+	if (align_except)
+	    except_size = except_size + 3 & ~(u32)3;
+	data_bytes_read -= except_size;
+    }
+
+    const u32 expected_size = job->packed_size ? job->packed_size : data_size;
+    if ( !err && data_bytes_read != expected_size )
+	err = ERR_WIA_INVALID;
+
+    if ( !err && job->packed_size )
+	err = unpack_rvz_data( 0, dest + except_size, job->packed_size,
+				job->gdata, data_size, job->data_offset );
+    else if ( !err && have_except )
+	memcpy( job->gdata, dest + except_size, data_size );
+
+    if ( !err && job->part >= 0 )
+	join_part_data(wia,job->gdata,&job->akey,job->hbuf,job->hbuf_size,job->group);
+
+    job->err = err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static wia_rjob_t * find_read_job
+(
+    wia_controller_t	* wia,		// valid controller
+    int			group		// group to find
+)
+{
+    DASSERT(wia);
+
+    wia_rjob_t *job = wia->rjob, *job_end = job + wia->n_rjobs;
+    for ( ; job < job_end; job++ )
+	if ( job->group == group )
+	    return job;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError start_read_job
+(
+    SuperFile_t		* sf,		// source file
+    wia_rjob_t		* job,		// unused job
+    int			group		// group to read
+)
+{
+    // Read the compressed data of 'group' and pass it to a worker thread.
+    // Groups, that can't be handled, are ignored and loaded later by
+    // read_gdata() or read_part_gdata(), which also report the errors.
+
+    DASSERT(sf);
+    DASSERT(job);
+    DASSERT( job->group < 0 );
+
+    wia_controller_t * wia = sf->wia;
+    DASSERT(wia);
+
+    int part;
+    u32 size;
+    if ( !get_group_info(wia,group,&part,&size) || size > wia->gdata_size )
+	return ERR_OK;
+
+    const wia_group_t * grp = wia->group + group;
+    const u32 gsize = ntohl(grp->data_size);
+    if ( !gsize || gsize > 2 * tempbuf_size )
+	return ERR_OK;
+
+    const bool have_except = part >= 0;
+    const u32 data_size = have_except
+			? size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE
+			: size;
+    const wd_compression_t compr = get_group_compression(wia,group);
+    const u32 packed_size = get_packed_size(wia,group);
+    const bool use_hbuf = have_except || packed_size;
+    if ( packed_size > job->hbuf_size )
+	return ERR_OK;
+
+    u8 * dest;
+    switch (compr)
+    {
+      case WD_COMPR_NONE:
+	if ( gsize > ( use_hbuf ? job->hbuf_size : data_size ) )
+	    return ERR_OK;
+	dest = use_hbuf ? job->hbuf : job->gdata;
+	break;
+
+      case WD_COMPR_PURGE:
+	if ( gsize > job->hbuf_size || gsize <= WII_HASH_SIZE )
+	    return ERR_OK;
+	dest = job->hbuf;
+	break;
+
+      default:
+	if ( job->inbuf_size < gsize )
+	{
+	    FREE(job->inbuf);
+	    job->inbuf_size = gsize + 0x10000;
+	    job->inbuf = MALLOC(job->inbuf_size);
+	}
+	dest = job->inbuf;
+	break;
+    }
+
+    enumError err = ReadAtF( &sf->f, (u64)ntohl(grp->data_off4)<<2, dest, gsize );
+    if (err)
+	return err;
+
+    job->group		= group;
+    job->part		= part;
+    job->size		= size;
+    job->in_used	= gsize;
+    job->compr		= compr;
+    job->packed_size	= packed_size;
+    job->data_offset	= packed_size ? calc_rvz_data_offset(wia,group,part) : 0;
+    if ( part >= 0 )
+	wd_aes_set_key(&job->akey,wia->part[part].part_key);
+
+    noPRINT("READ AHEAD: group %d, part %d, size %x, file size %x\n",
+		group, part, size, gsize );
+    AddThreadJob(wia->tpool,&job->tjob,decompress_job,0);
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError read_ahead
+(
+    SuperFile_t		* sf,		// source file
+    int			group		// current group
+)
+{
+    // Start jobs for the groups behind 'group', if not already done.
+
+    DASSERT(sf);
+    wia_controller_t * wia = sf->wia;
+    DASSERT(wia);
+
+    if (!wia->rjob)
+    {
+	if ( wia->ra_disabled || wia->tpool )
+	    return ERR_OK;
+	setup_read_jobs(wia);
+	if (!wia->rjob)
+	    return ERR_OK;
+    }
+
+    const int max_group = group + wia->n_rjobs;
+    int next;
+    for ( next = group + 1; next <= max_group && next < wia->group_used; next++ )
+    {
+	if (find_read_job(wia,next))
+	    continue;
+
+	//--- find a job outside the read ahead window
+
+	wia_rjob_t *job = wia->rjob, *job_end = job + wia->n_rjobs;
+	for ( ; job < job_end; job++ )
+	    if ( job->group <= group || job->group > max_group )
+		break;
+	if ( job == job_end )
+	    break;
+
+	if ( job->group >= 0 )
+	{
+	    // discard the result of an unused job
+	    WaitThreadJob(wia->tpool,&job->tjob);
+	    job->group = -1;
+	}
+
+	enumError err = start_read_job(sf,job,next);
+	if (err)
+	    return err;
+    }
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError load_gdata
+(
+    SuperFile_t		* sf,		// source file
+    int			part_index,	// -1 or partition index
+    u32			group,		// group index
+    u32			size		// group size
+)
+{
+    // Load a group into 'wia->gdata'. Take it from a read ahead job
+    // if available. Start read ahead if sequential access is detected.
+
+    DASSERT(sf);
+    wia_controller_t * wia = sf->wia;
+    DASSERT(wia);
+
+    if ( group == wia->ra_last_group + 1 )
+	wia->ra_seq_count++;
+    else
+	wia->ra_seq_count = 0;
+    wia->ra_last_group = group;
+
+    enumError err = ERR_OK;
+    wia_rjob_t * job = wia->rjob ? find_read_job(wia,group) : 0;
+    if ( job && job->part == part_index && job->size == size )
+    {
+	WaitThreadJob(wia->tpool,&job->tjob);
+	job->group = -1;
+	if (!job->err)
+	{
+	    u8 * temp	= job->gdata;
+	    job->gdata	= wia->gdata;
+	    wia->gdata	= temp;
+
+	    wia->gdata_group = group;
+	    if ( part_index >= 0 && wia->gdata_part != part_index )
+	    {
+		wia->gdata_part = part_index;
+		memcpy(&wia->akey,&job->akey,sizeof(wia->akey));
+	    }
+	    wia->ra_hits++;
+	}
+	else
+	{
+	    // the worker doesn't print errors
+	    //  => load the group again to report the error by this thread
+	    PRINT("READ AHEAD FAILED: group %u, err %d\n",group,job->err);
+	    job = 0;
+	}
+    }
+    else
+	job = 0;
+
+    if (!job)
+    {
+	if (wia->rjob)
+	    wia->ra_misses++;
+	err = part_index < 0
+		? read_gdata(sf,-1,group,size,false)
+		: read_part_gdata(sf,part_index,group,size);
+    }
+
+    if ( !err && wia->ra_seq_count >= WIA_READ_AHEAD_TRIGGER )
+	err = read_ahead(sf,group);
+    return err;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			    ReadWIA()			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+enumError ReadWIA 
+(
+    struct SuperFile_t	* sf,		// source file
+    off_t		off,		// file offset
+    void		* p_buf,	// destination buffer
+    size_t		count		// number of bytes to read
+)
+{
+    ASSERT(sf);
+    ASSERT(sf->wia);
+
+    TRACE("#W# -----\n");
+    TRACE(TRACE_RDWR_FORMAT, "#W# ReadWIA()",
+		GetFD(&sf->f), GetFP(&sf->f),
+		(u64)off, (u64)off+count, count, "" );
+
+    char * buf = p_buf;
+    memset(buf,0,count);
+
+    if (SIGINT_level>1)
+	return ERR_INTERRUPT;
+
+    wia_controller_t * wia = sf->wia;
+    if (!wia->is_valid)
+	return ERR_WIA_INVALID;
+
+    const u64 off2 = off + count;
+    const wd_memmap_item_t * item = wia->memmap.item;
+    const wd_memmap_item_t * item_end = item + wia->memmap.used;
+
+    for ( ; item < item_end && item->offset < off2; item++ )
+    {
+      const u64 end = item->offset + item->size;
+      noTRACE("> off=%llx..%llx, item=%llx..%llx\n", (u64)off, off2, item->offset, end );
       if ( item->offset < off2 && end > off )
       {
 	u64 overlap1 = item->offset > off ? item->offset : off;
@@ -864,7 +1747,8 @@ enumError ReadWIA
 		    const int base_sector = item->offset / WII_SECTOR_SIZE;
 		    const int sector      = overlap1 / WII_SECTOR_SIZE - base_sector;
 		    const int base_group  = sector / wia->chunk_sectors;
-		    const int group       = base_group + ntohl(rdata->group_index);
+		    const int group       = base_group * wia->sub_chunks
+					  + ntohl(rdata->group_index);
 
 		    u64 base_off = base_sector * (u64)WII_SECTOR_SIZE
 				 + base_group  * (u64)wia->chunk_size;
@@ -876,7 +1760,7 @@ enumError ReadWIA
 			    base_sector, sector,
 			    base_group, group, wia->group_used,
 			    base_off, end_off, end );
-		    DASSERT( base_group < ntohl(rdata->n_groups) );
+		    DASSERT( base_group * wia->sub_chunks < ntohl(rdata->n_groups) );
 		    DASSERT( group >= 0 && group < wia->group_used );
 
 		    if ( group != wia->gdata_group )
@@ -884,8 +1768,8 @@ enumError ReadWIA
 			noPRINT("----- SETUP RAW%4u GROUP %4u/%4u>%4u, off=%9llx, size=%6llx\n",
 				item->index, base_group, ntohl(rdata->n_groups), group,
 				base_off, end_off - base_off );
-			enumError err = read_gdata( sf, group, end_off - base_off, false );
-			DASSERT( group == wia->gdata_group );
+			enumError err = load_gdata( sf, -1, group, end_off - base_off );
+			DASSERT( err || group == wia->gdata_group );
 			if (err)
 			    return err;
 		    }
@@ -917,12 +1801,13 @@ enumError ReadWIA
 		while ( overlap1 < overlap2 )
 		{
 		    int group = ( overlap1 - item->offset ) / wia->chunk_size;
-		    DASSERT( group < pd->n_groups );
 		    u64 base_off = item->offset + group * (u64)wia->chunk_size;
 		    u64 end_off  = base_off + wia->chunk_size;
 		    if ( end_off > end )
 			 end_off = end;
 
+		    group = group * wia->sub_chunks;
+		    DASSERT( group < pd->n_groups );
 		    group += pd->group_index;
 		    DASSERT( group >= 0 && group < wia->group_used );
 
@@ -933,7 +1818,7 @@ enumError ReadWIA
 				group - pd->group_index, pd->n_groups, group,
 				base_off, end_off-base_off );
 			enumError err
-			    = read_part_gdata( sf, item->index, group, end_off-base_off );
+			    = load_gdata( sf, item->index, group, end_off-base_off );
 			if (err)
 			    return err;
 		    }
@@ -1034,6 +1919,8 @@ enumError SetupReadWIA
     wia_controller_t * wia = CALLOC(1,sizeof(*wia));
     sf->wia = wia;
     wia->gdata_group = wia->gdata_part = -1;  // reset gdata
+    wia->ra_last_group = -1;
+    wia->sub_chunks = 1;
     wia->encrypt = encoding & ENCODE_ENCRYPT || !( encoding & ENCODE_DECRYPT );
 
     AllocBufferWIA(wia,WIA_BASE_CHUNK_SIZE,false,false);
@@ -1046,26 +1933,35 @@ enumError SetupReadWIA
     if (err)
 	return err;
 
-    const bool is_wia = IsWIA(fhead,sizeof(*fhead),0,0,0);
+    wia->is_rvz = IsRVZ(fhead,sizeof(*fhead),0,0,0);
+    const bool is_wia = wia->is_rvz || IsWIA(fhead,sizeof(*fhead),0,0,0);
     wia_ntoh_file_head(fhead,fhead);
     if ( !is_wia || fhead->disc_size > MiB )
 	return ERROR0(ERR_WIA_INVALID,"Invalid file header: %s\n",sf->f.fname);
 
-    if ( WIA_VERSION < fhead->version_compatible
-	|| fhead->version < WIA_VERSION_READ_COMPATIBLE )
+    const ccp fname = wia->is_rvz ? "RVZ" : "WIA";
+    const enumOFT oft = wia->is_rvz ? OFT_RVZ : OFT_WIA;
+    const u32 version = wia->is_rvz ? RVZ_VERSION : WIA_VERSION;
+    const u32 version_read_compatible = wia->is_rvz
+		? RVZ_VERSION_READ_COMPATIBLE : WIA_VERSION_READ_COMPATIBLE;
+
+    if ( version < fhead->version_compatible
+	|| fhead->version < version_read_compatible )
     {
-	if ( WIA_VERSION_READ_COMPATIBLE < WIA_VERSION )
+	if ( version_read_compatible < version )
 	    return ERROR0(ERR_WIA_INVALID,
-		"WIA version %s is not supported (compatible %s .. %s): %s\n",
+		"%s version %s is not supported (compatible %s .. %s): %s\n",
+		fname,
 		PrintVersionWIA(0,0,fhead->version),
-		PrintVersionWIA(0,0,WIA_VERSION_READ_COMPATIBLE),
-		PrintVersionWIA(0,0,WIA_VERSION),
+		PrintVersionWIA(0,0,version_read_compatible),
+		PrintVersionWIA(0,0,version),
 		sf->f.fname );
 	else
 	    return ERROR0(ERR_WIA_INVALID,
-		"WIA version %s is not supported (%s expected): %s\n",
+		"%s version %s is not supported (%s expected): %s\n",
+		fname,
 		PrintVersionWIA(0,0,fhead->version),
-		PrintVersionWIA(0,0,WIA_VERSION),
+		PrintVersionWIA(0,0,version),
 		sf->f.fname );
     }
 
@@ -1073,7 +1969,7 @@ enumError SetupReadWIA
     //----- check file size
 
     if ( sf->f.st.st_size < fhead->wia_file_size )
-	SetupSplitFile(&sf->f,OFT_WIA,0);
+	SetupSplitFile(&sf->f,oft,0);
 
     if ( sf->f.st.st_size != fhead->wia_file_size )
 	return ERROR0(ERR_WIA_INVALID,
@@ -1100,8 +1996,21 @@ enumError SetupReadWIA
     wia_disc_t *disc = &wia->disc;
     wia_ntoh_disc(disc,(wia_disc_t*)tempbuf);
 
-    AllocBufferWIA(wia,disc->chunk_size,false,false);
-    if ( wia->chunk_size != disc->chunk_size )
+    if ( wia->is_rvz
+	&& disc->chunk_size >= RVZ_MIN_CHUNK_SIZE
+	&& disc->chunk_size < WIA_BASE_CHUNK_SIZE
+	&& !( disc->chunk_size & disc->chunk_size - 1 ) )
+    {
+	// join small RVZ chunks to internal chunks of WIA_BASE_CHUNK_SIZE
+	wia->sub_chunks = WIA_BASE_CHUNK_SIZE / disc->chunk_size;
+	wia->xlist = MALLOC( sizeof(wia_except_list_t)
+			   + WII_N_HASH_GROUP * sizeof(wia_exception_t) );
+	AllocBufferWIA(wia,WIA_BASE_CHUNK_SIZE,false,false);
+    }
+    else
+	AllocBufferWIA(wia,disc->chunk_size,false,false);
+
+    if ( wia->chunk_size != disc->chunk_size * wia->sub_chunks )
 	return ERROR0(ERR_WIA_INVALID,
 	    "Only multiple of %s, but not %s, are supported as a chunk size: %s\n",
 		wd_print_size_1024(0,0,wia->chunk_size,false),
@@ -1145,10 +2054,16 @@ enumError SetupReadWIA
     {
 	case WD_COMPR__N:
 	case WD_COMPR_NONE:
-	case WD_COMPR_PURGE:
 	    // nothing to do
 	    break;
 
+	case WD_COMPR_PURGE:
+	    if (wia->is_rvz)
+		return ERROR0(ERR_WIA_INVALID,
+			"Compression method PURGE is not allowed for RVZ: %s\n",
+			sf->f.fname );
+	    break;
+
 	case WD_COMPR_BZIP2:
 	 #ifdef NO_BZIP2
 	    return ERROR0(ERR_NOT_IMPLEMENTED,
@@ -1169,6 +2084,15 @@ enumError SetupReadWIA
 	    wia->memory_usage += CalcMemoryUsageLZMA2(disc->compr_level,false);
 	    break;
 
+	case WD_COMPR_ZSTD:
+	 #ifndef HAVE_ZSTD
+	    return ERROR0(ERR_NOT_IMPLEMENTED,
+			"No zstd support for this release! Sorry!\n");
+	 #else
+	    wia->memory_usage += CalcMemoryUsageZSTD(disc->compr_level,false);
+	 #endif
+	    break;
+
 	default:
 	    return ERROR0(ERR_NOT_IMPLEMENTED,
 			"No support for compression method #%u (%x/hex, %s)\n",
@@ -1188,7 +2112,7 @@ enumError SetupReadWIA
 	const u32 raw_data_len = wia->raw_data_used * sizeof(wia_raw_data_t);
 	wia->raw_data = MALLOC(raw_data_len);
 
-	err = read_data( sf, disc->raw_data_off, disc->raw_data_size,
+	err = read_data( sf, disc->compression, disc->raw_data_off, disc->raw_data_size,
 			 0, wia->raw_data, raw_data_len );
 	if (err)
 	    return err;
@@ -1208,10 +2132,33 @@ enumError SetupReadWIA
 	const u32 group_len = wia->group_used * sizeof(wia_group_t);
 	wia->group = MALLOC(group_len);
 
-	err = read_data( sf, disc->group_off, disc->group_size,
-			 0, wia->group, group_len );
-	if (err)
-	    return err;
+	if (wia->is_rvz)
+	{
+	    // RVZ: keep the original table and strip the compression flag
+	    const u32 rvz_len = wia->group_used * sizeof(rvz_group_t);
+	    wia->rvz_group = MALLOC(rvz_len);
+	    err = read_data( sf, disc->compression, disc->group_off,
+				disc->group_size, 0, wia->rvz_group, rvz_len );
+	    if (err)
+		return err;
+
+	    uint ig;
+	    for ( ig = 0; ig < wia->group_used; ig++ )
+	    {
+		const rvz_group_t * rg = wia->rvz_group + ig;
+		wia_group_t * grp = wia->group + ig;
+		grp->data_off4 = rg->data_off4;
+		grp->data_size = htonl( ntohl(rg->data_size) & ~RVZ_COMPRESSED );
+	    }
+	    wia->memory_usage += rvz_len;
+	}
+	else
+	{
+	    err = read_data( sf, disc->compression, disc->group_off,
+				disc->group_size, 0, wia->group, group_len );
+	    if (err)
+		return err;
+	}
 
 	wia->memory_usage += wia->group_size * sizeof(*wia->group);
     }
@@ -1299,7 +2246,7 @@ enumError SetupReadWIA
 
     if ( logging > 0 )
     {
-	printf("\nWIA memory map:\n\n");
+	printf("\n%s memory map:\n\n",fname);
 	wd_print_memmap(stdout,3,&wia->memmap);
 	putchar('\n');
     }
@@ -1309,7 +2256,7 @@ enumError SetupReadWIA
 
     sf->file_size = fhead->iso_file_size;
     wia->is_valid = true;
-    SetupIOD(sf,OFT_WIA,OFT_WIA);
+    SetupIOD(sf,oft,oft);
 
     return ERR_OK;
 }
@@ -1384,6 +2331,176 @@ static wia_segment_t * calc_segments
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static u8 * store_rvz_block
+(
+    u8			* dest,		// destination buffer
+    const void		* data,		// NULL or data
+    u32			size,		// size of data
+    const void		* seed		// NULL or seed of junk data
+)
+{
+    DASSERT(dest);
+
+    const u32 head = htonl( seed ? size | RVZ_JUNK : size );
+    memcpy(dest,&head,sizeof(head));
+    dest += sizeof(head);
+
+    if (seed)
+    {
+	memcpy(dest,seed,LFG_SEED_SIZE*4);
+	return dest + LFG_SEED_SIZE*4;
+    }
+
+    memcpy(dest,data,size);
+    return dest + size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 pack_rvz_data
+(
+    u8			* dest,		// destination buffer
+    u32			dest_size,	// size of 'dest'
+    const u8		* src,		// data to pack
+    u32			src_size,	// size of 'src'
+    u64			data_offset	// base offset for the junk generator
+)
+{
+    // This is the reverse of unpack_rvz_data(). Junk data is searched
+    // for each sector, because the generator is reseeded for each sector.
+    // Return the size of the packed data or 0, if no junk data was found.
+    // This function is used by write_data() and by compression threads.
+
+    DASSERT(dest);
+    DASSERT(src);
+
+    u8 *d = dest, *dest_end = dest + dest_size;
+    u8 *junk = 0;
+    u8 seed[LFG_SEED_SIZE*4];
+    u32 pos = 0, lit = 0;
+
+    while ( pos < src_size )
+    {
+	const u32 sect_off = ( data_offset + pos ) % WII_SECTOR_SIZE;
+	u32 sect_end = pos + WII_SECTOR_SIZE - sect_off;
+	if ( sect_end > src_size )
+	    sect_end = src_size;
+
+	//--- find the seed of the sector
+
+	bool found = false;
+	uint n_fails = 0;
+	u32 p = pos + ( -sect_off & 3 );
+	while ( p + LFG_BUF_SIZE <= sect_end )
+	{
+	    const u32 n = CheckJunkLFG(src+p,LFG_BUF_SIZE);
+	    if ( n < LFG_BUF_SIZE )
+	    {
+		p += n + 4;
+		continue;
+	    }
+
+	    if (DetectJunkLFG(seed,src+p,sect_end-p,sect_off+p-pos))
+	    {
+		found = true;
+		break;
+	    }
+
+	    if ( ++n_fails >= RVZ_MAX_SEED_TRIES )
+		break;
+	    p += 4;
+	}
+
+	//--- compare the sector with the junk and store long matches as seed
+
+	if (found)
+	{
+	    const u32 len = sect_end - pos;
+	    if (!junk)
+		junk = MALLOC(WII_SECTOR_SIZE);
+
+	    LFG_t lfg;
+	    SetSeedLFG(&lfg,seed);
+	    ForwardLFG(&lfg,sect_off);
+	    GetBytesLFG(&lfg,junk,len);
+
+	    const u8 *data = src + pos;
+	    u32 i = 0;
+	    while ( i < len )
+	    {
+		while ( i < len && data[i] != junk[i] )
+		    i++;
+		const u32 beg = i;
+		while ( i < len && data[i] == junk[i] )
+		    i++;
+
+		if ( i - beg >= RVZ_MIN_JUNK_SIZE )
+		{
+		    const u32 lit_size = pos + beg - lit;
+		    if ( d + lit_size + 8 + LFG_SEED_SIZE*4 > dest_end )
+		    {
+			FREE(junk);
+			return 0;
+		    }
+		    if (lit_size)
+			d = store_rvz_block(d,src+lit,lit_size,0);
+		    d = store_rvz_block(d,0,i-beg,seed);
+		    lit = pos + i;
+		}
+	    }
+	}
+	pos = sect_end;
+    }
+
+    FREE(junk);
+    if ( !lit )
+	return 0;
+
+    if ( lit < src_size )
+    {
+	const u32 lit_size = src_size - lit;
+	if ( d + lit_size + 4 > dest_end )
+	    return 0;
+	d = store_rvz_block(d,src+lit,lit_size,0);
+    }
+
+    noPRINT("RVZ PACK: %llx+%x => %zx\n",data_offset,src_size,d-dest);
+    return d - dest;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void set_group_entry
+(
+    wia_controller_t	* wia,		// valid controller
+    int			group,		// index of group, ignored if invalid
+    u32			written,	// number of written bytes
+    u32			packed_size	// RVZ only: >0: size of packed data
+)
+{
+    // store the group data at 'wia->write_data_off' into the group table(s)
+
+    DASSERT(wia);
+    if ( group < 0 || group >= wia->group_used )
+	return;
+
+    wia_group_t * grp = wia->group + group;
+    grp->data_off4 = htonl( written ? wia->write_data_off >> 2 : 0 );
+    grp->data_size = htonl( written );
+
+    if (wia->rvz_group)
+    {
+	rvz_group_t * rg = wia->rvz_group + group;
+	rg->data_off4	= grp->data_off4;
+	rg->data_size	= htonl( written
+			&& wia->disc.compression >= WD_COMPR__FIRST_REAL
+				? written | RVZ_COMPRESSED : written );
+	rg->packed_size	= htonl( written ? packed_size : 0 );
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static enumError write_data
 (
     struct SuperFile_t	* sf,		// destination file
@@ -1391,6 +2508,7 @@ static enumError write_data
     const void		* data_ptr,	// NULL or u32-aligned pointer to data
     u32			data_size,	// size of data, u32-aligned
     int			group,		// >=0: write group data
+    int			part_index,	// -1 or index of partition of 'group'
     u32			* write_count	// not NULL: store written data count
 )
 {
@@ -1401,6 +2519,19 @@ static enumError write_data
     wia_controller_t * wia = sf->wia;
     DASSERT(wia);
 
+    u32 packed_size = 0;
+    if ( wia->rvz_group && group >= 0 && data_size )
+    {
+	if ( wia->pdata_size < data_size )
+	{
+	    FREE(wia->pdata);
+	    wia->pdata_size = data_size;
+	    wia->pdata = MALLOC(data_size);
+	}
+	packed_size = pack_rvz_data( wia->pdata, wia->pdata_size, data_ptr, data_size,
+				calc_rvz_data_offset(wia,group,part_index) );
+    }
+
     u32 except_size = except ? calc_except_size(except,wia->chunk_groups) : 0;
     TRACE_IF( except_size > wia->chunk_groups * sizeof(wia_except_list_t),
 		"%zd exceptions in group %d, size=%u=0x%x\n",
@@ -1409,6 +2540,12 @@ static enumError write_data
 		group, except_size, except_size );
 
     DefineProgressChunkSF(sf,data_size,data_size+except_size);
+    if (packed_size)
+    {
+	// packed data is not u32 aligned
+	data_ptr  = wia->pdata;
+	data_size = packed_size;
+    }
 
     u32 written = 0;
     switch((wd_compression_t)wia->disc.compression)
@@ -1505,20 +2642,597 @@ static enumError write_data
 	noPRINT(">> WRITE BZIP2: %9llx, %6x+%6x => %6x, grp %d\n",
 		    wia->write_data_off, except_size, data_size, written, group );
 
-	sf->f.max_off = wia->write_data_off + written;
+	sf->f.max_off = wia->write_data_off + written;
+      }
+      break;
+ #endif // !NO_BZIP2
+
+      //----------------------------------------------------------------------
+
+      case WD_COMPR_LZMA:
+      case WD_COMPR_LZMA2:
+      {
+	enumError err = SeekF(&sf->f,wia->write_data_off);
+	if (err)
+	    return err;
+
+	DataArea_t area[3], *ap = area;
+	if (except_size)
+	{
+	    ap->data = (u8*)except;
+	    ap->size = except_size;
+	    ap++;
+	}
+	if (data_size)
+	{
+	    ap->data = data_ptr;
+	    ap->size = data_size;
+	    ap++;
+	}
+	ap->data = 0;
+
+	DataList_t list;
+	SetupDataList(&list,area);
+
+	err = wia->disc.compression == WD_COMPR_LZMA
+		? EncLZMA_List2File (0,sf,opt_compr_level,false,true,&list,&written)
+		: EncLZMA2_List2File(0,sf,opt_compr_level,false,true,&list,&written);
+	if (err)
+	    return err;
+
+	noPRINT(">> WRITE LZMA: %9llx, %6x+%6x => %6x, grp %d\n",
+		    wia->write_data_off, except_size, data_size, written, group );
+      }
+      break;
+
+      //----------------------------------------------------------------------
+
+      case WD_COMPR_ZSTD:
+ #ifndef HAVE_ZSTD
+	return ERROR0(ERR_NOT_IMPLEMENTED,
+			"No WIA/ZSTD support for this release! Sorry!\n");
+ #else
+      {
+	DataArea_t area[3], *ap = area;
+	if (except_size)
+	{
+	    ap->data = (u8*)except;
+	    ap->size = except_size;
+	    ap++;
+	}
+	if (data_size)
+	{
+	    ap->data = data_ptr;
+	    ap->size = data_size;
+	    ap++;
+	}
+	ap->data = 0;
+
+	// a zstd frame is never much larger than its source
+	const uint out_size = except_size + data_size
+			    + ( except_size + data_size ) / 8 + 0x10000;
+	u8 * out = MALLOC(out_size);
+	uint out_used;
+	enumError err = EncZSTD_List2Buf( sf->f.fname, out, out_size, &out_used,
+					area, opt_compr_level );
+	if (!err)
+	    err = WriteAtF( &sf->f, wia->write_data_off, out, out_used );
+	FREE(out);
+	if (err)
+	    return err;
+	written = out_used;
+
+	noPRINT(">> WRITE ZSTD: %9llx, %6x+%6x => %6x, grp %d\n",
+		    wia->write_data_off, except_size, data_size, written, group );
+      }
+      break;
+ #endif // HAVE_ZSTD
+
+      //----------------------------------------------------------------------
+
+      // no default case defined
+      //	=> compiler checks the existence of all enum values
+
+      case WD_COMPR__N:
+	ASSERT(0);
+    }
+
+
+    set_group_entry(wia,group,written,packed_size);
+
+    wia->write_data_off += written + 3 & ~3;
+    if ( sf->f.bytes_written > wia->disc.chunk_size )
+	sf->progress_trigger++;
+
+    if (write_count)
+	*write_count = written;
+
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static void split_part_data
+(
+    const wia_controller_t * wia,	// valid controller
+    u8			* gdata_ptr,	// group data, decrypted and split in place
+    const aes_key_t	* akey,		// aes key of the partition
+    bool		is_encrypted,	// true: 'gdata' must be decrypted
+    u8			* hbuf,		// buffer for exception list and hash tables
+    u32			hbuf_size,	// size of 'hbuf'
+    int			group		// group index, only used for logging
+)
+{
+    // Decrypt and split the data of 'wia->chunk_sectors' sectors.
+    // The exception list is stored at the beginning of 'hbuf'.
+    // This function is called by worker threads too => no global data!
+
+    DASSERT(wia);
+    DASSERT(gdata_ptr);
+    DASSERT(akey);
+    DASSERT(hbuf);
+
+
+    //----- decrypt and split data
+
+ #if WATCH_GROUP >= 0 && defined(TEST)
+    if ( group == WATCH_GROUP )
+    {
+	PRINT("##### WATCH GROUP #%u #####\n",WATCH_GROUP);
+	FILE * f = fopen("pool/write.all.dump","wb");
+	if (f)
+	{
+	    HexDump(f,0,0,9,16,gdata_ptr,wia->chunk_size);
+	    fclose(f);
+	}
+    }
+ #endif
+
+    u8 * hashtab0 = hbuf + hbuf_size - WII_GROUP_HASH_SIZE * wia->chunk_groups;
+    if (is_encrypted)
+	wd_decrypt_sectors(0,akey,gdata_ptr,gdata_ptr,hashtab0,wia->chunk_sectors);
+    else
+	wd_split_sectors(gdata_ptr,gdata_ptr,hashtab0,wia->chunk_sectors);
+
+ #if WATCH_GROUP >= 0 && defined(TEST)
+    if ( group == WATCH_GROUP )
+    {
+	FILE * f = fopen("pool/write.split.dump","wb");
+	if (f)
+	{
+	    HexDump(f,0,0,9,16,gdata_ptr,WII_GROUP_DATA_SIZE*wia->chunk_groups);
+	    fclose(f);
+	}
+
+	f = fopen("pool/write.hash.dump","wb");
+	if (f)
+	{
+	    int g;
+	    for ( g = 0; g < wia->chunk_groups; g++ )
+	    {
+		HexDump(f,0,0,9,16,hashtab0+WII_GROUP_HASH_SIZE*g,WII_GROUP_HASH_SIZE);
+		fprintf(f,"---\f\n");
+	    }
+	    fclose(f);
+	}
+    }
+ #endif
+
+
+    //----- setup exceptions
+
+    u8 * gdata = gdata_ptr;
+    u8 * hashtab1 = hashtab0;
+    wia_except_list_t * except_list = (wia_except_list_t*)hbuf;
+
+    int g;
+    for ( g = 0;
+	  g < wia->chunk_groups;
+	  g++, gdata += WII_GROUP_DATA_SIZE, hashtab1 += WII_GROUP_HASH_SIZE )
+    {
+	u8 hashtab2[WII_GROUP_HASH_SIZE];
+	wd_calc_group_hashes(gdata,hashtab2,0,0);
+
+     #if WATCH_GROUP >= 0 && defined(TEST)
+	if ( group == WATCH_GROUP && g == WATCH_SUB_GROUP )
+	{
+	    FILE * f = fopen("pool/write.calc.dump","wb");
+	    if (f)
+	    {
+		HexDump(f,0,0,9,16,hashtab2,WII_GROUP_HASH_SIZE);
+		fclose(f);
+	    }
+	}
+     #endif
+
+	int is;
+	wia_exception_t * except = except_list->exception;
+	noPRINT("** exc=%p,%p, gdata=%p, hash=%p\n",
+		except_list, except, gdata, hashtab1 );
+	for ( is = 0; is < WII_GROUP_SECTORS; is++ )
+	{
+	    wd_part_sector_t * sector1
+		= (wd_part_sector_t*)( hashtab1 + is * WII_SECTOR_HASH_SIZE );
+	    wd_part_sector_t * sector2
+		= (wd_part_sector_t*)( hashtab2 + is * WII_SECTOR_HASH_SIZE );
+
+	    int ih;
+	    u8 * h1 = sector1->h0[0];
+	    u8 * h2 = sector2->h0[0];
+	    for ( ih = 0; ih < WII_N_ELEMENTS_H0; ih++ )
+	    {
+		if (memcmp(h1,h2,WII_HASH_SIZE))
+		{
+		    TRACE("%5u.%02u.H0.%02u -> %04zx,%04zx\n",
+				group, is, ih,
+				h1 - hashtab1,  h2 - hashtab2 );
+		    except->offset = htons(h1-hashtab1);
+		    memcpy(except->hash,h1,sizeof(except->hash));
+		    except++;
+		}
+		h1 += WII_HASH_SIZE;
+		h2 += WII_HASH_SIZE;
+	    }
+
+	    h1 = sector1->h1[0];
+	    h2 = sector2->h1[0];
+	    for ( ih = 0; ih < WII_N_ELEMENTS_H1; ih++ )
+	    {
+		if (memcmp(h1,h2,WII_HASH_SIZE))
+		{
+		    TRACE("%5u.%02u.H1.%u  -> %04zx,%04zx\n",
+				group, is, ih,
+				h1 - hashtab1,  h2 - hashtab2 );
+		    except->offset = htons(h1-hashtab1);
+		    memcpy(except->hash,h1,sizeof(except->hash));
+		    except++;
+		}
+		h1 += WII_HASH_SIZE;
+		h2 += WII_HASH_SIZE;
+	    }
+
+	    h1 = sector1->h2[0];
+	    h2 = sector2->h2[0];
+	    for ( ih = 0; ih < WII_N_ELEMENTS_H2; ih++ )
+	    {
+		if (memcmp(h1,h2,WII_HASH_SIZE))
+		{
+		    TRACE("%5u.%02u.H2.%u  -> %04zx,%04zx\n",
+				group, is, ih,
+				h1 - hashtab1,  h2 - hashtab2 );
+		    except->offset = htons(h1-hashtab1);
+		    memcpy(except->hash,h1,sizeof(except->hash));
+		    except++;
+		}
+		h1 += WII_HASH_SIZE;
+		h2 += WII_HASH_SIZE;
+	    }
+	}
+	except_list->n_exceptions = htons( except - except_list->exception );
+	memset(except,0,sizeof(*except)); // no garbage data
+	noPRINT_IF( except > except_list->exception,
+			" + %zu excpetions in group %u.%u\n",
+			except - except_list->exception,
+			group, g );
+
+     #if WATCH_GROUP >= 0 && defined(TEST)
+	if ( group == WATCH_GROUP && g == WATCH_SUB_GROUP
+		&& except > except_list->exception )
+	{
+	    FILE * f = fopen("pool/write.except.dump","wb");
+	    if (f)
+	    {
+		const size_t sz = sizeof(wia_exception_t);
+		HexDump(f,0,0,9,sz,except_list,sizeof(except_list));
+		HexDump(f,0,0,9,sz,except_list->exception,
+				(except - except_list->exception) * sz );
+		fclose(f);
+	    }
+	}
+     #endif
+
+	except_list = (wia_except_list_t*)except;
+	DASSERT( (u8*)except_list < hashtab0 );
+    }
+    noPRINT("## exc=%p,%p, gdata=%p, hash=%p\n",
+		except_list, except_list, gdata, hashtab1 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError write_part_data
+(
+    struct SuperFile_t	* sf		// destination file
+)
+{
+    DASSERT(sf);
+    DASSERT(sf->wia);
+
+    wia_controller_t * wia = sf->wia;
+    DASSERT( wia->gdata_group >= 0 && wia->gdata_group < wia->group_used );
+    DASSERT( wia->gdata_part  >= 0 && wia->gdata_part  < wia->disc.n_part );
+
+    wd_disc_t * wdisc = wia->wdisc;
+    ASSERT(wdisc);
+    ASSERT( wia->gdata_part < wdisc->n_part );
+    wd_part_t * wpart = wdisc->part + wia->gdata_part;
+
+    split_part_data( wia, wia->gdata, &wia->akey, wpart->is_encrypted,
+			tempbuf, tempbuf_size, wia->gdata_group );
+
+    return write_data( sf, (wia_except_list_t*)tempbuf, wia->gdata,
+			wia->gdata_used / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE,
+			wia->gdata_group, wia->gdata_part, 0 );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct wia_job_t
+{
+    ThreadJob_t		tjob;		// thread pool job, must be the first member
+    wia_controller_t	* wia;		// related controller, read only access
+
+    int			group;		// index of group
+    int			part;		// -1 or index of partition
+    bool		is_encrypted;	// true: partition data must be decrypted
+    aes_key_t		akey;		// aes key of 'part'
+
+    u8			* gdata;	// group data, swapped with 'wia->gdata'
+    u32			gdata_used;	// relevant size of 'gdata'
+    u8			* hbuf;		// buffer for hash exceptions and tables
+    u32			hbuf_size;	// size of 'hbuf'
+    u8			* pdata;	// RVZ only: buffer for packed data
+    u32			packed_size;	// RVZ only: >0: size of packed data
+
+    u8			* out;		// output buffer: data as stored in file
+    u32			out_size;	// alloced size of 'out'
+    u32			out_used;	// number of valid bytes in 'out'
+    u32			data_size;	// uncompressed size (exceptions+data)
+    enumError		err;		// result of compression
+
+} wia_job_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void reset_thread_jobs
+(
+    wia_controller_t	* wia		// valid pointer
+)
+{
+    DASSERT(wia);
+
+    if (wia->tpool)
+    {
+	ResetThreadPool(wia->tpool);
+	FREE(wia->tpool);
+	wia->tpool = 0;
+    }
+
+    uint i;
+    if (wia->job)
+    {
+	for ( i = 0; i < wia->n_jobs; i++ )
+	{
+	    wia_job_t * job = wia->job + i;
+	    FREE(job->gdata);
+	    FREE(job->hbuf);
+	    FREE(job->pdata);
+	    FREE(job->out);
+	}
+	FREE(wia->job);
+	wia->job = 0;
+    }
+    wia->n_jobs = wia->job_first = wia->job_pending = 0;
+
+    if (wia->rjob)
+    {
+	PRINT("WIA READ AHEAD: %u hits, %u misses\n",wia->ra_hits,wia->ra_misses);
+	for ( i = 0; i < wia->n_rjobs; i++ )
+	{
+	    wia_rjob_t * job = wia->rjob + i;
+	    FREE(job->gdata);
+	    FREE(job->hbuf);
+	    FREE(job->inbuf);
+	}
+	FREE(wia->rjob);
+	wia->rjob = 0;
+    }
+    wia->n_rjobs = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setup_write_jobs
+(
+    wia_controller_t	* wia		// valid pointer
+)
+{
+    // Setup a pool of threads and a ring buffer of jobs for compression.
+    // The number of threads is limited by option --threads and by the
+    // memory limit (option --mem). Each job needs an own set of buffers.
+
+    DASSERT(wia);
+    DASSERT(!wia->tpool);
+
+    uint n_threads = GetThreadCount();
+    if ( n_threads <= 1 )
+	return;
+
+    const u32 hbuf_size = wia->chunk_groups
+			* ( WII_GROUP_HASH_SIZE + sizeof(wia_except_list_t)
+				+ WII_N_HASH_GROUP * sizeof(wia_exception_t) )
+			+ sizeof(wia_exception_t);
+    const u32 out_size  = wia->chunk_size + wia->chunk_size/8 + hbuf_size + 0x10000;
+    const u32 pdata_size = wia->is_rvz ? wia->gdata_size : 0;
+    const u64 job_mem	= wia->chunk_size + hbuf_size + pdata_size + out_size;
+    const u64 thread_mem = CalcMemoryUsageWIA( wia->disc.compression,
+				wia->disc.compr_level, wia->chunk_size, true )
+			 + job_mem;
+
+    const u64 mem_limit = GetMemLimit();
+    if ( mem_limit && mem_limit > wia->memory_usage + job_mem )
+    {
+	const u64 max_threads = ( mem_limit - wia->memory_usage - job_mem ) / thread_mem;
+	if ( n_threads > max_threads )
+	    n_threads = max_threads;
+    }
+    if ( n_threads <= 1 )
+	return;
+
+    wia->tpool = MALLOC(sizeof(*wia->tpool));
+    InitializeThreadPool(wia->tpool,n_threads);
+    if (!wia->tpool->n_threads)
+    {
+	FREE(wia->tpool);
+	wia->tpool = 0;
+	return;
+    }
+
+    // one more job than threads => the caller can fill a job while all threads work
+    wia->n_jobs = wia->tpool->n_threads + 1;
+    wia->job = CALLOC(wia->n_jobs,sizeof(*wia->job));
+
+    uint i;
+    for ( i = 0; i < wia->n_jobs; i++ )
+    {
+	wia_job_t * job = wia->job + i;
+	job->wia	= wia;
+	job->gdata	= MALLOC(wia->gdata_size);
+	job->hbuf_size	= hbuf_size;
+	job->hbuf	= MALLOC(hbuf_size);
+	job->pdata	= pdata_size ? MALLOC(pdata_size) : 0;
+	job->out_size	= out_size;
+	job->out	= MALLOC(out_size);
+    }
+
+    wia->memory_usage += wia->n_jobs * job_mem
+		+ ( wia->tpool->n_threads - 1 ) * ( thread_mem - job_mem );
+    PRINT("WIA: %u compression threads, %u jobs\n",wia->tpool->n_threads,wia->n_jobs);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void compress_job
+(
+    ThreadJob_t		* tjob		// valid job, embedded in wia_job_t
+)
+{
+    // This function is executed by worker threads.
+    // Global data is accessed read only. Errors are not printed,
+    // but stored in 'job->err' and reported by write_oldest_job().
+
+    DASSERT(tjob);
+    wia_job_t * job = (wia_job_t*)tjob;
+    wia_controller_t * wia = job->wia;
+    DASSERT(wia);
+
+    u8 * data_ptr = job->gdata;
+    u32 data_size = job->gdata_used;
+    wia_except_list_t * except = 0;
+    u32 except_size = 0;
+
+    if ( job->part >= 0 )
+    {
+	split_part_data( wia, job->gdata, &job->akey, job->is_encrypted,
+				job->hbuf, job->hbuf_size, job->group );
+	except = (wia_except_list_t*)job->hbuf;
+	except_size = calc_except_size(except,wia->chunk_groups);
+	data_size = data_size / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE;
+    }
+
+    job->data_size   = except_size + data_size;
+    job->out_used    = 0;
+    job->packed_size = 0;
+    job->err	     = ERR_OK;
+
+    if ( job->pdata && data_size )
+    {
+	job->packed_size = pack_rvz_data( job->pdata, wia->gdata_size, data_ptr,
+			data_size, calc_rvz_data_offset(wia,job->group,job->part) );
+	if (job->packed_size)
+	{
+	    data_ptr  = job->pdata;
+	    data_size = job->packed_size;
+	}
+    }
+
+    switch((wd_compression_t)wia->disc.compression)
+    {
+      //----------------------------------------------------------------------
+
+      case WD_COMPR_NONE:
+      {
+	u8 * dest = job->out;
+	if (except_size)
+	{
+	    except_size = except_size + 3 & ~(u32)3; // u32 alignment
+	    memcpy(dest,except,except_size);
+	    dest += except_size;
+	}
+	memcpy(dest,data_ptr,data_size);
+	job->out_used = dest + data_size - job->out;
+      }
+      break;
+
+      //----------------------------------------------------------------------
+
+      case WD_COMPR_PURGE:
+      {
+	if (except_size)
+	{
+	    except_size = except_size + 3 & ~(u32)3; // u32 alignment
+	    memcpy(job->out,except,except_size);
+	}
+
+	wia_segment_t * seg1 = (wia_segment_t*)(job->out+except_size);
+	wia_segment_t * seg2
+	    = calc_segments( seg1, job->out + job->out_size - WII_HASH_SIZE,
+				data_ptr, data_size );
+
+	if ( except_size || seg2 > seg1+1 )
+	{
+	    u32 written = except_size + ( (ccp)seg2 - (ccp)seg1 );
+	    SHA1(job->out,written,job->out+written);
+	    job->out_used = written + WII_HASH_SIZE;
+	}
+      }
+      break;
+
+      //----------------------------------------------------------------------
+
+      case WD_COMPR_BZIP2:
+ #ifdef NO_BZIP2
+	job->err = ERR_NOT_IMPLEMENTED;
+ #else
+      {
+	DataArea_t area[3], *ap = area;
+	if (except_size)
+	{
+	    ap->data = (u8*)except;
+	    ap->size = except_size;
+	    ap++;
+	}
+	ap->data = data_ptr;
+	ap->size = data_size;
+	ap++;
+	ap->data = 0;
+
+	uint written;
+	job->err = EncBZIP2_List2Buf( 0, job->out, job->out_size, &written,
+					area, opt_compr_level );
+	job->out_used = written;
       }
-      break;
  #endif // !NO_BZIP2
+      break;
 
       //----------------------------------------------------------------------
 
       case WD_COMPR_LZMA:
       case WD_COMPR_LZMA2:
       {
-	enumError err = SeekF(&sf->f,wia->write_data_off);
-	if (err)
-	    return err;
-
 	DataArea_t area[3], *ap = area;
 	if (except_size)
 	{
@@ -1537,15 +3251,39 @@ static enumError write_data
 	DataList_t list;
 	SetupDataList(&list,area);
 
-	err = wia->disc.compression == WD_COMPR_LZMA
-		? EncLZMA_List2File (0,sf,opt_compr_level,false,true,&list,&written)
-		: EncLZMA2_List2File(0,sf,opt_compr_level,false,true,&list,&written);
-	if (err)
-	    return err;
+	job->err = wia->disc.compression == WD_COMPR_LZMA
+		? EncLZMA_List2Buf ( 0, 0, opt_compr_level, false, true,
+				&list, job->out, job->out_size, &job->out_used )
+		: EncLZMA2_List2Buf( 0, 0, opt_compr_level, false, true,
+				&list, job->out, job->out_size, &job->out_used );
+      }
+      break;
 
-	noPRINT(">> WRITE LZMA: %9llx, %6x+%6x => %6x, grp %d\n",
-		    wia->write_data_off, except_size, data_size, written, group );
+      //----------------------------------------------------------------------
+
+      case WD_COMPR_ZSTD:
+ #ifndef HAVE_ZSTD
+	job->err = ERR_NOT_IMPLEMENTED;
+ #else
+      {
+	DataArea_t area[3], *ap = area;
+	if (except_size)
+	{
+	    ap->data = (u8*)except;
+	    ap->size = except_size;
+	    ap++;
+	}
+	ap->data = data_ptr;
+	ap->size = data_size;
+	ap++;
+	ap->data = 0;
+
+	uint written;
+	job->err = EncZSTD_List2Buf( 0, job->out, job->out_size, &written,
+					area, opt_compr_level );
+	job->out_used = written;
       }
+ #endif // HAVE_ZSTD
       break;
 
       //----------------------------------------------------------------------
@@ -1554,219 +3292,130 @@ static enumError write_data
       //	=> compiler checks the existence of all enum values
 
       case WD_COMPR__N:
-	ASSERT(0);
+	job->err = ERR_INTERNAL;
     }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError write_oldest_job
+(
+    struct SuperFile_t	* sf		// destination file
+)
+{
+    // Wait for the oldest pending job and write its data.
+    // Jobs are written in the order of submission, so that the
+    // data layout of the WIA file is the same as for serial writing.
 
+    DASSERT(sf);
+    wia_controller_t * wia = sf->wia;
+    DASSERT(wia);
+    DASSERT(wia->job_pending);
+
+    wia_job_t * job = wia->job + wia->job_first;
+    wia->job_first = ( wia->job_first + 1 ) % wia->n_jobs;
+    wia->job_pending--;
+
+    WaitThreadJob(wia->tpool,&job->tjob);
+    if (job->err)
+	return ERROR0(job->err,
+		"Error while compressing group %u [%s]: %s\n",
+		job->group,
+		wd_get_compression_name(wia->disc.compression,"?"),
+		sf->f.fname );
 
-    if ( group >= 0 && group < wia->group_used )
+    const u32 written = job->out_used;
+    if (written)
     {
-	wia_group_t * grp = wia->group + group;
-	grp->data_off4 = htonl( written ? wia->write_data_off >> 2 : 0 );
-	grp->data_size = htonl( written );
+	enumError err = WriteAtF( &sf->f, wia->write_data_off, job->out, written );
+	if (err)
+	    return err;
+
+	if ( wia->disc.compression >= WD_COMPR__FIRST_REAL )
+	{
+	    // count only uncompressed size like the serial compressors
+	    sf->f.bytes_written += job->data_size;
+	    sf->f.bytes_written -= written;
+	}
     }
 
+    noPRINT(">> WRITE JOB: %9llx, %6x => %6x, grp %d\n",
+		wia->write_data_off, job->data_size, written, job->group );
+
+    set_group_entry(wia,job->group,written,job->packed_size);
+
     wia->write_data_off += written + 3 & ~3;
     if ( sf->f.bytes_written > wia->disc.chunk_size )
 	sf->progress_trigger++;
 
-    if (write_count)
-	*write_count = written;
-
     return ERR_OK;
 }
 
-///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-static enumError write_part_data
+static enumError flush_write_jobs
 (
     struct SuperFile_t	* sf		// destination file
 )
 {
     DASSERT(sf);
-    DASSERT(sf->wia);
-
     wia_controller_t * wia = sf->wia;
-    DASSERT( wia->gdata_group >= 0 && wia->gdata_group < wia->group_used );
-    DASSERT( wia->gdata_part  >= 0 && wia->gdata_part  < wia->disc.n_part );
-
-
-    //----- decrypt and split data
-
-    wd_disc_t * wdisc = wia->wdisc;
-    ASSERT(wdisc);
-    ASSERT( wia->gdata_part < wdisc->n_part );
-    wd_part_t * wpart = wdisc->part + wia->gdata_part;
-
- #if WATCH_GROUP >= 0 && defined(TEST)
-    if ( wia->gdata_group == WATCH_GROUP )
-    {
-	PRINT("##### WATCH GROUP #%u #####\n",WATCH_GROUP);
-	FILE * f = fopen("pool/write.all.dump","wb");
-	if (f)
-	{
-	    HexDump(f,0,0,9,16,wia->gdata,wia->chunk_size);
-	    fclose(f);
-	}
-    }
- #endif
-
-    u8 * hashtab0 = tempbuf + tempbuf_size - WII_GROUP_HASH_SIZE * wia->chunk_groups;
-    if ( wpart->is_encrypted )
-	wd_decrypt_sectors(0,&wia->akey,
-			wia->gdata,wia->gdata,hashtab0,wia->chunk_sectors);
-    else
-	wd_split_sectors(wia->gdata,wia->gdata,hashtab0,wia->chunk_sectors);
+    DASSERT(wia);
 
- #if WATCH_GROUP >= 0 && defined(TEST)
-    if ( wia->gdata_group == WATCH_GROUP )
+    while ( wia->job_pending )
     {
-	FILE * f = fopen("pool/write.split.dump","wb");
-	if (f)
-	{
-	    HexDump(f,0,0,9,16,wia->gdata,WII_GROUP_DATA_SIZE*wia->chunk_groups);
-	    fclose(f);
-	}
-
-	f = fopen("pool/write.hash.dump","wb");
-	if (f)
-	{
-	    int g;
-	    for ( g = 0; g < wia->chunk_groups; g++ )
-	    {
-		HexDump(f,0,0,9,16,hashtab0+WII_GROUP_HASH_SIZE*g,WII_GROUP_HASH_SIZE);
-		fprintf(f,"---\f\n");
-	    }
-	    fclose(f);
-	}
+	enumError err = write_oldest_job(sf);
+	if (err)
+	    return err;
     }
- #endif
+    return ERR_OK;
+}
 
+///////////////////////////////////////////////////////////////////////////////
 
-    //----- setup exceptions
+static enumError submit_write_job
+(
+    struct SuperFile_t	* sf		// destination file
+)
+{
+    // Pass the current group data to a worker thread.
+    // The data buffers are swapped, so no data copy is needed.
 
-    u8 * gdata = wia->gdata;
-    u8 * hashtab1 = hashtab0;
-    wia_except_list_t * except_list = (wia_except_list_t*)tempbuf;
+    DASSERT(sf);
+    wia_controller_t * wia = sf->wia;
+    DASSERT(wia);
+    DASSERT(wia->tpool);
 
-    int g;
-    for ( g = 0;
-	  g < wia->chunk_groups;
-	  g++, gdata += WII_GROUP_DATA_SIZE, hashtab1 += WII_GROUP_HASH_SIZE )
+    if ( wia->job_pending == wia->n_jobs )
     {
-	u8 hashtab2[WII_GROUP_HASH_SIZE];
-	wd_calc_group_hashes(gdata,hashtab2,0,0);
-
-     #if WATCH_GROUP >= 0 && defined(TEST)
-	if ( wia->gdata_group == WATCH_GROUP && g == WATCH_SUB_GROUP )
-	{
-	    FILE * f = fopen("pool/write.calc.dump","wb");
-	    if (f)
-	    {
-		HexDump(f,0,0,9,16,hashtab2,WII_GROUP_HASH_SIZE);
-		fclose(f);
-	    }
-	}
-     #endif
-
-	int is;
-	wia_exception_t * except = except_list->exception;
-	noPRINT("** exc=%p,%p, gdata=%p, hash=%p\n",
-		except_list, except, gdata, hashtab1 );
-	for ( is = 0; is < WII_GROUP_SECTORS; is++ )
-	{
-	    wd_part_sector_t * sector1
-		= (wd_part_sector_t*)( hashtab1 + is * WII_SECTOR_HASH_SIZE );
-	    wd_part_sector_t * sector2
-		= (wd_part_sector_t*)( hashtab2 + is * WII_SECTOR_HASH_SIZE );
-
-	    int ih;
-	    u8 * h1 = sector1->h0[0];
-	    u8 * h2 = sector2->h0[0];
-	    for ( ih = 0; ih < WII_N_ELEMENTS_H0; ih++ )
-	    {
-		if (memcmp(h1,h2,WII_HASH_SIZE))
-		{
-		    TRACE("%5u.%02u.H0.%02u -> %04zx,%04zx\n",
-				wia->gdata_group, is, ih,
-				h1 - hashtab1,  h2 - hashtab2 );
-		    except->offset = htons(h1-hashtab1);
-		    memcpy(except->hash,h1,sizeof(except->hash));
-		    except++;
-		}
-		h1 += WII_HASH_SIZE;
-		h2 += WII_HASH_SIZE;
-	    }
+	enumError err = write_oldest_job(sf);
+	if (err)
+	    return err;
+    }
 
-	    h1 = sector1->h1[0];
-	    h2 = sector2->h1[0];
-	    for ( ih = 0; ih < WII_N_ELEMENTS_H1; ih++ )
-	    {
-		if (memcmp(h1,h2,WII_HASH_SIZE))
-		{
-		    TRACE("%5u.%02u.H1.%u  -> %04zx,%04zx\n",
-				wia->gdata_group, is, ih,
-				h1 - hashtab1,  h2 - hashtab2 );
-		    except->offset = htons(h1-hashtab1);
-		    memcpy(except->hash,h1,sizeof(except->hash));
-		    except++;
-		}
-		h1 += WII_HASH_SIZE;
-		h2 += WII_HASH_SIZE;
-	    }
+    wia_job_t * job = wia->job
+		+ ( wia->job_first + wia->job_pending ) % wia->n_jobs;
+    wia->job_pending++;
 
-	    h1 = sector1->h2[0];
-	    h2 = sector2->h2[0];
-	    for ( ih = 0; ih < WII_N_ELEMENTS_H2; ih++ )
-	    {
-		if (memcmp(h1,h2,WII_HASH_SIZE))
-		{
-		    TRACE("%5u.%02u.H2.%u  -> %04zx,%04zx\n",
-				wia->gdata_group, is, ih,
-				h1 - hashtab1,  h2 - hashtab2 );
-		    except->offset = htons(h1-hashtab1);
-		    memcpy(except->hash,h1,sizeof(except->hash));
-		    except++;
-		}
-		h1 += WII_HASH_SIZE;
-		h2 += WII_HASH_SIZE;
-	    }
-	}
-	except_list->n_exceptions = htons( except - except_list->exception );
-	memset(except,0,sizeof(*except)); // no garbage data
-	noPRINT_IF( except > except_list->exception,
-			" + %zu excpetions in group %u.%u\n",
-			except - except_list->exception,
-			wia->gdata_group, g );
+    u8 * temp	= job->gdata;
+    job->gdata	= wia->gdata;
+    wia->gdata	= temp;
 
-     #if WATCH_GROUP >= 0 && defined(TEST)
-	if ( wia->gdata_group == WATCH_GROUP && g == WATCH_SUB_GROUP
-		&& except > except_list->exception )
-	{
-	    FILE * f = fopen("pool/write.except.dump","wb");
-	    if (f)
-	    {
-		const size_t sz = sizeof(wia_exception_t);
-		HexDump(f,0,0,9,sz,except_list,sizeof(except_list));
-		HexDump(f,0,0,9,sz,except_list->exception,
-				(except - except_list->exception) * sz );
-		fclose(f);
-	    }
-	}
-     #endif
+    job->group		= wia->gdata_group;
+    job->gdata_used	= wia->gdata_used;
+    job->part		= -1;
 
-	except_list = (wia_except_list_t*)except;
-	DASSERT( (u8*)except_list < hashtab0 );
+    if ( wia->gdata_part >= 0 && wia->gdata_part < wia->disc.n_part )
+    {
+	DASSERT(wia->wdisc);
+	DASSERT( wia->gdata_part < wia->wdisc->n_part );
+	job->part = wia->gdata_part;
+	job->is_encrypted = wia->wdisc->part[job->part].is_encrypted;
+	memcpy(&job->akey,&wia->akey,sizeof(job->akey));
     }
-    noPRINT("## exc=%p,%p, gdata=%p, hash=%p\n",
-		except_list, except_list, gdata, hashtab1 );
-
-
-    //----- write data
 
-    return write_data( sf, (wia_except_list_t*)tempbuf, wia->gdata,
-			wia->gdata_used / WII_SECTOR_SIZE * WII_SECTOR_DATA_SIZE,
-			wia->gdata_group, 0 );
+    AddThreadJob(wia->tpool,&job->tjob,compress_job,0);
+    return ERR_OK;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1784,9 +3433,13 @@ static enumError write_cached_gdata
     enumError err = ERR_OK;
     if ( wia->gdata_group >= 0 && wia->gdata_group < wia->group_used )
     {
-	if ( wia->gdata_part < 0 || wia->gdata_part >= wia->disc.n_part )
+	if (wia->job)
 	{
-	    err = write_data(sf, 0, wia->gdata, wia->gdata_used, wia->gdata_group, 0 );
+	    err = submit_write_job(sf);
+	}
+	else if ( wia->gdata_part < 0 || wia->gdata_part >= wia->disc.n_part )
+	{
+	    err = write_data(sf, 0, wia->gdata, wia->gdata_used, wia->gdata_group, -1, 0 );
 	}
 	else
 	{
@@ -2079,6 +3732,8 @@ enumError FlushWIA
     if (wia->is_writing)
     {
 	err = write_cached_gdata(sf,-1);
+	if (!err)
+	    err = flush_write_jobs(sf);
 	if (!err)
 	    err = FlushFile(sf);
     }
@@ -2227,9 +3882,20 @@ static enumError FinishSetupWriteWIA
 	wia->group = CALLOC(wia->group_size,sizeof(*wia->group));
 	wia->memory_usage += wia->group_size * sizeof(*wia->group);
 	sf->progress_add_total += wia->group_size * sizeof(*wia->group);
+
+	if (wia->is_rvz)
+	{
+	    wia->rvz_group = CALLOC(wia->group_size,sizeof(*wia->rvz_group));
+	    wia->memory_usage += wia->group_size * sizeof(*wia->rvz_group);
+	}
     }
 
 
+    //----- setup parallel compression
+
+    setup_write_jobs(wia);
+
+
     //----- logging
 
     if ( verbose > 1 )
@@ -2242,7 +3908,7 @@ static enumError FinishSetupWriteWIA
 
     if ( logging > 0 )
     {
-	printf("\nWIA memory map:\n\n");
+	printf("\n%s memory map:\n\n", wia->is_rvz ? "RVZ" : "WIA" );
 	wd_print_memmap(stdout,3,&wia->memmap);
 	putchar('\n');
     }
@@ -2256,7 +3922,8 @@ static enumError FinishSetupWriteWIA
     sf->progress_add_total += wia->write_data_off + sizeof(wia_part_t) * disc->n_part;
 
     wia->is_valid = true;
-    SetupIOD(sf,OFT_WIA,OFT_WIA);
+    const enumOFT oft = wia->is_rvz ? OFT_RVZ : OFT_WIA;
+    SetupIOD(sf,oft,oft);
 
     //----- preallocate disc space
 
@@ -2328,6 +3995,8 @@ enumError SetupWriteWIA
     wia_controller_t * wia = CALLOC(1,sizeof(*wia));
     sf->wia = wia;
     wia->is_writing = true;
+    wia->is_rvz = sf->iod.oft == OFT_RVZ;
+    wia->sub_chunks = 1;
     wia->gdata_group = wia->gdata_part = -1;  // reset gdata
 
     AllocBufferWIA(wia, opt_compr_chunk_size
@@ -2337,10 +4006,11 @@ enumError SetupWriteWIA
     //----- setup file header
 
     wia_file_head_t *fhead = &wia->fhead;
-    memcpy(fhead->magic,WIA_MAGIC,sizeof(fhead->magic));
+    memcpy(fhead->magic, wia->is_rvz ? RVZ_MAGIC : WIA_MAGIC, sizeof(fhead->magic));
     fhead->magic[3]++; // magic is invalid now
-    fhead->version		= WIA_VERSION;
-    fhead->version_compatible	= WIA_VERSION_COMPATIBLE;
+    fhead->version		= wia->is_rvz ? RVZ_VERSION : WIA_VERSION;
+    fhead->version_compatible	= wia->is_rvz
+				? RVZ_VERSION_COMPATIBLE : WIA_VERSION_COMPATIBLE;
     fhead->iso_file_size	= src_file_size ? src_file_size
 					: sf->src ? sf->src->file_size : 0;
 
@@ -2355,10 +4025,16 @@ enumError SetupWriteWIA
     {
 	case WD_COMPR__N:
 	case WD_COMPR_NONE:
-	case WD_COMPR_PURGE:
 	    // nothing to do
 	    break;
 
+	case WD_COMPR_PURGE:
+	    if (wia->is_rvz)
+		return ERROR0(ERR_SYNTAX,
+			"Compression method PURGE is not allowed for RVZ: %s\n",
+			sf->f.fname );
+	    break;
+
 	case WD_COMPR_BZIP2:
 	 #ifdef NO_BZIP2
 	    return ERROR0(ERR_NOT_IMPLEMENTED,
@@ -2402,6 +4078,16 @@ enumError SetupWriteWIA
 		EncLZMA2_Close(&lzma);
 	    }
 	    break;
+
+	case WD_COMPR_ZSTD:
+	 #ifndef HAVE_ZSTD
+	    return ERROR0(ERR_NOT_IMPLEMENTED,
+			"No zstd support for this release! Sorry!\n");
+	 #else
+	    disc->compr_level = CalcCompressionLevelZSTD(opt_compr_level);
+	    wia->memory_usage += CalcMemoryUsageZSTD(opt_compr_level,true);
+	 #endif
+	    break;
     }
 
 
@@ -2520,6 +4206,8 @@ enumError TermWriteWIA
     //----- write chached gdata
 
     enumError err = write_cached_gdata(sf,-1);
+    if (!err)
+	err = flush_write_jobs(sf);
     if (err)
 	return err;
 
@@ -2534,7 +4222,7 @@ enumError TermWriteWIA
 	    wia_raw_data_t * rdata = wia->raw_data + it->index;
 	    ASSERT( ntohl(rdata->n_groups) == 1 );
 	    DASSERT( ntohl(rdata->group_index) < wia->group_used );
-	    err = write_data(sf, 0, it->data,it->size, ntohl(rdata->group_index), 0 );
+	    err = write_data(sf, 0, it->data,it->size, ntohl(rdata->group_index), -1, 0 );
 	    if (err)
 		return err;
 	}
@@ -2552,7 +4240,7 @@ enumError TermWriteWIA
 	disc->n_raw_data	= wia->raw_data_used;
 	disc->raw_data_off	= wia->write_data_off;
 	const u32 raw_data_len	= wia->raw_data_used * sizeof(wia_raw_data_t);
-	err = write_data( sf, 0, wia->raw_data, raw_data_len, -1, &disc->raw_data_size );
+	err = write_data( sf, 0, wia->raw_data, raw_data_len, -1, -1, &disc->raw_data_size );
 	PRINT("** RAW DATA TABLE: n=%d, off=%llx, size=%x\n",
 			disc->n_raw_data, disc->raw_data_off, disc->raw_data_size );
 	if (err)
@@ -2567,8 +4255,10 @@ enumError TermWriteWIA
 	DASSERT(wia->group);
 	disc->n_groups	= wia->group_used;
 	disc->group_off	= wia->write_data_off;
-	const u32 group_len	= wia->group_used * sizeof(wia_group_t);
-	err = write_data( sf, 0, wia->group, group_len, -1, &disc->group_size );
+	const void * group_tab	= wia->rvz_group ? (void*)wia->rvz_group : wia->group;
+	const u32 group_len	= wia->group_used * ( wia->rvz_group
+				? sizeof(rvz_group_t) : sizeof(wia_group_t) );
+	err = write_data( sf, 0, group_tab, group_len, -1, -1, &disc->group_size );
 	PRINT("** GROUP TABLE: n=%d, off=%llx, size=%x\n",
 			disc->n_groups, disc->group_off, disc->group_size );
 	if (err)
@@ -2598,9 +4288,18 @@ enumError TermWriteWIA
     //----- calc file header
 
     wia_file_head_t *fhead	= &wia->fhead;
-    memcpy(fhead->magic,WIA_MAGIC,sizeof(fhead->magic));
-    fhead->version		= WIA_VERSION;
-    fhead->version_compatible	= WIA_VERSION_COMPATIBLE;
+    if (wia->is_rvz)
+    {
+	memcpy(fhead->magic,RVZ_MAGIC,sizeof(fhead->magic));
+	fhead->version			= RVZ_VERSION;
+	fhead->version_compatible	= RVZ_VERSION_COMPATIBLE;
+    }
+    else
+    {
+	memcpy(fhead->magic,WIA_MAGIC,sizeof(fhead->magic));
+	fhead->version			= WIA_VERSION;
+	fhead->version_compatible	= WIA_VERSION_COMPATIBLE;
+    }
     fhead->disc_size		= sizeof(wia_disc_t);
     fhead->wia_file_size	= sf->f.max_off;
 
@@ -117,6 +117,24 @@
 #define WIA_VERSION_READ_COMPATIBLE	0x00080000  // read compatible
 #define PrintVersionWIA PrintVersion
 
+//-----------------------------------------------------
+// RVZ is a revision of WIA by the Dolphin project. It uses the same
+// data structures, but with an extended group table (rvz_group_t),
+// optionally uncompressed groups and packed junk data.
+//-----------------------------------------------------
+
+#define RVZ_MAGIC			"RVZ\1"
+#define RVZ_VERSION			0x01000000  // current writing version
+#define RVZ_VERSION_COMPATIBLE		0x00030000  // down compatible
+#define RVZ_VERSION_READ_COMPATIBLE	0x00030000  // read compatible
+
+// the minimal chunk size of RVZ. Smaller chunks than WIA_BASE_CHUNK_SIZE
+// must be a power of 2, larger chunks a multiple of WIA_BASE_CHUNK_SIZE.
+#define RVZ_MIN_CHUNK_SIZE	0x8000
+
+// the minimal size of junk data, that is stored as seed when writing RVZ.
+#define RVZ_MIN_JUNK_SIZE	0x100
+
 // the minimal size of holes in bytes that will be detected.
 #define WIA_MIN_HOLE_SIZE	0x400
 
@@ -128,6 +146,11 @@
 #define WIA_DEF_CHUNK_FACTOR	 20
 #define WIA_MAX_CHUNK_FACTOR	100
 
+// read ahead: number of sequential group loads to start read ahead
+// and the maximal memory usage of the read ahead buffers
+#define WIA_READ_AHEAD_TRIGGER	  2
+#define WIA_READ_AHEAD_MEM	(512*MiB)
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			struct wia_file_head_t		///////////////
@@ -275,6 +298,32 @@ typedef struct wia_group_t
 
 } __attribute__ ((packed)) wia_group_t;		// 0x08 = 8 = sizeof(wia_group_t)
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			struct rvz_group_t		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// RVZ replaces wia_group_t by this structure. The data of a group is
+// compressed only if RVZ_COMPRESSED is set in 'data_size'. Otherwise the
+// exception lists are u32 aligned like for method NONE.
+// If 'packed_size' is not NULL, the data behind the exception lists is
+// packed: It is a sequence of blocks, each headed by a big endian u32 size.
+// If RVZ_JUNK is set in the size, LFG_SEED_SIZE u32 seed values follow and
+// the data is created by the junk generator. Otherwise the data follows.
+
+#define RVZ_COMPRESSED		0x80000000  // flag of rvz_group_t::data_size
+#define RVZ_JUNK		0x80000000  // flag of packed block sizes
+
+typedef struct rvz_group_t
+{
+    // All values are stored in network byte order (big endian)
+
+    u32			data_off4;		// 0x00: file offset/4 of data
+    u32			data_size;		// 0x04: file size of data | RVZ_COMPRESSED
+    u32			packed_size;		// 0x08: size of packed data, NULL if unpacked
+
+} __attribute__ ((packed)) rvz_group_t;		// 0x0c = 12 = sizeof(rvz_group_t)
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			struct wia_exception_t		///////////////
@@ -341,16 +390,20 @@ typedef struct wia_controller_t
     wia_group_t		* group;	// NULL or pointer to group list
     u32			group_used;	// number of used 'group' elements
     u32			group_size;	// number of alloced 'group' elements
+    rvz_group_t		* rvz_group;	// RVZ only: NULL or list parallel to 'group'
 
     wd_memmap_t		memmap;		// memory mapping
 
     bool		encrypt;	// true: encrypt data if reading
     bool		is_writing;	// false: read a WIA / true: write a WIA
     bool		is_valid;	// true: WIA is valid
+    bool		is_rvz;		// true: file format is RVZ
 
     u32			chunk_size;	// chunk size in use
     u32			chunk_sectors;	// sector per chunk
     u32			chunk_groups;	// sector groups per chunk
+    u32			sub_chunks;	// RVZ only: >1: number of small file chunks
+					// joined to one internal chunk of 2 MiB
     u32			memory_usage;	// calculated memory usage (RAM)
 
     u64			write_data_off;	// writing file offset for the next data
@@ -367,6 +420,34 @@ typedef struct wia_controller_t
     aes_key_t		akey;		// akey of 'gdata_part'
     wd_part_sector_t	empty_sector;	// empty encrypted sector, calced with 'akey'
 
+    u8			* pdata;	// NULL or buffer for packed RVZ data (read+write)
+    u32			pdata_size;	// alloced size of 'pdata'
+    wia_except_list_t	* xlist;	// NULL or joined exceptions of sub chunks
+
+
+    //----- worker threads
+
+    struct ThreadPool_t	* tpool;	// NULL or pool of worker threads
+
+
+    //----- parallel compression (writing only)
+
+    struct wia_job_t	* job;		// NULL or ring buffer with 'n_jobs' jobs
+    uint		n_jobs;		// number of elements of 'job'
+    uint		job_first;	// index of oldest pending job
+    uint		job_pending;	// number of pending jobs
+
+
+    //----- parallel decompression with read ahead (reading only)
+
+    struct wia_rjob_t	* rjob;		// NULL or list with 'n_rjobs' read ahead jobs
+    uint		n_rjobs;	// number of elements of 'rjob'
+    int			ra_last_group;	// last group loaded, -1:invalid
+    uint		ra_seq_count;	// number of sequential group loads
+    bool		ra_disabled;	// true: read ahead is not possible
+    u32			ra_hits;	// number of groups taken from read ahead
+    u32			ra_misses;	// number of groups loaded without read ahead
+
 } wia_controller_t;
 
 //
@@ -392,6 +473,17 @@ bool IsWIA
 
 //-----------------------------------------------------------------------------
 
+bool IsRVZ
+(
+    const void		* data,		// data to check
+    size_t		data_size,	// size of data
+    void		* id6_result,	// not NULL: store ID6 (6 bytes without null term)
+    wd_disc_type_t	* disc_type,	// not NULL: store disc type
+    wd_compression_t	* compression	// not NULL: store compression
+);
+
+//-----------------------------------------------------------------------------
+
 u32 CalcMemoryUsageWIA
 (
     wd_compression_t	compression,	// compression method
@@ -413,7 +505,7 @@ int CalcDefaultSettingsWIA
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			SuperFile_t interface		///////////////
 ///////////////////////////////////////////////////////////////////////////////
-// WIA reading support
+// WIA and RVZ reading support
 
 struct SuperFile_t;
 
@@ -443,7 +535,7 @@ off_t DataBlockWIA
 );
 
 //-----------------------------------------------------------------------------
-// WIA writing support
+// WIA and RVZ writing support, the format is selected by 'sf->iod.oft'
 
 enumError SetupWriteWIA
 (
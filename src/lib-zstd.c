@@ -0,0 +1,221 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#define _GNU_SOURCE 1
+
+/******************/
+  #ifdef HAVE_ZSTD
+/******************/
+
+#include <zstd.h>
+#include "lib-zstd.h"
+
+/*************************************************************
+ **  Zstandard support: https://facebook.github.io/zstd/    **
+ *************************************************************/
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			    ZSTD helpers		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// The WIA levels 1..9 are mapped to the zstd levels 1..19. The memory usage
+// is the size of the zstd context (ZSTD_estimateCCtxSize() of zstd v1.5)
+// rounded up. Decoding is done in one step directly into the destination
+// buffer, so only the small decoding context is needed for reading.
+
+static const u8 zstd_level_tab[10] =
+	{ 0, 1, 3, 5, 7, 9, 12, 15, 17, 19 };
+
+static const u32 zstd_write_kib_tab[10] =
+	{ 0, 600, 1300, 3600, 6700, 12800, 49700, 66100, 66100, 83200 };
+
+#define ZSTD_READ_KIB 100
+
+///////////////////////////////////////////////////////////////////////////////
+
+int CalcCompressionLevelZSTD
+(
+    int			compr_level	// valid are 1..9 / 0: use default value
+)
+{
+    return compr_level < 1
+		? 5
+		: compr_level < 9
+			? compr_level
+			: 9;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+u32 CalcMemoryUsageZSTD
+(
+    int			compr_level,	// valid are 1..9 / 0: use default value
+    bool		is_writing	// false: reading mode, true: writing mode
+)
+{
+    compr_level = CalcCompressionLevelZSTD(compr_level);
+    return ( is_writing ? zstd_write_kib_tab[compr_level] : ZSTD_READ_KIB ) * KiB;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////		    ZSTD memory conversions		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+enumError EncZSTD_List2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const DataArea_t	*area,		// source list, terminated with data==NULL
+    int			compr_level	// valid are 1..9 / 0: use default value
+)
+{
+    // Create a single zstd frame. The total size is stored in the frame.
+    // This function doesn't use any global data, so it is usable by threads,
+    // if 'error_object' is NULL.
+
+    DASSERT(dest);
+    DASSERT(dest_written);
+    DASSERT(area);
+
+    *dest_written = 0;
+    ZSTD_CCtx * cctx = ZSTD_createCCtx();
+    if (!cctx)
+	return !error_object ? ERR_ZSTD : ERROR0(ERR_ZSTD,
+		"Error while opening zstd stream: %s\n-> zstd error: out of memory\n",
+		error_object );
+
+    const DataArea_t * ap;
+    u64 total = 0;
+    for ( ap = area; ap->data; ap++ )
+	total += ap->size;
+
+    compr_level = CalcCompressionLevelZSTD(compr_level);
+    size_t stat = ZSTD_CCtx_setParameter( cctx, ZSTD_c_compressionLevel,
+					zstd_level_tab[compr_level] );
+    if (!ZSTD_isError(stat))
+	stat = ZSTD_CCtx_setPledgedSrcSize(cctx,total);
+
+    ZSTD_outBuffer out = { dest, dest_size, 0 };
+    bool full = false;
+    for ( ap = area; ap->data && !ZSTD_isError(stat) && !full; ap++ )
+    {
+	ZSTD_inBuffer in = { ap->data, ap->size, 0 };
+	while ( in.pos < in.size )
+	{
+	    stat = ZSTD_compressStream2(cctx,&out,&in,ZSTD_e_continue);
+	    if (ZSTD_isError(stat))
+		break;
+	    if ( out.pos == out.size )
+	    {
+		full = true;
+		break;
+	    }
+	}
+    }
+
+    if ( !ZSTD_isError(stat) && !full )
+    {
+	// flush the frame; 'stat' is the number of bytes still to flush
+	ZSTD_inBuffer in = { 0, 0, 0 };
+	do
+	{
+	    stat = ZSTD_compressStream2(cctx,&out,&in,ZSTD_e_end);
+	    full = stat && !ZSTD_isError(stat) && out.pos == out.size;
+	}
+	while ( stat && !ZSTD_isError(stat) && !full );
+    }
+
+    *dest_written = out.pos;
+    ZSTD_freeCCtx(cctx);
+
+    if ( ZSTD_isError(stat) || full )
+	return !error_object ? ERR_ZSTD : ERROR0(ERR_ZSTD,
+		"Error while compressing data: %s\n-> zstd error: %s\n",
+		error_object,
+		full ? "Destination buffer is too small" : ZSTD_getErrorName(stat) );
+
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError DecZSTD_Buf2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const void		*src,		// source: a single zstd frame
+    uint		src_size	// size of source buffer
+)
+{
+    // Decode a zstd frame created by EncZSTD_List2Buf().
+    // This function doesn't use any global data, so it is usable by threads,
+    // if 'error_object' is NULL.
+
+    DASSERT(dest);
+    DASSERT(dest_written);
+    DASSERT(src);
+
+    const size_t stat = ZSTD_decompress(dest,dest_size,src,src_size);
+    if (ZSTD_isError(stat))
+    {
+	*dest_written = 0;
+	return !error_object ? ERR_ZSTD : ERROR0(ERR_ZSTD,
+		"Error while decompressing data: %s\n-> zstd error: %s\n",
+		error_object, ZSTD_getErrorName(stat) );
+    }
+
+    *dest_written = stat;
+    return ERR_OK;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			    END				///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/*******************/
+  #endif // HAVE_ZSTD
+/*******************/
+
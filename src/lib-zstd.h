@@ -0,0 +1,101 @@
+
+/***************************************************************************
+ *                    __            __ _ ___________                       *
+ *                    \ \          / /| |____   ____|                      *
+ *                     \ \        / / | |    | |                           *
+ *                      \ \  /\  / /  | |    | |                           *
+ *                       \ \/  \/ /   | |    | |                           *
+ *                        \  /\  /    | |    | |                           *
+ *                         \/  \/     |_|    |_|                           *
+ *                                                                         *
+ *                           Wiimms ISO Tools                              *
+ *                         http://wit.wiimm.de/                            *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This file is part of the WIT project.                                 *
+ *   Visit http://wit.wiimm.de/ for project details and sources.           *
+ *                                                                         *
+ *   Copyright (c) 2009-2017 by Dirk Clemens <wiimm@wiimm.de>              *
+ *                                                                         *
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   See file gpl-2.0.txt or http://www.gnu.org/licenses/gpl-2.0.txt       *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef WIT_LIB_ZSTD_H
+#define WIT_LIB_ZSTD_H 1
+#ifdef HAVE_ZSTD
+
+#define _GNU_SOURCE 1
+
+#include "lib-std.h"
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  helpers			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int CalcCompressionLevelZSTD
+(
+    int			compr_level	// valid are 1..9 / 0: use default value
+);
+
+//-----------------------------------------------------------------------------
+
+u32 CalcMemoryUsageZSTD
+(
+    int			compr_level,	// valid are 1..9 / 0: use default value
+    bool		is_writing	// false: reading mode, true: writing mode
+);
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////		    ZSTD memory conversions		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+enumError EncZSTD_List2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const DataArea_t	*area,		// source list, terminated with data==NULL
+    int			compr_level	// valid are 1..9 / 0: use default value
+);
+
+//-----------------------------------------------------------------------------
+
+enumError DecZSTD_Buf2Buf
+(
+    ccp			error_object,	// NULL or object name for error messages
+					// NULL: don't print error messages
+    void		*dest,		// valid destination buffer
+    uint		dest_size,	// size of 'dest'
+    uint		*dest_written,	// store num bytes written to 'dest', never NULL
+
+    const void		*src,		// source: a single zstd frame
+    uint		src_size	// size of source buffer
+);
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////				END			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // HAVE_ZSTD
+#endif // WIT_LIB_ZSTD_H 1
+
@@ -248,6 +248,7 @@ typedef enum wd_compression_t
     WD_COMPR_BZIP2,		// use BZIP2 compression
     WD_COMPR_LZMA,		// use LZMA compression
     WD_COMPR_LZMA2,		// use LZMA2 compression
+    WD_COMPR_ZSTD,		// use Zstandard compression
 
     WD_COMPR__N,		// number of compressions
 
@@ -827,7 +828,7 @@ typedef struct wbfs_head_t
     // more parameters
 
  /* 0x0a */	u8	wbfs_version;	// informative version number
- /* 0x0b */	u8	padding;
+ /* 0x0b */	u8	flags;		// bit field of WBFS_HEAD_F_*, always 0 in old versions
  /* 0x0c */	u8	disc_table[0];	// size depends on hd sector size
 }
 __attribute__ ((packed)) wbfs_head_t;
@@ -74,6 +74,7 @@ be64_t wbfs_setup_inode_info
     ASSERT( sizeof(wbfs_inode_info_t) == WBFS_INODE_INFO_SIZE );
 
     memcpy(ii,p->head,WBFS_INODE_INFO_HEAD_SIZE);
+    ii->magic = wbfs_htonl(WBFS_MAGIC);
     ii->info_version = htonl(WBFS_INODE_INFO_VERSION);
 
     be64_t now = hton64(wbfs_time());
@@ -119,10 +120,15 @@ int wbfs_is_inode_info_valid
     if ( !version || version > WBFS_INODE_INFO_VERSION )
 	return 0;
 
+    if ( ii->magic != wbfs_htonl(WBFS_MAGIC) )
+	return 0;
+
+    // the magic of the header depends on WBFS_HEAD_F_DEDUP => skip it
     if ( p && p->head )
-	return memcmp(ii,p->head,WBFS_INODE_INFO_CMP_SIZE) ? 0 : version;
+	return memcmp( &ii->magic+1, &p->head->magic+1,
+			WBFS_INODE_INFO_CMP_SIZE - sizeof(ii->magic) ) ? 0 : version;
 
-    return ii->magic == wbfs_htonl(WBFS_MAGIC) ? version : 0;
+    return version;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -172,6 +178,164 @@ wbfs_t * wbfs_open_partition
 }
 
 #endif // !WIT 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			free block bitmap		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// The bitmap 'free_map' mirrors the zero entries of 'used_block' and is
+// updated with each change of a block, together with the related word of
+// 'freeblks'. The extent list 'free_ext' is calculated from the bitmap on
+// demand, then maintained by splitting and merging extents and searched
+// by bisection.
+
+static int find_free_ext ( wbfs_t * p, u32 bl )
+{
+    // returns the index of the free extent containing block 'bl' or -1
+
+    DASSERT(p);
+    const wbfs_extent_t *ext, *end = p->free_ext + p->free_ext_used;
+    for ( ext = p->free_ext; ext < end; ext++ )
+	if ( bl >= ext->first && bl - ext->first < ext->count )
+	    return ext - p->free_ext;
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+static void remove_free_ext ( wbfs_t * p, int idx )
+{
+    DASSERT(p);
+    DASSERT( idx >= 0 && idx < p->free_ext_used );
+
+    p->free_ext_used--;
+    memmove( p->free_ext + idx, p->free_ext + idx + 1,
+		( p->free_ext_used - idx ) * sizeof(*p->free_ext) );
+}
+
+//-----------------------------------------------------------------------------
+
+static void insert_free_ext ( wbfs_t * p, u32 first, u32 count )
+{
+    // insert an extent and keep the list sorted by 'count' and 'first'
+
+    DASSERT(p);
+    DASSERT(count);
+
+    if ( p->free_ext_used == p->free_ext_size )
+    {
+	p->free_ext_size = 2 * p->free_ext_size + 100;
+	p->free_ext = REALLOC( p->free_ext,
+			p->free_ext_size * sizeof(*p->free_ext) );
+    }
+
+    int beg = 0;
+    int end = p->free_ext_used;
+    while ( beg < end )
+    {
+	const int idx = ( beg + end ) / 2;
+	const wbfs_extent_t * ext = p->free_ext + idx;
+	if ( ext->count < count || ext->count == count && ext->first < first )
+	    beg = idx + 1;
+	else
+	    end = idx;
+    }
+
+    memmove( p->free_ext + beg + 1, p->free_ext + beg,
+		( p->free_ext_used - beg ) * sizeof(*p->free_ext) );
+    p->free_ext_used++;
+    p->free_ext[beg].first = first;
+    p->free_ext[beg].count = count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void set_free_map ( wbfs_t * p, u32 bl, bool is_free )
+{
+    DASSERT(p);
+    DASSERT(p->free_map);
+    DASSERT( bl > 0 && bl < p->n_wbfs_sec );
+
+    const u32 idx  = ( bl - 1 ) / 32;
+    const u32 mask = (u32)1 << ( ( bl - 1 ) & 31 );
+    if (is_free)
+    {
+	DASSERT(!( p->free_map[idx] & mask ));
+	p->free_map[idx] |= mask;
+	p->free_count++;
+
+	if (!p->free_ext_dirty)
+	{
+	    // merge with the neighbour extents
+
+	    u32 first = bl, count = 1;
+	    int ext_idx = find_free_ext(p,bl+1);
+	    if ( ext_idx >= 0 )
+	    {
+		count += p->free_ext[ext_idx].count;
+		remove_free_ext(p,ext_idx);
+	    }
+	    ext_idx = find_free_ext(p,bl-1);
+	    if ( ext_idx >= 0 )
+	    {
+		first  = p->free_ext[ext_idx].first;
+		count += p->free_ext[ext_idx].count;
+		remove_free_ext(p,ext_idx);
+	    }
+	    insert_free_ext(p,first,count);
+	}
+    }
+    else
+    {
+	DASSERT( p->free_map[idx] & mask );
+	p->free_map[idx] &= ~mask;
+	p->free_count--;
+
+	if (!p->free_ext_dirty)
+	{
+	    // split the extent containing 'bl'
+
+	    const int ext_idx = find_free_ext(p,bl);
+	    DASSERT( ext_idx >= 0 );
+	    const u32 first = p->free_ext[ext_idx].first;
+	    const u32 end   = first + p->free_ext[ext_idx].count;
+	    remove_free_ext(p,ext_idx);
+	    if ( first < bl )
+		insert_free_ext(p,first,bl-first);
+	    if ( bl + 1 < end )
+		insert_free_ext(p,bl+1,end-bl-1);
+	}
+    }
+
+    if ( p->freeblks && !p->freeblks_dirty && idx < p->freeblks_size4 )
+	p->freeblks[idx] = htonl(p->free_map[idx]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setup_free_map ( wbfs_t * p )
+{
+    // recalculate 'free_map' from 'used_block'
+
+    DASSERT(p);
+    DASSERT(p->used_block);
+
+    p->free_map_size4 = ( p->n_wbfs_sec - 1 + 31 ) / 32;
+    if (!p->free_map)
+	p->free_map = MALLOC( ( p->free_map_size4 + 1 ) * sizeof(*p->free_map) );
+    memset(p->free_map,0,( p->free_map_size4 + 1 ) * sizeof(*p->free_map));
+
+    u32 bl, count = 0;
+    for ( bl = 1; bl < p->n_wbfs_sec; bl++ )
+	if (!p->used_block[bl])
+	{
+	    p->free_map[(bl-1)/32] |= (u32)1 << ( ( bl - 1 ) & 31 );
+	    count++;
+	}
+
+    p->free_count = count;
+    p->free_ext_dirty = p->freeblks_dirty = true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void wbfs_setup_lists
@@ -186,6 +350,7 @@ void wbfs_setup_lists
 	p->used_block = MALLOC(used_size);
     memset(p->used_block,0,used_size);
     p->used_block[0] = 0xff;
+    setup_free_map(p);
 
     const size_t id_list_size = (p->max_disc+1) * sizeof(*p->id_list);
     if (!p->id_list)
@@ -258,7 +423,9 @@ wbfs_t * wbfs_open_partition_param ( wbfs_param_t * par )
 
     //----- validation tests
 
-    if ( head->magic != wbfs_htonl(WBFS_MAGIC) )
+    if ( head->magic == wbfs_htonl(WBFS_DEDUP_MAGIC) )
+	head->flags |= WBFS_HEAD_F_DEDUP;
+    else if ( head->magic != wbfs_htonl(WBFS_MAGIC) )
 	WBFS_ERROR("bad magic");
 
     if ( par->force_mode <= 0 )
@@ -438,12 +605,14 @@ void wbfs_calc_geometry
 
     if (p->head)
     {
+	const u8 flags = p->head->flags; // flags are independent of the geometry
 	memset(p->head,0,sizeof(*p->head));
-	p->head->magic		= wbfs_htonl(WBFS_MAGIC);
+	p->head->magic		= wbfs_htonl(wbfs_head_magic(flags));
 	p->head->n_hd_sec	= wbfs_htonl(n_hd_sec);
 	p->head->hd_sec_sz_s	= hd_sec_sz_s;
 	p->head->wbfs_sec_sz_s	= wbfs_sec_sz_s;
 	p->head->wbfs_version	= WBFS_VERSION;
+	p->head->flags		= flags;
     }
 
     //----- setup some wii constants
@@ -557,6 +726,8 @@ void wbfs_close ( wbfs_t * p )
     wbfs_free_freeblocks(p);
     wbfs_iofree(p->block0);
     wbfs_free(p->used_block);
+    wbfs_free(p->free_map);
+    wbfs_free(p->free_ext);
     wbfs_free(p->id_list);
     wbfs_iofree(p->head);
     wbfs_iofree(p->tmp_buffer);
@@ -1167,8 +1338,13 @@ u32 * wbfs_free_freeblocks ( wbfs_t * p )
 	{
 	    wbfs_iofree(p->freeblks);
 	}
-	p->freeblks = (u32*)( p->block0
+	u32 * freeblks = (u32*)( p->block0
 				+ ( p->part_lba + p->freeblks_lba ) * p->hd_sec_sz );
+	if ( p->freeblks != freeblks )
+	{
+	    p->freeblks = freeblks;
+	    p->freeblks_dirty = true;
+	}
 	return p->freeblks;
     }
 
@@ -1190,7 +1366,8 @@ u32 * wbfs_load_freeblocks ( wbfs_t * p )
     if (p->block0)
 	wbfs_free_freeblocks(p); // setup 'freeblks' pointer from block0
 
-    bool dirty = p->used_block_dirty;
+    // 'freeblks' is updated by set_free_map() if not dirty
+    bool dirty = p->used_block_dirty && p->freeblks_dirty;
     const size_t fb_memsize = p->freeblks_lba_count * p->hd_sec_sz;
     if ( !p->freeblks && fb_memsize )
     {
@@ -1205,25 +1382,21 @@ u32 * wbfs_load_freeblocks ( wbfs_t * p )
 	// fill complete array with zeros == mark all blocks as used
 	wbfs_memset(p->freeblks,0,fb_memsize);
 
-	u32 idx = 0, mask = 0;
-	u8 *ptr, *end = p->used_block + p->n_wbfs_sec;
-	for ( ptr = p->used_block + 1; ptr < end; ptr++ )
-	    if (!*ptr)
-	    {
-		const u32 bl = ptr - p->used_block - 1;
-		const u32 new_idx = bl / 32;
-		if ( idx != new_idx )
-		{
-		    if ( idx >= p->freeblks_size4 )
-			break; // end of free blocks table reached
-		    p->freeblks[idx] = htonl(mask);
-		    idx = new_idx;
-		    mask = 0;
-		}
-		mask |= (u32)1 << ( bl & 31 );
-	    }
-	if ( idx < p->freeblks_size4 )
-	    p->freeblks[idx] = htonl(mask);
+	// copy the bitmap word by word, it has the same layout
+	DASSERT(p->free_map);
+	const u32 n = p->free_map_size4 < p->freeblks_size4
+			? p->free_map_size4 : p->freeblks_size4;
+	u32 idx;
+	for ( idx = 0; idx < n; idx++ )
+	    p->freeblks[idx] = htonl(p->free_map[idx]);
+
+	// never mark blocks behind the end of the partition as free
+	const u32 n_bits = p->n_wbfs_sec - 1;
+	if ( n_bits & 31 && n_bits / 32 < n )
+	    p->freeblks[n_bits/32]
+		= htonl( p->free_map[n_bits/32] & ( (u32)1 << ( n_bits & 31 ) ) - 1 );
+
+	p->freeblks_dirty = false;
     }
 
     return p->freeblks;
@@ -1321,6 +1494,8 @@ int wbfs_calc_used_blocks
 
     //----- scan discs, pass 1/2
 
+    // shared blocks are no error, if the WBFS is deduplicated
+    const bool dedup = ( p->head->flags & WBFS_HEAD_F_DEDUP ) != 0;
     const bool valid_slot_info = p->head->wbfs_version > 1;
     p->head->wbfs_version = WBFS_VERSION;
 
@@ -1427,7 +1602,7 @@ int wbfs_calc_used_blocks
 		func(p,WBFS_CHK_UNUSED_BLOCK,-1,0,i,0,msg,msg_len,param);
 	    }
 	}
-	else if ( ucnt > 1 )
+	else if ( ucnt > 1 && !dedup )
 	{
 	    PRINT_IF(!func,
 		"!!! NEW WBFS INTERFACE: block %u* used: #%x [%02x]\n", ucnt, i, used[i] );
@@ -1501,7 +1676,8 @@ int wbfs_calc_used_blocks
 
     //----- terminate
 
-    
+    setup_free_map(p);
+
     if (store_block0)
     {
 	p->block0 = block0;
@@ -1517,7 +1693,102 @@ int wbfs_calc_used_blocks
 
 ///////////////////////////////////////////////////////////////////////////////
 
-u32 wbfs_find_free_blocks
+static u32 find_free_bit
+(
+    // returns the first free block of 'first_bl..end_bl-1' or WBFS_NO_BLOCK
+
+    wbfs_t	* p,		// valid WBFS descriptor
+    u32		first_bl,	// first block to check, >0
+    u32		end_bl		// end of search, <= n_wbfs_sec
+)
+{
+    DASSERT(p);
+    DASSERT(p->free_map);
+    DASSERT( first_bl > 0 );
+    DASSERT( end_bl <= p->n_wbfs_sec );
+
+    if ( first_bl >= end_bl )
+	return WBFS_NO_BLOCK;
+
+    const u32 end_idx = ( end_bl - 2 ) / 32 + 1;
+    u32 idx = ( first_bl - 1 ) / 32;
+    u32 v = p->free_map[idx] & ~(u32)0 << ( ( first_bl - 1 ) & 31 );
+    while (!v)
+    {
+	if ( ++idx >= end_idx )
+	    return WBFS_NO_BLOCK;
+	v = p->free_map[idx];
+    }
+
+    u32 bl = idx * 32 + 1;
+    if (!( v & 0xffff )) { v >>= 16; bl += 16; }
+    if (!( v & 0x00ff )) { v >>=  8; bl +=  8; }
+    if (!( v & 0x000f )) { v >>=  4; bl +=  4; }
+    if (!( v & 0x0003 )) { v >>=  2; bl +=  2; }
+    if (!( v & 0x0001 )) {           bl +=  1; }
+
+    return bl < end_bl ? bl : WBFS_NO_BLOCK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int cmp_free_ext ( const void * va, const void * vb )
+{
+    const wbfs_extent_t * a = va;
+    const wbfs_extent_t * b = vb;
+
+    if ( a->count != b->count )
+	return a->count < b->count ? -1 : 1;
+    return a->first < b->first ? -1 : a->first > b->first;
+}
+
+//-----------------------------------------------------------------------------
+
+static void setup_free_ext ( wbfs_t * p )
+{
+    // recalculate the sorted list of free extents from 'free_map'
+
+    DASSERT(p);
+    DASSERT(p->free_map);
+
+    p->free_ext_used = 0;
+    u32 bl = find_free_bit(p,1,p->n_wbfs_sec);
+    while ( bl != WBFS_NO_BLOCK )
+    {
+	// find the end of the extent; full words are skipped at once
+	u32 end = bl + 1;
+	while ( end < p->n_wbfs_sec )
+	{
+	    if ( !( ( end - 1 ) & 31 ) && p->free_map[(end-1)/32] == ~(u32)0 )
+		end += 32;
+	    else if ( p->free_map[(end-1)/32] & (u32)1 << ( ( end - 1 ) & 31 ) )
+		end++;
+	    else
+		break;
+	}
+	if ( end > p->n_wbfs_sec )
+	     end = p->n_wbfs_sec;
+
+	if ( p->free_ext_used == p->free_ext_size )
+	{
+	    p->free_ext_size = 2 * p->free_ext_size + 100;
+	    p->free_ext = REALLOC( p->free_ext,
+				p->free_ext_size * sizeof(*p->free_ext) );
+	}
+	wbfs_extent_t * ext = p->free_ext + p->free_ext_used++;
+	ext->first = bl;
+	ext->count = end - bl;
+
+	bl = find_free_bit(p,end,p->n_wbfs_sec);
+    }
+
+    qsort( p->free_ext, p->free_ext_used, sizeof(*p->free_ext), cmp_free_ext );
+    p->free_ext_dirty = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 find_free_window
 (
     // returns index of first free block or WBFS_NO_BLOCK if not enough blocks free
 
@@ -1525,6 +1796,8 @@ u32 wbfs_find_free_blocks
     u32		n_needed	// number of needed blocks
 )
 {
+    // find the smallest area, that contains 'n_needed' free blocks
+
     DASSERT(p);
     DASSERT(p->used_block);
     DASSERT(n_needed);
@@ -1567,17 +1840,59 @@ u32 wbfs_find_free_blocks
 
 ///////////////////////////////////////////////////////////////////////////////
 
+u32 wbfs_find_free_blocks
+(
+    // returns index of first free block or WBFS_NO_BLOCK if not enough blocks free
+
+    wbfs_t	* p,		// valid WBFS descriptor
+    u32		n_needed	// number of needed blocks
+)
+{
+    DASSERT(p);
+    DASSERT(p->used_block);
+    DASSERT(n_needed);
+
+    if ( n_needed > p->free_count )
+	return WBFS_NO_BLOCK;
+
+    if (p->free_ext_dirty)
+	setup_free_ext(p);
+
+    // best fit: the smallest extent with at least 'n_needed' blocks
+
+    int beg = 0;
+    int end = p->free_ext_used;
+    while ( beg < end )
+    {
+	const int idx = ( beg + end ) / 2;
+	if ( p->free_ext[idx].count < n_needed )
+	    beg = idx + 1;
+	else
+	    end = idx;
+    }
+
+    if ( beg < p->free_ext_used )
+    {
+	TRACE("found extent: %5u..%5u [%5u]\n",
+		p->free_ext[beg].first,
+		p->free_ext[beg].first + p->free_ext[beg].count,
+		p->free_ext[beg].count );
+	return p->free_ext[beg].first;
+    }
+
+    // no extent is large enough => use the smallest fragmented area
+    return find_free_window(p,n_needed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 u32 wbfs_get_free_block_count ( wbfs_t * p )
 {
     DASSERT(p);
     DASSERT(p->used_block);
+    DASSERT(p->free_map);
 
-    u32 count = 0;
-    u8 *ptr, *end = p->used_block + p->n_wbfs_sec;
-    for ( ptr = p->used_block + 1; ptr < end; ptr++ )
-	if (!*ptr)
-	    count++;
-    return count;
+    return p->free_count;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1594,23 +1909,20 @@ u32 wbfs_alloc_block
     if ( start_block < 1 || start_block >= p->n_wbfs_sec )
 	 start_block = 1;
 
-    u32 bl = start_block;
-    do
-    {
-	if (!p->used_block[bl])
-	{
-	    p->used_block[bl] = 1;
-	    p->used_block_dirty = p->is_dirty = true;
-	    noPRINT("wbfs_alloc_block(%p,%u) -> %d\n",p,start_block,bl);
-	    return bl;
-	}
-	
-	if ( ++bl >= p->n_wbfs_sec )
-	    bl = 1;
+    u32 bl = find_free_bit(p,start_block,p->n_wbfs_sec);
+    if ( bl == WBFS_NO_BLOCK )
+	bl = find_free_bit(p,1,start_block);
 
-    } while ( bl != start_block );
+    if ( bl != WBFS_NO_BLOCK )
+    {
+	DASSERT(!p->used_block[bl]);
+	p->used_block[bl] = 1;
+	p->used_block_dirty = p->is_dirty = true;
+	set_free_map(p,bl,false);
+	noPRINT("wbfs_alloc_block(%p,%u) -> %d\n",p,start_block,bl);
+    }
 
-    return WBFS_NO_BLOCK;
+    return bl;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1641,7 +1953,10 @@ void wbfs_free_block ( wbfs_t *p, u32 bl )
 	)
     {
 	if (!--p->used_block[bl])
+	{
 	    p->used_block_dirty = p->is_dirty = true;
+	    set_free_map(p,bl,true);
+	}
     }
 }
 
@@ -1656,7 +1971,26 @@ void wbfs_use_block ( wbfs_t *p, u32 bl )
     {
 	p->used_block[bl] = 1;
 	p->used_block_dirty = p->is_dirty = true;
+	set_free_map(p,bl,false);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool wbfs_share_block ( wbfs_t *p, u32 bl )
+{
+    // add a reference to a used block => return false if not possible
+
+    DASSERT(p);
+    DASSERT(p->used_block);
+
+    if ( bl > 0 && bl < p->n_wbfs_sec
+	&& p->used_block[bl] > 0 && p->used_block[bl] < WBFS_DEDUP_MAX_REF )
+    {
+	p->used_block[bl]++;
+	return true;
     }
+    return false;
 }
 
 //
@@ -1701,28 +2035,53 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
     ASSERT(p);
     ASSERT(par);
 
+    wbfs_add_t add;
+    if (!wbfs_reserve_disc(p,par,&add))
+	wbfs_copy_disc(&add);
+    return wbfs_commit_disc(&add);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int wbfs_reserve_disc
+(
+    // returns 0 on success; 'add' is always initialized and
+    // must be released by wbfs_commit_disc()
+
+    wbfs_t		* p,		// valid WBFS descriptor
+    wbfs_param_t	* par,		// valid parameters, must stay valid
+    wbfs_add_t		* add		// data structure to initialize
+)
+{
+    ASSERT(p);
+    ASSERT(par);
+    ASSERT(add);
+
+    memset(add,0,sizeof(*add));
+    add->p	= p;
+    add->par	= par;
+    add->slot	= -1;
+    add->status	= 1; // error until success
+
     par->slot = -1; // no slot assigned
     par->open_disc = 0;
 
     int i, slot;
-    u32 wii_sec_per_wbfs_sect = 1 << (p->wbfs_sec_sz_s-p->wii_sec_sz_s);
-    wbfs_disc_info_t *info = 0;
-    u8* copy_buffer = 0;
-    int disc_info_sz_lba;
-    u8 * used = wbfs_malloc(WII_MAX_SECTORS);
+    const u32 wii_sec_per_wbfs_sect = 1 << (p->wbfs_sec_sz_s-p->wii_sec_sz_s);
+    u8 * used = add->used = wbfs_malloc(WII_MAX_SECTORS);
 
 
     //----- open source disc
 
-    wd_disc_t * disc = wd_dup_disc(par->wd_disc);
+    wd_disc_t * disc = add->disc = wd_dup_disc(par->wd_disc);
     if (!disc)
     {
-	disc = wd_open_disc(	par->read_src_wii_disc,
-				par->callback_data,
-				par->iso_size,
-				0,
-				0,
-				0 );
+	disc = add->disc = wd_open_disc( par->read_src_wii_disc,
+					 par->callback_data,
+					 par->iso_size,
+					 0,
+					 0,
+					 0 );
 	if (!disc)
 	    WBFS_ERROR("unable to open wii disc");
     }
@@ -1736,12 +2095,12 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
 
     //----- count total number of blocks to write
 
-    u32 current_block = 0;
     u32 total_blocks  = 0;
 
     for ( i = 0; i < p->n_wbfs_sec_per_disc; i++ )
 	if ( wd_is_block_used(used, i, wii_sec_per_wbfs_sect) )
 	    total_blocks++;
+    add->total_blocks = total_blocks;
 
     PRINT("ADD, TOTAL BLOCKS= %u*%u*%u = %llu\n",
 		total_blocks, wii_sec_per_wbfs_sect, WII_SECTOR_SIZE,
@@ -1758,9 +2117,6 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
 	goto error;
     }
 
-    if (par->spinner)
-	par->spinner(0,total_blocks,par->callback_data);
-
  // [codeview]
 
     for ( i = 0; i < p->max_disc; i++) // find a free slot.
@@ -1770,25 +2126,24 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
     if (i == p->max_disc)
 	WBFS_ERROR("no space left on device (table full)");
 
-    p->head->disc_table[i] = WBFS_SLOT_VALID;
-    slot = i;
+    // the slot is marked invalid until wbfs_commit_disc(), because
+    // the head may be written by other jobs in the meantime
+    p->head->disc_table[i] = WBFS_SLOT_INVALID;
+    slot = add->slot = i;
 
     // build disc info
-    info = wbfs_ioalloc(p->disc_info_sz);
+    wbfs_disc_info_t * info = add->info = wbfs_ioalloc(p->disc_info_sz);
     memset(info,0,p->disc_info_sz);
     // [[2do]] use wd_read_and_patch()
     par->read_src_wii_disc(par->callback_data, 0, 0x100, info->dhead);
     if (par->wbfs_id6[0])
 	memcpy(info->dhead,par->wbfs_id6,6);
 
-    copy_buffer = wbfs_ioalloc(p->wbfs_sec_sz);
-    if (!copy_buffer)
-	WBFS_ERROR("alloc memory");
+    // reserve the id, so that it is found by other jobs
+    if (p->id_list)
+	memcpy(p->id_list[slot],info,sizeof(*p->id_list));
 
- #ifndef WIT // WIT does it in an other way (patching while reading)
-    const u32 ptab_off   = wd_get_ptab_sector(disc) * WII_SECTOR_SIZE;
-    const int ptab_index = ptab_off >> p->wbfs_sec_sz_s;
- #endif
+    //----- allocate all blocks
 
     u32 bl = 0;
     if ( p->balloc_mode == WBFS_BA_AVOID_FRAG
@@ -1806,23 +2161,62 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
 	{
 	    bl = wbfs_alloc_block(p,bl);
 	    if ( bl == WBFS_NO_BLOCK )
-	    {
-		// free disc slot
-		p->head->disc_table[slot] = WBFS_SLOT_FREE;
-
-		// free already allocated blocks
-		int j;
-		for ( j = 0; j < i; j++ )
-		{
-		    bl = wbfs_ntohs(info->wlba_table[j]);
-		    if (bl)
-			wbfs_free_block(p,bl);
-		}
-		wbfs_sync(p);
 		WBFS_ERROR("No space left on device (WBFS runs full)");
-	    }
 	    info->wlba_table[i] = wbfs_htons(bl);
+	}
+    }
+
+    add->status = 0;
+    return 0;
+
+error:
+    return add->status;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int wbfs_copy_disc
+(
+    // copy the disc data into the reserved blocks; returns 0 on success
+    // The management data of the WBFS is not touched, so that
+    // several discs can be copied at the same time.
+
+    wbfs_add_t		* add		// valid data, set by wbfs_reserve_disc()
+)
+{
+    ASSERT(add);
+    if (add->status)
+	return add->status;
 
+    wbfs_t * p = add->p;
+    wbfs_param_t * par = add->par;
+    DASSERT(p);
+    DASSERT(par);
+    DASSERT(add->info);
+
+    add->status = 1; // error until success
+    const u8 * used = add->used;
+    const u32 wii_sec_per_wbfs_sect = 1 << (p->wbfs_sec_sz_s-p->wii_sec_sz_s);
+
+    if (par->spinner)
+	par->spinner(0,add->total_blocks,par->callback_data);
+
+    u32 current_block = 0;
+    u8 * copy_buffer = wbfs_ioalloc(p->wbfs_sec_sz);
+    if (!copy_buffer)
+	WBFS_ERROR("alloc memory");
+
+ #ifndef WIT // WIT does it in an other way (patching while reading)
+    const u32 ptab_off   = wd_get_ptab_sector(add->disc) * WII_SECTOR_SIZE;
+    const int ptab_index = ptab_off >> p->wbfs_sec_sz_s;
+ #endif
+
+    int i;
+    for ( i = 0; i < p->n_wbfs_sec_per_disc; i++ )
+    {
+	const u32 bl = wbfs_ntohs(add->info->wlba_table[i]);
+	if (bl)
+	{
 	    u8 * dest = copy_buffer;
 	    const u32 wiimax = (i+1) * wii_sec_per_wbfs_sect;
 	    u32 subsec = 0;
@@ -1836,9 +2230,14 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
 			wiiend++;
 		    const u32 size = ( wiiend - wiisec ) * p->wii_sec_sz;
 		    // [[2do]] use wd_read_and_patch()
-		    if (par->read_src_wii_disc(par->callback_data,
-				wiisec * (p->wii_sec_sz>>2), size, dest ))
-			WBFS_ERROR("error reading disc");
+		    add->read_status = par->read_src_wii_disc( par->callback_data,
+				wiisec * (p->wii_sec_sz>>2), size, dest );
+		    if (add->read_status)
+		    {
+			if (!add->disable_errors)
+			    wbfs_error("error reading disc");
+			goto error;
+		    }
 
 		    dest += size;
 		    subsec += wiiend - wiisec;
@@ -1855,53 +2254,105 @@ u32 wbfs_add_disc_param ( wbfs_t *p, wbfs_param_t * par )
  #ifndef WIT //  WIT does it in an other way (patching while reading)
 	    // fix the partition table.
 	    if ( i == ptab_index )
-		wd_patch_ptab(	disc,
+		wd_patch_ptab(	add->disc,
 				copy_buffer + ptab_off - i * p->wbfs_sec_sz,
 				false );
  #endif
 
+	    if (add->lock_func)
+		add->lock_func(add->lock_data,true);
 	    p->write_hdsector(	p->callback_data,
 				p->part_lba + bl * (p->wbfs_sec_sz / p->hd_sec_sz),
 				p->wbfs_sec_sz / p->hd_sec_sz,
 				copy_buffer );
+	    if (add->lock_func)
+		add->lock_func(add->lock_data,false);
 
 	    if (par->spinner)
-		par->spinner(++current_block,total_blocks,par->callback_data);
+		par->spinner(++current_block,add->total_blocks,par->callback_data);
+	}
+    }
+    add->status = 0;
+
+error:
+    if (copy_buffer)
+	wbfs_iofree(copy_buffer);
+    return add->status;
+}
 
- 	}
-   }
+///////////////////////////////////////////////////////////////////////////////
 
-    // inode info
-    par->iinfo.itime = 0ull;
-    wbfs_setup_inode_info(p,&par->iinfo,1,1);
-    memcpy( info->dhead + WBFS_INODE_INFO_OFF,
-	    &par->iinfo,
-	    sizeof(par->iinfo) );
+int wbfs_commit_disc
+(
+    // write the inode of a successful copied disc and sync the WBFS,
+    // or release the reservation if an error occurred.
+    // All resources of 'add' are freed; returns 0 on success.
 
-    // write disc info
-    disc_info_sz_lba = p->disc_info_sz >> p->hd_sec_sz_s;
-    p->write_hdsector(	p->callback_data,
-			p->part_lba + 1 + slot * disc_info_sz_lba,
-			disc_info_sz_lba,
-			info );
-    if (p->id_list)
-	memcpy(p->id_list[slot],info,sizeof(*p->id_list));
-    wbfs_sync(p);
+    wbfs_add_t		* add		// valid data, set by wbfs_reserve_disc()
+)
+{
+    ASSERT(add);
+    wbfs_t * p = add->p;
+    wbfs_param_t * par = add->par;
+    DASSERT(p);
+    DASSERT(par);
 
-    par->slot = slot;
-    par->open_disc = wbfs_open_disc_by_info(p,slot,info,0);
-    info = 0;
+    if ( !add->status && add->info )
+    {
+	wbfs_disc_info_t * info = add->info;
+
+	// inode info
+	par->iinfo.itime = 0ull;
+	wbfs_setup_inode_info(p,&par->iinfo,1,1);
+	memcpy( info->dhead + WBFS_INODE_INFO_OFF,
+		&par->iinfo,
+		sizeof(par->iinfo) );
+
+	// write disc info
+	const int disc_info_sz_lba = p->disc_info_sz >> p->hd_sec_sz_s;
+	p->write_hdsector(	p->callback_data,
+				p->part_lba + 1 + add->slot * disc_info_sz_lba,
+				disc_info_sz_lba,
+				info );
+	if (p->id_list)
+	    memcpy(p->id_list[add->slot],info,sizeof(*p->id_list));
+	p->head->disc_table[add->slot] = WBFS_SLOT_VALID;
+	wbfs_sync(p);
 
-error:
-    wd_close_disc(disc);
-    if (used)
-	wbfs_free(used);
-    if (info)
-	wbfs_iofree(info);
-    if (copy_buffer)
-	wbfs_iofree(copy_buffer);
+	par->slot = add->slot;
+	par->open_disc = wbfs_open_disc_by_info(p,add->slot,info,0);
+	add->info = 0;
+    }
+    else if ( add->slot >= 0 )
+    {
+	// free already allocated blocks and the disc slot
 
-    return 0;
+	if (add->info)
+	{
+	    int i;
+	    for ( i = 0; i < p->n_wbfs_sec_per_disc; i++ )
+	    {
+		const u32 bl = wbfs_ntohs(add->info->wlba_table[i]);
+		if (bl)
+		    wbfs_free_block(p,bl);
+	    }
+	}
+	p->head->disc_table[add->slot] = WBFS_SLOT_FREE;
+	if (p->id_list)
+	    memset(p->id_list[add->slot],0,sizeof(*p->id_list));
+	wbfs_sync(p);
+    }
+
+    wd_close_disc(add->disc);
+    if (add->used)
+	wbfs_free(add->used);
+    if (add->info)
+	wbfs_iofree(add->info);
+
+    const int status = add->status;
+    memset(add,0,sizeof(*add));
+    add->slot = -1;
+    return status;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2070,6 +2521,7 @@ u32 wbfs_trim ( wbfs_t * p ) // trim the file-system to its minimum size
     const u32 max_block = wbfs_find_last_used_block(p) + 1;
     wbfs_calc_geometry( p, max_block << p->wbfs_sec_sz_s - p->hd_sec_sz_s,
 			p->hd_sec_sz, p->wbfs_sec_sz );
+    setup_free_map(p);
     p->used_block_dirty = p->is_dirty = true;
     wbfs_sync(p);
 
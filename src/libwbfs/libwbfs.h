@@ -49,6 +49,7 @@ extern "C"
 ///////////////////////////////////////////////////////////////////////////////
 
 #define WBFS_MAGIC ( 'W'<<24 | 'B'<<16 | 'F'<<8 | 'S' )
+#define WBFS_DEDUP_MAGIC ( 'W'<<24 | 'B'<<16 | 'F'<<8 | 'D' )
 #define WBFS_VERSION 1
 #define WBFS_NO_BLOCK (~(u32)0)
 
@@ -115,6 +116,31 @@ extern char wbfs_slot_mode_info[WBFS_SLOT__MASK+1];
 
 //-----------------------------------------------------------------------------
 
+typedef enum wbfs_head_flags_t // flags of 'wbfs_head_t::flags'
+{
+    WBFS_HEAD_F_DEDUP	= 0x01,  // data blocks are intentionally shared by discs
+
+} wbfs_head_flags_t;
+
+#define WBFS_DEDUP_MAX_REF 100	// max number of references to a shared block
+
+// A deduplicated WBFS uses WBFS_DEDUP_MAGIC instead of WBFS_MAGIC. Tools
+// without deduplication support don't know the shared blocks and would
+// release them, when deleting a disc. The other magic hides the WBFS from
+// them. Inode infos always use WBFS_MAGIC.
+
+static inline u32 wbfs_head_magic ( u8 flags )
+{
+    return flags & WBFS_HEAD_F_DEDUP ? WBFS_DEDUP_MAGIC : WBFS_MAGIC;
+}
+
+static inline bool wbfs_is_head_magic ( u32 magic ) // magic in host byte order
+{
+    return magic == WBFS_MAGIC || magic == WBFS_DEDUP_MAGIC;
+}
+
+//-----------------------------------------------------------------------------
+
 typedef enum wbfs_balloc_mode_t // block allocation mode
 {
     WBFS_BA_AUTO,	// let add disc the choice:
@@ -130,6 +156,15 @@ typedef enum wbfs_balloc_mode_t // block allocation mode
 
 //-----------------------------------------------------------------------------
 
+typedef struct wbfs_extent_t
+{
+    u32		first;			// first block of a free extent
+    u32		count;			// number of blocks of the extent
+
+} wbfs_extent_t;
+
+//-----------------------------------------------------------------------------
+
 typedef struct wbfs_t
 {
     wbfs_head_t	* head;
@@ -174,6 +209,17 @@ typedef struct wbfs_t
 					// >128: reserved for internal usage
 					//  255: header block #0
     bool	used_block_dirty;	// true: 'used_block' must be written to disc
+
+    u32		* free_map;		// bitmap of free blocks, same layout as 'freeblks',
+					//   but host byte order: bit 'bl-1' set: 'bl' is free
+    u32		free_map_size4;		// number of u32 elements of 'free_map'
+    u32		free_count;		// number of free blocks
+    wbfs_extent_t * free_ext;		// free extents, sorted by 'count' and 'first'
+    u32		free_ext_used;		// number of used elements of 'free_ext'
+    u32		free_ext_size;		// number of alloced elements of 'free_ext'
+    bool	free_ext_dirty;		// true: 'free_ext' must be recalculated
+    bool	freeblks_dirty;		// true: 'freeblks' must be recalculated
+
     wbfs_slot_mode_t	new_slot_err;	// new detected errors
     wbfs_slot_mode_t	all_slot_err;	// all detected errros
     wbfs_balloc_mode_t	balloc_mode;	// block allocation mode
@@ -495,6 +541,7 @@ u32 * wbfs_free_freeblocks	( wbfs_t * p );
 u32 * wbfs_load_freeblocks	( wbfs_t * p );
 void wbfs_free_block		( wbfs_t * p, u32 bl );
 void wbfs_use_block		( wbfs_t * p, u32 bl );
+bool wbfs_share_block		( wbfs_t * p, u32 bl );
 u32 wbfs_find_last_used_block	( wbfs_t * p );
 
 /*! add a wii dvd inside the partition
@@ -516,6 +563,39 @@ u32 wbfs_add_disc
 
 u32 wbfs_add_disc_param ( wbfs_t * p, wbfs_param_t * par );
 
+//-----------------------------------------------------------------------------
+// wbfs_add_disc_param() is split into 3 steps, so that the data of several
+// discs can be copied at the same time. wbfs_reserve_disc() allocates the
+// disc slot and all blocks, wbfs_copy_disc() copies the data without touching
+// the management data and wbfs_commit_disc() writes the inode and syncs the
+// WBFS (or releases the reservation on error). All calls except
+// wbfs_copy_disc() must be serialized by the caller.
+
+typedef void (*wbfs_lock_func_t) ( void * lock_data, bool lock );
+
+typedef struct wbfs_add_t
+{
+    wbfs_t		* p;		// WBFS of the reservation
+    wbfs_param_t	* par;		// parameters, see wbfs_add_disc_param()
+    wd_disc_t		* disc;		// NULL or opened source disc
+    u8			* used;		// NULL or usage table of source
+    wbfs_disc_info_t	* info;		// NULL or disc info with reserved blocks
+    int			slot;		// -1 or reserved slot
+    u32			total_blocks;	// number of reserved blocks
+    int			status;		// 0: no error until now
+    int			read_status;	// 0 or result of a failed source read
+
+    // if set: lock the WBFS for each block written by wbfs_copy_disc()
+    wbfs_lock_func_t	lock_func;	// NULL or lock function
+    void		* lock_data;	// user data for 'lock_func'
+    bool		disable_errors;	// true: wbfs_copy_disc() prints no errors
+
+} wbfs_add_t;
+
+int wbfs_reserve_disc	( wbfs_t * p, wbfs_param_t * par, wbfs_add_t * add );
+int wbfs_copy_disc	( wbfs_add_t * add );
+int wbfs_commit_disc	( wbfs_add_t * add );
+
 u32 wbfs_add_phantom ( wbfs_t *p, ccp phantom_id, u32 wii_sectors );
 
 // remove a disc from partition
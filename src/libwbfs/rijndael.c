@@ -11,6 +11,18 @@
 
 #include <stdio.h>
 #include <string.h>
+
+#if ( defined(__x86_64__) || defined(__i386__) ) && defined(__GNUC__) \
+	&& !defined(NO_AESNI)
+    #define HAVE_AESNI 1
+    #include <cpuid.h>
+    #include <wmmintrin.h>
+    #define AESNI_FUNC static __attribute__((target("aes,sse2")))
+#else
+    #define HAVE_AESNI 0
+#endif
+
+// include this after <wmmintrin.h>, because of the malloc() protection
 #include "rijndael.h"
 
 #ifndef ASSERT
@@ -356,10 +368,169 @@ static void decrypt ( const aes_key_t * akey, char *buff )
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// AES-NI support
+
+static int hw_available = -1;	// -1: unknown, 0: no, 1: AES-NI available
+static int hw_enabled	= 1;	// 0: disabled by user
+
+int wd_aes_hw_available()
+{
+    if ( hw_available < 0 )
+    {
+	hw_available = 0;
+     #if HAVE_AESNI
+	unsigned int eax, ebx, ecx, edx;
+	if ( __get_cpuid(1,&eax,&ebx,&ecx,&edx) && ecx & bit_AES && edx & bit_SSE2 )
+	    hw_available = 1;
+     #endif
+    }
+    return hw_available;
+}
+
+int wd_aes_hw_enable ( int enable )
+{
+    const int prev = hw_enabled && wd_aes_hw_available();
+    if ( enable >= 0 )
+	hw_enabled = enable != 0;
+    return prev;
+}
+
+#if HAVE_AESNI
+
+#define AESNI_EXPAND(k,rcon) \
+	aesni_expand_key(k,_mm_aeskeygenassist_si128(k,rcon))
+
+AESNI_FUNC __m128i aesni_expand_key ( __m128i key, __m128i keygen )
+{
+    keygen = _mm_shuffle_epi32(keygen,0xff);
+    key = _mm_xor_si128(key,_mm_slli_si128(key,4));
+    key = _mm_xor_si128(key,_mm_slli_si128(key,4));
+    key = _mm_xor_si128(key,_mm_slli_si128(key,4));
+    return _mm_xor_si128(key,keygen);
+}
+
+AESNI_FUNC void aesni_set_key ( aes_key_t * akey, const void * key )
+{
+    __m128i ek[11];
+    ek[0]  = _mm_loadu_si128((const __m128i*)key);
+    ek[1]  = AESNI_EXPAND(ek[0],0x01);
+    ek[2]  = AESNI_EXPAND(ek[1],0x02);
+    ek[3]  = AESNI_EXPAND(ek[2],0x04);
+    ek[4]  = AESNI_EXPAND(ek[3],0x08);
+    ek[5]  = AESNI_EXPAND(ek[4],0x10);
+    ek[6]  = AESNI_EXPAND(ek[5],0x20);
+    ek[7]  = AESNI_EXPAND(ek[6],0x40);
+    ek[8]  = AESNI_EXPAND(ek[7],0x80);
+    ek[9]  = AESNI_EXPAND(ek[8],0x1b);
+    ek[10] = AESNI_EXPAND(ek[9],0x36);
+
+    __m128i *ekey = (__m128i*)akey->hw_ekey;
+    __m128i *dkey = (__m128i*)akey->hw_dkey;
+    int i;
+    for ( i = 0; i < 11; i++ )
+	_mm_storeu_si128(ekey+i,ek[i]);
+
+    _mm_storeu_si128(dkey,ek[10]);
+    for ( i = 1; i < 10; i++ )
+	_mm_storeu_si128(dkey+i,_mm_aesimc_si128(ek[10-i]));
+    _mm_storeu_si128(dkey+10,ek[0]);
+
+    akey->hw_valid = 1;
+}
+
+AESNI_FUNC void aesni_decrypt
+	( const aes_key_t * akey, const u8 *iv, const u8 *in, u8 *out, u64 len )
+{
+    // CBC decryption is parallelizable => decrypt 4 blocks at once.
+    // All input blocks are loaded before storing => inplace is possible.
+
+    __m128i k[11];
+    int r;
+    for ( r = 0; r < 11; r++ )
+	k[r] = _mm_loadu_si128((const __m128i*)akey->hw_dkey+r);
+
+    __m128i prev = _mm_loadu_si128((const __m128i*)iv);
+    u64 n = len / 16;
+
+    for ( ; n >= 4; n -= 4, in += 64, out += 64 )
+    {
+	const __m128i c0 = _mm_loadu_si128((const __m128i*)in);
+	const __m128i c1 = _mm_loadu_si128((const __m128i*)in+1);
+	const __m128i c2 = _mm_loadu_si128((const __m128i*)in+2);
+	const __m128i c3 = _mm_loadu_si128((const __m128i*)in+3);
+
+	__m128i b0 = _mm_xor_si128(c0,k[0]);
+	__m128i b1 = _mm_xor_si128(c1,k[0]);
+	__m128i b2 = _mm_xor_si128(c2,k[0]);
+	__m128i b3 = _mm_xor_si128(c3,k[0]);
+	for ( r = 1; r < 10; r++ )
+	{
+	    b0 = _mm_aesdec_si128(b0,k[r]);
+	    b1 = _mm_aesdec_si128(b1,k[r]);
+	    b2 = _mm_aesdec_si128(b2,k[r]);
+	    b3 = _mm_aesdec_si128(b3,k[r]);
+	}
+	b0 = _mm_aesdeclast_si128(b0,k[10]);
+	b1 = _mm_aesdeclast_si128(b1,k[10]);
+	b2 = _mm_aesdeclast_si128(b2,k[10]);
+	b3 = _mm_aesdeclast_si128(b3,k[10]);
+
+	_mm_storeu_si128((__m128i*)out,  _mm_xor_si128(b0,prev));
+	_mm_storeu_si128((__m128i*)out+1,_mm_xor_si128(b1,c0));
+	_mm_storeu_si128((__m128i*)out+2,_mm_xor_si128(b2,c1));
+	_mm_storeu_si128((__m128i*)out+3,_mm_xor_si128(b3,c2));
+	prev = c3;
+    }
+
+    for ( ; n > 0; n--, in += 16, out += 16 )
+    {
+	const __m128i c = _mm_loadu_si128((const __m128i*)in);
+	__m128i b = _mm_xor_si128(c,k[0]);
+	for ( r = 1; r < 10; r++ )
+	    b = _mm_aesdec_si128(b,k[r]);
+	b = _mm_aesdeclast_si128(b,k[10]);
+	_mm_storeu_si128((__m128i*)out,_mm_xor_si128(b,prev));
+	prev = c;
+    }
+}
+
+AESNI_FUNC void aesni_encrypt
+	( const aes_key_t * akey, const u8 *iv, const u8 *in, u8 *out, u64 len )
+{
+    __m128i k[11];
+    int r;
+    for ( r = 0; r < 11; r++ )
+	k[r] = _mm_loadu_si128((const __m128i*)akey->hw_ekey+r);
+
+    __m128i b = _mm_loadu_si128((const __m128i*)iv);
+    u64 n = len / 16;
+
+    for ( ; n > 0; n--, in += 16, out += 16 )
+    {
+	b = _mm_xor_si128(b,_mm_loadu_si128((const __m128i*)in));
+	b = _mm_xor_si128(b,k[0]);
+	for ( r = 1; r < 10; r++ )
+	    b = _mm_aesenc_si128(b,k[r]);
+	b = _mm_aesenclast_si128(b,k[10]);
+	_mm_storeu_si128((__m128i*)out,b);
+    }
+}
+
+#endif // HAVE_AESNI
+
+///////////////////////////////////////////////////////////////////////////////
+
 void wd_aes_set_key ( aes_key_t * akey, const void * key )
 {
     gentables();
     gkey( akey, 4, 4, (char*)key );
+
+    akey->hw_valid = 0;
+ #if HAVE_AESNI
+    if (wd_aes_hw_available())
+	aesni_set_key(akey,key);
+ #endif
 }
 
 // CBC mode decryption
@@ -378,6 +549,14 @@ void wd_aes_decrypt
 
     ASSERT( inbuf != outbuf ); //no inplace decryption possible
 
+ #if HAVE_AESNI
+    if ( akey->hw_valid && hw_enabled && !(len&15) )
+    {
+	aesni_decrypt(akey,iv,inbuf,outbuf,len);
+	return;
+    }
+ #endif
+
     u8 block[16];
     const u8 *ctext_ptr;
     unsigned int blockno = 0, i;
@@ -429,6 +608,14 @@ void wd_aes_encrypt
     const u8 * inbuf	= p_inbuf;
 	  u8 * outbuf	= p_outbuf;
 
+ #if HAVE_AESNI
+    if ( akey->hw_valid && hw_enabled && !(len&15) )
+    {
+	aesni_encrypt(akey,p_iv,inbuf,outbuf,len);
+	return;
+    }
+ #endif
+
     u8 block[16], iv[16];
     memcpy(iv, p_iv, sizeof(iv));
     unsigned int blockno = 0, i;
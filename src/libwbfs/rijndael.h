@@ -15,6 +15,10 @@ typedef struct aes_key_t
 	u32 fkey[120];
 	u32 rkey[120];
 
+	int hw_valid;		// true: 'hw_ekey' and 'hw_dkey' are valid
+	u8  hw_ekey[11*16];	// AES-NI round keys for encryption
+	u8  hw_dkey[11*16];	// AES-NI round keys for decryption
+
 } aes_key_t;
 
 //-----------------------------------------------------------------------------
@@ -43,6 +47,17 @@ void wd_aes_encrypt
 	u64 len
 );
 
+//-----------------------------------------------------------------------------
+// Hardware support: AES-NI is detected by CPUID and used automatically.
+// Keys created by wd_aes_set_key() contain the round keys for both paths.
+
+int wd_aes_hw_available(); // returns true if AES-NI is supported by the CPU
+int wd_aes_hw_enable
+(
+	int enable	// 0: disable AES-NI, 1: enable AES-NI if available,
+			// -1: don't change; returns the previous state
+);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif // RIJNDAEL_H
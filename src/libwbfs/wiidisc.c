@@ -166,6 +166,25 @@ void wd_encrypt_title_key
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static const aes_key_t * get_part_akey
+(
+    wd_read_ctx_t	* ctx,		// valid read context
+    wd_part_t		* part		// valid pointer to a disc partition
+)
+{
+    DASSERT(ctx);
+    DASSERT(part);
+
+    if ( ctx->akey_part != part )
+    {
+	ctx->akey_part = part;
+	wd_aes_set_key(&ctx->akey,part->key);
+    }
+    return &ctx->akey;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void wd_decrypt_sectors
 (
     wd_part_t		* part,		// NULL or pointer to partition
@@ -179,14 +198,8 @@ void wd_decrypt_sectors
     if (!akey)
     {
 	DASSERT(part);
-	wd_disc_t * disc = part->disc;
-	DASSERT(disc);
-	if ( disc->akey_part != part )
-	{
-	    disc->akey_part = part;
-	    wd_aes_set_key(&disc->akey,part->key);
-	}
-	akey = &disc->akey;
+	DASSERT(part->disc);
+	akey = get_part_akey(&part->disc->read_ctx,part);
     }
 
     const u8 * src = sect_src;
@@ -273,14 +286,8 @@ void wd_encrypt_sectors
     if (!akey)
     {
 	DASSERT(part);
-	wd_disc_t * disc = part->disc;
-	DASSERT(disc);
-	if ( disc->akey_part != part )
-	{
-	    disc->akey_part = part;
-	    wd_aes_set_key(&disc->akey,part->key);
-	}
-	akey = &disc->akey;
+	DASSERT(part->disc);
+	akey = get_part_akey(&part->disc->read_ctx,part);
     }
 
     const u8 * src = sect_src;
@@ -745,63 +752,74 @@ enumError wd_read_part_raw
 
 ///////////////////////////////////////////////////////////////////////////////
 
-enumError wd_read_part_block
+static enumError load_part_block
 (
+    wd_read_ctx_t	* ctx,		// valid read context
     wd_part_t		* part,		// valid pointer to a disc partition
     u32			block_num,	// block number of partition
-    u8			* block,	// destination buf
     bool		mark_block	// true: mark block in 'usage_table'
 )
 {
-    TRACE("#WD# #%08x          wd_read_part_block()\n",block_num);
+    // load and decrypt a block into 'ctx->block_buf'
+
+    DASSERT(ctx);
     DASSERT(part);
     DASSERT(part->disc);
 
-    wd_disc_t * disc = part->disc;
+    if ( ctx->block_part == part && ctx->block_num == block_num )
+	return ERR_OK;
 
-    enumError err = ERR_OK;
-    if ( disc->block_part != part || disc->block_num != block_num )
-    {
+    const enumError err
+	= wd_read_raw(	part->disc,
+			part->data_off4 + block_num * WII_SECTOR_SIZE4,
+			ctx->temp_buf,
+			WII_SECTOR_SIZE,
+			mark_block ? part->usage_id | WD_USAGE_F_CRYPT : 0 );
 
-	err = wd_read_raw(	part->disc,
-				part->data_off4 + block_num * WII_SECTOR_SIZE4,
-				disc->temp_buf,
-				WII_SECTOR_SIZE,
-				mark_block ? part->usage_id | WD_USAGE_F_CRYPT : 0 );
-
-	if (err)
-	{
-	    memset(disc->block_buf,0,sizeof(disc->block_buf));
-	    disc->block_part = 0;
-	}
-	else
-	{
-	    disc->block_part = part;
-	    disc->block_num  = block_num;
+    if (err)
+    {
+	memset(ctx->block_buf,0,sizeof(ctx->block_buf));
+	ctx->block_part = 0;
+	return err;
+    }
 
-	    if (part->is_encrypted)
-	    {
-		if ( disc->akey_part != part )
-		{
-		    disc->akey_part = part;
-		    wd_aes_set_key(&disc->akey,part->key);
-		}
+    ctx->block_part = part;
+    ctx->block_num  = block_num;
 
-		// decrypt data
-		wd_aes_decrypt(	&disc->akey,
-				disc->temp_buf + WII_SECTOR_IV_OFF,
-				disc->temp_buf + WII_SECTOR_HASH_SIZE,
-				disc->block_buf,
-				WII_SECTOR_DATA_SIZE );
-	    }
-	    else
-		memcpy(	disc->block_buf,
-			disc->temp_buf + WII_SECTOR_HASH_SIZE,
+    if (part->is_encrypted)
+    {
+	// decrypt data
+	wd_aes_decrypt(	get_part_akey(ctx,part),
+			ctx->temp_buf + WII_SECTOR_IV_OFF,
+			ctx->temp_buf + WII_SECTOR_HASH_SIZE,
+			ctx->block_buf,
 			WII_SECTOR_DATA_SIZE );
-	}
     }
+    else
+	memcpy(	ctx->block_buf,
+		ctx->temp_buf + WII_SECTOR_HASH_SIZE,
+		WII_SECTOR_DATA_SIZE );
+
+    return ERR_OK;
+}
 
-    memcpy( block, disc->block_buf, WII_SECTOR_DATA_SIZE );
+///////////////////////////////////////////////////////////////////////////////
+
+enumError wd_read_part_block
+(
+    wd_part_t		* part,		// valid pointer to a disc partition
+    u32			block_num,	// block number of partition
+    u8			* block,	// destination buf
+    bool		mark_block	// true: mark block in 'usage_table'
+)
+{
+    TRACE("#WD# #%08x          wd_read_part_block()\n",block_num);
+    DASSERT(part);
+    DASSERT(part->disc);
+
+    wd_read_ctx_t * ctx = &part->disc->read_ctx;
+    const enumError err = load_part_block(ctx,part,block_num,mark_block);
+    memcpy( block, ctx->block_buf, WII_SECTOR_DATA_SIZE );
     return err;
 }
 
@@ -815,6 +833,21 @@ enumError wd_read_part
     u32			read_size,	// number of bytes to read 
     bool		mark_block	// true: mark block in 'usage_table'
 )
+{
+    return wd_read_part_ctx(0,part,data_offset4,dest_buf,read_size,mark_block);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError wd_read_part_ctx
+(
+    wd_read_ctx_t	* ctx,		// NULL or read context; NULL: use disc context
+    wd_part_t		* part,		// valid pointer to a disc partition
+    u32			data_offset4,	// partition data offset/4
+    void		* dest_buf,	// destination buffer
+    u32			read_size,	// number of bytes to read
+    bool		mark_block	// true: mark block in 'usage_table'
+)
 {
     TRACE("#WD# %8x %8x wd_read_part()\n",data_offset4,read_size);
     DASSERT(part);
@@ -841,7 +874,8 @@ enumError wd_read_part
     if ( part->max_marked < mark_end )
 	 part->max_marked = mark_end;
 
-    u8 * temp = disc->temp_buf;
+    if (!ctx)
+	ctx = &disc->read_ctx;
     u8 * dest = dest_buf;
 
     enumError err = ERR_OK;
@@ -852,11 +886,11 @@ enumError wd_read_part
 	if ( len_in_block > read_size )
 	     len_in_block = read_size;
 
-	err = wd_read_part_block( part,
-				  data_offset4 / WII_SECTOR_DATA_SIZE4,
-				  temp,
-				  mark_block );
-	memcpy( dest, temp + (offset4_in_block<<2), len_in_block );
+	err = load_part_block( ctx,
+			       part,
+			       data_offset4 / WII_SECTOR_DATA_SIZE4,
+			       mark_block );
+	memcpy( dest, ctx->block_buf + (offset4_in_block<<2), len_in_block );
 
 	dest		+= len_in_block;
 	data_offset4	+= len_in_block >> 2;
@@ -867,6 +901,18 @@ enumError wd_read_part
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void wd_reset_read_ctx
+(
+    wd_read_ctx_t	* ctx		// valid read context
+)
+{
+    DASSERT(ctx);
+    ctx->block_part = 0;
+    ctx->akey_part  = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void wd_mark_part
 (
     wd_part_t		* part,		// valid pointer to a disc partition
@@ -5179,6 +5225,14 @@ void wd_calc_group_hashes
 					// NULL or 'dirty sector' flags
 )
 {
+    //----- collect all H0 and H1 jobs of the dirty sectors
+
+    const u8 *data_list[WII_GROUP_SECTORS*WII_N_ELEMENTS_H0];
+    u8 *hash_list[WII_GROUP_SECTORS*WII_N_ELEMENTS_H0];
+    const u8 *h0_list[WII_GROUP_SECTORS];
+    u8 *h1_list[WII_GROUP_SECTORS];
+    uint n_h0 = 0, n_h1 = 0;
+
     int d;
     for ( d = 0; d < WII_GROUP_SECTORS; d++ )
     {
@@ -5190,31 +5244,42 @@ void wd_calc_group_hashes
 	int d0;
 	for ( d0 = 0; d0 < WII_N_ELEMENTS_H0; d0++ )
 	{
-	    SHA1(data,WII_H0_DATA_SIZE,h0);
+	    data_list[n_h0] = data;
+	    hash_list[n_h0] = h0;
+	    n_h0++;
 	    data += WII_H0_DATA_SIZE;
 	    h0   += WII_HASH_SIZE;
 	}
 
-	h0 = group_hash + d * WII_SECTOR_HASH_SIZE;
-	u8 * h1 = group_hash
+	h0_list[n_h1] = group_hash + d * WII_SECTOR_HASH_SIZE;
+	h1_list[n_h1] = group_hash
 		+ (d/WII_N_ELEMENTS_H1) * WII_N_ELEMENTS_H1 * WII_SECTOR_HASH_SIZE
 		+ (d%WII_N_ELEMENTS_H1) * WII_HASH_SIZE
 		+ 0x280;
-	SHA1(h0,WII_N_ELEMENTS_H0*WII_HASH_SIZE,h1);
+	n_h1++;
     }
 
+    //----- calculate them with one call for each level
+
+    SHA1_MB(data_list,WII_H0_DATA_SIZE,hash_list,n_h0);
+    SHA1_MB(h0_list,WII_N_ELEMENTS_H0*WII_HASH_SIZE,h1_list,n_h1);
+
     u8 * h1 = group_hash + 0x280;
     u8 * h2 = group_hash + 0x340;
+    const u8 *h1_src[WII_N_ELEMENTS_H2];
+    u8 *h2_dest[WII_N_ELEMENTS_H2];
     int d1, d2;
     for ( d2 = 0; d2 < WII_N_ELEMENTS_H2; d2++ )
     {
 	for ( d1 = 1; d1 < WII_N_ELEMENTS_H1; d1++ )
 	    memcpy( h1 + d1 * WII_SECTOR_HASH_SIZE, h1, WII_N_ELEMENTS_H1*WII_HASH_SIZE );
 
-	SHA1(h1,WII_N_ELEMENTS_H1*WII_HASH_SIZE,h2);
+	h1_src[d2]  = h1;
+	h2_dest[d2] = h2;
 	h1 += WII_N_ELEMENTS_H1 * WII_SECTOR_HASH_SIZE;
 	h2 += WII_HASH_SIZE;
     }
+    SHA1_MB(h1_src,WII_N_ELEMENTS_H1*WII_HASH_SIZE,h2_dest,WII_N_ELEMENTS_H2);
 
     h2 = group_hash + 0x340;
     for ( d1 = 1; d1 < WII_GROUP_SECTORS; d1++ )
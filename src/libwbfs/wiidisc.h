@@ -638,6 +638,34 @@ typedef struct wd_part_t
 
 } wd_part_t;
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			struct wd_read_ctx_t		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// A read context holds the caches and the scratch buffer of wd_read_part().
+// Each disc has its own context. Threads, that read the same disc
+// concurrently, must use a private context each. A zeroed context is valid.
+
+typedef struct wd_read_ctx_t
+{
+    //----- block cache
+
+    u8			block_buf[WII_SECTOR_DATA_SIZE];
+					// cache for partition blocks
+    u32			block_num;	// block number of last loaded 'block_buf'
+    wd_part_t		* block_part;	// partition of last loaded 'block_buf'
+
+    //----- akey cache
+
+    aes_key_t		akey;		// aes key for 'akey_part'
+    wd_part_t		* akey_part;	// partition of 'akey'
+
+    //----- temp buffer
+
+    u8	temp_buf[WII_SECTOR_SIZE];	// temp buffer for reading a sector
+
+} wd_read_ctx_t;
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			struct wd_disc_t		///////////////
@@ -719,17 +747,9 @@ typedef struct wd_disc_t
 					// usage table of disc
     int			usage_max;	// ( max used index of 'usage_table' ) + 1
 
-    //----- block cache
+    //----- read context
 
-    u8			block_buf[WII_SECTOR_DATA_SIZE];
-					// cache for partition blocks
-    u32			block_num;	// block number of last loaded 'block_buf'
-    wd_part_t		* block_part;	// partition of last loaded 'block_buf'
-
-    //----- akey cache
-
-    aes_key_t		akey;		// aes key for 'akey_part'
-    wd_part_t		* akey_part;	// partition of 'akey'
+    wd_read_ctx_t	read_ctx;	// block & akey cache of the disc
 
     //----- temp buffer
 
@@ -995,6 +1015,25 @@ enumError wd_read_part
 
 //-----------------------------------------------------------------------------
 
+enumError wd_read_part_ctx
+(
+    wd_read_ctx_t	* ctx,		// NULL or read context; NULL: use disc context
+    wd_part_t		* part,		// valid pointer to a disc partition
+    u32			data_offset4,	// partition data offset/4
+    void		* dest_buf,	// destination buffer
+    u32			read_size,	// number of bytes to read
+    bool		mark_block	// true: mark block in 'usage_table'
+);
+
+//-----------------------------------------------------------------------------
+
+void wd_reset_read_ctx
+(
+    wd_read_ctx_t	* ctx		// valid read context
+);
+
+//-----------------------------------------------------------------------------
+
 void wd_mark_part
 (
     wd_part_t		* part,		// valid pointer to a disc partition
@@ -37,11 +37,15 @@
 #define _GNU_SOURCE 1
 
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <ctype.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
 
 #include "debug.h"
 #include "lib-std.h"
@@ -106,6 +110,46 @@ int AddTitleFile ( ccp arg, int unused )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static bool FindTitleFile
+(
+    // return true if found and store the path to open in 'buf'
+
+    ccp		fname,		// name of title file, not '-'
+    char	*buf,		// result buffer
+    uint	buf_size	// size of 'buf'
+)
+{
+    ASSERT( fname && *fname );
+    ASSERT(buf);
+
+    struct stat st;
+    if (strchr(fname,'/'))
+    {
+     #ifdef __CYGWIN__
+	NormalizeFilenameCygwin(buf,buf_size,fname);
+     #else
+	StringCopyS(buf,buf_size,fname);
+     #endif
+	TRACE("#T#  - try %s\n",buf);
+	return !stat(buf,&st);
+    }
+
+    // no path found ==> use search_path[]
+    ccp * sp;
+    for ( sp = search_path; *sp; sp++ )
+    {
+	snprintf(buf,buf_size,"%s%s",*sp,fname);
+	TRACE("#T#  - try %s\n",buf);
+	if (!stat(buf,&st))
+	    return true;
+    }
+
+    *buf = 0;
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static int LoadTitleFile ( ccp fname, bool warn )
 {
     ASSERT( fname && *fname );
@@ -122,28 +166,10 @@ static int LoadTitleFile ( ccp fname, bool warn )
 	f = stdin;
 	TRACE("#T#  - use stdin, f=%p\n",f);
     }
-    else if (strchr(fname,'/'))
+    else if (FindTitleFile(fname,buf,sizeof(buf)))
     {
-     #ifdef __CYGWIN__
-	NormalizeFilenameCygwin(buf,sizeof(buf),fname);
 	f = fopen(buf,"r");
 	TRACE("#T#  - f=%p: %s\n",f,buf);
-	buf[0] = 0;
-     #else
-	f = fopen(fname,"r");
-	TRACE("#T#  - f=%p: %s\n",f,fname);
-     #endif
-    }
-    else
-    {
-	// no path found ==> use search_path[]
-	ccp * sp;
-	for ( sp = search_path; *sp && !f; sp++ )
-	{
-	    snprintf(buf,sizeof(buf),"%s%s",*sp,fname);
-	    f = fopen(buf,"r");
-	    TRACE("#T#  - f=%p: %s\n",f,buf);
-	}
     }
 
     if (!f)
@@ -238,6 +264,251 @@ static int LoadTitleFile ( ccp fname, bool warn )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			title index file		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#define TDB_INDEX_MAGIC		"WIT-TDB\n"
+#define TDB_INDEX_VERSION	1
+
+typedef struct TDBIndexHead_t
+{
+    char		magic[8];	// TDB_INDEX_MAGIC
+    u32			version;	// TDB_INDEX_VERSION, also endian check
+    u32			key_size;	// size of source key behind the header
+    u32			n_titles;	// number of titles
+    u32			off_list;	// file offset of offset list, aligned 4
+    u64			file_size;	// total size of index file
+}
+TDBIndexHead_t;
+
+//-----------------------------------------------------------------------------
+
+typedef struct TDBSource_t
+{
+    ccp			fname;		// name of title file as defined
+    bool		warn;		// true: warn if not found
+    bool		found;		// true: file found while creating the key
+}
+TDBSource_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static char * GetTitleIndexKey
+(
+    // return an alloced key, that describes all title sources,
+    // or NULL if the sources can't be indexed (stdin)
+
+    TDBSource_t		*src,		// list of title sources
+    uint		n_src,		// number of elements in 'src'
+    u32			*key_size,	// store size of key here
+    u32			*key_hash	// store hash of the key without file times
+)
+{
+    DASSERT( src || !n_src );
+    DASSERT(key_size);
+    DASSERT(key_hash);
+
+    // a source is stored by its found path or by its name as defined
+    uint i, size = 20;
+    for ( i = 0; i < n_src; i++ )
+	size += strlen(src[i].fname) + PATH_MAX + 80;
+
+    char *key = MALLOC(size), *dest = key, *end = key + size;
+    dest += snprintf(dest,end-dest,"utf8=%d\n",use_utf8);
+    u32 hash = 2166136261u; // FNV-1a
+    ccp ptr;
+    for ( ptr = key; ptr < dest; ptr++ )
+	hash = ( hash ^ (u8)*ptr ) * 16777619u;
+
+    for ( ; n_src > 0; n_src--, src++ )
+    {
+	if ( src->fname[0] == '-' && !src->fname[1] )
+	{
+	    FREE(key);
+	    return 0;
+	}
+
+	char path[PATH_MAX];
+	struct stat st;
+	src->found = FindTitleFile(src->fname,path,sizeof(path))
+			&& !stat(path,&st) && S_ISREG(st.st_mode);
+	ccp start = dest;
+	dest += snprintf(dest,end-dest,"%c %s",
+			src->found ? '+' : '-', src->found ? path : src->fname );
+	for ( ptr = start; ptr < dest; ptr++ )
+	    hash = ( hash ^ (u8)*ptr ) * 16777619u;
+
+	if (src->found)
+	    dest += snprintf(dest,end-dest," %llu %llu.%09lu",
+			(u64)st.st_size, (u64)st.st_mtim.tv_sec,
+			(ulong)st.st_mtim.tv_nsec );
+	if ( dest >= end - 1 )
+	{
+	    // never expected, but don't write behind the buffer
+	    FREE(key);
+	    return 0;
+	}
+	*dest++ = '\n';
+    }
+
+    *key_size = dest - key;
+    *key_hash = hash;
+    return key;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool GetTitleIndexPath ( char *buf, uint buf_size, u32 key_hash )
+{
+    // return false if no cache directory is available
+
+    char fname[30];
+    snprintf(fname,sizeof(fname),"titles-%08x.tdb",key_hash);
+    return GetCachePath(buf,buf_size,"WIT_TITLES_CACHE",fname);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool LoadTitleIndex
+(
+    // map the index file into 'db' and return true on success
+
+    ID_DB_t		*db,		// empty data base
+    ccp			path,		// path of index file
+    ccp			key,		// expected key
+    u32			key_size	// size of 'key'
+)
+{
+    DASSERT(db);
+    DASSERT(path);
+    DASSERT(key);
+
+    const int fd = open(path,O_RDONLY);
+    if ( fd < 0 )
+	return false;
+
+    struct stat st;
+    u8 *data = MAP_FAILED;
+    if ( !fstat(fd,&st)
+	&& S_ISREG(st.st_mode)
+	&& st.st_size >= sizeof(TDBIndexHead_t)
+	&& st.st_size == (size_t)st.st_size )
+    {
+	data = mmap(0,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    }
+    close(fd);
+    if ( data == MAP_FAILED )
+	return false;
+
+    const size_t size = st.st_size;
+    const TDBIndexHead_t *head = (TDBIndexHead_t*)data;
+    const u64 min_off = head->off_list + 4ull * head->n_titles;
+    if (   memcmp(head->magic,TDB_INDEX_MAGIC,sizeof(head->magic))
+	|| head->version != TDB_INDEX_VERSION
+	|| head->file_size != size
+	|| head->key_size != key_size
+	|| memcmp(head+1,key,key_size)
+	|| head->off_list & 3
+	|| head->off_list < sizeof(*head) + key_size
+	|| min_off > size
+	|| head->n_titles > INT_MAX
+	|| head->n_titles && data[size-1] )
+    {
+	goto invalid;
+    }
+
+    // each record needs the ID and at least the NULL of the title
+    const u32 *off = (u32*)( data + head->off_list ), *off_end;
+    for ( off_end = off + head->n_titles; off < off_end; off++ )
+	if ( *off < min_off || *off + sizeof(((ID_t*)0)->id) >= size )
+	    goto invalid;
+
+    TRACE("#T# title index mapped: %u titles, %s\n",head->n_titles,path);
+    db->list	 = 0;
+    db->used	 = head->n_titles;
+    db->size	 = 0;
+    db->map_off	 = (u32*)( data + head->off_list );
+    db->map_data = data;
+    db->map_size = size;
+    return true;
+
+ invalid:
+    TRACE("#T# invalid or outdated title index: %s\n",path);
+    munmap(data,size);
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void SaveTitleIndex
+(
+    ID_DB_t		*db,		// valid data base
+    ccp			path,		// path of index file
+    ccp			key,		// key to store
+    u32			key_size	// size of 'key'
+)
+{
+    DASSERT(db);
+    DASSERT(path);
+    DASSERT(key);
+
+    CreateCacheDir(path);
+
+    // write a temporary file first and rename it to be atomic
+    char temp[PATH_MAX+30];
+    snprintf(temp,sizeof(temp),"%s.%u.tmp",path,getpid());
+    FILE *f = fopen(temp,"wb");
+    if (!f)
+	return;
+
+    const uint n = db->used;
+    TDBIndexHead_t head;
+    memset(&head,0,sizeof(head));
+    memcpy(head.magic,TDB_INDEX_MAGIC,sizeof(head.magic));
+    head.version  = TDB_INDEX_VERSION;
+    head.key_size = key_size;
+    head.n_titles = n;
+    head.off_list = ALIGN32(sizeof(head)+key_size,4);
+
+    u32 *off = MALLOC( n * sizeof(*off) + 1 ), pos = head.off_list + n * sizeof(*off);
+    uint i;
+    for ( i = 0; i < n; i++ )
+    {
+	off[i] = pos;
+	pos += sizeof(((ID_t*)0)->id) + strlen(GetIDDB(db,i)->title) + 1;
+    }
+    head.file_size = pos;
+
+    static const char zero[4] = {0};
+    fwrite(&head,sizeof(head),1,f);
+    fwrite(key,key_size,1,f);
+    fwrite(zero,head.off_list-sizeof(head)-key_size,1,f);
+    fwrite(off,sizeof(*off),n,f);
+    for ( i = 0; i < n; i++ )
+    {
+	const ID_t *elem = GetIDDB(db,i);
+	char id[sizeof(elem->id)];
+	memset(id,0,sizeof(id));
+	StringCopyS(id,sizeof(id),elem->id);
+	fwrite(id,sizeof(id),1,f);
+	fwrite(elem->title,strlen(elem->title)+1,1,f);
+    }
+    FREE(off);
+
+    const bool failed = ferror(f) != 0;
+    if ( fclose(f) || failed || rename(temp,path) )
+	unlink(temp);
+    else
+	TRACE("#T# title index written: %u titles, %s\n",n,path);
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			titles interface (cont.)	///////////////
+///////////////////////////////////////////////////////////////////////////////
+
 void InitializeTDB()
 {
     static bool tdb_initialized = false;
@@ -245,28 +516,66 @@ void InitializeTDB()
     {
 	tdb_initialized = true;
 
-	title_db.list	= 0;
-	title_db.used	= 0;
-	title_db.size	= 0;
+	memset(&title_db,0,sizeof(title_db));
+
+	//--- collect title sources
+
+	uint n_src = 3;
+	StringList_t * sl;
+	for ( sl = first_title_fname; sl; sl = sl->next )
+	    n_src++;
+	TDBSource_t *src = CALLOC(n_src,sizeof(*src));
+	n_src = 0;
 
+	char lang[100];
 	if (load_default_titles)
 	{
-	    LoadTitleFile("titles.txt",false);
+	    src[n_src++].fname = "titles.txt";
 
 	    if (lang_info)
 	    {
-		char lang[100];
 		snprintf(lang,sizeof(lang),"titles-%s.txt",lang_info);
-		LoadTitleFile(lang,false);
+		src[n_src++].fname = lang;
 	    }
 
-	    LoadTitleFile("titles.local.txt",false);
+	    src[n_src++].fname = "titles.local.txt";
 	}
 
+	for ( sl = first_title_fname; sl; sl = sl->next )
+	{
+	    src[n_src].fname = sl->str;
+	    src[n_src++].warn = true;
+	}
+
+	//--- use the index file if valid, otherwise scan and create it
+
+	char path[PATH_MAX];
+	u32 key_size = 0, key_hash = 0;
+	char *key = GetTitleIndexKey(src,n_src,&key_size,&key_hash);
+	const bool use_index = key && GetTitleIndexPath(path,sizeof(path),key_hash);
+
+	uint i;
+	if ( use_index && LoadTitleIndex(&title_db,path,key,key_size) )
+	{
+	    if ( verbose > 3 )
+		printf("LOAD TITLE INDEX %s\n",path);
+	    for ( i = 0; i < n_src; i++ )
+		if ( !src[i].found && ( src[i].warn || verbose > 3 ) )
+		    ERROR0(ERR_WARNING,"Title file not found: %s\n",src[i].fname);
+	}
+	else
+	{
+	    for ( i = 0; i < n_src; i++ )
+		LoadTitleFile(src[i].fname,src[i].warn);
+	    if (use_index)
+		SaveTitleIndex(&title_db,path,key,key_size);
+	}
+	FREE(key);
+	FREE(src);
+
 	while (first_title_fname)
 	{
-	    StringList_t * sl = first_title_fname;
-	    LoadTitleFile(sl->str,true);
+	    sl = first_title_fname;
 	    first_title_fname = sl->next;
 	    FREE((char*)sl->str);
 	    FREE(sl);
@@ -291,12 +600,12 @@ ccp GetTitle ( ccp id6, ccp default_if_failed )
     int idx = FindID(&title_db,id6,&stat,0);
     TRACE("#T# GetTitle(%s) tm=%d  idx=%d/%d/%d  stat=%d -> %s %s\n",
 		id6, title_mode, idx, title_db.used, title_db.size, stat,
-		idx < title_db.used ? title_db.list[idx]->id : "",
-		idx < title_db.used ? title_db.list[idx]->title : "" );
+		idx < title_db.used ? GetIDDB(&title_db,idx)->id : "",
+		idx < title_db.used ? GetIDDB(&title_db,idx)->title : "" );
     ASSERT( stat == IDB_NOT_FOUND || idx < title_db.used );
     return stat == IDB_NOT_FOUND
 		? default_if_failed
-		: title_db.list[idx]->title;
+		: GetIDDB(&title_db,idx)->title;
 }
 
 //
@@ -957,7 +1266,7 @@ int FindID ( ID_DB_t *db, ccp id, TDBfind_t *p_stat, int * p_num )
 	return 0;
     }
 
-    ID_t * elem = 0;
+    const ID_t * elem = 0;
     size_t id_len  = strlen(id);
     if ( id_len > sizeof(elem->id)-1 )
 	id_len = sizeof(elem->id)-1;
@@ -966,7 +1275,7 @@ int FindID ( ID_DB_t *db, ccp id, TDBfind_t *p_stat, int * p_num )
     while ( beg <= end )
     {
 	int idx = (beg+end)/2;
-	elem = db->list[idx];
+	elem = GetIDDB(db,idx);
 	const int cmp_stat = memcmp(id,elem->id,id_len);
 	noPRINT(" - check: %d..%d..%d: %d = %s\n",beg,idx,end,cmp_stat,elem->id);
 	if ( cmp_stat < 0 )
@@ -976,13 +1285,13 @@ int FindID ( ID_DB_t *db, ccp id, TDBfind_t *p_stat, int * p_num )
 	else
 	{
 	    beg = idx;
-	    while ( beg > 0 && !memcmp(id,db->list[beg-1]->id,id_len) )
+	    while ( beg > 0 && !memcmp(id,GetIDDB(db,beg-1)->id,id_len) )
 		beg--;
 	    break;
 	}
     }
     ASSERT( beg >= 0 && beg <= db->used );
-    elem = db->list[beg];
+    elem = beg < db->used ? GetIDDB(db,beg) : 0;
 
     TDBfind_t stat = IDB_NOT_FOUND;
     if ( beg < db->used )
@@ -993,7 +1302,7 @@ int FindID ( ID_DB_t *db, ccp id, TDBfind_t *p_stat, int * p_num )
 	    stat = IDB_ABBREV_FOUND;
 	else if ( beg > 0 )
 	{
-	    elem = db->list[beg-1];
+	    elem = GetIDDB(db,beg-1);
 	    xTRACE("cmp-1[%s,%s] -> %d\n",id,elem->id,memcmp(id,elem->id,strlen(elem->id)));
 	    if (!memcmp(id,elem->id,strlen(elem->id)))
 	    {
@@ -1014,7 +1323,7 @@ int FindID ( ID_DB_t *db, ccp id, TDBfind_t *p_stat, int * p_num )
     if (p_num)
     {
 	int idx = beg;
-	while ( idx < db->used && !memcmp(id,db->list[idx],id_len) )
+	while ( idx < db->used && !memcmp(id,GetIDDB(db,idx)->id,id_len) )
 	    idx++;
 	xTRACE(" - num = %d\n",idx-beg);
 	*p_num = idx - beg;    }
@@ -1031,6 +1340,7 @@ int InsertID ( ID_DB_t * db, ccp id, ccp title )
 
     // remove all previous definitions first
     int idx = RemoveID(db,id,true);
+    DASSERT(!db->map_off);
 
     if ( db->used == db->size )
     {
@@ -1061,9 +1371,31 @@ int InsertID ( ID_DB_t * db, ccp id, ccp title )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static void SetupListIDDB ( ID_DB_t * db )
+{
+    // convert a mapped data base into a list based one to allow modifications.
+    // The list points into the mapped data, which stays valid.
+
+    DASSERT(db);
+    DASSERT(db->map_off);
+    TRACE("#T# SetupListIDDB(%p) n=%d\n",db,db->used);
+
+    db->size = db->used + tdb_grow_size;
+    db->list = (ID_t**)MALLOC(db->size*sizeof(*db->list));
+
+    int idx;
+    for ( idx = 0; idx < db->used; idx++ )
+	db->list[idx] = (ID_t*)GetIDDB(db,idx);
+    db->map_off = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 int RemoveID ( ID_DB_t * db, ccp id, bool remove_extended )
 {
     ASSERT(db);
+    if (db->map_off)
+	SetupListIDDB(db);
 
     TDBfind_t stat;
     int count;
@@ -1103,7 +1435,9 @@ int RemoveID ( ID_DB_t * db, ccp id, bool remove_extended )
 	    for ( c = 0; c < count; c++ )
 	    {
 		noPRINT(" - remove %s = %s\n",elem[c]->id,elem[c]->title);
-		FREE(elem[c]);
+		if ( (u8*)elem[c] < db->map_data
+			|| (u8*)elem[c] >= db->map_data + db->map_size )
+		    FREE(elem[c]);
 	    }
 
 	    db->used -= count;
@@ -1122,13 +1456,13 @@ int RemoveID ( ID_DB_t * db, ccp id, bool remove_extended )
 
 void DumpIDDB ( ID_DB_t * db, FILE * f )
 {
-    if ( !db || !db->list || !f )
+    if ( !db || !db->used || !f )
 	return;
 
-    ID_t ** list = db->list, **end;
-    for ( end = list + db->used; list < end; list++ )
+    int idx;
+    for ( idx = 0; idx < db->used; idx++ )
     {
-	ID_t * elem = *list;
+	const ID_t * elem = GetIDDB(db,idx);
 	if (*elem->title)
 	    fprintf(f,"%-6s = %s\n",elem->id,elem->title);
 	else
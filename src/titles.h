@@ -63,6 +63,22 @@
 //  abbreviaton for that ID is searched. Binary searching is used.
 //
 //---------------------------------------------------------------------------
+//
+//  Parsing the title files is expensive. Therefor the resulting data base
+//  is stored in a binary index file in the cache directory. The index is
+//  keyed by the path, size and mtime of all title sources. If the key
+//  matches, the index is mapped into memory and searched in place:
+//
+//      TDBIndexHead_t : header with magic, version and sizes
+//      key            : 'key_size' bytes, description of the title sources
+//      u32[]          : 'n_titles' offsets of the ID_t records, aligned 4
+//      ID_t[]         : the records, each with a NULL terminated title
+//
+//  The cache directory is $WIT_TITLES_CACHE, $XDG_CACHE_HOME/wit or
+//  $HOME/.cache/wit. An empty $WIT_TITLES_CACHE disables the index.
+//  A mapped data base is copied into memory before the first modification.
+//
+//---------------------------------------------------------------------------
 
 #endif
 //
@@ -93,8 +109,22 @@ typedef struct ID_DB_t
 	int used;		// number of used titles in the title field
 	int size;		// number of allocated pointer in 'title'
 
+	// read only data base mapped from an index file
+	const u32 * map_off;	// not NULL: 'used' offsets into 'map_data'
+	const u8  * map_data;	// mapped index file
+	size_t map_size;	// size of 'map_data'
+
 } ID_DB_t;
 
+//-----------------------------------------------------------------------------
+
+static inline const ID_t * GetIDDB ( const ID_DB_t * db, int idx )
+{
+    return db->map_off
+		? (const ID_t*)( db->map_data + db->map_off[idx] )
+		: db->list[idx];
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////                 titles interface                ///////////////
@@ -265,13 +265,13 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Select one compression method, level and chunk size for new WIA"
 	" files. The syntax for mode is: [method] [.level] [@factor]\n"
 	"  'method' is the name of the method. Possible compressions method"
-	" are NONE, PURGE, BZIP2, LZMA and LZMA2. There are additional"
-	" keywords: DEFAULT (=LZMA.5@20), FAST (=BZIP2.3@10), GOOD"
-	" (=LZMA.5@20) BEST (=LZMA.7@50), and MEM (use best mode in respect to"
-	" memory limit set by --mem). Additionally the single digit modes 0"
-	" (=NONE), 1 (=fast LZMA) .. 9 (=BEST)are defined. These additional"
-	" keywords may change their meanings if a new compression method is"
-	" implemented.\n"
+	" are NONE, PURGE, BZIP2, LZMA, LZMA2 and ZSTD (if supported by the"
+	" build). There are additional keywords: DEFAULT (=LZMA.5@20), FAST"
+	" (=BZIP2.3@10), GOOD (=LZMA.5@20) BEST (=LZMA.7@50), and MEM (use"
+	" best mode in respect to memory limit set by --mem). Additionally the"
+	" single digit modes 0 (=NONE), 1 (=fast LZMA) .. 9 (=BEST)are"
+	" defined. These additional keywords may change their meanings if a"
+	" new compression method is implemented.\n"
 	"  '.level' is a point followed by one digit. It defines the"
 	" compression level. The special value .0 means: Use default"
 	" compression level (=.5).\n"
@@ -344,7 +344,36 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Setup the IO mode for experiments. The standard file IO is based on"
 	" open() function. The value '1' defines that WBFS IO is based on"
 	" fopen() function. The value '2' defines the same for ISO files and"
-	" value '4' for WIA files. You can combine the values by adding them."
+	" value '4' for WIA files. The value '16' enables io_uring based"
+	" reading and writing of plain files and split files, if supported by"
+	" the kernel. The value '32' maps ISO and WDF source files into memory"
+	" and reads them without system calls. You can combine the values by"
+	" adding them."
+    },
+
+    {	OPT_THREADS, 0, "threads",
+	"num",
+	"Define the maximum number of worker threads used for compressing and"
+	" other parallel jobs. The value '0' (default) selects the number of"
+	" online CPUs or the value of environment variable 'WIT_THREADS'. The"
+	" value '1' disables multi threading."
+    },
+
+    {	OPT_IOBUF, 0, "iobuf",
+	"size",
+	"Define the size of the I/O buffers used for copying and comparing (in"
+	" MiB if no other unit is entered). Each operation gets an own buffer"
+	" aligned to 4 KiB. The value '0' (default) selects 4 MiB. Larger"
+	" values may speed up transfers on fast devices."
+    },
+
+    {	OPT_GCZ_CACHE, 0, "gcz-cache",
+	"num",
+	"Define the number of decompressed blocks, that are cached while"
+	" reading GCZ images. The value '0' (default) selects 32 blocks. The"
+	" memory used by the cache is limited to 64 MiB. If multi threading is"
+	" enabled, the next blocks of sequential reads are decompressed in"
+	" parallel by worker threads."
     },
 
     {	OPT_DIRECT, 0, "direct",
@@ -381,7 +410,7 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Use new implementation if available."
     },
 
-    {0,0,0,0,0} // OPT__N_TOTAL == 43
+    {0,0,0,0,0} // OPT__N_TOTAL == 46
 
 };
 
@@ -475,6 +504,10 @@ const struct option OptionLong[] =
 	{ "verbose",		0, 0, 'v' },
 	{ "logging",		0, 0, 'L' },
 	{ "io",			1, 0, GO_IO },
+	{ "threads",		1, 0, GO_THREADS },
+	{ "iobuf",		1, 0, GO_IOBUF },
+	{ "gcz-cache",		1, 0, GO_GCZ_CACHE },
+	 { "gczcache",		1, 0, GO_GCZ_CACHE },
 	{ "direct",		0, 0, GO_DIRECT },
 	{ "chunk",		0, 0, GO_CHUNK },
 	{ "long",		0, 0, 'l' },
@@ -577,27 +610,30 @@ const u8 OptionIndex[OPT_INDEX_SIZE] =
 	/* 0x80   */	OPT_XHELP,
 	/* 0x81   */	OPT_WIDTH,
 	/* 0x82   */	OPT_IO,
-	/* 0x83   */	OPT_DIRECT,
-	/* 0x84   */	OPT_CHUNK,
-	/* 0x85   */	OPT_LIMIT,
-	/* 0x86   */	OPT_FILE_LIMIT,
-	/* 0x87   */	OPT_BLOCK_SIZE,
-	/* 0x88   */	OPT_WDF1,
-	/* 0x89   */	OPT_WDF2,
-	/* 0x8a   */	OPT_ALIGN_WDF,
-	/* 0x8b   */	OPT_WIA,
-	/* 0x8c   */	OPT_WBI,
-	/* 0x8d   */	OPT_AUTO_SPLIT,
-	/* 0x8e   */	OPT_NO_SPLIT,
-	/* 0x8f   */	OPT_PREALLOC,
-	/* 0x90   */	OPT_CHUNK_MODE,
-	/* 0x91   */	OPT_CHUNK_SIZE,
-	/* 0x92   */	OPT_MAX_CHUNKS,
-	/* 0x93   */	OPT_COMPRESSION,
-	/* 0x94   */	OPT_MEM,
-	/* 0x95   */	OPT_OLD,
-	/* 0x96   */	OPT_NEW,
-	/* 0x97   */	 0,0,0,0, 0,0,0,0, 0,
+	/* 0x83   */	OPT_THREADS,
+	/* 0x84   */	OPT_IOBUF,
+	/* 0x85   */	OPT_GCZ_CACHE,
+	/* 0x86   */	OPT_DIRECT,
+	/* 0x87   */	OPT_CHUNK,
+	/* 0x88   */	OPT_LIMIT,
+	/* 0x89   */	OPT_FILE_LIMIT,
+	/* 0x8a   */	OPT_BLOCK_SIZE,
+	/* 0x8b   */	OPT_WDF1,
+	/* 0x8c   */	OPT_WDF2,
+	/* 0x8d   */	OPT_ALIGN_WDF,
+	/* 0x8e   */	OPT_WIA,
+	/* 0x8f   */	OPT_WBI,
+	/* 0x90   */	OPT_AUTO_SPLIT,
+	/* 0x91   */	OPT_NO_SPLIT,
+	/* 0x92   */	OPT_PREALLOC,
+	/* 0x93   */	OPT_CHUNK_MODE,
+	/* 0x94   */	OPT_CHUNK_SIZE,
+	/* 0x95   */	OPT_MAX_CHUNKS,
+	/* 0x96   */	OPT_COMPRESSION,
+	/* 0x97   */	OPT_MEM,
+	/* 0x98   */	OPT_OLD,
+	/* 0x99   */	OPT_NEW,
+	/* 0x9a   */	 0,0,0,0, 0,0,
 	/* 0xa0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 	/* 0xb0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 	/* 0xc0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
@@ -665,6 +701,9 @@ const InfoOption_t * option_tab_tool[] =
 	OptionInfo + OPT_VERBOSE,
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_IO,
+	OptionInfo + OPT_THREADS,
+	OptionInfo + OPT_IOBUF,
+	OptionInfo + OPT_GCZ_CACHE,
 
 	OptionInfo + OPT_NONE, // separator
 
@@ -801,7 +840,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	" wdf-dump (with or without minus signs).\n"
 	"  'wdf +CAT' replaces the old tool wdf-cat and 'wdf +DUMP' the old"
 	" tool wdf-dump.",
-	10,
+	13,
 	option_tab_tool,
 	0
     },
@@ -98,13 +98,16 @@ typedef enum enumOptions
 	OPT_VERBOSE,
 	OPT_LOGGING,
 	OPT_IO,
+	OPT_THREADS,
+	OPT_IOBUF,
+	OPT_GCZ_CACHE,
 	OPT_DIRECT,
 	OPT_ALIGN_WDF,
 	OPT_TEST,
 	OPT_OLD,
 	OPT_NEW,
 
-	OPT__N_TOTAL // == 43
+	OPT__N_TOTAL // == 46
 
 } enumOptions;
 
@@ -259,6 +262,9 @@ typedef enum enumGetOpt
 	GO_XHELP		= 0x80,
 	GO_WIDTH,
 	GO_IO,
+	GO_THREADS,
+	GO_IOBUF,
+	GO_GCZ_CACHE,
 	GO_DIRECT,
 	GO_CHUNK,
 	GO_LIMIT,
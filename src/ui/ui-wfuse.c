@@ -92,7 +92,27 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Setup the IO mode for experiments. The standard file IO is based on"
 	" open() function. The value '1' defines that WBFS IO is based on"
 	" fopen() function. The value '2' defines the same for ISO files and"
-	" value '4' for WIA files. You can combine the values by adding them."
+	" value '4' for WIA files. The value '16' enables io_uring based"
+	" reading and writing of plain files and split files, if supported by"
+	" the kernel. The value '32' maps ISO and WDF source files into memory"
+	" and reads them without system calls. You can combine the values by"
+	" adding them."
+    },
+
+    {	OPT_THREADS, 0, "threads",
+	"num",
+	"Define the maximum number of worker threads used for compressing and"
+	" other parallel jobs. The value '0' (default) selects the number of"
+	" online CPUs or the value of environment variable 'WIT_THREADS'. The"
+	" value '1' disables multi threading."
+    },
+
+    {	OPT_FST_CACHE, 0, "fst-cache",
+	"num",
+	"Define the number of encrypted partition groups (2 MiB each), that"
+	" are cached while reading a composed image from an extracted file"
+	" system. The value '0' (default) selects 8 groups. The memory is"
+	" allocated on demand."
     },
 
     {	OPT_PARAM, 'p', "param",
@@ -124,6 +144,17 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" first."
     },
 
+    {	OPT_PERF, 0, "perf",
+	0,
+	"Enable the performance mode for large and repeated reads. The source"
+	" must not change while it is mounted. The kernel keeps the page cache"
+	" of opened files, caches the attributes for one minute and uses a"
+	" larger readahead window. With FUSE 2.9 or newer, data of plain ISO"
+	" images and of WBFS discs is spliced from the source file without"
+	" copying it through wfuse. The file '/stats.txt' counts the reads of"
+	" each disc."
+    },
+
     {	OPT_UMOUNT, 'u', "umount",
 	0,
 	"Enter 'unmount mode' and unmount each entered directory by calling"
@@ -137,7 +168,7 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" as it is not busy anymore."
     },
 
-    {0,0,0,0,0} // OPT__N_TOTAL == 16
+    {0,0,0,0,0} // OPT__N_TOTAL == 19
 
 };
 
@@ -159,12 +190,17 @@ const struct option OptionLong[] =
 	{ "quiet",		0, 0, 'q' },
 	{ "verbose",		0, 0, 'v' },
 	{ "io",			1, 0, GO_IO },
+	{ "threads",		1, 0, GO_THREADS },
+	{ "fst-cache",		1, 0, GO_FST_CACHE },
+	 { "fstcache",		1, 0, GO_FST_CACHE },
 	{ "param",		1, 0, 'p' },
 	{ "option",		1, 0, 'o' },
 	{ "allow-other",	0, 0, 'O' },
 	 { "allowother",	0, 0, 'O' },
 	{ "create",		0, 0, 'c' },
 	{ "remount",		0, 0, 'r' },
+	{ "perf",		0, 0, GO_PERF },
+	 { "performance",	0, 0, GO_PERF },
 	{ "umount",		0, 0, 'u' },
 	 { "unmount",		0, 0, 'u' },
 	{ "lazy",		0, 0, 'l' },
@@ -209,7 +245,10 @@ const u8 OptionIndex[OPT_INDEX_SIZE] =
 	/* 0x80   */	OPT_XHELP,
 	/* 0x81   */	OPT_WIDTH,
 	/* 0x82   */	OPT_IO,
-	/* 0x83   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,
+	/* 0x83   */	OPT_THREADS,
+	/* 0x84   */	OPT_FST_CACHE,
+	/* 0x85   */	OPT_PERF,
+	/* 0x86   */	 0,0,0,0, 0,0,0,0, 0,0,
 	/* 0x90   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 	/* 0xa0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 	/* 0xb0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
@@ -232,6 +271,7 @@ const InfoOption_t * option_tab_tool[] =
 	OptionInfo + OPT_HELP_FUSE,
 	OptionInfo + OPT_WIDTH,
 	OptionInfo + OPT_QUIET,
+	OptionInfo + OPT_FST_CACHE,
 
 	OptionInfo + OPT_NONE, // separator
 
@@ -240,6 +280,7 @@ const InfoOption_t * option_tab_tool[] =
 	OptionInfo + OPT_ALLOW_OTHER,
 	OptionInfo + OPT_CREATE,
 	OptionInfo + OPT_REMOUNT,
+	OptionInfo + OPT_PERF,
 
 	OptionInfo + OPT_NONE, // separator
 
@@ -267,7 +308,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"Mount a Wii or GameCube image or a WBFS file or partition to a mount"
 	" point using FUSE (Filesystem in USErspace). Use 'wfuse --umount"
 	" mountdir' for unmounting.",
-	13,
+	15,
 	option_tab_tool,
 	0
     },
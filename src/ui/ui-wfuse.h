@@ -62,15 +62,18 @@ typedef enum enumOptions
 	OPT_QUIET,
 	OPT_VERBOSE,
 	OPT_IO,
+	OPT_THREADS,
+	OPT_FST_CACHE,
 	OPT_PARAM,
 	OPT_OPTION,
 	OPT_ALLOW_OTHER,
 	OPT_CREATE,
 	OPT_REMOUNT,
+	OPT_PERF,
 	OPT_UMOUNT,
 	OPT_LAZY,
 
-	OPT__N_TOTAL // == 16
+	OPT__N_TOTAL // == 19
 
 } enumOptions;
 
@@ -112,6 +115,9 @@ typedef enum enumGetOpt
 	GO_XHELP		= 0x80,
 	GO_WIDTH,
 	GO_IO,
+	GO_THREADS,
+	GO_FST_CACHE,
+	GO_PERF,
 
 } enumGetOpt;
 
@@ -596,13 +596,13 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Select one compression method, level and chunk size for new WIA"
 	" files. The syntax for mode is: [method] [.level] [@factor]\n"
 	"  'method' is the name of the method. Possible compressions method"
-	" are NONE, PURGE, BZIP2, LZMA and LZMA2. There are additional"
-	" keywords: DEFAULT (=LZMA.5@20), FAST (=BZIP2.3@10), GOOD"
-	" (=LZMA.5@20) BEST (=LZMA.7@50), and MEM (use best mode in respect to"
-	" memory limit set by --mem). Additionally the single digit modes 0"
-	" (=NONE), 1 (=fast LZMA) .. 9 (=BEST)are defined. These additional"
-	" keywords may change their meanings if a new compression method is"
-	" implemented.\n"
+	" are NONE, PURGE, BZIP2, LZMA, LZMA2 and ZSTD (if supported by the"
+	" build). There are additional keywords: DEFAULT (=LZMA.5@20), FAST"
+	" (=BZIP2.3@10), GOOD (=LZMA.5@20) BEST (=LZMA.7@50), and MEM (use"
+	" best mode in respect to memory limit set by --mem). Additionally the"
+	" single digit modes 0 (=NONE), 1 (=fast LZMA) .. 9 (=BEST)are"
+	" defined. These additional keywords may change their meanings if a"
+	" new compression method is implemented.\n"
 	"  '.level' is a point followed by one digit. It defines the"
 	" compression level. The special value .0 means: Use default"
 	" compression level (=.5).\n"
@@ -698,6 +698,16 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" '--wia --compression mode'."
     },
 
+    {	OPT_RVZ, 0, "rvz",
+	"[=compr]",
+	"Set image output file type to RVZ (Dolphins Revolution Zip), a"
+	" revision of WIA. The optional parameter is a compression mode and"
+	" --rvz=mode is a shortcut for '--rvz --compression mode'. Method"
+	" PURGE is not allowed for RVZ. Junk data of unused disc areas is"
+	" stored by its seed, so that unscrubbed images are stored bit-exact"
+	" at nearly the size of scrubbed images."
+    },
+
     {	OPT_GCZ, 'G', "gcz",
 	0,
 	"Set image output file type to GCZ (Dolphins GameCube Zip)."
@@ -819,6 +829,15 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Eliminate multiple entries with same ID6."
     },
 
+    {	OPT_NO_CACHE, 0, "no-cache",
+	0,
+	"Don't use the disc info cache. The cache stores the disc infos of all"
+	" scanned image files and is used again for unchanged files (path,"
+	" size, mtime and inode). It is stored in the directory defined by"
+	" environment variable 'WIT_DISC_CACHE' or in 'XDG_CACHE_HOME/wit' or"
+	" 'HOME/.cache/wit'. An empty 'WIT_DISC_CACHE' disables the cache."
+    },
+
     {	OPT_NO_HEADER, 'H', "no-header",
 	0,
 	"Suppress printing of header and footer."
@@ -863,7 +882,7 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Define a patch file."
     },
 
-    {0,0,0,0,0}, // OPT__N_SPECIFIC == 103
+    {0,0,0,0,0}, // OPT__N_SPECIFIC == 105
 
     //----- global options -----
 
@@ -930,7 +949,54 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Setup the IO mode for experiments. The standard file IO is based on"
 	" open() function. The value '1' defines that WBFS IO is based on"
 	" fopen() function. The value '2' defines the same for ISO files and"
-	" value '4' for WIA files. You can combine the values by adding them."
+	" value '4' for WIA files. The value '16' enables io_uring based"
+	" reading and writing of plain files and split files, if supported by"
+	" the kernel. The value '32' maps ISO and WDF source files into memory"
+	" and reads them without system calls. You can combine the values by"
+	" adding them."
+    },
+
+    {	OPT_THREADS, 0, "threads",
+	"num",
+	"Define the maximum number of worker threads used for compressing and"
+	" other parallel jobs. The value '0' (default) selects the number of"
+	" online CPUs or the value of environment variable 'WIT_THREADS'. The"
+	" value '1' disables multi threading."
+    },
+
+    {	OPT_SCAN_THREADS, 0, "scan-threads",
+	"num",
+	"Define the number of worker threads, that probe directory entries in"
+	" advance (status and file header) while scanning source directories."
+	" The scanner itself keeps the order of the entries and finds the data"
+	" in the caches of the operating system. This hides the latency of"
+	" network file systems. The value '0' (default) selects the value of"
+	" --threads. The value '1' disables probing in advance."
+    },
+
+    {	OPT_IOBUF, 0, "iobuf",
+	"size",
+	"Define the size of the I/O buffers used for copying and comparing (in"
+	" MiB if no other unit is entered). Each operation gets an own buffer"
+	" aligned to 4 KiB. The value '0' (default) selects 4 MiB. Larger"
+	" values may speed up transfers on fast devices."
+    },
+
+    {	OPT_GCZ_CACHE, 0, "gcz-cache",
+	"num",
+	"Define the number of decompressed blocks, that are cached while"
+	" reading GCZ images. The value '0' (default) selects 32 blocks. The"
+	" memory used by the cache is limited to 64 MiB. If multi threading is"
+	" enabled, the next blocks of sequential reads are decompressed in"
+	" parallel by worker threads."
+    },
+
+    {	OPT_FST_CACHE, 0, "fst-cache",
+	"num",
+	"Define the number of encrypted partition groups (2 MiB each), that"
+	" are cached while reading a composed image from an extracted file"
+	" system. The value '0' (default) selects 8 groups. The memory is"
+	" allocated on demand."
     },
 
     {	OPT_FORCE, 'f', "force",
@@ -948,7 +1014,11 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
     {	OPT_TITLES, 'T', "titles",
 	"file",
 	"Read file for disc titles. -T/ disables automatic search for title"
-	" files."
+	" files. The parsed titles are cached in a binary index file in the"
+	" directory defined by environment variable 'WIT_TITLES_CACHE' or in"
+	" 'XDG_CACHE_HOME/wit' or 'HOME/.cache/wit'. The index is rebuilt"
+	" automatically if a title file changes. An empty 'WIT_TITLES_CACHE'"
+	" disables the index."
     },
 
     {	OPT_UTF_8, 0, "utf-8",
@@ -1024,7 +1094,7 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" caution!"
     },
 
-    {0,0,0,0,0} // OPT__N_TOTAL == 128
+    {0,0,0,0,0} // OPT__N_TOTAL == 135
 
 };
 
@@ -1427,6 +1497,7 @@ const CommandTab_t CommandTab[] =
     { CMD_EXCLUDE,	"EXCLUDE",	0,		0 },
     { CMD_TITLES,	"TITLES",	0,		0 },
     { CMD_GETTITLES,	"GETTITLES",	0,		0 },
+    { CMD_CLEAR_CACHE,	"CLEAR-CACHE",	"CLEARCACHE",	0 },
     { CMD_CERT,		"CERT",		0,		0 },
     { CMD_CREATE,	"CREATE",	0,		0 },
     { CMD_DOLPATCH,	"DOLPATCH",	0,		0 },
@@ -1493,6 +1564,14 @@ const struct option OptionLong[] =
 	{ "logging",		0, 0, 'L' },
 	{ "esc",		1, 0, 'E' },
 	{ "io",			1, 0, GO_IO },
+	{ "threads",		1, 0, GO_THREADS },
+	{ "scan-threads",	1, 0, GO_SCAN_THREADS },
+	 { "scanthreads",	1, 0, GO_SCAN_THREADS },
+	{ "iobuf",		1, 0, GO_IOBUF },
+	{ "gcz-cache",		1, 0, GO_GCZ_CACHE },
+	 { "gczcache",		1, 0, GO_GCZ_CACHE },
+	{ "fst-cache",		1, 0, GO_FST_CACHE },
+	 { "fstcache",		1, 0, GO_FST_CACHE },
 	{ "force",		0, 0, 'f' },
 	{ "direct",		0, 0, GO_DIRECT },
 	{ "titles",		1, 0, 'T' },
@@ -1637,6 +1716,7 @@ const struct option OptionLong[] =
 	{ "ciso",		0, 0, 'C' },
 	{ "wbfs",		0, 0, 'B' },
 	{ "wia",		2, 0, GO_WIA },
+	{ "rvz",		2, 0, GO_RVZ },
 	{ "gcz",		0, 0, 'G' },
 	{ "gcz-zip",		0, 0, GO_GCZ_ZIP },
 	 { "gczzip",		0, 0, GO_GCZ_ZIP },
@@ -1660,6 +1740,8 @@ const struct option OptionLong[] =
 	{ "show",		1, 0, '+' },
 	{ "unit",		1, 0, GO_UNIT },
 	{ "unique",		0, 0, 'U' },
+	{ "no-cache",		0, 0, GO_NO_CACHE },
+	 { "nocache",		0, 0, GO_NO_CACHE },
 	{ "no-header",		0, 0, 'H' },
 	 { "noheader",		0, 0, 'H' },
 	{ "old-style",		0, 0, GO_OLD_STYLE },
@@ -1748,90 +1830,97 @@ const u8 OptionIndex[OPT_INDEX_SIZE] =
 	/* 0x81   */	OPT_WIDTH,
 	/* 0x82   */	OPT_SCAN_PROGRESS,
 	/* 0x83   */	OPT_IO,
-	/* 0x84   */	OPT_DIRECT,
-	/* 0x85   */	OPT_UTF_8,
-	/* 0x86   */	OPT_NO_UTF_8,
-	/* 0x87   */	OPT_LANG,
-	/* 0x88   */	OPT_CERT,
-	/* 0x89   */	OPT_OLD,
-	/* 0x8a   */	OPT_NEW,
-	/* 0x8b   */	OPT_NO_EXPAND,
-	/* 0x8c   */	OPT_RDEPTH,
-	/* 0x8d   */	OPT_INCLUDE_FIRST,
-	/* 0x8e   */	OPT_JOB_LIMIT,
-	/* 0x8f   */	OPT_FAKE_SIGN,
-	/* 0x90   */	OPT_IGNORE_FST,
-	/* 0x91   */	OPT_IGNORE_SETUP,
-	/* 0x92   */	OPT_LINKS,
-	/* 0x93   */	OPT_PSEL,
-	/* 0x94   */	OPT_RAW,
-	/* 0x95   */	OPT_PMODE,
-	/* 0x96   */	OPT_FLAT,
-	/* 0x97   */	OPT_COPY_GC,
-	/* 0x98   */	OPT_NO_LINK,
-	/* 0x99   */	OPT_NEEK,
-	/* 0x9a   */	OPT_HOOK,
-	/* 0x9b   */	OPT_ENC,
-	/* 0x9c   */	OPT_MODIFY,
-	/* 0x9d   */	OPT_NAME,
-	/* 0x9e   */	OPT_ID,
-	/* 0x9f   */	OPT_DISC_ID,
-	/* 0xa0   */	OPT_BOOT_ID,
-	/* 0xa1   */	OPT_TICKET_ID,
-	/* 0xa2   */	OPT_TMD_ID,
-	/* 0xa3   */	OPT_TT_ID,
-	/* 0xa4   */	OPT_WBFS_ID,
-	/* 0xa5   */	OPT_REGION,
-	/* 0xa6   */	OPT_COMMON_KEY,
-	/* 0xa7   */	OPT_IOS,
-	/* 0xa8   */	OPT_HTTP,
-	/* 0xa9   */	OPT_DOMAIN,
-	/* 0xaa   */	OPT_WIIMMFI,
-	/* 0xab   */	OPT_TWIIMMFI,
-	/* 0xac   */	OPT_RM_FILES,
-	/* 0xad   */	OPT_ZERO_FILES,
-	/* 0xae   */	OPT_OVERLAY,
-	/* 0xaf   */	OPT_REPL_FILE,
-	/* 0xb0   */	OPT_ADD_FILE,
-	/* 0xb1   */	OPT_IGNORE_FILES,
-	/* 0xb2   */	OPT_TRIM,
-	/* 0xb3   */	OPT_ALIGN,
-	/* 0xb4   */	OPT_ALIGN_PART,
-	/* 0xb5   */	OPT_ALIGN_FILES,
-	/* 0xb6   */	OPT_AUTO_SPLIT,
-	/* 0xb7   */	OPT_NO_SPLIT,
-	/* 0xb8   */	OPT_DISC_SIZE,
-	/* 0xb9   */	OPT_PREALLOC,
-	/* 0xba   */	OPT_TRUNC,
-	/* 0xbb   */	OPT_CHUNK_MODE,
-	/* 0xbc   */	OPT_CHUNK_SIZE,
-	/* 0xbd   */	OPT_MAX_CHUNKS,
-	/* 0xbe   */	OPT_BLOCK_SIZE,
-	/* 0xbf   */	OPT_COMPRESSION,
-	/* 0xc0   */	OPT_MEM,
-	/* 0xc1   */	OPT_DIFF,
-	/* 0xc2   */	OPT_WDF1,
-	/* 0xc3   */	OPT_WDF2,
-	/* 0xc4   */	OPT_ALIGN_WDF,
-	/* 0xc5   */	OPT_WIA,
-	/* 0xc6   */	OPT_GCZ_ZIP,
-	/* 0xc7   */	OPT_GCZ_BLOCK,
-	/* 0xc8   */	OPT_FST,
-	/* 0xc9   */	OPT_ITIME,
-	/* 0xca   */	OPT_MTIME,
-	/* 0xcb   */	OPT_CTIME,
-	/* 0xcc   */	OPT_ATIME,
-	/* 0xcd   */	OPT_TIME,
-	/* 0xce   */	OPT_NUMERIC,
-	/* 0xcf   */	OPT_TECHNICAL,
-	/* 0xd0   */	OPT_REALPATH,
-	/* 0xd1   */	OPT_UNIT,
-	/* 0xd2   */	OPT_OLD_STYLE,
-	/* 0xd3   */	OPT_SECTIONS,
-	/* 0xd4   */	OPT_LIMIT,
-	/* 0xd5   */	OPT_FILE_LIMIT,
-	/* 0xd6   */	OPT_PATCH_FILE,
-	/* 0xd7   */	 0,0,0,0, 0,0,0,0, 0,
+	/* 0x84   */	OPT_THREADS,
+	/* 0x85   */	OPT_SCAN_THREADS,
+	/* 0x86   */	OPT_IOBUF,
+	/* 0x87   */	OPT_GCZ_CACHE,
+	/* 0x88   */	OPT_FST_CACHE,
+	/* 0x89   */	OPT_DIRECT,
+	/* 0x8a   */	OPT_UTF_8,
+	/* 0x8b   */	OPT_NO_UTF_8,
+	/* 0x8c   */	OPT_LANG,
+	/* 0x8d   */	OPT_CERT,
+	/* 0x8e   */	OPT_OLD,
+	/* 0x8f   */	OPT_NEW,
+	/* 0x90   */	OPT_NO_EXPAND,
+	/* 0x91   */	OPT_RDEPTH,
+	/* 0x92   */	OPT_INCLUDE_FIRST,
+	/* 0x93   */	OPT_JOB_LIMIT,
+	/* 0x94   */	OPT_FAKE_SIGN,
+	/* 0x95   */	OPT_IGNORE_FST,
+	/* 0x96   */	OPT_IGNORE_SETUP,
+	/* 0x97   */	OPT_LINKS,
+	/* 0x98   */	OPT_PSEL,
+	/* 0x99   */	OPT_RAW,
+	/* 0x9a   */	OPT_PMODE,
+	/* 0x9b   */	OPT_FLAT,
+	/* 0x9c   */	OPT_COPY_GC,
+	/* 0x9d   */	OPT_NO_LINK,
+	/* 0x9e   */	OPT_NEEK,
+	/* 0x9f   */	OPT_HOOK,
+	/* 0xa0   */	OPT_ENC,
+	/* 0xa1   */	OPT_MODIFY,
+	/* 0xa2   */	OPT_NAME,
+	/* 0xa3   */	OPT_ID,
+	/* 0xa4   */	OPT_DISC_ID,
+	/* 0xa5   */	OPT_BOOT_ID,
+	/* 0xa6   */	OPT_TICKET_ID,
+	/* 0xa7   */	OPT_TMD_ID,
+	/* 0xa8   */	OPT_TT_ID,
+	/* 0xa9   */	OPT_WBFS_ID,
+	/* 0xaa   */	OPT_REGION,
+	/* 0xab   */	OPT_COMMON_KEY,
+	/* 0xac   */	OPT_IOS,
+	/* 0xad   */	OPT_HTTP,
+	/* 0xae   */	OPT_DOMAIN,
+	/* 0xaf   */	OPT_WIIMMFI,
+	/* 0xb0   */	OPT_TWIIMMFI,
+	/* 0xb1   */	OPT_RM_FILES,
+	/* 0xb2   */	OPT_ZERO_FILES,
+	/* 0xb3   */	OPT_OVERLAY,
+	/* 0xb4   */	OPT_REPL_FILE,
+	/* 0xb5   */	OPT_ADD_FILE,
+	/* 0xb6   */	OPT_IGNORE_FILES,
+	/* 0xb7   */	OPT_TRIM,
+	/* 0xb8   */	OPT_ALIGN,
+	/* 0xb9   */	OPT_ALIGN_PART,
+	/* 0xba   */	OPT_ALIGN_FILES,
+	/* 0xbb   */	OPT_AUTO_SPLIT,
+	/* 0xbc   */	OPT_NO_SPLIT,
+	/* 0xbd   */	OPT_DISC_SIZE,
+	/* 0xbe   */	OPT_PREALLOC,
+	/* 0xbf   */	OPT_TRUNC,
+	/* 0xc0   */	OPT_CHUNK_MODE,
+	/* 0xc1   */	OPT_CHUNK_SIZE,
+	/* 0xc2   */	OPT_MAX_CHUNKS,
+	/* 0xc3   */	OPT_BLOCK_SIZE,
+	/* 0xc4   */	OPT_COMPRESSION,
+	/* 0xc5   */	OPT_MEM,
+	/* 0xc6   */	OPT_DIFF,
+	/* 0xc7   */	OPT_WDF1,
+	/* 0xc8   */	OPT_WDF2,
+	/* 0xc9   */	OPT_ALIGN_WDF,
+	/* 0xca   */	OPT_WIA,
+	/* 0xcb   */	OPT_RVZ,
+	/* 0xcc   */	OPT_GCZ_ZIP,
+	/* 0xcd   */	OPT_GCZ_BLOCK,
+	/* 0xce   */	OPT_FST,
+	/* 0xcf   */	OPT_ITIME,
+	/* 0xd0   */	OPT_MTIME,
+	/* 0xd1   */	OPT_CTIME,
+	/* 0xd2   */	OPT_ATIME,
+	/* 0xd3   */	OPT_TIME,
+	/* 0xd4   */	OPT_NUMERIC,
+	/* 0xd5   */	OPT_TECHNICAL,
+	/* 0xd6   */	OPT_REALPATH,
+	/* 0xd7   */	OPT_UNIT,
+	/* 0xd8   */	OPT_NO_CACHE,
+	/* 0xd9   */	OPT_OLD_STYLE,
+	/* 0xda   */	OPT_SECTIONS,
+	/* 0xdb   */	OPT_LIMIT,
+	/* 0xdc   */	OPT_FILE_LIMIT,
+	/* 0xdd   */	OPT_PATCH_FILE,
+	/* 0xde   */	 0,0,
 	/* 0xe0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 	/* 0xf0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 };
@@ -1841,348 +1930,356 @@ const u8 OptionIndex[OPT_INDEX_SIZE] =
 ///////////////                opt_allowed_cmd_*                ///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-static u8 option_allowed_cmd_VERSION[103] = // cmd #1
+static u8 option_allowed_cmd_VERSION[105] = // cmd #1
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,1,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    1,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_HELP[103] = // cmd #2
+static u8 option_allowed_cmd_HELP[105] = // cmd #2
 {
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
-    1,1,1,1,1, 1,1,1,1,1,  1,1,1
+    1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1
 };
 
-static u8 option_allowed_cmd_INFO[103] = // cmd #3
+static u8 option_allowed_cmd_INFO[105] = // cmd #3
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_TEST[103] = // cmd #4
+static u8 option_allowed_cmd_TEST[105] = // cmd #4
 {
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
-    1,1,1,1,1, 1,1,1,1,1,  1,1,1
+    1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1
 };
 
-static u8 option_allowed_cmd_ERROR[103] = // cmd #5
+static u8 option_allowed_cmd_ERROR[105] = // cmd #5
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,1,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,1,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_COMPR[103] = // cmd #6
+static u8 option_allowed_cmd_COMPR[105] = // cmd #6
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    1,0,0,0,0, 0,1,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,1,0,0,0, 0,0,0,1,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_FEATURES[103] = // cmd #7
+static u8 option_allowed_cmd_FEATURES[105] = // cmd #7
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_ANAID[103] = // cmd #8
+static u8 option_allowed_cmd_ANAID[105] = // cmd #8
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,1,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,1,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_EXCLUDE[103] = // cmd #9
+static u8 option_allowed_cmd_EXCLUDE[105] = // cmd #9
 {
     0,0,0,0,0, 0,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_TITLES[103] = // cmd #10
+static u8 option_allowed_cmd_TITLES[105] = // cmd #10
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_GETTITLES[103] = // cmd #11
+static u8 option_allowed_cmd_GETTITLES[105] = // cmd #11
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_CERT[103] = // cmd #12
+static u8 option_allowed_cmd_CLEAR_CACHE[105] = // cmd #12
+{
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
+};
+
+static u8 option_allowed_cmd_CERT[105] = // cmd #13
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_CREATE[103] = // cmd #13
+static u8 option_allowed_cmd_CREATE[105] = // cmd #14
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
     0,0,0,0,0, 0,0,0,1,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_DOLPATCH[103] = // cmd #14
+static u8 option_allowed_cmd_DOLPATCH[105] = // cmd #15
 {
     0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_CODE[103] = // cmd #15
+static u8 option_allowed_cmd_CODE[105] = // cmd #16
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_FILELIST[103] = // cmd #16
+static u8 option_allowed_cmd_FILELIST[105] = // cmd #17
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_FILETYPE[103] = // cmd #17
+static u8 option_allowed_cmd_FILETYPE[105] = // cmd #18
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,1,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,1,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_ISOSIZE[103] = // cmd #18
+static u8 option_allowed_cmd_ISOSIZE[105] = // cmd #19
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,1, 0,1,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 1,0,0,1,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_DUMP[103] = // cmd #19
+static u8 option_allowed_cmd_DUMP[105] = // cmd #20
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 0,1,1,1,1,  1,1,1,0,0, 0,0,0,0,1,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,1,0,
-    0,0,0,1,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,1,
+    0,0,0,0,1, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_ID6[103] = // cmd #20
+static u8 option_allowed_cmd_ID6[105] = // cmd #21
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,1,0,1,
     1,1,1,1,1, 1,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_ID8[103] = // cmd #21
+static u8 option_allowed_cmd_ID8[105] = // cmd #22
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,1,0,1,
     1,1,1,1,1, 1,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_FRAGMENTS[103] = // cmd #22
+static u8 option_allowed_cmd_FRAGMENTS[105] = // cmd #23
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,1,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_LIST[103] = // cmd #23
+static u8 option_allowed_cmd_LIST[105] = // cmd #24
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 1,1,1,1,0,
-    0,0,1,0,1, 1,1,0,1,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,1, 1,1,1,1,1,
+    0,0,0,1,0, 1,1,1,1,0,  1,1,0,0,0
 };
 
-static u8 option_allowed_cmd_LIST_L[103] = // cmd #24
+static u8 option_allowed_cmd_LIST_L[105] = // cmd #25
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 1,1,1,1,0,
-    0,0,1,0,1, 1,1,0,1,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,1, 1,1,1,1,1,
+    0,0,0,1,0, 1,1,1,1,0,  1,1,0,0,0
 };
 
-static u8 option_allowed_cmd_LIST_LL[103] = // cmd #25
+static u8 option_allowed_cmd_LIST_LL[105] = // cmd #26
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 1,1,1,1,0,
-    0,0,1,0,1, 1,1,0,1,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,1, 1,1,1,1,1,
+    0,0,0,1,0, 1,1,1,1,0,  1,1,0,0,0
 };
 
-static u8 option_allowed_cmd_LIST_LLL[103] = // cmd #26
+static u8 option_allowed_cmd_LIST_LLL[105] = // cmd #27
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 1,1,1,1,0,
-    0,0,1,0,1, 1,1,0,1,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,1, 1,1,1,1,1,
+    0,0,0,1,0, 1,1,1,1,0,  1,1,0,0,0
 };
 
-static u8 option_allowed_cmd_FILES[103] = // cmd #27
+static u8 option_allowed_cmd_FILES[105] = // cmd #28
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,1,0,
-    0,0,0,1,0, 0,1,0,0,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,1,
+    0,0,0,0,1, 0,0,0,1,0,  0,1,0,0,0
 };
 
-static u8 option_allowed_cmd_FILES_L[103] = // cmd #28
+static u8 option_allowed_cmd_FILES_L[105] = // cmd #29
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,1,0,
-    0,0,0,1,0, 0,1,0,0,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,1,
+    0,0,0,0,1, 0,0,0,1,0,  0,1,0,0,0
 };
 
-static u8 option_allowed_cmd_FILES_LL[103] = // cmd #29
+static u8 option_allowed_cmd_FILES_LL[105] = // cmd #30
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,1,0,
-    0,0,0,1,0, 0,1,0,0,1,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,1,
+    0,0,0,0,1, 0,0,0,1,0,  0,1,0,0,0
 };
 
-static u8 option_allowed_cmd_DIFF[103] = // cmd #30
+static u8 option_allowed_cmd_DIFF[105] = // cmd #31
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
-    0,0,0,0,0, 1,0,0,0,0,  0,0,0,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,1,0,  1,1,1
+    0,0,0,0,0, 1,0,0,0,0,  0,0,0,1,1, 1,1,1,1,1,  1,1,1,1,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  1,0,1,1,1
 };
 
-static u8 option_allowed_cmd_FDIFF[103] = // cmd #31
+static u8 option_allowed_cmd_FDIFF[105] = // cmd #32
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
-    0,0,0,0,0, 1,0,0,0,0,  0,0,0,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,1,0,  1,1,1
+    0,0,0,0,0, 1,0,0,0,0,  0,0,0,1,1, 1,1,1,1,1,  1,1,1,1,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  1,0,1,1,1
 };
 
-static u8 option_allowed_cmd_EXTRACT[103] = // cmd #32
+static u8 option_allowed_cmd_EXTRACT[105] = // cmd #33
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 0,1,1,1,1,  1,1,1,1,1, 0,0,0,0,0,
-    1,0,0,0,0, 0,0,0,1,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,1,1,  0,0,0
+    1,0,0,0,0, 0,0,0,1,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,1,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  1,1,0,0,0
 };
 
-static u8 option_allowed_cmd_COPY[103] = // cmd #33
+static u8 option_allowed_cmd_COPY[105] = // cmd #34
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 0,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
-    1,1,1,1,1, 0,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,1,0,
-    0,0,0,0,0, 0,0,0,1,1,  0,0,0
+    1,1,1,1,1, 0,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,0, 0,0,0,0,1,
+    0,0,0,0,0, 0,0,0,0,0,  1,1,0,0,0
 };
 
-static u8 option_allowed_cmd_CONVERT[103] = // cmd #34
+static u8 option_allowed_cmd_CONVERT[105] = // cmd #35
 {
     0,1,1,1,1, 0,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,0,0,0,0, 0,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 0,1,1,1,1,  1,1,1,0,0, 1,1,1,1,1,
-    1,1,1,1,1, 0,1,1,1,0,  0,0,0,1,1, 1,1,1,1,1,  1,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    1,1,1,1,1, 0,1,1,1,0,  0,0,0,1,1, 1,1,1,1,1,  1,1,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_EDIT[103] = // cmd #35
+static u8 option_allowed_cmd_EDIT[105] = // cmd #36
 {
     0,1,1,1,1, 0,1,1,1,1,  1,1,1,0,1, 0,0,0,0,1,  1,0,0,0,0, 0,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,1,0,  0,0,0,0,1, 1,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_IMGFILES[103] = // cmd #36
+static u8 option_allowed_cmd_IMGFILES[105] = // cmd #37
 {
     0,1,1,1,1, 0,1,1,1,1,  1,1,1,0,1, 0,0,0,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_REMOVE[103] = // cmd #37
+static u8 option_allowed_cmd_REMOVE[105] = // cmd #38
 {
     0,1,1,1,1, 0,1,1,1,1,  1,1,1,0,1, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_MOVE[103] = // cmd #38
+static u8 option_allowed_cmd_MOVE[105] = // cmd #39
 {
     0,1,1,1,1, 0,1,1,1,1,  1,1,1,0,1, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,1,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  1,0,0,0,0
 };
 
-static u8 option_allowed_cmd_RENAME[103] = // cmd #39
+static u8 option_allowed_cmd_RENAME[105] = // cmd #40
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,0,1,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_SETTITLE[103] = // cmd #40
+static u8 option_allowed_cmd_SETTITLE[105] = // cmd #41
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,0,1,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_VERIFY[103] = // cmd #41
+static u8 option_allowed_cmd_VERIFY[105] = // cmd #42
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
-    0,1,0,0,0, 0,0,0,0,0,  1,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,
+    0,0,1,0,0, 0,0,0,0,0,  0,0,1,0,0
 };
 
-static u8 option_allowed_cmd_SKELETON[103] = // cmd #42
+static u8 option_allowed_cmd_SKELETON[105] = // cmd #43
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,0,1, 1,1,1,0,1,  1,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
-static u8 option_allowed_cmd_MIX[103] = // cmd #43
+static u8 option_allowed_cmd_MIX[105] = // cmd #44
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,1,
     0,0,0,0,0, 0,1,0,0,0,  0,0,0,0,0, 1,0,0,0,0,  0,1,0,1,1, 1,1,1,1,1,
     1,1,1,1,1, 0,1,1,0,0,  1,0,0,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0
 };
 
 
@@ -2204,6 +2301,11 @@ const InfoOption_t * option_tab_tool[] =
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_ESC,
 	OptionInfo + OPT_IO,
+	OptionInfo + OPT_THREADS,
+	OptionInfo + OPT_SCAN_THREADS,
+	OptionInfo + OPT_IOBUF,
+	OptionInfo + OPT_GCZ_CACHE,
+	OptionInfo + OPT_FST_CACHE,
 	OptionInfo + OPT_FORCE,
 
 	OptionInfo + OPT_NONE, // separator
@@ -2317,6 +2419,13 @@ static const InfoOption_t * option_tab_cmd_GETTITLES[] =
 	0
 };
 
+static const InfoOption_t * option_tab_cmd_CLEAR_CACHE[] =
+{
+	OptionInfo + OPT_TEST,
+
+	0
+};
+
 static const InfoOption_t * option_tab_cmd_CERT[] =
 {
 	OptionInfo + OPT_CERT,
@@ -2674,6 +2783,7 @@ static const InfoOption_t * option_tab_cmd_LIST[] =
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_UNIQUE,
 	OptionInfo + OPT_SORT,
+	OptionInfo + OPT_NO_CACHE,
 	OptionInfo + OPT_SECTIONS,
 	OptionInfo + OPT_NO_HEADER,
 	&option_cmd_LIST_LONG,
@@ -2726,6 +2836,7 @@ static const InfoOption_t * option_tab_cmd_LIST_L[] =
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_UNIQUE,
 	OptionInfo + OPT_SORT,
+	OptionInfo + OPT_NO_CACHE,
 	OptionInfo + OPT_SECTIONS,
 	OptionInfo + OPT_NO_HEADER,
 	&option_cmd_LIST_LONG,
@@ -2778,6 +2889,7 @@ static const InfoOption_t * option_tab_cmd_LIST_LL[] =
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_UNIQUE,
 	OptionInfo + OPT_SORT,
+	OptionInfo + OPT_NO_CACHE,
 	OptionInfo + OPT_SECTIONS,
 	OptionInfo + OPT_NO_HEADER,
 	&option_cmd_LIST_LONG,
@@ -2830,6 +2942,7 @@ static const InfoOption_t * option_tab_cmd_LIST_LLL[] =
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_UNIQUE,
 	OptionInfo + OPT_SORT,
+	OptionInfo + OPT_NO_CACHE,
 	OptionInfo + OPT_SECTIONS,
 	OptionInfo + OPT_NO_HEADER,
 	&option_cmd_LIST_LONG,
@@ -3060,6 +3173,7 @@ static const InfoOption_t * option_tab_cmd_DIFF[] =
 	OptionInfo + OPT_CISO,
 	OptionInfo + OPT_WBFS,
 	OptionInfo + OPT_WIA,
+	OptionInfo + OPT_RVZ,
 	OptionInfo + OPT_GCZ,
 	OptionInfo + OPT_GCZ_ZIP,
 	OptionInfo + OPT_GCZ_BLOCK,
@@ -3138,6 +3252,7 @@ static const InfoOption_t * option_tab_cmd_FDIFF[] =
 	OptionInfo + OPT_CISO,
 	OptionInfo + OPT_WBFS,
 	OptionInfo + OPT_WIA,
+	OptionInfo + OPT_RVZ,
 	OptionInfo + OPT_GCZ,
 	OptionInfo + OPT_GCZ_ZIP,
 	OptionInfo + OPT_GCZ_BLOCK,
@@ -3349,6 +3464,7 @@ static const InfoOption_t * option_tab_cmd_COPY[] =
 	OptionInfo + OPT_CISO,
 	OptionInfo + OPT_WBFS,
 	OptionInfo + OPT_WIA,
+	OptionInfo + OPT_RVZ,
 	OptionInfo + OPT_GCZ,
 	OptionInfo + OPT_GCZ_ZIP,
 	OptionInfo + OPT_GCZ_BLOCK,
@@ -3450,6 +3566,7 @@ static const InfoOption_t * option_tab_cmd_CONVERT[] =
 	OptionInfo + OPT_CISO,
 	OptionInfo + OPT_WBFS,
 	OptionInfo + OPT_WIA,
+	OptionInfo + OPT_RVZ,
 	OptionInfo + OPT_GCZ,
 	OptionInfo + OPT_GCZ_ZIP,
 	OptionInfo + OPT_GCZ_BLOCK,
@@ -3903,7 +4020,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	" patch, mix, extract, compose, rename and compare Wii and GameCube"
 	" images. It also can create and dump different other Wii file"
 	" formats.",
-	21,
+	26,
 	option_tab_tool,
 	0
     },
@@ -4052,6 +4169,20 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	option_allowed_cmd_GETTITLES
     },
 
+    {	CMD_CLEAR_CACHE,
+	false,
+	false,
+	"CLEAR-CACHE",
+	"CLEARCACHE",
+	"wit CLEAR-CACHE [path]...",
+	"Remove the disc info cache of the LIST commands. If paths are given,"
+	" only the entries of these files and of all files below these"
+	" directories are removed.",
+	1,
+	option_tab_cmd_CLEAR_CACHE,
+	option_allowed_cmd_CLEAR_CACHE
+    },
+
     {	CMD_CERT,
 	false,
 	false,
@@ -4207,7 +4338,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"LS",
 	"wit LIST [source]...",
 	"List all found ISO files.",
-	34,
+	35,
 	option_tab_cmd_LIST,
 	option_allowed_cmd_LIST
     },
@@ -4220,7 +4351,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"wit LIST-L [source]...",
 	"List all found ISO files with size and region. 'LIST-L' is a shortcut"
 	" for 'LIST --long'.",
-	34,
+	35,
 	option_tab_cmd_LIST_L,
 	option_allowed_cmd_LIST_L
     },
@@ -4233,7 +4364,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"wit LIST-LL [source]...",
 	"List all found ISO files with date, size and region. 'LIST-LL' is a"
 	" shortcut for 'LIST --long --long'.",
-	34,
+	35,
 	option_tab_cmd_LIST_LL,
 	option_allowed_cmd_LIST_LL
     },
@@ -4247,7 +4378,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"List all found ISO files with date, size and region and add a second"
 	" status line with more info. 'LIST-LLL' is a shortcut for 'LIST"
 	" --long --long --long'.",
-	34,
+	35,
 	option_tab_cmd_LIST_LLL,
 	option_allowed_cmd_LIST_LLL
     },
@@ -4300,7 +4431,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"DIFF compares ISO images in scrubbed or raw mode or on file level."
 	" Images, WBFS partitions and directories are accepted as source. DIFF"
 	" works like COPY but comparing source and destination.",
-	54,
+	55,
 	option_tab_cmd_DIFF,
 	option_allowed_cmd_DIFF
     },
@@ -4315,7 +4446,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"FDIFF compares ISO images on file level. Images, WBFS partitions and"
 	" directories are accepted as source. 'FDIFF' is a shortcut for 'DIFF"
 	" --files +'.",
-	54,
+	55,
 	option_tab_cmd_FDIFF,
 	option_allowed_cmd_FDIFF
     },
@@ -4344,7 +4475,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"Copy, scrub, convert, join, split, compose, extract, patch, encrypt"
 	" and decrypt Wii and GameCube disc images. Images, WBFS partitions"
 	" and directories are accepted as source.",
-	90,
+	91,
 	option_tab_cmd_COPY,
 	option_allowed_cmd_COPY
     },
@@ -4366,7 +4497,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	" CONVERT' does more than only scrubbing and therefor it was renamed"
 	" from 'SCRUB' to 'CONVERT', but the old command name is still"
 	" allowed.",
-	73,
+	74,
 	option_tab_cmd_CONVERT,
 	option_allowed_cmd_CONVERT
     },
@@ -135,6 +135,7 @@ typedef enum enumOptions
 	OPT_CISO,
 	OPT_WBFS,
 	OPT_WIA,
+	OPT_RVZ,
 	OPT_GCZ,
 	OPT_FST,
 	OPT_FILES,
@@ -151,6 +152,7 @@ typedef enum enumOptions
 	OPT_SHOW,
 	OPT_UNIT,
 	OPT_UNIQUE,
+	OPT_NO_CACHE,
 	OPT_NO_HEADER,
 	OPT_OLD_STYLE,
 	OPT_SECTIONS,
@@ -159,7 +161,7 @@ typedef enum enumOptions
 	OPT_FILE_LIMIT,
 	OPT_PATCH_FILE,
 
-	OPT__N_SPECIFIC, // == 103 
+	OPT__N_SPECIFIC, // == 105 
 
 	//----- global options -----
 
@@ -174,6 +176,11 @@ typedef enum enumOptions
 	OPT_LOGGING,
 	OPT_ESC,
 	OPT_IO,
+	OPT_THREADS,
+	OPT_SCAN_THREADS,
+	OPT_IOBUF,
+	OPT_GCZ_CACHE,
+	OPT_FST_CACHE,
 	OPT_FORCE,
 	OPT_DIRECT,
 	OPT_TITLES,
@@ -189,7 +196,7 @@ typedef enum enumOptions
 	OPT_GCZ_ZIP,
 	OPT_GCZ_BLOCK,
 
-	OPT__N_TOTAL // == 128
+	OPT__N_TOTAL // == 135
 
 } enumOptions;
 
@@ -283,6 +290,7 @@ typedef enum enumOptions
 //	OB_CISO			= 1llu << OPT_CISO,
 //	OB_WBFS			= 1llu << OPT_WBFS,
 //	OB_WIA			= 1llu << OPT_WIA,
+//	OB_RVZ			= 1llu << OPT_RVZ,
 //	OB_GCZ			= 1llu << OPT_GCZ,
 //	OB_FST			= 1llu << OPT_FST,
 //	OB_FILES		= 1llu << OPT_FILES,
@@ -299,6 +307,7 @@ typedef enum enumOptions
 //	OB_SHOW			= 1llu << OPT_SHOW,
 //	OB_UNIT			= 1llu << OPT_UNIT,
 //	OB_UNIQUE		= 1llu << OPT_UNIQUE,
+//	OB_NO_CACHE		= 1llu << OPT_NO_CACHE,
 //	OB_NO_HEADER		= 1llu << OPT_NO_HEADER,
 //	OB_OLD_STYLE		= 1llu << OPT_OLD_STYLE,
 //	OB_SECTIONS		= 1llu << OPT_SECTIONS,
@@ -352,6 +361,7 @@ typedef enum enumOptions
 //
 //	OB_GRP_OUTMODE		= OB_GRP_OUTMODE_EDIT
 //				| OB_WIA
+//				| OB_RVZ
 //				| OB_GCZ,
 //
 //	OB_GRP_OUTMODE_FST	= OB_GRP_OUTMODE
@@ -450,6 +460,8 @@ typedef enum enumOptions
 //
 //	OB_CMD_GETTITLES	= 0,
 //
+//	OB_CMD_CLEAR_CACHE	= 0,
+//
 //	OB_CMD_CERT		= OB_FILES
 //				| OB_FAKE_SIGN
 //				| OB_DEST
@@ -522,6 +534,7 @@ typedef enum enumOptions
 //				| OB_GRP_FST_OPTIONS
 //				| OB_UNIQUE
 //				| OB_SORT
+//				| OB_NO_CACHE
 //				| OB_SECTIONS
 //				| OB_NO_HEADER
 //				| OB_LONG
@@ -688,6 +701,7 @@ typedef enum enumCommands
 	CMD_EXCLUDE,
 	CMD_TITLES,
 	CMD_GETTITLES,
+	CMD_CLEAR_CACHE,
 	CMD_CERT,
 	CMD_CREATE,
 	CMD_DOLPATCH,
@@ -726,7 +740,7 @@ typedef enum enumCommands
 	CMD_SKELETON,
 	CMD_MIX,
 
-	CMD__N // == 44
+	CMD__N // == 45
 
 } enumCommands;
 
@@ -787,6 +801,11 @@ typedef enum enumGetOpt
 	GO_WIDTH,
 	GO_SCAN_PROGRESS,
 	GO_IO,
+	GO_THREADS,
+	GO_SCAN_THREADS,
+	GO_IOBUF,
+	GO_GCZ_CACHE,
+	GO_FST_CACHE,
 	GO_DIRECT,
 	GO_UTF_8,
 	GO_NO_UTF_8,
@@ -853,6 +872,7 @@ typedef enum enumGetOpt
 	GO_WDF2,
 	GO_ALIGN_WDF,
 	GO_WIA,
+	GO_RVZ,
 	GO_GCZ_ZIP,
 	GO_GCZ_BLOCK,
 	GO_FST,
@@ -865,6 +885,7 @@ typedef enum enumGetOpt
 	GO_TECHNICAL,
 	GO_REALPATH,
 	GO_UNIT,
+	GO_NO_CACHE,
 	GO_OLD_STYLE,
 	GO_SECTIONS,
 	GO_LIMIT,
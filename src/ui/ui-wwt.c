@@ -580,13 +580,13 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Select one compression method, level and chunk size for new WIA"
 	" files. The syntax for mode is: [method] [.level] [@factor]\n"
 	"  'method' is the name of the method. Possible compressions method"
-	" are NONE, PURGE, BZIP2, LZMA and LZMA2. There are additional"
-	" keywords: DEFAULT (=LZMA.5@20), FAST (=BZIP2.3@10), GOOD"
-	" (=LZMA.5@20) BEST (=LZMA.7@50), and MEM (use best mode in respect to"
-	" memory limit set by --mem). Additionally the single digit modes 0"
-	" (=NONE), 1 (=fast LZMA) .. 9 (=BEST)are defined. These additional"
-	" keywords may change their meanings if a new compression method is"
-	" implemented.\n"
+	" are NONE, PURGE, BZIP2, LZMA, LZMA2 and ZSTD (if supported by the"
+	" build). There are additional keywords: DEFAULT (=LZMA.5@20), FAST"
+	" (=BZIP2.3@10), GOOD (=LZMA.5@20) BEST (=LZMA.7@50), and MEM (use"
+	" best mode in respect to memory limit set by --mem). Additionally the"
+	" single digit modes 0 (=NONE), 1 (=fast LZMA) .. 9 (=BEST)are"
+	" defined. These additional keywords may change their meanings if a"
+	" new compression method is implemented.\n"
 	"  '.level' is a point followed by one digit. It defines the"
 	" compression level. The special value .0 means: Use default"
 	" compression level (=.5).\n"
@@ -703,6 +703,16 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" is an extracted file systems (FST) it isn't removed."
     },
 
+    {	OPT_PARALLEL, 0, "parallel",
+	"num",
+	"Import up to 'num' discs at the same time. The WBFS blocks of each"
+	" disc are reserved before copying, then the sources are read in"
+	" parallel by worker threads. This is faster if the sources are stored"
+	" on other devices than the WBFS. The value '0' selects the number of"
+	" threads (see --threads). The default value '1' imports the discs one"
+	" after another."
+    },
+
     {	OPT_WDF, 'W', "wdf",
 	"[=param]",
 	"Set the image output file type to WDF (Wii Disc Format). The output"
@@ -730,6 +740,16 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" '--wia --compression mode'."
     },
 
+    {	OPT_RVZ, 0, "rvz",
+	"[=compr]",
+	"Set image output file type to RVZ (Dolphins Revolution Zip), a"
+	" revision of WIA. The optional parameter is a compression mode and"
+	" --rvz=mode is a shortcut for '--rvz --compression mode'. Method"
+	" PURGE is not allowed for RVZ. Junk data of unused disc areas is"
+	" stored by its seed, so that unscrubbed images are stored bit-exact"
+	" at nearly the size of scrubbed images."
+    },
+
     {	OPT_GCZ, 0, "gcz",
 	0,
 	"Set image output file type to GCZ (Dolphins GameCube Zip)."
@@ -900,7 +920,7 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Limit the output to NUM messages."
     },
 
-    {0,0,0,0,0}, // OPT__N_SPECIFIC == 110
+    {0,0,0,0,0}, // OPT__N_SPECIFIC == 112
 
     //----- global options -----
 
@@ -967,7 +987,54 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	"Setup the IO mode for experiments. The standard file IO is based on"
 	" open() function. The value '1' defines that WBFS IO is based on"
 	" fopen() function. The value '2' defines the same for ISO files and"
-	" value '4' for WIA files. You can combine the values by adding them."
+	" value '4' for WIA files. The value '16' enables io_uring based"
+	" reading and writing of plain files and split files, if supported by"
+	" the kernel. The value '32' maps ISO and WDF source files into memory"
+	" and reads them without system calls. You can combine the values by"
+	" adding them."
+    },
+
+    {	OPT_THREADS, 0, "threads",
+	"num",
+	"Define the maximum number of worker threads used for compressing and"
+	" other parallel jobs. The value '0' (default) selects the number of"
+	" online CPUs or the value of environment variable 'WIT_THREADS'. The"
+	" value '1' disables multi threading."
+    },
+
+    {	OPT_SCAN_THREADS, 0, "scan-threads",
+	"num",
+	"Define the number of worker threads, that probe directory entries in"
+	" advance (status and file header) while scanning source directories."
+	" The scanner itself keeps the order of the entries and finds the data"
+	" in the caches of the operating system. This hides the latency of"
+	" network file systems. The value '0' (default) selects the value of"
+	" --threads. The value '1' disables probing in advance."
+    },
+
+    {	OPT_IOBUF, 0, "iobuf",
+	"size",
+	"Define the size of the I/O buffers used for copying and comparing (in"
+	" MiB if no other unit is entered). Each operation gets an own buffer"
+	" aligned to 4 KiB. The value '0' (default) selects 4 MiB. Larger"
+	" values may speed up transfers on fast devices."
+    },
+
+    {	OPT_GCZ_CACHE, 0, "gcz-cache",
+	"num",
+	"Define the number of decompressed blocks, that are cached while"
+	" reading GCZ images. The value '0' (default) selects 32 blocks. The"
+	" memory used by the cache is limited to 64 MiB. If multi threading is"
+	" enabled, the next blocks of sequential reads are decompressed in"
+	" parallel by worker threads."
+    },
+
+    {	OPT_FST_CACHE, 0, "fst-cache",
+	"num",
+	"Define the number of encrypted partition groups (2 MiB each), that"
+	" are cached while reading a composed image from an extracted file"
+	" system. The value '0' (default) selects 8 groups. The memory is"
+	" allocated on demand."
     },
 
     {	OPT_DIRECT, 0, "direct",
@@ -980,7 +1047,11 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
     {	OPT_TITLES, 'T', "titles",
 	"file",
 	"Read file for disc titles. -T/ disables automatic search for title"
-	" files."
+	" files. The parsed titles are cached in a binary index file in the"
+	" directory defined by environment variable 'WIT_TITLES_CACHE' or in"
+	" 'XDG_CACHE_HOME/wit' or 'HOME/.cache/wit'. The index is rebuilt"
+	" automatically if a title file changes. An empty 'WIT_TITLES_CACHE'"
+	" disables the index."
     },
 
     {	OPT_UTF_8, 0, "utf-8",
@@ -1043,7 +1114,7 @@ const InfoOption_t OptionInfo[OPT__N_TOTAL+1] =
 	" caution!"
     },
 
-    {0,0,0,0,0} // OPT__N_TOTAL == 133
+    {0,0,0,0,0} // OPT__N_TOTAL == 140
 
 };
 
@@ -1245,6 +1316,18 @@ const InfoOption_t option_cmd_PHANTOM_VERBOSE =
 	"Print a status line for each added disc."
     };
 
+const InfoOption_t option_cmd_DEDUP_VERBOSE =
+    {	OPT_VERBOSE, 'v', "verbose",
+	0,
+	"Print the block statistics of each WBFS."
+    };
+
+const InfoOption_t option_cmd_DEFRAG_VERBOSE =
+    {	OPT_VERBOSE, 'v', "verbose",
+	0,
+	"Print the fragment statistics of each WBFS."
+    };
+
 const InfoOption_t option_cmd_SYNC_TRUNC =
     {	OPT_TRUNC, 0, "trunc",
 	0,
@@ -1457,6 +1540,9 @@ const CommandTab_t CommandTab[] =
     { CMD_EDIT,		"EDIT",		0,		0 },
     { CMD_PHANTOM,	"PHANTOM",	0,		0 },
     { CMD_TRUNCATE,	"TRUNCATE",	"TR",		0 },
+    { CMD_DEDUP,	"DEDUP",	"DD",		0 },
+    { CMD_REHYDRATE,	"REHYDRATE",	"RH",		0 },
+    { CMD_DEFRAG,	"DEFRAG",	"DF",		0 },
     { CMD_ADD,		"ADD",		"A",		0 },
     { CMD_UPDATE,	"UPDATE",	"U",		0 },
     { CMD_NEW,		"NEW",		"N",		0 },
@@ -1496,6 +1582,14 @@ const struct option OptionLong[] =
 	{ "logging",		0, 0, 'L' },
 	{ "esc",		1, 0, 'E' },
 	{ "io",			1, 0, GO_IO },
+	{ "threads",		1, 0, GO_THREADS },
+	{ "scan-threads",	1, 0, GO_SCAN_THREADS },
+	 { "scanthreads",	1, 0, GO_SCAN_THREADS },
+	{ "iobuf",		1, 0, GO_IOBUF },
+	{ "gcz-cache",		1, 0, GO_GCZ_CACHE },
+	 { "gczcache",		1, 0, GO_GCZ_CACHE },
+	{ "fst-cache",		1, 0, GO_FST_CACHE },
+	 { "fstcache",		1, 0, GO_FST_CACHE },
 	{ "direct",		0, 0, GO_DIRECT },
 	{ "titles",		1, 0, 'T' },
 	{ "utf-8",		0, 0, GO_UTF_8 },
@@ -1640,6 +1734,7 @@ const struct option OptionLong[] =
 	 { "new",		0, 0, 'e' },
 	{ "overwrite",		0, 0, 'o' },
 	{ "remove",		0, 0, 'R' },
+	{ "parallel",		1, 0, GO_PARALLEL },
 	{ "wdf",		2, 0, 'W' },
 	{ "wdf1",		2, 0, GO_WDF1 },
 	{ "wdf2",		2, 0, GO_WDF2 },
@@ -1648,6 +1743,7 @@ const struct option OptionLong[] =
 	 { "wdf-align",		1, 0, GO_ALIGN_WDF },
 	 { "wdfalign",		1, 0, GO_ALIGN_WDF },
 	{ "wia",		2, 0, GO_WIA },
+	{ "rvz",		2, 0, GO_RVZ },
 	{ "gcz",		0, 0, GO_GCZ },
 	{ "gcz-zip",		0, 0, GO_GCZ_ZIP },
 	 { "gczzip",		0, 0, GO_GCZ_ZIP },
@@ -1757,96 +1853,102 @@ const u8 OptionIndex[OPT_INDEX_SIZE] =
 	/* 0x81   */	OPT_WIDTH,
 	/* 0x82   */	OPT_SCAN_PROGRESS,
 	/* 0x83   */	OPT_IO,
-	/* 0x84   */	OPT_DIRECT,
-	/* 0x85   */	OPT_UTF_8,
-	/* 0x86   */	OPT_NO_UTF_8,
-	/* 0x87   */	OPT_LANG,
-	/* 0x88   */	OPT_OLD,
-	/* 0x89   */	OPT_NEW,
-	/* 0x8a   */	OPT_SOURCE,
-	/* 0x8b   */	OPT_NO_EXPAND,
-	/* 0x8c   */	OPT_RDEPTH,
-	/* 0x8d   */	OPT_PSEL,
-	/* 0x8e   */	OPT_RAW,
-	/* 0x8f   */	OPT_WBFS_ALLOC,
-	/* 0x90   */	OPT_INCLUDE_FIRST,
-	/* 0x91   */	OPT_JOB_LIMIT,
-	/* 0x92   */	OPT_IGNORE_FST,
-	/* 0x93   */	OPT_IGNORE_SETUP,
-	/* 0x94   */	OPT_LINKS,
-	/* 0x95   */	OPT_PMODE,
-	/* 0x96   */	OPT_FLAT,
-	/* 0x97   */	OPT_COPY_GC,
-	/* 0x98   */	OPT_NO_LINK,
-	/* 0x99   */	OPT_NEEK,
-	/* 0x9a   */	OPT_HOOK,
-	/* 0x9b   */	OPT_ENC,
-	/* 0x9c   */	OPT_MODIFY,
-	/* 0x9d   */	OPT_NAME,
-	/* 0x9e   */	OPT_ID,
-	/* 0x9f   */	OPT_DISC_ID,
-	/* 0xa0   */	OPT_BOOT_ID,
-	/* 0xa1   */	OPT_TICKET_ID,
-	/* 0xa2   */	OPT_TMD_ID,
-	/* 0xa3   */	OPT_TT_ID,
-	/* 0xa4   */	OPT_WBFS_ID,
-	/* 0xa5   */	OPT_REGION,
-	/* 0xa6   */	OPT_COMMON_KEY,
-	/* 0xa7   */	OPT_IOS,
-	/* 0xa8   */	OPT_HTTP,
-	/* 0xa9   */	OPT_DOMAIN,
-	/* 0xaa   */	OPT_WIIMMFI,
-	/* 0xab   */	OPT_TWIIMMFI,
-	/* 0xac   */	OPT_RM_FILES,
-	/* 0xad   */	OPT_ZERO_FILES,
-	/* 0xae   */	OPT_REPL_FILE,
-	/* 0xaf   */	OPT_ADD_FILE,
-	/* 0xb0   */	OPT_IGNORE_FILES,
-	/* 0xb1   */	OPT_TRIM,
-	/* 0xb2   */	OPT_ALIGN,
-	/* 0xb3   */	OPT_ALIGN_PART,
-	/* 0xb4   */	OPT_ALIGN_FILES,
-	/* 0xb5   */	OPT_AUTO_SPLIT,
-	/* 0xb6   */	OPT_NO_SPLIT,
-	/* 0xb7   */	OPT_DISC_SIZE,
-	/* 0xb8   */	OPT_PREALLOC,
-	/* 0xb9   */	OPT_TRUNC,
-	/* 0xba   */	OPT_CHUNK_MODE,
-	/* 0xbb   */	OPT_CHUNK_SIZE,
-	/* 0xbc   */	OPT_MAX_CHUNKS,
-	/* 0xbd   */	OPT_COMPRESSION,
-	/* 0xbe   */	OPT_MEM,
-	/* 0xbf   */	OPT_HSS,
-	/* 0xc0   */	OPT_WSS,
-	/* 0xc1   */	OPT_RECOVER,
-	/* 0xc2   */	OPT_NO_CHECK,
-	/* 0xc3   */	OPT_REPAIR,
-	/* 0xc4   */	OPT_NO_FREE,
-	/* 0xc5   */	OPT_SYNC_ALL,
-	/* 0xc6   */	OPT_WDF1,
-	/* 0xc7   */	OPT_WDF2,
-	/* 0xc8   */	OPT_ALIGN_WDF,
-	/* 0xc9   */	OPT_WIA,
-	/* 0xca   */	OPT_GCZ,
-	/* 0xcb   */	OPT_GCZ_ZIP,
-	/* 0xcc   */	OPT_GCZ_BLOCK,
-	/* 0xcd   */	OPT_FST,
-	/* 0xce   */	OPT_FILES,
-	/* 0xcf   */	OPT_ITIME,
-	/* 0xd0   */	OPT_MTIME,
-	/* 0xd1   */	OPT_CTIME,
-	/* 0xd2   */	OPT_ATIME,
-	/* 0xd3   */	OPT_TIME,
-	/* 0xd4   */	OPT_SET_TIME,
-	/* 0xd5   */	OPT_FRAGMENTS,
-	/* 0xd6   */	OPT_NUMERIC,
-	/* 0xd7   */	OPT_TECHNICAL,
-	/* 0xd8   */	OPT_INODE,
-	/* 0xd9   */	OPT_OLD_STYLE,
-	/* 0xda   */	OPT_SECTIONS,
-	/* 0xdb   */	OPT_LIMIT,
-	/* 0xdc   */	 0,0,0,0, 
-	/* 0xe0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
+	/* 0x84   */	OPT_THREADS,
+	/* 0x85   */	OPT_SCAN_THREADS,
+	/* 0x86   */	OPT_IOBUF,
+	/* 0x87   */	OPT_GCZ_CACHE,
+	/* 0x88   */	OPT_FST_CACHE,
+	/* 0x89   */	OPT_DIRECT,
+	/* 0x8a   */	OPT_UTF_8,
+	/* 0x8b   */	OPT_NO_UTF_8,
+	/* 0x8c   */	OPT_LANG,
+	/* 0x8d   */	OPT_OLD,
+	/* 0x8e   */	OPT_NEW,
+	/* 0x8f   */	OPT_SOURCE,
+	/* 0x90   */	OPT_NO_EXPAND,
+	/* 0x91   */	OPT_RDEPTH,
+	/* 0x92   */	OPT_PSEL,
+	/* 0x93   */	OPT_RAW,
+	/* 0x94   */	OPT_WBFS_ALLOC,
+	/* 0x95   */	OPT_INCLUDE_FIRST,
+	/* 0x96   */	OPT_JOB_LIMIT,
+	/* 0x97   */	OPT_IGNORE_FST,
+	/* 0x98   */	OPT_IGNORE_SETUP,
+	/* 0x99   */	OPT_LINKS,
+	/* 0x9a   */	OPT_PMODE,
+	/* 0x9b   */	OPT_FLAT,
+	/* 0x9c   */	OPT_COPY_GC,
+	/* 0x9d   */	OPT_NO_LINK,
+	/* 0x9e   */	OPT_NEEK,
+	/* 0x9f   */	OPT_HOOK,
+	/* 0xa0   */	OPT_ENC,
+	/* 0xa1   */	OPT_MODIFY,
+	/* 0xa2   */	OPT_NAME,
+	/* 0xa3   */	OPT_ID,
+	/* 0xa4   */	OPT_DISC_ID,
+	/* 0xa5   */	OPT_BOOT_ID,
+	/* 0xa6   */	OPT_TICKET_ID,
+	/* 0xa7   */	OPT_TMD_ID,
+	/* 0xa8   */	OPT_TT_ID,
+	/* 0xa9   */	OPT_WBFS_ID,
+	/* 0xaa   */	OPT_REGION,
+	/* 0xab   */	OPT_COMMON_KEY,
+	/* 0xac   */	OPT_IOS,
+	/* 0xad   */	OPT_HTTP,
+	/* 0xae   */	OPT_DOMAIN,
+	/* 0xaf   */	OPT_WIIMMFI,
+	/* 0xb0   */	OPT_TWIIMMFI,
+	/* 0xb1   */	OPT_RM_FILES,
+	/* 0xb2   */	OPT_ZERO_FILES,
+	/* 0xb3   */	OPT_REPL_FILE,
+	/* 0xb4   */	OPT_ADD_FILE,
+	/* 0xb5   */	OPT_IGNORE_FILES,
+	/* 0xb6   */	OPT_TRIM,
+	/* 0xb7   */	OPT_ALIGN,
+	/* 0xb8   */	OPT_ALIGN_PART,
+	/* 0xb9   */	OPT_ALIGN_FILES,
+	/* 0xba   */	OPT_AUTO_SPLIT,
+	/* 0xbb   */	OPT_NO_SPLIT,
+	/* 0xbc   */	OPT_DISC_SIZE,
+	/* 0xbd   */	OPT_PREALLOC,
+	/* 0xbe   */	OPT_TRUNC,
+	/* 0xbf   */	OPT_CHUNK_MODE,
+	/* 0xc0   */	OPT_CHUNK_SIZE,
+	/* 0xc1   */	OPT_MAX_CHUNKS,
+	/* 0xc2   */	OPT_COMPRESSION,
+	/* 0xc3   */	OPT_MEM,
+	/* 0xc4   */	OPT_HSS,
+	/* 0xc5   */	OPT_WSS,
+	/* 0xc6   */	OPT_RECOVER,
+	/* 0xc7   */	OPT_NO_CHECK,
+	/* 0xc8   */	OPT_REPAIR,
+	/* 0xc9   */	OPT_NO_FREE,
+	/* 0xca   */	OPT_SYNC_ALL,
+	/* 0xcb   */	OPT_PARALLEL,
+	/* 0xcc   */	OPT_WDF1,
+	/* 0xcd   */	OPT_WDF2,
+	/* 0xce   */	OPT_ALIGN_WDF,
+	/* 0xcf   */	OPT_WIA,
+	/* 0xd0   */	OPT_RVZ,
+	/* 0xd1   */	OPT_GCZ,
+	/* 0xd2   */	OPT_GCZ_ZIP,
+	/* 0xd3   */	OPT_GCZ_BLOCK,
+	/* 0xd4   */	OPT_FST,
+	/* 0xd5   */	OPT_FILES,
+	/* 0xd6   */	OPT_ITIME,
+	/* 0xd7   */	OPT_MTIME,
+	/* 0xd8   */	OPT_CTIME,
+	/* 0xd9   */	OPT_ATIME,
+	/* 0xda   */	OPT_TIME,
+	/* 0xdb   */	OPT_SET_TIME,
+	/* 0xdc   */	OPT_FRAGMENTS,
+	/* 0xdd   */	OPT_NUMERIC,
+	/* 0xde   */	OPT_TECHNICAL,
+	/* 0xdf   */	OPT_INODE,
+	/* 0xe0   */	OPT_OLD_STYLE,
+	/* 0xe1   */	OPT_SECTIONS,
+	/* 0xe2   */	OPT_LIMIT,
+	/* 0xe3   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,
 	/* 0xf0   */	 0,0,0,0, 0,0,0,0, 0,0,0,0, 0,0,0,0,
 };
 
@@ -1855,356 +1957,380 @@ const u8 OptionIndex[OPT_INDEX_SIZE] =
 ///////////////                opt_allowed_cmd_*                ///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-static u8 option_allowed_cmd_VERSION[110] = // cmd #1
+static u8 option_allowed_cmd_VERSION[112] = // cmd #1
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_HELP[110] = // cmd #2
+static u8 option_allowed_cmd_HELP[112] = // cmd #2
 {
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
-    1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1
+    1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1
 };
 
-static u8 option_allowed_cmd_INFO[110] = // cmd #3
+static u8 option_allowed_cmd_INFO[112] = // cmd #3
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_TEST[110] = // cmd #4
+static u8 option_allowed_cmd_TEST[112] = // cmd #4
 {
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,
-    1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1
+    1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1
 };
 
-static u8 option_allowed_cmd_ERROR[110] = // cmd #5
+static u8 option_allowed_cmd_ERROR[112] = // cmd #5
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 1,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,1,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_COMPR[110] = // cmd #6
+static u8 option_allowed_cmd_COMPR[112] = // cmd #6
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  1,0,0,0,0, 1,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,1,0,0, 0,0,1,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_FEATURES[110] = // cmd #7
+static u8 option_allowed_cmd_FEATURES[112] = // cmd #7
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_EXCLUDE[110] = // cmd #8
+static u8 option_allowed_cmd_EXCLUDE[112] = // cmd #8
 {
     0,0,0,0,0, 0,0,0,0,0,  0,1,1,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_TITLES[110] = // cmd #9
+static u8 option_allowed_cmd_TITLES[112] = // cmd #9
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_GETTITLES[110] = // cmd #10
+static u8 option_allowed_cmd_GETTITLES[112] = // cmd #10
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_FIND[110] = // cmd #11
+static u8 option_allowed_cmd_FIND[112] = // cmd #11
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 1,1,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,1,1,1,  0,0
 };
 
-static u8 option_allowed_cmd_SPACE[110] = // cmd #12
+static u8 option_allowed_cmd_SPACE[112] = // cmd #12
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 1,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,1,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_ANALYZE[110] = // cmd #13
+static u8 option_allowed_cmd_ANALYZE[112] = // cmd #13
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_DUMP[110] = // cmd #14
+static u8 option_allowed_cmd_DUMP[112] = // cmd #14
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,1,0,  0,0,1,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,1,  1,0,0,0,1, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_ID6[110] = // cmd #15
+static u8 option_allowed_cmd_ID6[112] = // cmd #15
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_LIST[110] = // cmd #16
+static u8 option_allowed_cmd_LIST[112] = // cmd #16
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_L[110] = // cmd #17
+static u8 option_allowed_cmd_LIST_L[112] = // cmd #17
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_LL[110] = // cmd #18
+static u8 option_allowed_cmd_LIST_LL[112] = // cmd #18
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_LLL[110] = // cmd #19
+static u8 option_allowed_cmd_LIST_LLL[112] = // cmd #19
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_A[110] = // cmd #20
+static u8 option_allowed_cmd_LIST_A[112] = // cmd #20
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_M[110] = // cmd #21
+static u8 option_allowed_cmd_LIST_M[112] = // cmd #21
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_U[110] = // cmd #22
+static u8 option_allowed_cmd_LIST_U[112] = // cmd #22
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_LIST_F[110] = // cmd #23
+static u8 option_allowed_cmd_LIST_F[112] = // cmd #23
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 1,0,1,0,1,  0,0,0,1,1, 1,0,1,1,0
+    0,0,0,1,1, 1,1,1,0,1,  0,1,0,0,0, 1,1,1,0,1,  1,0
 };
 
-static u8 option_allowed_cmd_FORMAT[110] = // cmd #24
+static u8 option_allowed_cmd_FORMAT[112] = // cmd #24
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,1,1,0,
     0,0,0,0,0, 0,0,1,1,1,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,1, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_RECOVER[110] = // cmd #25
+static u8 option_allowed_cmd_RECOVER[112] = // cmd #25
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_CHECK[110] = // cmd #26
+static u8 option_allowed_cmd_CHECK[112] = // cmd #26
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_REPAIR[110] = // cmd #27
+static u8 option_allowed_cmd_REPAIR[112] = // cmd #27
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,1,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_EDIT[110] = // cmd #28
+static u8 option_allowed_cmd_EDIT[112] = // cmd #28
 {
     0,1,0,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_PHANTOM[110] = // cmd #29
+static u8 option_allowed_cmd_PHANTOM[112] = // cmd #29
 {
     0,1,1,1,0, 0,0,0,0,0,  1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
+};
+
+static u8 option_allowed_cmd_TRUNCATE[112] = // cmd #30
+{
+    0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
+};
+
+static u8 option_allowed_cmd_DEDUP[112] = // cmd #31
+{
+    0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_TRUNCATE[110] = // cmd #30
+static u8 option_allowed_cmd_REHYDRATE[112] = // cmd #32
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_ADD[110] = // cmd #31
+static u8 option_allowed_cmd_DEFRAG[112] = // cmd #33
+{
+    0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
+};
+
+static u8 option_allowed_cmd_ADD[112] = // cmd #34
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,0,0,0, 0,0,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,1, 1,1,1,1,1,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,1, 1,1,1,1,1,  1,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_UPDATE[110] = // cmd #32
+static u8 option_allowed_cmd_UPDATE[112] = // cmd #35
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,0,0,0, 0,0,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 1,1,1,0,1,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 1,1,1,0,1,  1,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_NEW[110] = // cmd #33
+static u8 option_allowed_cmd_NEW[112] = // cmd #36
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,0,0,0, 0,0,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 1,1,1,0,1,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 1,1,1,0,1,  1,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_SYNC[110] = // cmd #34
+static u8 option_allowed_cmd_SYNC[112] = // cmd #37
 {
     0,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,0,0,0, 0,0,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,1,1,1,1,  1,1,1,0,0, 0,0,0,0,0,
-    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,1,1,0,1,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,1,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,1,1,0,1,  1,0,0,0,0, 0,0,0,0,0,
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_DUP[110] = // cmd #35
+static u8 option_allowed_cmd_DUP[112] = // cmd #38
 {
     0,1,1,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,1,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_EXTRACT[110] = // cmd #36
+static u8 option_allowed_cmd_EXTRACT[112] = // cmd #39
 {
     0,1,1,1,0, 0,0,0,1,1,  0,1,1,1,1, 1,1,1,1,0,  0,1,1,1,1, 1,1,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,0,0,0,0,  0,0,0,1,1, 1,1,1,1,1,
-    1,1,1,1,1, 1,1,0,0,0,  0,1,0,0,1, 0,0,0,1,1,  1,1,1,1,1, 1,1,1,1,1,
-    1,0,0,0,0, 0,0,1,0,0,  0,0,0,0,1, 0,0,1,0,0
+    1,1,1,1,1, 1,1,0,0,0,  0,1,0,0,1, 0,0,0,1,1,  0,1,1,1,1, 1,1,1,1,1,
+    1,1,1,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,1,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_SCRUB[110] = // cmd #37
+static u8 option_allowed_cmd_SCRUB[112] = // cmd #40
 {
     0,1,1,1,0, 0,0,0,1,1,  0,1,1,1,1, 1,1,1,0,0,  0,0,0,0,0, 0,0,1,1,1,
     1,1,1,1,1, 1,1,1,1,1,  1,1,1,1,1, 1,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 0,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_REMOVE[110] = // cmd #38
+static u8 option_allowed_cmd_REMOVE[112] = // cmd #41
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,1,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,1, 0,0,1,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,0,0,1,  0,0
 };
 
-static u8 option_allowed_cmd_RENAME[110] = // cmd #39
+static u8 option_allowed_cmd_RENAME[112] = // cmd #42
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
+    1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_SETTITLE[110] = // cmd #40
+static u8 option_allowed_cmd_SETTITLE[112] = // cmd #43
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,1,0,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,
+    1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_TOUCH[110] = // cmd #41
+static u8 option_allowed_cmd_TOUCH[112] = // cmd #44
 {
     0,1,1,1,0, 0,0,0,0,0,  0,1,1,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,1,1,1,1, 0,1,0,0,0,  0,0,0,0,1, 0,0,0,0,0
+    0,0,0,1,1, 1,1,0,1,0,  0,0,0,0,0, 0,1,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_VERIFY[110] = // cmd #42
+static u8 option_allowed_cmd_VERIFY[112] = // cmd #45
 {
     0,1,1,1,0, 0,0,0,1,1,  0,1,1,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,1,0,1,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,1,0,0,1, 0,0,0,0,1
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,1,0, 0,1,0,0,0,  0,1
 };
 
-static u8 option_allowed_cmd_SKELETON[110] = // cmd #43
+static u8 option_allowed_cmd_SKELETON[112] = // cmd #46
 {
     0,1,1,1,0, 0,0,0,1,1,  0,1,1,1,1, 1,1,1,1,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,1,1, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  1,1,1,0,0, 0,1,1,1,0,
-    0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,0,  0,1,0,0,0, 0,0,0,0,0,  0,1,1,1,0, 0,0,0,1,1,
+    1,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0
 };
 
-static u8 option_allowed_cmd_FILETYPE[110] = // cmd #44
+static u8 option_allowed_cmd_FILETYPE[112] = // cmd #47
 {
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,1,1,  1,1,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
     0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,  0,0,0,0,0, 0,0,0,0,0,
-    0,0,0,0,0, 0,0,1,0,0,  0,0,0,0,0, 1,0,0,0,0
+    0,0,0,0,0, 0,0,0,0,1,  0,0,0,0,0, 0,0,1,0,0,  0,0
 };
 
 
@@ -2226,6 +2352,11 @@ const InfoOption_t * option_tab_tool[] =
 	OptionInfo + OPT_LOGGING,
 	OptionInfo + OPT_ESC,
 	OptionInfo + OPT_IO,
+	OptionInfo + OPT_THREADS,
+	OptionInfo + OPT_SCAN_THREADS,
+	OptionInfo + OPT_IOBUF,
+	OptionInfo + OPT_GCZ_CACHE,
+	OptionInfo + OPT_FST_CACHE,
 
 	OptionInfo + OPT_NONE, // separator
 
@@ -2891,6 +3022,54 @@ static const InfoOption_t * option_tab_cmd_TRUNCATE[] =
 	0
 };
 
+static const InfoOption_t * option_tab_cmd_DEDUP[] =
+{
+	OptionInfo + OPT_AUTO,
+	OptionInfo + OPT_ALL,
+	OptionInfo + OPT_PART,
+	&option_grp_MOD_WBFS_NO_CHECK,
+
+	OptionInfo + OPT_NONE, // separator
+
+	OptionInfo + OPT_QUIET,
+	&option_cmd_DEDUP_VERBOSE,
+	OptionInfo + OPT_TEST,
+
+	0
+};
+
+static const InfoOption_t * option_tab_cmd_REHYDRATE[] =
+{
+	OptionInfo + OPT_AUTO,
+	OptionInfo + OPT_ALL,
+	OptionInfo + OPT_PART,
+	&option_grp_MOD_WBFS_NO_CHECK,
+
+	OptionInfo + OPT_NONE, // separator
+
+	OptionInfo + OPT_QUIET,
+	&option_cmd_DEDUP_VERBOSE,
+	OptionInfo + OPT_TEST,
+
+	0
+};
+
+static const InfoOption_t * option_tab_cmd_DEFRAG[] =
+{
+	OptionInfo + OPT_AUTO,
+	OptionInfo + OPT_ALL,
+	OptionInfo + OPT_PART,
+	&option_grp_MOD_WBFS_NO_CHECK,
+
+	OptionInfo + OPT_NONE, // separator
+
+	OptionInfo + OPT_QUIET,
+	&option_cmd_DEFRAG_VERBOSE,
+	OptionInfo + OPT_TEST,
+
+	0
+};
+
 static const InfoOption_t * option_tab_cmd_ADD[] =
 {
 	OptionInfo + OPT_TITLES,
@@ -2969,6 +3148,7 @@ static const InfoOption_t * option_tab_cmd_ADD[] =
 	&option_cmd_SYNC_TRUNC,
 	OptionInfo + OPT_NEWER,
 	OptionInfo + OPT_SYNC_ALL,
+	OptionInfo + OPT_PARALLEL,
 	OptionInfo + OPT_SYNC,
 	OptionInfo + OPT_UPDATE,
 	&option_cmd_ADD_OVERWRITE,
@@ -3054,6 +3234,7 @@ static const InfoOption_t * option_tab_cmd_UPDATE[] =
 	&option_cmd_SYNC_TRUNC,
 	OptionInfo + OPT_NEWER,
 	OptionInfo + OPT_SYNC_ALL,
+	OptionInfo + OPT_PARALLEL,
 	OptionInfo + OPT_SYNC,
 
 	0
@@ -3137,6 +3318,7 @@ static const InfoOption_t * option_tab_cmd_NEW[] =
 	&option_cmd_SYNC_TRUNC,
 	OptionInfo + OPT_NEWER,
 	OptionInfo + OPT_SYNC_ALL,
+	OptionInfo + OPT_PARALLEL,
 	OptionInfo + OPT_SYNC,
 
 	0
@@ -3220,6 +3402,7 @@ static const InfoOption_t * option_tab_cmd_SYNC[] =
 	&option_cmd_SYNC_TRUNC,
 	OptionInfo + OPT_NEWER,
 	OptionInfo + OPT_SYNC_ALL,
+	OptionInfo + OPT_PARALLEL,
 
 	0
 };
@@ -3339,6 +3522,7 @@ static const InfoOption_t * option_tab_cmd_EXTRACT[] =
 	OptionInfo + OPT_CISO,
 	OptionInfo + OPT_WBFS,
 	OptionInfo + OPT_WIA,
+	OptionInfo + OPT_RVZ,
 	OptionInfo + OPT_GCZ,
 	OptionInfo + OPT_GCZ_ZIP,
 	OptionInfo + OPT_GCZ_BLOCK,
@@ -3722,7 +3906,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"Wiimms WBFS Tool (WBFS manager) : It can create, check, repair,"
 	" verify and clone WBFS files and partitions. It can list, add,"
 	" extract, remove, rename and recover ISO images as part of a WBFS.",
-	19,
+	24,
 	option_tab_tool,
 	0
     },
@@ -4129,6 +4313,52 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	option_allowed_cmd_TRUNCATE
     },
 
+    {	CMD_DEDUP,
+	false,
+	false,
+	"DEDUP",
+	"DD",
+	"wwt DEDUP [wbfs_partition]..",
+	"Find equal data blocks of different discs and store them only once."
+	" The discs share these blocks then and the WBFS is marked as"
+	" deduplicated. Shared blocks are copied before they are modified."
+	" Only this tool knows about shared blocks. Therefore a deduplicated"
+	" WBFS gets the magic 'WBFD' instead of 'WBFS', so that other WBFS"
+	" tools don't recognize it. Use 'wwt REHYDRATE' before using other"
+	" WBFS tools.",
+	7,
+	option_tab_cmd_DEDUP,
+	option_allowed_cmd_DEDUP
+    },
+
+    {	CMD_REHYDRATE,
+	false,
+	false,
+	"REHYDRATE",
+	"RH",
+	"wwt REHYDRATE [wbfs_partition]..",
+	"Give each disc a private copy of all shared blocks and remove the"
+	" deduplication mark. This undoes 'wwt DEDUP'.",
+	7,
+	option_tab_cmd_REHYDRATE,
+	option_allowed_cmd_REHYDRATE
+    },
+
+    {	CMD_DEFRAG,
+	false,
+	false,
+	"DEFRAG",
+	"DF",
+	"wwt DEFRAG [wbfs_partition]..",
+	"Move fragmented discs into contiguous free areas of the WBFS. Each"
+	" disc is copied first and released after its inode is updated, so an"
+	" interruption never damages a disc. Use --test to print the expected"
+	" fragment reduction.",
+	7,
+	option_tab_cmd_DEFRAG,
+	option_allowed_cmd_DEFRAG
+    },
+
     {	CMD_ADD,
 	false,
 	true,
@@ -4137,7 +4367,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"wwt ADD [[--source|--recurse] source]...",
 	"Add Wii and GameCube ISO discs to WBFS partitions. Images, WBFS"
 	" partitions and directories are accepted as source.",
-	61,
+	62,
 	option_tab_cmd_ADD,
 	option_allowed_cmd_ADD
     },
@@ -4151,7 +4381,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"Add missing Wii and GameCube ISO discs to WBFS partitions. Images,"
 	" WBFS partitions and directories are accepted as source. 'UPDATE' is"
 	" a shortcut for 'ADD --update'.",
-	59,
+	60,
 	option_tab_cmd_UPDATE,
 	option_allowed_cmd_UPDATE
     },
@@ -4165,7 +4395,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"Add missing and newer Wii and GameCube ISO discs to WBFS partitions."
 	" Images, WBFS partitions and directories are accepted as source."
 	" 'NEW' is a shortcut for 'ADD --update --newer'.",
-	59,
+	60,
 	option_tab_cmd_NEW,
 	option_allowed_cmd_NEW
     },
@@ -4180,7 +4410,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	" same discs as all sources together. Images, WBFS partitions and"
 	" directories are accepted as source. 'SYNC' is a shortcut for 'ADD"
 	" --sync'.",
-	58,
+	59,
 	option_tab_cmd_SYNC,
 	option_allowed_cmd_SYNC
     },
@@ -4208,7 +4438,7 @@ const InfoCommand_t CommandInfo[CMD__N+1] =
 	"wwt EXTRACT id6[=dest]...",
 	"Extract discs from WBFS partitions and store them as Wii or GameCube"
 	" images.",
-	76,
+	77,
 	option_tab_cmd_EXTRACT,
 	option_allowed_cmd_EXTRACT
     },
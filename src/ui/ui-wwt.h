@@ -135,10 +135,12 @@ typedef enum enumOptions
 	OPT_NEWER,
 	OPT_OVERWRITE,
 	OPT_REMOVE,
+	OPT_PARALLEL,
 	OPT_WDF,
 	OPT_WDF1,
 	OPT_WDF2,
 	OPT_WIA,
+	OPT_RVZ,
 	OPT_GCZ,
 	OPT_GCZ_ZIP,
 	OPT_ISO,
@@ -166,7 +168,7 @@ typedef enum enumOptions
 	OPT_SORT,
 	OPT_LIMIT,
 
-	OPT__N_SPECIFIC, // == 110 
+	OPT__N_SPECIFIC, // == 112 
 
 	//----- global options -----
 
@@ -181,6 +183,11 @@ typedef enum enumOptions
 	OPT_LOGGING,
 	OPT_ESC,
 	OPT_IO,
+	OPT_THREADS,
+	OPT_SCAN_THREADS,
+	OPT_IOBUF,
+	OPT_GCZ_CACHE,
+	OPT_FST_CACHE,
 	OPT_DIRECT,
 	OPT_TITLES,
 	OPT_UTF_8,
@@ -194,7 +201,7 @@ typedef enum enumOptions
 	OPT_ALIGN_WDF,
 	OPT_GCZ_BLOCK,
 
-	OPT__N_TOTAL // == 133
+	OPT__N_TOTAL // == 140
 
 } enumOptions;
 
@@ -288,10 +295,12 @@ typedef enum enumOptions
 //	OB_NEWER		= 1llu << OPT_NEWER,
 //	OB_OVERWRITE		= 1llu << OPT_OVERWRITE,
 //	OB_REMOVE		= 1llu << OPT_REMOVE,
+//	OB_PARALLEL		= 1llu << OPT_PARALLEL,
 //	OB_WDF			= 1llu << OPT_WDF,
 //	OB_WDF1			= 1llu << OPT_WDF1,
 //	OB_WDF2			= 1llu << OPT_WDF2,
 //	OB_WIA			= 1llu << OPT_WIA,
+//	OB_RVZ			= 1llu << OPT_RVZ,
 //	OB_GCZ			= 1llu << OPT_GCZ,
 //	OB_GCZ_ZIP		= 1llu << OPT_GCZ_ZIP,
 //	OB_ISO			= 1llu << OPT_ISO,
@@ -373,6 +382,7 @@ typedef enum enumOptions
 //
 //	OB_GRP_OUTMODE		= OB_GRP_OUTMODE_EDIT
 //				| OB_WIA
+//				| OB_RVZ
 //				| OB_GCZ
 //				| OB_GCZ_ZIP
 //				| OB_FST,
@@ -535,6 +545,12 @@ typedef enum enumOptions
 //
 //	OB_CMD_TRUNCATE		= OB_GRP_MOD_WBFS,
 //
+//	OB_CMD_DEDUP		= OB_GRP_MOD_WBFS,
+//
+//	OB_CMD_REHYDRATE	= OB_CMD_DEDUP,
+//
+//	OB_CMD_DEFRAG		= OB_GRP_MOD_WBFS,
+//
 //	OB_CMD_SYNC		= OB_GRP_TITLES
 //				| OB_GRP_MOD_WBFS
 //				| OB_WBFS_ALLOC
@@ -551,7 +567,8 @@ typedef enum enumOptions
 //				| OB_REMOVE
 //				| OB_TRUNC
 //				| OB_NEWER
-//				| OB_SYNC_ALL,
+//				| OB_SYNC_ALL
+//				| OB_PARALLEL,
 //
 //	OB_CMD_UPDATE		= OB_CMD_SYNC
 //				| OB_SYNC,
@@ -700,6 +717,9 @@ typedef enum enumCommands
 	CMD_EDIT,
 	CMD_PHANTOM,
 	CMD_TRUNCATE,
+	CMD_DEDUP,
+	CMD_REHYDRATE,
+	CMD_DEFRAG,
 
 	CMD_ADD,
 	CMD_UPDATE,
@@ -717,7 +737,7 @@ typedef enum enumCommands
 
 	CMD_FILETYPE,
 
-	CMD__N // == 45
+	CMD__N // == 48
 
 } enumCommands;
 
@@ -778,6 +798,11 @@ typedef enum enumGetOpt
 	GO_WIDTH,
 	GO_SCAN_PROGRESS,
 	GO_IO,
+	GO_THREADS,
+	GO_SCAN_THREADS,
+	GO_IOBUF,
+	GO_GCZ_CACHE,
+	GO_FST_CACHE,
 	GO_DIRECT,
 	GO_UTF_8,
 	GO_NO_UTF_8,
@@ -844,10 +869,12 @@ typedef enum enumGetOpt
 	GO_REPAIR,
 	GO_NO_FREE,
 	GO_SYNC_ALL,
+	GO_PARALLEL,
 	GO_WDF1,
 	GO_WDF2,
 	GO_ALIGN_WDF,
 	GO_WIA,
+	GO_RVZ,
 	GO_GCZ,
 	GO_GCZ_ZIP,
 	GO_GCZ_BLOCK,
@@ -392,7 +392,7 @@ enumError AnalyzePartitions ( FILE * outfile, bool non_found_is_ok, bool scan_wb
 		goto _done;
 	    }
 
-	    if (memcmp(&whead.magic,"WBFS",sizeof(whead.magic)))
+	    if (!wbfs_is_head_magic(ntohl(whead.magic)))
 	    {
 		info->part_mode = PM_NO_WBFS_MAGIC;
 		read_error = "No WBFS magic found: %s\n";
@@ -1219,6 +1219,7 @@ enumError RecoverWBFS ( WBFS_t * wbfs, ccp fname, bool testmode )
 		    w->max_disc * w->disc_info_sz );
 
 	memset(w->freeblks,0,w->freeblks_size4*4);
+	w->freeblks_dirty = true;
 	SyncWBFS(wbfs,true);
 
 	CheckWBFS_t ck;
@@ -1713,6 +1714,10 @@ enumError DumpWBFS
 
 	    fprintf(f,"%*s  WBFS VERSION:     %#13x =%15u\n", indent,"",
 			    head->wbfs_version, head->wbfs_version );
+	    if (head->flags)
+		fprintf(f,"%*s  WBFS FLAGS:       %#13x =%15s\n", indent,"",
+			    head->flags,
+			    head->flags & WBFS_HEAD_F_DEDUP ? "dedup" : "?" );
 
 	    fprintf(f,"%*s  hd sectors:       %#13x =%15u\n", indent,"",
 			    (u32)htonl(head->n_hd_sec), (u32)htonl(head->n_hd_sec) );
@@ -1805,6 +1810,18 @@ enumError DumpWBFS
 	fprintf(f,"%*swbfs total blocks:    %#11x =%15u =%8u MiB = 100%%\n\n", indent,"",
 		w->n_wbfs_sec, w->n_wbfs_sec, total_mib );
 
+	if ( head && head->flags & WBFS_HEAD_F_DEDUP )
+	{
+	    DedupWBFS_t dd;
+	    CountDedupWBFS(wbfs,&dd);
+	    fprintf(f,"%*sdedup block refs:     %#11x =%15u\n", indent,"",
+		dd.ref_blocks, dd.ref_blocks );
+	    fprintf(f,"%*sdedup shared blocks:  %#11x =%15u\n", indent,"",
+		dd.shared_blocks, dd.shared_blocks );
+	    fprintf(f,"%*sdedup ratio:          %28.2f\n\n", indent,"",
+		dd.used_blocks ? (double)dd.ref_blocks / dd.used_blocks : 1.0 );
+	}
+
 	const u64 wbfs_max  = (u64)w->wbfs_sec_sz * WBFS_MAX_SECTORS;
 	const u64 wbfs_trim = (u64)w->wbfs_sec_sz * (wbfs_find_last_used_block(w)+1);
 	const u32 max_mib   = ( wbfs_max  + MiB/2 ) / MiB;
@@ -2133,7 +2150,7 @@ static void AW_header ( AWData_t * awd, File_t * f )
 
     wbfs_head_t wh;
     if ( ReadAtF(f,0,&wh,sizeof(wh)) == ERR_OK
-	&& !memcmp((ccp)&wh.magic,"WBFS",4) )
+	&& wbfs_is_head_magic(ntohl(wh.magic)) )
     {
 	AWRecord_t * r = AW_get_record(awd);
 	r->status		= AW_HEADER;
@@ -2717,6 +2734,9 @@ enumError CheckWBFS ( CheckWBFS_t * ck, WBFS_t * wbfs,
 
     u32 WBFS0_SEC = N_SEC;	// used sectors
 
+    // shared blocks are intended by a deduplicated WBFS
+    const bool dedup = ( w->head->flags & WBFS_HEAD_F_DEDUP ) != 0;
+
     if ( w->head->wbfs_version == 0 )
     {
 	// the old wbfs versions have calculation errors
@@ -2879,7 +2899,7 @@ enumError CheckWBFS ( CheckWBFS_t * ck, WBFS_t * wbfs,
 				    indent,"", slot, g->id6, bl, wlba );
 		}
 
-		if ( blc[wlba] > 1 )
+		if ( blc[wlba] > 1 && !dedup )
 		{
 		    invalid_game = 1;
 		    g->err_count++;
@@ -2932,9 +2952,10 @@ enumError CheckWBFS ( CheckWBFS_t * ck, WBFS_t * wbfs,
 	fprintf(f,"%*s* Check free blocks table.\n", indent,"" );
 
     u32 total_err_overlap  = 0;
-    for ( bl = 0; bl < N_SEC; bl++ )
-	if ( blc[bl] > 1 )
-	    total_err_overlap++;
+    if (!dedup)
+	for ( bl = 0; bl < N_SEC; bl++ )
+	    if ( blc[bl] > 1 )
+		total_err_overlap++;
 
     u32 total_err_fbt_used = 0;
     u32 total_err_fbt_free = 0;
@@ -3302,241 +3323,958 @@ bool CalcFBT ( CheckWBFS_t * ck )
 
 //
 ///////////////////////////////////////////////////////////////////////////////
-///////////////			   WDiscInfo_t			///////////////
+///////////////			block deduplication		///////////////
 ///////////////////////////////////////////////////////////////////////////////
-// is WDiscInfo_t obsolete? [wiidisc] [[obsolete]]
+// A deduplicated WBFS stores equal data blocks of different discs only once.
+// Such WBFS is marked by WBFS_HEAD_F_DEDUP and by WBFS_DEDUP_MAGIC, so that
+// other tools don't open it. The shared blocks are counted by 'used_block'.
+// The first block of a disc is never shared, because it is modified in place
+// when renaming the disc.
 
-void InitializeWDiscInfo ( WDiscInfo_t * dinfo )
+typedef struct DedupBlock_t
 {
-    memset(dinfo,0,sizeof(*dinfo));
-    dinfo->slot = -1;
-}
+    u32			wlba;		// index of WBFS block
+    sha1_hash_t		hash;		// SHA1 checksum of the block data
 
-///////////////////////////////////////////////////////////////////////////////
+} DedupBlock_t;
 
-enumError ResetWDiscInfo ( WDiscInfo_t * dinfo )
+//-----------------------------------------------------------------------------
+
+static int cmp_dedup_block ( const void * va, const void * vb )
 {
-    // nothing to do
+    const DedupBlock_t * a = va;
+    const DedupBlock_t * b = vb;
 
-    InitializeWDiscInfo(dinfo);
-    return ERR_OK;
+    const int stat = memcmp(a->hash,b->hash,sizeof(a->hash));
+    if (stat)
+	return stat;
+    return a->wlba < b->wlba ? -1 : a->wlba > b->wlba;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-enumError GetWDiscInfo ( WBFS_t * w, WDiscInfo_t * dinfo, int disc_index )
+void CountDedupWBFS ( WBFS_t * w, DedupWBFS_t * dd )
 {
     ASSERT(w);
-    if ( !w || !w->wbfs || !dinfo )
-	return ERROR0(ERR_INTERNAL,0);
+    ASSERT(dd);
+    memset(dd,0,sizeof(*dd));
 
-    w->disc_slot = -1;
+    wbfs_t * p = w->wbfs;
+    if (!p)
+	return;
 
-    u32 slot, size4;
-    const enumError err = wbfs_get_disc_info ( w->wbfs, disc_index,
-			    (u8*)&dinfo->dhead, sizeof(dinfo->dhead), &slot,
-			    &dinfo->disc_type, &dinfo->disc_attrib,
-			    &size4, &dinfo->wbfs_fragments );
+    const u32 N_SEC = p->n_wbfs_sec;
+    u16 * count = CALLOC(N_SEC,sizeof(*count));
 
-    if (err)
+    u32 slot;
+    for ( slot = 0; slot < p->max_disc; slot++ )
     {
-	memset(dinfo,0,sizeof(*dinfo));
-	return err;
-    }
+	wbfs_disc_t * d = wbfs_open_disc_by_slot(p,slot,0);
+	if (!d)
+	    continue;
 
-    CalcWDiscInfo(dinfo,0);
-    dinfo->disc_index	= disc_index;
-    dinfo->slot		= slot;
-    dinfo->size		= (u64)size4 * 4;
-    dinfo->used_blocks	= dinfo->size / WII_SECTOR_SIZE; // [[2do]] not exact
+	dd->n_disc++;
+	const wbfs_disc_info_t * info = d->header;
+	int bl;
+	for ( bl = 0; bl < p->n_wbfs_sec_per_disc; bl++ )
+	{
+	    const u32 wlba = ntohs(info->wlba_table[bl]);
+	    if ( wlba > 0 && wlba < N_SEC )
+	    {
+		dd->ref_blocks++;
+		if (!count[wlba]++)
+		    dd->used_blocks++;
+		else if ( count[wlba] == 2 )
+		    dd->shared_blocks++;
+	    }
+	}
+	wbfs_close_disc(d);
+    }
 
-    return dinfo->disc_type == WD_DT_UNKNOWN ? ERR_WARNING : ERR_OK;
+    FREE(count);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-enumError GetWDiscInfoBySlot ( WBFS_t * w, WDiscInfo_t * dinfo, u32 disc_slot )
+enumError DedupWBFS ( WBFS_t * w, DedupWBFS_t * dd, bool testmode )
 {
+    // find equal data blocks and let the discs share them.
+    // 'dd->mod_blocks' is set to the number of released blocks.
+
     ASSERT(w);
-    if ( !w || !w->wbfs || !dinfo )
+    ASSERT(dd);
+
+    CountDedupWBFS(w,dd);
+    if ( !w->wbfs || !w->sf )
 	return ERROR0(ERR_INTERNAL,0);
 
-    w->disc_slot = -1;
+    enumError err = CloseWDisc(w);
+    if (err)
+	return err;
 
-    memset(dinfo,0,sizeof(*dinfo));
+    wbfs_t * p = w->wbfs;
+    const u32 N_SEC   = p->n_wbfs_sec;
+    const u32 BL_SIZE = p->wbfs_sec_sz;
 
-    u32 size4;
-    const enumError err = wbfs_get_disc_info_by_slot ( w->wbfs, disc_slot,
-			    (u8*)&dinfo->dhead, sizeof(dinfo->dhead),
-			    &dinfo->disc_type, &dinfo->disc_attrib,
-			    &size4, &dinfo->wbfs_fragments );
+    //--- open all discs and mark the candidates
 
-    if (err)
-    {
-	TRACE("GetWDiscInfoBySlot() err=%d, magic=%x\n",err,dinfo->dhead.wii_magic);
-	return err;
-    }
+    enum { M_NONE, M_CAND, M_FIRST };
 
-    CalcWDiscInfo(dinfo,0);
-    dinfo->disc_index	= disc_slot;
-    dinfo->slot		= disc_slot;
-    dinfo->size		= (u64)size4 * 4;
-    dinfo->used_blocks	= dinfo->size / WII_SECTOR_SIZE; // [[2do]] not exact
+    wbfs_disc_t ** disc = CALLOC(p->max_disc,sizeof(*disc));
+    u8  * mark = CALLOC(N_SEC,1);
+    u32 * map  = CALLOC(N_SEC,sizeof(*map));
+    u32 slot, n_cand = 0;
 
-    w->disc_slot = disc_slot;
-    return dinfo->disc_type == WD_DT_UNKNOWN ? ERR_WARNING : ERR_OK;
-}
+    for ( slot = 0; slot < p->max_disc; slot++ )
+    {
+	wbfs_disc_t * d = wbfs_open_disc_by_slot(p,slot,0);
+	if (!d)
+	    continue;
+	if (!d->is_valid)
+	{
+	    wbfs_close_disc(d);
+	    continue;
+	}
+	disc[slot] = d;
 
-///////////////////////////////////////////////////////////////////////////////
+	const wbfs_disc_info_t * info = d->header;
+	int bl;
+	for ( bl = 0; bl < p->n_wbfs_sec_per_disc; bl++ )
+	{
+	    const u32 wlba = ntohs(info->wlba_table[bl]);
+	    if ( !wlba || wlba >= N_SEC )
+		continue;
 
-enumError FindWDiscInfo ( WBFS_t * w, WDiscInfo_t * dinfo, ccp id6 )
-{
-    // [[2do]] the wbfs subsystem can find ids!
+	    if (!bl)
+	    {
+		if ( mark[wlba] == M_CAND )
+		    n_cand--;
+		mark[wlba] = M_FIRST;
+	    }
+	    else if ( mark[wlba] == M_NONE )
+	    {
+		mark[wlba] = M_CAND;
+		n_cand++;
+	    }
+	}
+    }
 
-    ASSERT(w);
-    ASSERT(dinfo);
-    ASSERT(id6);
-    if ( !w || !w->wbfs || !dinfo || !id6 )
-	return ERROR0(ERR_INTERNAL,0);
+    //--- calculate the checksums of all candidates
 
-    w->disc_slot = -1;
+    DedupBlock_t * list = MALLOC( ( n_cand + 1 ) * sizeof(*list) );
+    u8 * buf = MALLOC(2*BL_SIZE);
+    u32 wlba, n = 0;
 
-    int i;
-    for ( i = 0; i < w->used_discs; i++ )
+    for ( wlba = 1; wlba < N_SEC && n < n_cand; wlba++ )
     {
-	if ( GetWDiscInfo(w,dinfo,i) == ERR_OK
-	    && !memcmp(id6,&dinfo->dhead.disc_id,6) )
-		return ERR_OK;
-    }
-    return ERR_WDISC_NOT_FOUND;
-}
+	if ( mark[wlba] != M_CAND )
+	    continue;
 
-///////////////////////////////////////////////////////////////////////////////
+	if (SIGINT_level)
+	{
+	    err = ERR_INTERRUPT;
+	    goto abort;
+	}
 
-enumError LoadIsoHeader	( WBFS_t * w, wd_header_t * iso_header, wbfs_disc_t * disc )
-{
-    ASSERT(w);
-    ASSERT(iso_header);
+	err = ReadAtF(&w->sf->f,(off_t)BL_SIZE*wlba,buf,BL_SIZE);
+	if (err)
+	    goto abort;
 
-    if ( !w || !w->sf || !w->wbfs || !iso_header )
-	return ERROR0(ERR_INTERNAL,0);
+	DedupBlock_t * db = list + n++;
+	db->wlba = wlba;
+	WIT_SHA1(buf,BL_SIZE,db->hash);
+    }
+    qsort(list,n,sizeof(*list),cmp_dedup_block);
 
-    memset(iso_header,0,sizeof(*iso_header));
-    if (!disc)
+    //--- find the duplicates and verify them by comparing the data
+
+    u32 i = 0;
+    while ( i < n )
     {
-	disc = w->disc;
-	if (!disc)
-	    return ERR_OK;
-    }
+	const DedupBlock_t * base = list + i;
+	u32 base_ref = p->used_block[base->wlba];
+	bool base_loaded = false;
 
-    u16 wlba = ntohs(disc->header->wlba_table[0]);
-    if (!wlba)
-	return ERR_OK;
+	for ( i++; i < n && !memcmp(list[i].hash,base->hash,sizeof(base->hash)); i++ )
+	{
+	    const DedupBlock_t * db = list + i;
+	    const u32 ref = p->used_block[db->wlba];
+	    if ( base_ref + ref > WBFS_DEDUP_MAX_REF )
+	    {
+		// too many references => continue with a new base
+		base = db;
+		base_ref = ref;
+		base_loaded = false;
+		continue;
+	    }
 
-    char buf[HD_SECTOR_SIZE]; // read whole hd sector
-    enumError err = ReadSF(w->sf, wlba * (off_t)w->wbfs->wbfs_sec_sz,
-			buf, sizeof(buf) );
-    if (!err)
-	memcpy(iso_header,buf,sizeof(*iso_header));
-    return err;
-}
+	    if (!base_loaded)
+	    {
+		err = ReadAtF(&w->sf->f,(off_t)BL_SIZE*base->wlba,buf,BL_SIZE);
+		if (err)
+		    goto abort;
+		base_loaded = true;
+	    }
 
-///////////////////////////////////////////////////////////////////////////////
+	    err = ReadAtF(&w->sf->f,(off_t)BL_SIZE*db->wlba,buf+BL_SIZE,BL_SIZE);
+	    if (err)
+		goto abort;
+	    if (memcmp(buf,buf+BL_SIZE,BL_SIZE))
+		continue;
 
-void CalcWDiscInfo ( WDiscInfo_t * dinfo, SuperFile_t * sf )
-{
-    ASSERT(dinfo);
+	    map[db->wlba] = base->wlba;
+	    base_ref += ref;
+	    dd->mod_blocks++;
+	}
+    }
 
-    if (sf)
+    //--- remap the disc blocks
+
+    if ( !testmode && dd->mod_blocks )
     {
-	const wd_disc_t * disc = OpenDiscSF(sf,false,false);
-	if (disc)
+	// mark the WBFS first, so that an interrupted
+	// run leaves only some unused blocks behind.
+
+	p->head->flags |= WBFS_HEAD_F_DEDUP;
+	p->head->magic  = htonl(wbfs_head_magic(p->head->flags));
+	wbfs_sync(p);
+
+	for ( slot = 0; slot < p->max_disc; slot++ )
 	{
-	    memcpy(&dinfo->dhead,&disc->dhead,sizeof(dinfo->dhead));
-	    dinfo->magic2	= disc->magic2;
-	    dinfo->n_part	= disc->n_part;
-	    dinfo->used_blocks	= CountUsedIsoBlocksSF(sf,&part_selector);
+	    wbfs_disc_t * d = disc[slot];
+	    if (!d)
+		continue;
 
-	    static char mask[] = "DUC?";
-	    strcpy(dinfo->part_info,"----");
-	    int ip;
-	    for ( ip = 0; ip < disc->n_part; ip++ )
+	    wbfs_disc_info_t * info = d->header;
+	    int bl;
+	    for ( bl = 1; bl < p->n_wbfs_sec_per_disc; bl++ )
 	    {
-		u32 pt = disc->part[ip].part_type;
-		if ( pt > sizeof(mask)-2 )
-		     pt = sizeof(mask)-2;
-		dinfo->part_info[pt] = mask[pt];
+		const u32 wlba = ntohs(info->wlba_table[bl]);
+		if ( wlba > 0 && wlba < N_SEC && map[wlba]
+			&& wbfs_share_block(p,map[wlba]) )
+		{
+		    info->wlba_table[bl] = htons(map[wlba]);
+		    wbfs_free_block(p,wlba);
+		    d->is_dirty = true;
+		}
 	    }
 	}
-	else
-	    ReadSF(sf,0,&dinfo->dhead,sizeof(dinfo->dhead));
     }
 
-    memcpy(dinfo->id6,&dinfo->dhead.disc_id,6);
-    dinfo->id6[6]	= 0;
-    dinfo->used_blocks	= 0;
-    dinfo->disc_index	= 0;
-    dinfo->size		= 0;
-    dinfo->title	= GetTitle(dinfo->id6,0);
-    dinfo->disc_type	= get_header_disc_type(&dinfo->dhead,&dinfo->disc_attrib);
+ abort:
+    for ( slot = 0; slot < p->max_disc; slot++ )
+	if (disc[slot])
+	    wbfs_close_disc(disc[slot]);
+    if ( !testmode && dd->mod_blocks )
+    {
+	p->used_block_dirty = p->is_dirty = true;
+	wbfs_sync(p);
+	CalcWBFSUsage(w);
+    }
+
+    FREE(buf);
+    FREE(list);
+    FREE(map);
+    FREE(mark);
+    FREE(disc);
+    return err;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void CopyWDiscInfo ( WDiscListItem_t * item, WDiscInfo_t * dinfo )
+enumError RehydrateWBFS ( WBFS_t * w, DedupWBFS_t * dd, bool testmode )
 {
-    ASSERT(item);
-    ASSERT(dinfo);
+    // give each disc its own copy of all shared blocks and
+    // clear the dedup flag. 'dd->mod_blocks' is set to the number of copies.
 
-    memset(item,0,sizeof(*item));
+    ASSERT(w);
+    ASSERT(dd);
 
-    memcpy(item->id6,&dinfo->dhead.disc_id,6);
-    item->size_mib = (u32)(( dinfo->size + MiB/2 ) / MiB );
-    memcpy(item->name64,dinfo->dhead.disc_title,64);
-    memcpy(item->part_info,dinfo->part_info,sizeof(item->part_info));
-    item->title		= dinfo->title;
-    item->n_part	= dinfo->n_part;
-    item->wbfs_slot	= dinfo->disc_index;
-    item->wbfs_fragments= dinfo->wbfs_fragments;
-    item->ftype		= FT_ID_WBFS | FT_A_WDISC;
-    item->used_blocks	= dinfo->used_blocks;
+    CountDedupWBFS(w,dd);
+    if ( !w->wbfs || !w->sf )
+	return ERROR0(ERR_INTERNAL,0);
 
-    CopyFileAttribDiscInfo(&item->fatt,dinfo);
-}
+    enumError err = CloseWDisc(w);
+    if (err)
+	return err;
 
-///////////////////////////////////////////////////////////////////////////////
+    wbfs_t * p = w->wbfs;
+    const u32 N_SEC = p->n_wbfs_sec;
 
-static void DumpTimestamp ( FILE * f, int indent, ccp head, u64 xtime, ccp comment )
-{
-    time_t tim = ntoh64(xtime);
-    if (tim)
+    u32 wlba;
+    for ( wlba = 1; wlba < N_SEC; wlba++ )
+	if ( p->used_block[wlba] > 1 )
+	    dd->mod_blocks += p->used_block[wlba] - 1;
+
+    const u32 free_blocks = wbfs_get_free_block_count(p);
+    if ( dd->mod_blocks > free_blocks )
+	return ERROR0(ERR_WBFS,
+		"Not enough free blocks to rehydrate WBFS (%u needed, %u free): %s\n",
+		dd->mod_blocks, free_blocks, w->sf->f.fname );
+
+    if (testmode)
+	return ERR_OK;
+
+    u32 slot;
+    for ( slot = 0; slot < p->max_disc && !err; slot++ )
     {
-	struct tm * tm = localtime(&tim);
-	char timbuf[40];
-	strftime(timbuf,sizeof(timbuf),"%F %T",tm);
-	fprintf(f,"%*s%-12s%s  (%s)\n", indent, "", head, timbuf, comment );
+	wbfs_disc_t * d = wbfs_open_disc_by_slot(p,slot,0);
+	if (!d)
+	    continue;
+
+	const wbfs_disc_info_t * info = d->header;
+	int bl;
+	for ( bl = 0; bl < p->n_wbfs_sec_per_disc && !err; bl++ )
+	{
+	    const u32 wlba = ntohs(info->wlba_table[bl]);
+	    if ( wlba > 0 && wlba < N_SEC && p->used_block[wlba] > 1 )
+		err = UnshareBlockWBFS(w,d,bl);
+	}
+	wbfs_close_disc(d);
+    }
+
+    if (!err)
+    {
+	p->head->flags &= ~WBFS_HEAD_F_DEDUP;
+	p->head->magic  = htonl(wbfs_head_magic(p->head->flags));
     }
+    p->used_block_dirty = p->is_dirty = true;
+    wbfs_sync(p);
+    CalcWBFSUsage(w);
+    return err;
 }
 
-//-----------------------------------------------------------------------------
+///////////////////////////////////////////////////////////////////////////////
 
-enumError DumpWDiscInfo
-	( WDiscInfo_t * di, wd_header_t * ih, FILE * f, int indent )
+enumError UnshareBlockWBFS
+(
+    WBFS_t		* w,		// valid WBFS
+    wbfs_disc_t		* disc,		// valid disc of 'w'
+    u32			bl		// block index of the disc
+)
 {
-    if ( !di || !f )
-	return ERROR0(ERR_INTERNAL,0);
+    // replace a shared block of a disc by a private copy (copy on write)
 
-    indent = NormalizeIndent(indent);
+    DASSERT(w);
+    DASSERT(w->wbfs);
+    DASSERT(w->sf);
+    DASSERT(disc);
+    DASSERT(disc->header);
+
+    wbfs_t * p = w->wbfs;
+    wbfs_disc_info_t * info = disc->header;
+    const u32 wlba = ntohs(info->wlba_table[bl]);
+    if ( !wlba || wlba >= p->n_wbfs_sec || p->used_block[wlba] <= 1 )
+	return ERR_OK;
 
-    const u32 magic = ntohl(di->dhead.wii_magic);
-    fprintf(f,"%*smagic:      %08x, %.64s\n", indent, "", magic,
-		magic == WII_MAGIC ? " (=WII-DISC)"
-			: magic == WII_MAGIC_DELETED ? " (=DELETED)" : "" );
+    const u32 new_wlba = wbfs_alloc_block(p,wlba);
+    if ( new_wlba == WBFS_NO_BLOCK )
+	return ERROR0(ERR_WRITE_FAILED,
+		"Can't allocate a free WBFS block: %s\n", w->sf->f.fname );
 
-    fprintf(f,"%*swbfs name:  %6s, %.64s\n",
-		indent, "", &di->dhead.disc_id, di->dhead.disc_title );
-    if (ih)
-	fprintf(f,"%*siso name:   %6s, %.64s\n",
+    const u32 BL_SIZE = p->wbfs_sec_sz;
+    u8 * buf = MALLOC(BL_SIZE);
+    enumError err = ReadAtF(&w->sf->f,(off_t)BL_SIZE*wlba,buf,BL_SIZE);
+    if (!err)
+	err = WriteAtF(&w->sf->f,(off_t)BL_SIZE*new_wlba,buf,BL_SIZE);
+    if (!err)
+	err = SyncF(&w->sf->f); // the copy must be stable before repointing
+    FREE(buf);
+    if (err)
+    {
+	wbfs_free_block(p,new_wlba);
+	return err;
+    }
+
+    noPRINT("UNSHARE BLOCK %u.%u: %u -> %u\n",disc->slot,bl,wlba,new_wlba);
+    info->wlba_table[bl] = htons(new_wlba);
+    disc->is_dirty = true;
+    wbfs_free_block(p,wlba);
+    return ERR_OK;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			  defragmentation		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// Each fragmented disc is moved into the best fitting free area of the WBFS.
+// The moves are planned with a copy of 'used_block' first. Blocks released
+// by a move are available for the following moves, so the planning is
+// repeated until no more disc can be moved. Discs with shared blocks of a
+// deduplicated WBFS are never moved.
+//
+// A move is crash safe: The new blocks are marked as used before they are
+// filled, the inode is updated by a single write and the old blocks are
+// released at last. An interruption leaves at most some lost blocks behind.
+
+#define DEFRAG_BUF_SIZE (32*MiB)
+
+typedef struct DefragDisc_t
+{
+    u32			slot;		// slot index of the disc
+    u32			n_blocks;	// number of used WBFS blocks
+    u32			n_frag;		// number of fragments
+    u32			first;		// >0: planned first block of the new area
+    u16			* wlba_tab;	// copy of the wlba table (network byte order)
+
+} DefragDisc_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static u32 find_defrag_area
+(
+    // returns the first block of the smallest free area
+    // with at least 'n_needed' blocks or 0 if not found
+
+    const u8		* used,		// usage map of the WBFS blocks
+    u32			n_sec,		// number of elements of 'used'
+    u32			n_needed	// number of needed blocks
+)
+{
+    DASSERT(used);
+    DASSERT(n_needed);
+
+    u32 found = 0, found_size = 0, bl = 1;
+    while ( bl < n_sec )
+    {
+	if (used[bl])
+	{
+	    bl++;
+	    continue;
+	}
+
+	const u32 first = bl;
+	while ( bl < n_sec && !used[bl] )
+	    bl++;
+	const u32 size = bl - first;
+	if ( size >= n_needed && ( !found || size < found_size ) )
+	{
+	    found = first;
+	    found_size = size;
+	    if ( size == n_needed )
+		break;
+	}
+    }
+    return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError move_defrag_disc
+(
+    WBFS_t		* w,		// valid WBFS
+    const DefragDisc_t	* dd,		// disc to move
+    u8			* buf,		// buffer with 'buf_blocks' WBFS blocks
+    u32			buf_blocks	// number of blocks of 'buf'
+)
+{
+    DASSERT(w);
+    DASSERT(w->wbfs);
+    DASSERT(w->sf);
+    DASSERT(dd);
+    DASSERT(dd->first);
+    DASSERT(buf);
+    DASSERT(buf_blocks);
+
+    wbfs_t * p = w->wbfs;
+    File_t * f = &w->sf->f;
+    const u32 BL_SIZE = p->wbfs_sec_sz;
+    const u32 N_BL    = p->n_wbfs_sec_per_disc;
+
+    wbfs_disc_t * d = wbfs_open_disc_by_slot(p,dd->slot,0);
+    if (!d)
+	return ERROR0(ERR_WBFS,"Can't open disc of WBFS slot #%u: %s\n",
+			dd->slot, f->fname );
+
+    wbfs_disc_info_t * info = d->header;
+    if (memcmp(info->wlba_table,dd->wlba_tab,N_BL*sizeof(*dd->wlba_tab)))
+    {
+	wbfs_close_disc(d);
+	return ERROR0(ERR_INTERNAL,
+		"WBFS slot #%u modified while defragmenting: %s\n",
+		dd->slot, f->fname );
+    }
+
+    //--- reserve the new blocks
+
+    u32 i;
+    for ( i = 0; i < dd->n_blocks; i++ )
+    {
+	DASSERT(!p->used_block[dd->first+i]);
+	wbfs_use_block(p,dd->first+i);
+    }
+    wbfs_sync(p);
+
+    //--- copy the data in large sequential batches
+
+    enumError err = ERR_OK;
+    u32 bl = 0, dest = dd->first;
+    while ( bl < N_BL && !err )
+    {
+	// collect up to 'buf_blocks' blocks and merge contiguous sources
+
+	u32 n = 0, src = 0, src_n = 0;
+	for ( ; bl < N_BL && n < buf_blocks; bl++ )
+	{
+	    const u32 wlba = ntohs(info->wlba_table[bl]);
+	    if (!wlba)
+		continue;
+
+	    if ( src_n && wlba != src + src_n )
+	    {
+		err = ReadAtF(f,(off_t)BL_SIZE*src,buf+(size_t)(n-src_n)*BL_SIZE,
+				(size_t)BL_SIZE*src_n);
+		if (err)
+		    break;
+		src_n = 0;
+	    }
+	    if (!src_n)
+		src = wlba;
+	    src_n++;
+	    n++;
+	}
+
+	if ( !err && src_n )
+	    err = ReadAtF(f,(off_t)BL_SIZE*src,buf+(size_t)(n-src_n)*BL_SIZE,
+				(size_t)BL_SIZE*src_n);
+	if ( !err && n )
+	{
+	    err = WriteAtF(f,(off_t)BL_SIZE*dest,buf,(size_t)BL_SIZE*n);
+	    dest += n;
+	}
+
+	if ( !err && SIGINT_level > 1 )
+	    err = ERR_INTERRUPT;
+    }
+
+    if (!err)
+	err = SyncF(f); // the copy must be stable before the inode is updated
+
+    if (err)
+    {
+	for ( i = 0; i < dd->n_blocks; i++ )
+	    wbfs_free_block(p,dd->first+i);
+	wbfs_sync(p);
+	wbfs_close_disc(d);
+	return err;
+    }
+    DASSERT( dest == dd->first + dd->n_blocks );
+
+    //--- update the inode by a single write
+
+    dest = dd->first;
+    for ( bl = 0; bl < N_BL; bl++ )
+	if (info->wlba_table[bl])
+	    info->wlba_table[bl] = htons(dest++);
+    d->n_fragments = 0;
+
+    if (wbfs_sync_disc_header(d))
+    {
+	// the old inode may be still valid => don't release any block
+	wbfs_close_disc(d);
+	return ERROR0(ERR_WRITE_FAILED,
+		"Can't write inode of WBFS slot #%u: %s\n",
+		dd->slot, f->fname );
+    }
+    wbfs_close_disc(d);
+
+    // the new inode must be stable before the old blocks are reused
+    if (SyncF(f))
+	return ERR_WRITE_FAILED;
+
+    //--- release the old blocks
+
+    for ( bl = 0; bl < N_BL; bl++ )
+    {
+	const u32 wlba = ntohs(dd->wlba_tab[bl]);
+	if (wlba)
+	    wbfs_free_block(p,wlba);
+    }
+    wbfs_sync(p);
+
+    noPRINT("DEFRAG SLOT %u: %u blocks, %u fragments -> %u\n",
+		dd->slot, dd->n_blocks, dd->n_frag, dd->first );
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError DefragWBFS ( WBFS_t * w, DefragWBFS_t * df, bool testmode )
+{
+    // move fragmented discs into contiguous free areas.
+    // In testmode, only the moves are planned and counted.
+
+    ASSERT(w);
+    ASSERT(df);
+    memset(df,0,sizeof(*df));
+
+    if ( !w->wbfs || !w->sf )
+	return ERROR0(ERR_INTERNAL,0);
+
+    enumError err = CloseWDisc(w);
+    if (err)
+	return err;
+
+    wbfs_t * p = w->wbfs;
+    const u32 N_SEC   = p->n_wbfs_sec;
+    const u32 N_BL    = p->n_wbfs_sec_per_disc;
+    const u32 BL_SIZE = p->wbfs_sec_sz;
+
+    //--- collect the fragmented discs
+
+    DefragDisc_t * list = CALLOC(p->max_disc+1,sizeof(*list));
+    u32 slot, n_list = 0;
+
+    for ( slot = 0; slot < p->max_disc; slot++ )
+    {
+	wbfs_disc_t * d = wbfs_open_disc_by_slot(p,slot,0);
+	if (!d)
+	    continue;
+
+	df->n_disc++;
+	const wbfs_disc_info_t * info = d->header;
+	const u32 n_frag = wbfs_get_disc_fragments(d,0);
+	df->frag_before += n_frag;
+	if ( n_frag > 1 )
+	    df->frag_discs++;
+
+	u32 bl, n_blocks = 0;
+	bool movable = d->is_valid;
+	for ( bl = 0; bl < N_BL && movable; bl++ )
+	{
+	    const u32 wlba = ntohs(info->wlba_table[bl]);
+	    if (wlba)
+	    {
+		n_blocks++;
+		movable = wlba < N_SEC && p->used_block[wlba] == 1;
+	    }
+	}
+
+	if ( n_frag > 1 && movable )
+	{
+	    DefragDisc_t * dd = list + n_list++;
+	    dd->slot	 = slot;
+	    dd->n_blocks = n_blocks;
+	    dd->n_frag	 = n_frag;
+	    dd->wlba_tab = MEMDUP(info->wlba_table,N_BL*sizeof(*dd->wlba_tab));
+	}
+	else
+	{
+	    df->frag_after += n_frag;
+	    if ( n_frag > 1 )
+		df->skipped_discs++;
+	}
+	wbfs_close_disc(d);
+    }
+
+    //--- plan the moves
+
+    u8 * used = MEMDUP(p->used_block,N_SEC);
+    u32 * order = CALLOC(n_list+1,sizeof(*order));
+    u32 i, n_order = 0;
+    bool progress = true;
+
+    while (progress)
+    {
+	progress = false;
+	for ( i = 0; i < n_list; i++ )
+	{
+	    DefragDisc_t * dd = list + i;
+	    if (dd->first)
+		continue;
+
+	    dd->first = find_defrag_area(used,N_SEC,dd->n_blocks);
+	    if (!dd->first)
+		continue;
+
+	    memset(used+dd->first,1,dd->n_blocks);
+	    u32 bl;
+	    for ( bl = 0; bl < N_BL; bl++ )
+		used[ntohs(dd->wlba_tab[bl])] = 0;
+	    used[0] = 1;
+
+	    order[n_order++] = i;
+	    progress = true;
+	}
+    }
+
+    for ( i = 0; i < n_list; i++ )
+    {
+	const DefragDisc_t * dd = list + i;
+	if (dd->first)
+	{
+	    df->frag_after++;
+	    df->moved_discs++;
+	    df->moved_blocks += dd->n_blocks;
+	}
+	else
+	{
+	    df->frag_after += dd->n_frag;
+	    df->skipped_discs++;
+	}
+    }
+
+    //--- execute the moves in the planned order
+
+    if ( !testmode && n_order )
+    {
+	u32 buf_blocks = DEFRAG_BUF_SIZE / BL_SIZE;
+	if (!buf_blocks)
+	    buf_blocks = 1;
+	u8 * buf = MALLOC((size_t)buf_blocks*BL_SIZE);
+
+	for ( i = 0; i < n_order && !err && !SIGINT_level; i++ )
+	    err = move_defrag_disc(w,list+order[i],buf,buf_blocks);
+
+	FREE(buf);
+	CalcWBFSUsage(w);
+    }
+
+    for ( i = 0; i < n_list; i++ )
+	FREE(list[i].wlba_tab);
+    FREE(order);
+    FREE(used);
+    FREE(list);
+    return err;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			   WDiscInfo_t			///////////////
+///////////////////////////////////////////////////////////////////////////////
+// is WDiscInfo_t obsolete? [wiidisc] [[obsolete]]
+
+void InitializeWDiscInfo ( WDiscInfo_t * dinfo )
+{
+    memset(dinfo,0,sizeof(*dinfo));
+    dinfo->slot = -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError ResetWDiscInfo ( WDiscInfo_t * dinfo )
+{
+    // nothing to do
+
+    InitializeWDiscInfo(dinfo);
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError GetWDiscInfo ( WBFS_t * w, WDiscInfo_t * dinfo, int disc_index )
+{
+    ASSERT(w);
+    if ( !w || !w->wbfs || !dinfo )
+	return ERROR0(ERR_INTERNAL,0);
+
+    w->disc_slot = -1;
+
+    u32 slot, size4;
+    const enumError err = wbfs_get_disc_info ( w->wbfs, disc_index,
+			    (u8*)&dinfo->dhead, sizeof(dinfo->dhead), &slot,
+			    &dinfo->disc_type, &dinfo->disc_attrib,
+			    &size4, &dinfo->wbfs_fragments );
+
+    if (err)
+    {
+	memset(dinfo,0,sizeof(*dinfo));
+	return err;
+    }
+
+    CalcWDiscInfo(dinfo,0);
+    dinfo->disc_index	= disc_index;
+    dinfo->slot		= slot;
+    dinfo->size		= (u64)size4 * 4;
+    dinfo->used_blocks	= dinfo->size / WII_SECTOR_SIZE; // [[2do]] not exact
+
+    return dinfo->disc_type == WD_DT_UNKNOWN ? ERR_WARNING : ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError GetWDiscInfoBySlot ( WBFS_t * w, WDiscInfo_t * dinfo, u32 disc_slot )
+{
+    ASSERT(w);
+    if ( !w || !w->wbfs || !dinfo )
+	return ERROR0(ERR_INTERNAL,0);
+
+    w->disc_slot = -1;
+
+    memset(dinfo,0,sizeof(*dinfo));
+
+    u32 size4;
+    const enumError err = wbfs_get_disc_info_by_slot ( w->wbfs, disc_slot,
+			    (u8*)&dinfo->dhead, sizeof(dinfo->dhead),
+			    &dinfo->disc_type, &dinfo->disc_attrib,
+			    &size4, &dinfo->wbfs_fragments );
+
+    if (err)
+    {
+	TRACE("GetWDiscInfoBySlot() err=%d, magic=%x\n",err,dinfo->dhead.wii_magic);
+	return err;
+    }
+
+    CalcWDiscInfo(dinfo,0);
+    dinfo->disc_index	= disc_slot;
+    dinfo->slot		= disc_slot;
+    dinfo->size		= (u64)size4 * 4;
+    dinfo->used_blocks	= dinfo->size / WII_SECTOR_SIZE; // [[2do]] not exact
+
+    w->disc_slot = disc_slot;
+    return dinfo->disc_type == WD_DT_UNKNOWN ? ERR_WARNING : ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError FindWDiscInfo ( WBFS_t * w, WDiscInfo_t * dinfo, ccp id6 )
+{
+    // [[2do]] the wbfs subsystem can find ids!
+
+    ASSERT(w);
+    ASSERT(dinfo);
+    ASSERT(id6);
+    if ( !w || !w->wbfs || !dinfo || !id6 )
+	return ERROR0(ERR_INTERNAL,0);
+
+    w->disc_slot = -1;
+
+    int i;
+    for ( i = 0; i < w->used_discs; i++ )
+    {
+	if ( GetWDiscInfo(w,dinfo,i) == ERR_OK
+	    && !memcmp(id6,&dinfo->dhead.disc_id,6) )
+		return ERR_OK;
+    }
+    return ERR_WDISC_NOT_FOUND;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError LoadIsoHeader	( WBFS_t * w, wd_header_t * iso_header, wbfs_disc_t * disc )
+{
+    ASSERT(w);
+    ASSERT(iso_header);
+
+    if ( !w || !w->sf || !w->wbfs || !iso_header )
+	return ERROR0(ERR_INTERNAL,0);
+
+    memset(iso_header,0,sizeof(*iso_header));
+    if (!disc)
+    {
+	disc = w->disc;
+	if (!disc)
+	    return ERR_OK;
+    }
+
+    u16 wlba = ntohs(disc->header->wlba_table[0]);
+    if (!wlba)
+	return ERR_OK;
+
+    char buf[HD_SECTOR_SIZE]; // read whole hd sector
+    enumError err = ReadSF(w->sf, wlba * (off_t)w->wbfs->wbfs_sec_sz,
+			buf, sizeof(buf) );
+    if (!err)
+	memcpy(iso_header,buf,sizeof(*iso_header));
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CalcWDiscInfo ( WDiscInfo_t * dinfo, SuperFile_t * sf )
+{
+    ASSERT(dinfo);
+
+    if (sf)
+    {
+	const wd_disc_t * disc = OpenDiscSF(sf,false,false);
+	if (disc)
+	{
+	    memcpy(&dinfo->dhead,&disc->dhead,sizeof(dinfo->dhead));
+	    dinfo->magic2	= disc->magic2;
+	    dinfo->n_part	= disc->n_part;
+	    dinfo->used_blocks	= CountUsedIsoBlocksSF(sf,&part_selector);
+
+	    static char mask[] = "DUC?";
+	    strcpy(dinfo->part_info,"----");
+	    int ip;
+	    for ( ip = 0; ip < disc->n_part; ip++ )
+	    {
+		u32 pt = disc->part[ip].part_type;
+		if ( pt > sizeof(mask)-2 )
+		     pt = sizeof(mask)-2;
+		dinfo->part_info[pt] = mask[pt];
+	    }
+	}
+	else
+	    ReadSF(sf,0,&dinfo->dhead,sizeof(dinfo->dhead));
+    }
+
+    memcpy(dinfo->id6,&dinfo->dhead.disc_id,6);
+    dinfo->id6[6]	= 0;
+    dinfo->used_blocks	= 0;
+    dinfo->disc_index	= 0;
+    dinfo->size		= 0;
+    dinfo->title	= GetTitle(dinfo->id6,0);
+    dinfo->disc_type	= get_header_disc_type(&dinfo->dhead,&dinfo->disc_attrib);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CopyWDiscInfo ( WDiscListItem_t * item, WDiscInfo_t * dinfo )
+{
+    ASSERT(item);
+    ASSERT(dinfo);
+
+    memset(item,0,sizeof(*item));
+
+    memcpy(item->id6,&dinfo->dhead.disc_id,6);
+    item->size_mib = (u32)(( dinfo->size + MiB/2 ) / MiB );
+    memcpy(item->name64,dinfo->dhead.disc_title,64);
+    memcpy(item->part_info,dinfo->part_info,sizeof(item->part_info));
+    item->title		= dinfo->title;
+    item->n_part	= dinfo->n_part;
+    item->wbfs_slot	= dinfo->disc_index;
+    item->wbfs_fragments= dinfo->wbfs_fragments;
+    item->ftype		= FT_ID_WBFS | FT_A_WDISC;
+    item->used_blocks	= dinfo->used_blocks;
+
+    CopyFileAttribDiscInfo(&item->fatt,dinfo);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void DumpTimestamp ( FILE * f, int indent, ccp head, u64 xtime, ccp comment )
+{
+    time_t tim = ntoh64(xtime);
+    if (tim)
+    {
+	struct tm * tm = localtime(&tim);
+	char timbuf[40];
+	strftime(timbuf,sizeof(timbuf),"%F %T",tm);
+	fprintf(f,"%*s%-12s%s  (%s)\n", indent, "", head, timbuf, comment );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+enumError DumpWDiscInfo
+	( WDiscInfo_t * di, wd_header_t * ih, FILE * f, int indent )
+{
+    if ( !di || !f )
+	return ERROR0(ERR_INTERNAL,0);
+
+    indent = NormalizeIndent(indent);
+
+    const u32 magic = ntohl(di->dhead.wii_magic);
+    fprintf(f,"%*smagic:      %08x, %.64s\n", indent, "", magic,
+		magic == WII_MAGIC ? " (=WII-DISC)"
+			: magic == WII_MAGIC_DELETED ? " (=DELETED)" : "" );
+
+    fprintf(f,"%*swbfs name:  %6s, %.64s\n",
+		indent, "", &di->dhead.disc_id, di->dhead.disc_title );
+    if (ih)
+	fprintf(f,"%*siso name:   %6s, %.64s\n",
 		indent, "", &ih->disc_id, ih->disc_title );
     if ( ih && strcmp(&di->dhead.disc_id,&ih->disc_id) )
     {
@@ -3629,7 +4367,7 @@ void ResetWDiscList ( WDiscList_t * wlist )
 
 ///////////////////////////////////////////////////////////////////////////////
 
-WDiscListItem_t * AppendWDiscList ( WDiscList_t * wlist, WDiscInfo_t * dinfo )
+static WDiscListItem_t * GrowWDiscList ( WDiscList_t * wlist )
 {
     ASSERT(wlist);
     ASSERT( wlist->used <= wlist->size );
@@ -3640,13 +4378,35 @@ WDiscListItem_t * AppendWDiscList ( WDiscList_t * wlist, WDiscInfo_t * dinfo )
 				wlist->size*sizeof(*wlist->first_disc));
     }
     wlist->sort_mode = SORT_NONE;
-    WDiscListItem_t * item = wlist->first_disc + wlist->used++;
+    return wlist->first_disc + wlist->used++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+WDiscListItem_t * AppendWDiscList ( WDiscList_t * wlist, WDiscInfo_t * dinfo )
+{
+    WDiscListItem_t * item = GrowWDiscList(wlist);
     CopyWDiscInfo(item,dinfo);
     return item;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+WDiscListItem_t * AppendWDiscListItem
+	( WDiscList_t * wlist, const WDiscListItem_t * src )
+{
+    // 'fname' is not copied and 'title' is searched again
+
+    ASSERT(src);
+    WDiscListItem_t * item = GrowWDiscList(wlist);
+    memcpy(item,src,sizeof(*item));
+    item->fname = 0;
+    item->title = GetTitle(item->id6,0);
+    return item;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void FreeWDiscList ( WDiscList_t * wlist )
 {
     ASSERT(wlist);
@@ -3964,76 +4724,521 @@ void SortWDiscList ( WDiscList_t * wlist,
 	wlist->used = dest - wlist->first_disc;
     }
 
-    if ( func && wlist->sort_mode != sort_mode )
+    if ( func && wlist->sort_mode != sort_mode )
+    {
+	wlist->sort_mode = sort_mode;
+	qsort(wlist->first_disc,wlist->used,sizeof(*wlist->first_disc),func);
+	if ( sort_mode & SORT_REVERSE )
+	    ReverseWDiscList(wlist);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void print_sect_time ( FILE *f, char name, time_t tim )
+{
+    ASSERT(f);
+    if (tim)
+    {
+	struct tm * tm = localtime(&tim);
+	char timbuf[40];
+	strftime(timbuf,sizeof(timbuf),"%F %T",tm);
+	fprintf(f,"%ctime=%llu %s\n", name, (u64)tim, timbuf );
+    }
+    else
+	fprintf(f,"%ctime=\n",name);
+}
+
+//-----------------------------------------------------------------------------
+
+void PrintSectWDiscListItem ( FILE * f, WDiscListItem_t * witem, ccp def_fname )
+{
+    ASSERT(f);
+    ASSERT(witem);
+
+    fprintf(f,"id=%s\n",witem->id6);
+    fprintf(f,"name=%s\n",witem->name64);
+    fprintf(f,"title=%s\n", witem->title ? witem->title : "" );
+    fprintf(f,"region=%s\n",GetRegionInfo(witem->id6[3])->name4);
+    fprintf(f,"size=%llu\n",(u64)witem->fatt.size
+				? (u64)witem->fatt.size : (u64)witem->size_mib*MiB );
+    //fprintf(f,"size_mib=%u\n",witem->size_mib);
+    if (witem->used_blocks)
+	fprintf(f,"used-blocks=%u\n",witem->used_blocks);
+
+    print_sect_time(f,'i',witem->fatt.itime);
+    print_sect_time(f,'m',witem->fatt.mtime);
+    print_sect_time(f,'c',witem->fatt.ctime);
+    print_sect_time(f,'a',witem->fatt.atime);
+    //fprintf(f,"part_index=%u\n",witem->part_index);
+    //fprintf(f,"n_part=%u\n",witem->n_part);
+
+    fprintf(f,"filetype=%s\n",GetNameFT(witem->ftype,0));
+    fprintf(f,"container=%s\n",GetContainerNameFT(witem->ftype,"-"));
+    const wd_disc_type_t dt = FileType2DiscType(witem->ftype);
+    fprintf(f,"disctype=%d %s\n",dt,wd_get_disc_type_name(dt,"?"));
+
+    if ( witem->n_part > 0 || *witem->part_info )
+    {
+	fprintf(f,"n-partitions=%d\n",witem->n_part);
+	fprintf(f,"partition-info=%s\n",witem->part_info);
+    }
+
+    fprintf(f,"wbfs_slot=%d\n",witem->wbfs_slot);
+    if (witem->wbfs_fragments)
+	fprintf(f,"wbfs-fragments=%u\n",witem->wbfs_fragments);
+
+    ccp fname = witem->fname ? witem->fname : def_fname ? def_fname : "";
+    fprintf(f,"filename=%s\n",fname);
+    if ( *fname && witem->wbfs_slot >= 0 )
+	fprintf(f,"source=%s/#%u\n",fname,witem->wbfs_slot);
+    else
+	fprintf(f,"source=%s\n",fname);
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////                 disc info cache                 ///////////////
+///////////////////////////////////////////////////////////////////////////////
+// The disc info cache stores the list items of scanned source files.
+// An entry is identified by the real path of the file and is only valid
+// if device, inode, size and mtime are unchanged. WBFS files are stored
+// as one entry with all discs.
+
+#define DISC_CACHE_MAGIC	"WIT-DC\0\n"
+#define DISC_CACHE_VERSION	1
+
+typedef struct DiscCacheHead_t
+{
+    char		magic[8];	// DISC_CACHE_MAGIC
+    u32			version;	// DISC_CACHE_VERSION
+    u32			item_size;	// sizeof(DiscCacheItem_t)
+    u32			n_entry;	// number of entries
+    u32			unused;		// always NULL
+
+} DiscCacheHead_t;
+
+//-----------------------------------------------------------------------------
+// Each entry is followed by the path (without NULL) and 'n_item' items.
+
+typedef struct DiscCacheFileEntry_t
+{
+    u64			dev;		// device of the source file
+    u64			ino;		// inode of the source file
+    u64			size;		// size of the source file
+    u64			mtime_sec;	// mtime of the source file, seconds
+    u32			mtime_nsec;	// mtime of the source file, nanoseconds
+    u32			path_len;	// length of the path
+    u32			n_item;		// number of items
+    u32			unused;		// always NULL
+
+} DiscCacheFileEntry_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void ResetDiscCacheEntry ( DiscCacheEntry_t * e )
+{
+    DASSERT(e);
+    FreeString(e->path);
+    FREE(e->item);
+    memset(e,0,sizeof(*e));
+}
+
+//-----------------------------------------------------------------------------
+
+static void SetDiscCacheKey ( DiscCacheEntry_t * e, const struct stat * st )
+{
+    DASSERT(e);
+    DASSERT(st);
+    e->dev		= st->st_dev;
+    e->ino		= st->st_ino;
+    e->size		= st->st_size;
+    e->mtime_sec	= st->st_mtim.tv_sec;
+    e->mtime_nsec	= st->st_mtim.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+
+static bool IsDiscCacheKey ( const DiscCacheEntry_t * e, const struct stat * st )
+{
+    DASSERT(e);
+    DASSERT(st);
+    return e->dev		== st->st_dev
+	&& e->ino		== st->st_ino
+	&& e->size		== st->st_size
+	&& e->mtime_sec		== st->st_mtim.tv_sec
+	&& e->mtime_nsec	== st->st_mtim.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+
+static DiscCacheEntry_t * GetDiscCacheEntry ( DiscCache_t * dc, ccp path )
+{
+    // return the entry for 'path' and create it if necessary
+
+    DASSERT(dc);
+    DASSERT(path);
+
+    ParamFieldItem_t * pi = FindParamField(&dc->index,path);
+    if (pi)
+    {
+	DASSERT( pi->num < dc->used );
+	DiscCacheEntry_t * e = dc->list + pi->num;
+	ResetDiscCacheEntry(e);
+	return e;
+    }
+
+    if ( dc->used == dc->size )
+    {
+	dc->size = 2 * dc->size + 100;
+	dc->list = REALLOC(dc->list,dc->size*sizeof(*dc->list));
+    }
+    InsertParamField(&dc->index,path,dc->used);
+    DiscCacheEntry_t * e = dc->list + dc->used++;
+    memset(e,0,sizeof(*e));
+    return e;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InitializeDiscCache ( DiscCache_t * dc )
+{
+    DASSERT(dc);
+    memset(dc,0,sizeof(*dc));
+    InitializeParamField(&dc->index,PFT_NONE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResetDiscCache ( DiscCache_t * dc )
+{
+    DASSERT(dc);
+
+    uint i;
+    for ( i = 0; i < dc->used; i++ )
+	ResetDiscCacheEntry(dc->list+i);
+    FREE(dc->list);
+    ResetDiscCacheEntry(&dc->pend);
+    ResetParamField(&dc->index);
+    FreeString(dc->fname);
+    InitializeDiscCache(dc);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool LoadDiscCache ( DiscCache_t * dc )
+{
+    // Setup the filename and load the cache file.
+    // Return false, if the cache is disabled.
+
+    DASSERT(dc);
+    ResetDiscCache(dc);
+
+    char path[PATH_MAX];
+    if (!GetCachePath(path,sizeof(path),"WIT_DISC_CACHE","discs.cache"))
+	return false;
+    dc->fname = STRDUP(path);
+
+    FILE * f = fopen(path,"rb");
+    if (!f)
+	return true;
+
+    struct stat st;
+    u8 * data = 0;
+    size_t size = 0;
+    if ( !fstat(fileno(f),&st)
+	&& S_ISREG(st.st_mode)
+	&& st.st_size >= sizeof(DiscCacheHead_t)
+	&& st.st_size == (size_t)st.st_size )
+    {
+	size = st.st_size;
+	data = MALLOC(size);
+	if ( fread(data,1,size,f) != size )
+	    size = 0;
+    }
+    fclose(f);
+
+    const DiscCacheHead_t * head = (DiscCacheHead_t*)data;
+    if (   size < sizeof(*head)
+	|| memcmp(head->magic,DISC_CACHE_MAGIC,sizeof(head->magic))
+	|| head->version != DISC_CACHE_VERSION
+	|| head->item_size != sizeof(DiscCacheItem_t) )
+    {
+	TRACE("#DC# invalid or outdated disc cache: %s\n",path);
+	FREE(data);
+	return true;
+    }
+
+    const u8 * ptr = data + sizeof(*head);
+    const u8 * end = data + size;
+    uint i;
+    for ( i = 0; i < head->n_entry; i++ )
+    {
+	DiscCacheFileEntry_t fe;
+	if ( end - ptr < sizeof(fe) )
+	    break;
+	memcpy(&fe,ptr,sizeof(fe));
+	ptr += sizeof(fe);
+
+	const u64 isize = (u64)fe.n_item * sizeof(DiscCacheItem_t);
+	if ( !fe.path_len || fe.path_len >= PATH_MAX || end - ptr < fe.path_len + isize )
+	    break;
+
+	char epath[PATH_MAX];
+	memcpy(epath,ptr,fe.path_len);
+	epath[fe.path_len] = 0;
+	ptr += fe.path_len;
+
+	DiscCacheEntry_t * e = GetDiscCacheEntry(dc,epath);
+	e->path		= STRDUP(epath);
+	e->dev		= fe.dev;
+	e->ino		= fe.ino;
+	e->size		= fe.size;
+	e->mtime_sec	= fe.mtime_sec;
+	e->mtime_nsec	= fe.mtime_nsec;
+	e->valid	= true;
+	e->n_item	= e->item_size = fe.n_item;
+	e->item		= MALLOC( isize + 1 );
+	memcpy(e->item,ptr,isize);
+	ptr += isize;
+    }
+
+    TRACE("#DC# %u entries loaded: %s\n",dc->used,path);
+    FREE(data);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SaveDiscCache ( DiscCache_t * dc )
+{
+    // Write the cache file, if modified. Entries found outdated by
+    // FindDiscCache() or removed by RemoveDiscCache() are dropped. Files
+    // not scanned in this run are kept. Errors are ignored silently.
+
+    DASSERT(dc);
+    DASSERT(!dc->pending);
+    if ( !dc->dirty || !dc->fname )
+	return;
+    dc->dirty = false;
+
+    CreateCacheDir(dc->fname);
+
+    // write a temporary file first and rename it to be atomic
+    char temp[PATH_MAX+30];
+    snprintf(temp,sizeof(temp),"%s.%u.tmp",dc->fname,getpid());
+    FILE * f = fopen(temp,"wb");
+    if (!f)
+	return;
+
+    DiscCacheHead_t head;
+    memset(&head,0,sizeof(head));
+    memcpy(head.magic,DISC_CACHE_MAGIC,sizeof(head.magic));
+    head.version   = DISC_CACHE_VERSION;
+    head.item_size = sizeof(DiscCacheItem_t);
+    fwrite(&head,sizeof(head),1,f);
+
+    uint i;
+    for ( i = 0; i < dc->used; i++ )
+    {
+	const DiscCacheEntry_t * e = dc->list + i;
+	if (!e->valid)
+	    continue;
+
+	DiscCacheFileEntry_t fe;
+	memset(&fe,0,sizeof(fe));
+	fe.dev		= e->dev;
+	fe.ino		= e->ino;
+	fe.size		= e->size;
+	fe.mtime_sec	= e->mtime_sec;
+	fe.mtime_nsec	= e->mtime_nsec;
+	fe.path_len	= strlen(e->path);
+	fe.n_item	= e->n_item;
+	fwrite(&fe,sizeof(fe),1,f);
+	fwrite(e->path,fe.path_len,1,f);
+	fwrite(e->item,sizeof(*e->item),e->n_item,f);
+	head.n_entry++;
+    }
+
+    rewind(f);
+    fwrite(&head,sizeof(head),1,f);
+
+    const bool failed = ferror(f) != 0;
+    if ( fclose(f) || failed || rename(temp,dc->fname) )
+	unlink(temp);
+    else
+	TRACE("#DC# %u entries written: %s\n",head.n_entry,dc->fname);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint RemoveDiscCache
+(
+    // Invalidate the entry of 'real_path' and all entries below it.
+    // Returns the number of removed entries.
+
+    DiscCache_t		* dc,		// valid disc cache
+    ccp			real_path	// real path of a file or directory
+)
+{
+    DASSERT(dc);
+    DASSERT(real_path);
+
+    uint len = strlen(real_path);
+    while ( len > 1 && real_path[len-1] == '/' )
+	len--;
+
+    uint i, count = 0;
+    for ( i = 0; i < dc->used; i++ )
     {
-	wlist->sort_mode = sort_mode;
-	qsort(wlist->first_disc,wlist->used,sizeof(*wlist->first_disc),func);
-	if ( sort_mode & SORT_REVERSE )
-	    ReverseWDiscList(wlist);
+	DiscCacheEntry_t * e = dc->list + i;
+	if ( e->valid
+	    && !memcmp(e->path,real_path,len)
+	    && ( !e->path[len] || e->path[len] == '/' || len == 1 ) )
+	{
+	    e->valid = false;
+	    dc->dirty = true;
+	    count++;
+	}
     }
+    return count;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static void print_sect_time ( FILE *f, char name, time_t tim )
+const DiscCacheEntry_t * FindDiscCache
+(
+    // Return the valid entry of 'real_path' or NULL.
+    // An outdated entry is invalidated and dropped by SaveDiscCache().
+
+    DiscCache_t		* dc,		// valid disc cache
+    ccp			real_path,	// real path of the source file
+    const struct stat	* st		// status of the source file
+)
 {
-    ASSERT(f);
-    if (tim)
+    DASSERT(dc);
+    DASSERT(real_path);
+    DASSERT(st);
+
+    const ParamFieldItem_t * pi = FindParamField(&dc->index,real_path);
+    if (pi)
     {
-	struct tm * tm = localtime(&tim);
-	char timbuf[40];
-	strftime(timbuf,sizeof(timbuf),"%F %T",tm);
-	fprintf(f,"%ctime=%llu %s\n", name, (u64)tim, timbuf );
+	DASSERT( pi->num < dc->used );
+	DiscCacheEntry_t * e = dc->list + pi->num;
+	if (e->valid)
+	{
+	    if (IsDiscCacheKey(e,st))
+		return e;
+	    e->valid = false;
+	    dc->dirty = true;
+	}
     }
-    else
-	fprintf(f,"%ctime=\n",name);
+    return 0;
 }
 
-//-----------------------------------------------------------------------------
+///////////////////////////////////////////////////////////////////////////////
 
-void PrintSectWDiscListItem ( FILE * f, WDiscListItem_t * witem, ccp def_fname )
+void BeginDiscCache
+(
+    // Start recording of the discs of a source file, that was not found.
+
+    DiscCache_t		* dc,		// valid disc cache
+    ccp			path,		// the source path as given by the user
+    ccp			real_path,	// real path of the source file
+    const struct stat	* st		// status of the source file
+)
 {
-    ASSERT(f);
-    ASSERT(witem);
+    DASSERT(dc);
+    DASSERT(!dc->pending);
+    DASSERT(path);
+    DASSERT(real_path);
+    DASSERT(st);
+
+    ResetDiscCacheEntry(&dc->pend);
+    dc->pend.path	= STRDUP(real_path);
+    SetDiscCacheKey(&dc->pend,st);
+    dc->pend_arg	= path;
+    dc->pend_expected	= 1;
+    dc->pend_failed	= false;
+    dc->pending		= true;
+}
 
-    fprintf(f,"id=%s\n",witem->id6);
-    fprintf(f,"name=%s\n",witem->name64);
-    fprintf(f,"title=%s\n", witem->title ? witem->title : "" );
-    fprintf(f,"region=%s\n",GetRegionInfo(witem->id6[3])->name4);
-    fprintf(f,"size=%llu\n",(u64)witem->fatt.size
-				? (u64)witem->fatt.size : (u64)witem->size_mib*MiB );
-    //fprintf(f,"size_mib=%u\n",witem->size_mib);
-    if (witem->used_blocks)
-	fprintf(f,"used-blocks=%u\n",witem->used_blocks);
+///////////////////////////////////////////////////////////////////////////////
 
-    print_sect_time(f,'i',witem->fatt.itime);
-    print_sect_time(f,'m',witem->fatt.mtime);
-    print_sect_time(f,'c',witem->fatt.ctime);
-    print_sect_time(f,'a',witem->fatt.atime);
-    //fprintf(f,"part_index=%u\n",witem->part_index);
-    //fprintf(f,"n_part=%u\n",witem->n_part);
+void InsertDiscCache
+(
+    // Record a disc of the pending source file.
 
-    fprintf(f,"filetype=%s\n",GetNameFT(witem->ftype,0));
-    fprintf(f,"container=%s\n",GetContainerNameFT(witem->ftype,"-"));
-    const wd_disc_type_t dt = FileType2DiscType(witem->ftype);
-    fprintf(f,"disctype=%d %s\n",dt,wd_get_disc_type_name(dt,"?"));
+    DiscCache_t		* dc,		// valid disc cache
+    const WDiscListItem_t * item,	// the list item; 'fname' is ignored
+    const SuperFile_t	* sf,		// the source of 'item'
+    ccp			real_path	// real path of 'sf' incl. selector
+)
+{
+    DASSERT(dc);
+    DASSERT(item);
+    DASSERT(sf);
 
-    if ( witem->n_part > 0 || *witem->part_info )
+    if ( !dc->pending || dc->pend_failed )
+	return;
+
+    // the names must be reproducible by appending a short suffix
+
+    DiscCacheEntry_t * e = &dc->pend;
+    const uint alen = strlen(dc->pend_arg);
+    const uint rlen = strlen(e->path);
+    ccp fname = sf->f.fname ? sf->f.fname : "";
+    ccp path  = sf->f.path;
+
+    if (   sf->f.split_used > 1
+	|| strncmp(fname,dc->pend_arg,alen)
+	|| strlen(fname+alen) >= sizeof(e->item->fname_suffix)
+	|| path && *path && strcmp(path,dc->pend_arg)
+	|| !real_path
+	|| strncmp(real_path,e->path,rlen)
+	|| strlen(real_path+rlen) >= sizeof(e->item->rpath_suffix) )
     {
-	fprintf(f,"n-partitions=%d\n",witem->n_part);
-	fprintf(f,"partition-info=%s\n",witem->part_info);
+	dc->pend_failed = true;
+	return;
     }
 
-    fprintf(f,"wbfs_slot=%d\n",witem->wbfs_slot);
-    if (witem->wbfs_fragments)
-	fprintf(f,"wbfs-fragments=%u\n",witem->wbfs_fragments);
+    if ( e->n_item == e->item_size )
+    {
+	e->item_size = 2 * e->item_size + 1;
+	e->item = REALLOC(e->item,e->item_size*sizeof(*e->item));
+    }
+    DiscCacheItem_t * ci = e->item + e->n_item++;
+    memset(ci,0,sizeof(*ci));
+    memcpy(&ci->item,item,sizeof(ci->item));
+    ci->item.title = 0;
+    ci->item.fname = 0;
+    StringCopyS(ci->fname_suffix,sizeof(ci->fname_suffix),fname+alen);
+    StringCopyS(ci->rpath_suffix,sizeof(ci->rpath_suffix),real_path+rlen);
+    ci->have_path = path && *path;
+}
 
-    ccp fname = witem->fname ? witem->fname : def_fname ? def_fname : "";
-    fprintf(f,"filename=%s\n",fname);
-    if ( *fname && witem->wbfs_slot >= 0 )
-	fprintf(f,"source=%s/#%u\n",fname,witem->wbfs_slot);
+///////////////////////////////////////////////////////////////////////////////
+
+void EndDiscCache ( DiscCache_t * dc )
+{
+    // Finish the pending source file and store it,
+    // if all expected discs were recorded.
+
+    DASSERT(dc);
+    if (!dc->pending)
+	return;
+    dc->pending = false;
+
+    if ( !dc->pend_failed && dc->pend.n_item == dc->pend_expected )
+    {
+	DiscCacheEntry_t * e = GetDiscCacheEntry(dc,dc->pend.path);
+	memcpy(e,&dc->pend,sizeof(*e));
+	memset(&dc->pend,0,sizeof(dc->pend));
+	e->valid = true;
+	dc->dirty = true;
+    }
     else
-	fprintf(f,"source=%s\n",fname);
+	ResetDiscCacheEntry(&dc->pend);
 }
 
 //
@@ -4207,54 +5412,62 @@ wd_header_t * GetWDiscHeader ( WBFS_t * w )
 }
 
 //
-///////////////////////////////////////////////////////////////////////////////
-///////////////                      AddWDisc()                 ///////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////                      AddWDisc()                 ///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-enumError AddWDisc ( WBFS_t * w, SuperFile_t * sf, const wd_select_t * psel )
+static void setup_add_param
+(
+    wbfs_param_t	* par,		// parameters to initialize
+    SuperFile_t		* sf,		// valid source file
+    const wd_select_t	* psel		// partition selector
+)
 {
-    if ( !w || !w->wbfs || !w->sf || !sf )
-	return ERROR0(ERR_INTERNAL,0);
-
-    TRACE("AddWDisc(w=%p,sf=%p) progress=%d,%d\n",
-		w, sf, sf->show_progress, sf->show_summary );
+    DASSERT(par);
+    DASSERT(sf);
 
-    CloseWDisc(w);
-
-    // this is needed for detailed error messages
-    const enumError saved_max_error = max_error;
-    max_error = 0;
-
-    wbfs_param_t par;
-    memset(&par,0,sizeof(par));
-    par.read_src_wii_disc	= WrapperReadSF; // [[2do]] [[obsolete]]? (both: param and func)
-    par.callback_data		= sf;
-    par.spinner			= sf->show_progress ? PrintProgressSF : 0;
-    par.psel			= psel;
-    par.iinfo.mtime		= hton64(sf->f.fatt.mtime);
-    par.iso_size		= sf->file_size;
-    par.wd_disc			= OpenDiscSF(sf,false,true);
+    memset(par,0,sizeof(*par));
+    par->read_src_wii_disc	= WrapperReadSF; // [[2do]] [[obsolete]]? (both: param and func)
+    par->callback_data		= sf;
+    par->spinner		= sf->show_progress ? PrintProgressSF : 0;
+    par->psel			= psel;
+    par->iinfo.mtime		= hton64(sf->f.fatt.mtime);
+    par->iso_size		= sf->file_size;
+    par->wd_disc		= OpenDiscSF(sf,false,true);
 
-    PRINT("iso_size=%llu\n",par.iso_size);
+    PRINT("iso_size=%llu\n",par->iso_size);
 
     // try to copy mtime from WBFS source disc
     if ( sf->wbfs && sf->wbfs->disc )
     {
 	const wbfs_inode_info_t * iinfo = wbfs_get_disc_inode_info(sf->wbfs->disc,0);
 	if (ntoh64(iinfo->mtime))
-	    par.iinfo.mtime = iinfo->mtime;
+	    par->iinfo.mtime = iinfo->mtime;
     }
 
     if (*sf->wbfs_id6)
-	CopyPatchWbfsId( par.wbfs_id6, sf->wbfs_id6 );
-    else if (par.wd_disc)
-	CopyPatchWbfsId( par.wbfs_id6, &par.wd_disc->dhead.disc_id );
+	CopyPatchWbfsId( par->wbfs_id6, sf->wbfs_id6 );
+    else if (par->wd_disc)
+	CopyPatchWbfsId( par->wbfs_id6, &par->wd_disc->dhead.disc_id );
+}
 
-    const int wbfs_stat = wbfs_add_disc_param(w->wbfs,&par);
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError finish_add
+(
+    WBFS_t		* w,		// valid WBFS descriptor
+    SuperFile_t		* sf,		// valid source file
+    wbfs_param_t	* par,		// valid parameters
+    int			wbfs_stat	// result of the libwbfs functions
+)
+{
+    DASSERT(w);
+    DASSERT(sf);
+    DASSERT(par);
 
     // transfer results
-    w->disc = par.open_disc;
-    w->disc_slot = par.slot;
+    w->disc = par->open_disc;
+    w->disc_slot = par->slot;
 
     enumError err = ERR_OK;
     if (wbfs_stat)
@@ -4271,6 +5484,29 @@ enumError AddWDisc ( WBFS_t * w, SuperFile_t * sf, const wd_select_t * psel )
 		w, w->disc_slot, w->sf, w->sf->iod.oft );
         err = RewriteModifiedSF(sf,0,w,0);
     }
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError AddWDisc ( WBFS_t * w, SuperFile_t * sf, const wd_select_t * psel )
+{
+    if ( !w || !w->wbfs || !w->sf || !sf )
+	return ERROR0(ERR_INTERNAL,0);
+
+    TRACE("AddWDisc(w=%p,sf=%p) progress=%d,%d\n",
+		w, sf, sf->show_progress, sf->show_summary );
+
+    CloseWDisc(w);
+
+    // this is needed for detailed error messages
+    const enumError saved_max_error = max_error;
+    max_error = 0;
+
+    wbfs_param_t par;
+    setup_add_param(&par,sf,psel);
+    const int wbfs_stat = wbfs_add_disc_param(w->wbfs,&par);
+    enumError err = finish_add(w,sf,&par,wbfs_stat);
 
     // catch read/write errors
     err = max_error = max_error > err ? max_error : err;
@@ -4286,6 +5522,253 @@ enumError AddWDisc ( WBFS_t * w, SuperFile_t * sf, const wd_select_t * psel )
     return err;
 }
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////                   AddWDiscQueue_t               ///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static void add_queue_lock ( void * lock_data, bool lock )
+{
+    AddWDiscQueue_t * aq = lock_data;
+    DASSERT(aq);
+
+    if (lock)
+	pthread_mutex_lock(&aq->mutex);
+    else
+	pthread_mutex_unlock(&aq->mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void add_queue_job ( ThreadJob_t * tjob )
+{
+    DASSERT(tjob);
+    AddWDiscJob_t * job = tjob->param;
+    DASSERT(job);
+
+    wbfs_copy_disc(&job->add);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError finish_add_job
+(
+    AddWDiscQueue_t	* aq,		// valid queue, locked by caller
+    AddWDiscJob_t	* job		// valid job
+)
+{
+    DASSERT(aq);
+    DASSERT(job);
+
+    if (!job->active)
+	return ERR_OK;
+
+    // the worker needs the lock to write its blocks
+    add_queue_lock(aq,false);
+    WaitThreadJob(&aq->tpool,&job->tjob);
+    add_queue_lock(aq,true);
+
+    // the worker doesn't print errors => report a read error here
+    if ( job->add.read_status && job->add.read_status != ERR_INTERRUPT )
+	ERROR0( job->add.read_status < ERR_NOT_IMPLEMENTED
+			? job->add.read_status : ERR_READ_FAILED,
+		"Error while reading source disc [%s]: %s\n",
+		job->sf.f.id6_dest, job->sf.f.fname );
+    job->sf.f.disable_errors = false;
+
+    WBFS_t * w = job->wbfs;
+    DASSERT(w);
+    CloseWDisc(w);
+
+    // errors are already reported by finish_add()
+    const int wbfs_stat = wbfs_commit_disc(&job->add);
+    const enumError err = finish_add(w,&job->sf,&job->par,wbfs_stat);
+
+    PrintSummarySF(&job->sf);
+    CalcWBFSUsage(w);
+
+    ResetSF(&job->sf,0);
+    job->wbfs = 0;
+    job->active = false;
+
+    if ( aq->max_err < err )
+	 aq->max_err = err;
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InitializeAddWDiscQueue
+(
+    AddWDiscQueue_t	* aq,		// valid queue, will be initialized
+    uint		n_jobs		// max number of parallel jobs, 0: auto
+)
+{
+    DASSERT(aq);
+    memset(aq,0,sizeof(*aq));
+
+    if (!n_jobs)
+	n_jobs = GetThreadCount();
+
+    pthread_mutex_init(&aq->mutex,0);
+    InitializeThreadPool(&aq->tpool, n_jobs > 1 ? n_jobs : 1 );
+    aq->n_jobs = aq->tpool.n_threads;
+    if ( aq->n_jobs )
+	aq->job = CALLOC(aq->n_jobs,sizeof(*aq->job));
+    PRINT("ADD-QUEUE: %u jobs\n",aq->n_jobs);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError ResetAddWDiscQueue
+(
+    AddWDiscQueue_t	* aq		// valid queue
+)
+{
+    DASSERT(aq);
+
+    add_queue_lock(aq,true);
+    const enumError err = FinishAddWDiscQueue(aq);
+    add_queue_lock(aq,false);
+
+    ResetThreadPool(&aq->tpool);
+    pthread_mutex_destroy(&aq->mutex);
+    FREE(aq->job);
+    memset(aq,0,sizeof(*aq));
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void LockAddWDiscQueue ( AddWDiscQueue_t * aq )
+{
+    DASSERT(aq);
+    if (aq->n_jobs)
+	add_queue_lock(aq,true);
+}
+
+//-----------------------------------------------------------------------------
+
+void UnlockAddWDiscQueue ( AddWDiscQueue_t * aq )
+{
+    DASSERT(aq);
+    if (aq->n_jobs)
+	add_queue_lock(aq,false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError StartAddWDisc
+(
+    AddWDiscQueue_t	* aq,		// valid queue, locked by caller
+    WBFS_t		* w,		// valid WBFS descriptor
+    SuperFile_t		* sf,		// valid and opened source file
+    const wd_select_t	* psel		// partition selector
+)
+{
+    DASSERT(aq);
+    if ( !w || !w->wbfs || !w->sf || !sf )
+	return ERROR0(ERR_INTERNAL,0);
+
+    if (!aq->n_jobs)
+	return AddWDisc(w,sf,psel);
+
+    //----- reuse the oldest job
+
+    // errors of finished jobs are collected in 'aq->max_err'
+    AddWDiscJob_t * job = aq->job + aq->next_job;
+    finish_add_job(aq,job);
+    aq->next_job = ( aq->next_job + 1 ) % aq->n_jobs;
+
+    //----- open a private copy of the source
+
+    // the source file is closed by the caller after returning,
+    // so it is opened again. Opening and closing is done by the main
+    // thread, only the data copying is done by the worker.
+
+    SuperFile_t * jsf = &job->sf;
+    InitializeSF(jsf);
+    jsf->allow_fst = sf->allow_fst;
+    enumError err = OpenSF(jsf,sf->f.fname,true,false);
+    if (err)
+    {
+	ResetSF(jsf,0);
+	return err;
+    }
+    memcpy(jsf->f.id6_dest,sf->f.id6_dest,sizeof(jsf->f.id6_dest));
+    jsf->f.read_behind_eof = sf->f.read_behind_eof;
+    jsf->show_progress = false; // workers don't print
+
+    //----- reserve slot and blocks
+
+    CloseWDisc(w);
+    setup_add_param(&job->par,jsf,psel);
+    job->wbfs   = w;
+    job->active = true;
+
+    if (wbfs_reserve_disc(w->wbfs,&job->par,&job->add))
+    {
+	// release the reservation immediately
+	job->tjob.done = true;
+	return finish_add_job(aq,job);
+    }
+
+    // the worker must not print errors => finish_add_job() reports them
+    jsf->f.disable_errors   = true;
+    job->add.disable_errors = true;
+    job->add.lock_func = add_queue_lock;
+    job->add.lock_data = aq;
+    AddThreadJob(&aq->tpool,&job->tjob,add_queue_job,job);
+    return ERR_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError FinishAddWDiscQueue
+(
+    AddWDiscQueue_t	* aq		// valid queue, locked by caller
+)
+{
+    // wait for all jobs in order of start and commit them
+
+    DASSERT(aq);
+
+    uint i;
+    for ( i = 0; i < aq->n_jobs; i++ )
+	finish_add_job(aq,aq->job+(aq->next_job+i)%aq->n_jobs);
+
+    const enumError err = aq->max_err;
+    aq->max_err = ERR_OK;
+    return err;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FinishAddWDiscID
+(
+    AddWDiscQueue_t	* aq,		// valid queue, locked by caller
+    ccp			id6		// ID of disc to access
+)
+{
+    // finish all jobs, if a running job is adding 'id6',
+    // so that the disc can be opened or removed
+
+    DASSERT(aq);
+    DASSERT(id6);
+
+    uint i;
+    for ( i = 0; i < aq->n_jobs; i++ )
+    {
+	const AddWDiscJob_t * job = aq->job + i;
+	if ( job->active && job->add.info && !memcmp(job->add.info->dhead,id6,6) )
+	{
+	    for ( i = 0; i < aq->n_jobs; i++ )
+		finish_add_job(aq,aq->job+(aq->next_job+i)%aq->n_jobs);
+	    break;
+	}
+    }
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////                    RemoveWDisc()                ///////////////
@@ -424,6 +424,45 @@ bool CalcFBT ( CheckWBFS_t * ck );
 
 //-----------------------------------------------------------------------------
 
+typedef struct DedupWBFS_t
+{
+	u32 n_disc;		// number of scanned discs
+	u32 ref_blocks;		// number of block references of all discs
+	u32 used_blocks;	// number of different referenced blocks
+	u32 shared_blocks;	// number of blocks referenced more than once
+	u32 mod_blocks;		// number of (would be) released or copied blocks
+
+} DedupWBFS_t;
+
+void CountDedupWBFS	( WBFS_t * w, DedupWBFS_t * dd );
+enumError DedupWBFS	( WBFS_t * w, DedupWBFS_t * dd, bool testmode );
+enumError RehydrateWBFS	( WBFS_t * w, DedupWBFS_t * dd, bool testmode );
+
+enumError UnshareBlockWBFS
+(
+    WBFS_t		* w,		// valid WBFS
+    wbfs_disc_t		* disc,		// valid disc of 'w'
+    u32			bl		// block index of the disc
+);
+
+//-----------------------------------------------------------------------------
+
+typedef struct DefragWBFS_t
+{
+	u32 n_disc;		// number of scanned discs
+	u32 frag_discs;		// number of fragmented discs
+	u32 frag_before;	// number of fragments of all discs before
+	u32 frag_after;		// number of (expected) fragments after
+	u32 moved_discs;	// number of (would be) moved discs
+	u32 moved_blocks;	// number of (would be) moved blocks
+	u32 skipped_discs;	// number of fragmented discs, that can't be moved
+
+} DefragWBFS_t;
+
+enumError DefragWBFS	( WBFS_t * w, DefragWBFS_t * df, bool testmode );
+
+//-----------------------------------------------------------------------------
+
 void InitializeWDiscInfo     ( WDiscInfo_t * dinfo );
 enumError ResetWDiscInfo     ( WDiscInfo_t * dinfo );
 enumError GetWDiscInfo	     ( WBFS_t * w, WDiscInfo_t * dinfo, int disc_index );
@@ -445,6 +484,8 @@ void ResetWDiscList ( WDiscList_t * wlist );
 void FreeWDiscList ( WDiscList_t * wlist );
 
 WDiscListItem_t *  AppendWDiscList ( WDiscList_t * wlist, WDiscInfo_t * winfo );
+WDiscListItem_t *  AppendWDiscListItem
+	( WDiscList_t * wlist, const WDiscListItem_t * src );
 void CopyWDiscInfo ( WDiscListItem_t * item, WDiscInfo_t * winfo );
 
 void ReverseWDiscList	( WDiscList_t * wlist );
@@ -455,6 +496,22 @@ void PrintSectWDiscListItem ( FILE * out, WDiscListItem_t * witem, ccp def_fname
 
 //-----------------------------------------------------------------------------
 
+void InitializeDiscCache ( DiscCache_t * dc );
+void ResetDiscCache ( DiscCache_t * dc );
+bool LoadDiscCache ( DiscCache_t * dc );
+void SaveDiscCache ( DiscCache_t * dc );
+uint RemoveDiscCache ( DiscCache_t * dc, ccp real_path );
+
+const DiscCacheEntry_t * FindDiscCache
+	( DiscCache_t * dc, ccp real_path, const struct stat * st );
+void BeginDiscCache
+	( DiscCache_t * dc, ccp path, ccp real_path, const struct stat * st );
+void InsertDiscCache ( DiscCache_t * dc, const WDiscListItem_t * item,
+			const SuperFile_t * sf, ccp real_path );
+void EndDiscCache ( DiscCache_t * dc );
+
+//-----------------------------------------------------------------------------
+
 enumError OpenWDiscID6	( WBFS_t * w, ccp id6 );
 enumError OpenWDiscIndex( WBFS_t * w, u32 index );
 enumError OpenWDiscSlot	( WBFS_t * w, u32 slot, bool force_open );
@@ -467,6 +524,58 @@ wd_header_t * GetWDiscHeader ( WBFS_t * w );
 
 enumError AddWDisc	( WBFS_t * w, SuperFile_t * sf, const wd_select_t * psel );
 
+//-----------------------------------------------------------------------------
+// AddWDiscQueue_t imports several discs at the same time: The main thread
+// opens the sources and reserves the WBFS blocks, worker threads copy the
+// data and the main thread commits the discs in order of start. The main
+// thread must hold the lock (LockAddWDiscQueue()) while it accesses the WBFS.
+
+typedef struct AddWDiscJob_t
+{
+    ThreadJob_t		tjob;		// job of the thread pool
+    WBFS_t		* wbfs;		// target WBFS
+    SuperFile_t		sf;		// private copy of the source
+    wbfs_param_t	par;		// parameters for libwbfs
+    wbfs_add_t		add;		// reservation data of libwbfs
+    bool		active;		// true: job started but not committed
+
+} AddWDiscJob_t;
+
+typedef struct AddWDiscQueue_t
+{
+    ThreadPool_t	tpool;		// pool of worker threads
+    pthread_mutex_t	mutex;		// lock for the target WBFS
+    AddWDiscJob_t	* job;		// list with 'n_jobs' jobs
+    uint		n_jobs;		// number of jobs, 0: don't use threads
+    uint		next_job;	// index of next job to use (the oldest)
+    enumError		max_err;	// max error of committed jobs
+
+} AddWDiscQueue_t;
+
+void InitializeAddWDiscQueue ( AddWDiscQueue_t * aq, uint n_jobs );
+enumError ResetAddWDiscQueue ( AddWDiscQueue_t * aq );
+void LockAddWDiscQueue	( AddWDiscQueue_t * aq );
+void UnlockAddWDiscQueue( AddWDiscQueue_t * aq );
+
+enumError StartAddWDisc
+(
+    AddWDiscQueue_t	* aq,		// valid queue, locked by caller
+    WBFS_t		* w,		// valid WBFS descriptor
+    SuperFile_t		* sf,		// valid and opened source file
+    const wd_select_t	* psel		// partition selector
+);
+
+enumError FinishAddWDiscQueue
+(
+    AddWDiscQueue_t	* aq		// valid queue, locked by caller
+);
+
+void FinishAddWDiscID
+(
+    AddWDiscQueue_t	* aq,		// valid queue, locked by caller
+    ccp			id6		// ID of disc to access
+);
+
 enumError RemoveWDisc
 (
     WBFS_t		* w,		// valid WBFS descriptor
@@ -43,6 +43,7 @@
 #include "types.h"
 #include "lib-std.h"
 #include "lib-sf.h"
+#include "lib-thread.h"
 
 #include "ui-wdf.c"
 #include "logo.inc"
@@ -733,19 +734,20 @@ enumError ciso_dump ( FILE *f, CISO_Head_t * ch, File_t *df, ccp fname )
 
 ///////////////////////////////////////////////////////////////////////////////
 
-enumError wia_dump ( FILE *f, File_t *df, ccp fname )
+enumError wia_dump ( FILE *f, File_t *df, ccp fname, ccp type )
 {
     ASSERT(df);
     ASSERT(fname);
+    ASSERT(type);
 
     if (testmode)
     {
-	fprintf(f," - WOULD dump WIA %s\n",fname);
+	fprintf(f," - WOULD dump %s %s\n",type,fname);
 	ResetFile(df,false);
 	return ERR_OK;
     }
 
-    fprintf(f,"\nWIA dump of file %s\n\n",fname);
+    fprintf(f,"\n%s dump of file %s\n\n",type,fname);
 
     SuperFile_t sf;
     InitializeSF(&sf);
@@ -1047,7 +1049,10 @@ enumError wdf_dump ( FILE *f, ccp fname )
     }
 
     if (!memcmp(&wh,WIA_MAGIC,WIA_MAGIC_SIZE))
-	return wia_dump(f,&df,fname);
+	return wia_dump(f,&df,fname,"WIA");
+
+    if (!memcmp(&wh,RVZ_MAGIC,WIA_MAGIC_SIZE))
+	return wia_dump(f,&df,fname,"RVZ");
 
     if (testmode)
     {
@@ -1333,6 +1338,9 @@ enumError CheckOptions ( int argc, char ** argv )
 	case GO_VERBOSE:	verbose = verbose <  0 ?  0 : verbose + 1; break;
 	case GO_LOGGING:	logging++; break;
 	case GO_IO:		ScanIOMode(optarg); break;
+	case GO_THREADS:	err += ScanOptThreads(optarg); break;
+	case GO_IOBUF:		err += ScanOptIOBuf(optarg); break;
+	case GO_GCZ_CACHE:	err += ScanOptGCZCache(optarg); break;
 	case GO_DIRECT:		opt_direct++; break;
 	case GO_CHUNK:		opt_chunk = true; break;
 	case GO_LONG:		opt_chunk = true; long_count++; break;
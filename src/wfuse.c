@@ -35,7 +35,7 @@
  ***************************************************************************/
 
 #define _GNU_SOURCE 1
-#define FUSE_USE_VERSION  25
+#define FUSE_USE_VERSION  26
 
 #include <sys/wait.h>
 
@@ -48,6 +48,7 @@
 #include "version.h"
 #include "lib-std.h"
 #include "lib-sf.h"
+#include "lib-thread.h"
 #include "titles.h"
 #include "iso-interface.h"
 #include "wbfs-interface.h"
@@ -94,6 +95,7 @@ static bool opt_umount		= false;
 static bool opt_lazy		= false;
 static bool opt_create		= false;
 static bool opt_remount		= false;
+static bool opt_perf		= false;
 static char * source_file	= 0;
 static char * mount_point	= 0;
 
@@ -149,7 +151,7 @@ static void help_fuse_exit()
     fputs( TITLE "\n", stdout );
     add_arg("--help",0);
     static struct fuse_operations wfuse_oper = {0};
-    fuse_main(wbfuse_argc,wbfuse_argv,&wfuse_oper);
+    fuse_main(wbfuse_argc,wbfuse_argv,&wfuse_oper,0);
     exit(ERR_OK);
 }
 
@@ -166,7 +168,7 @@ static void version_exit()
 	fputs( TITLE "\n", stdout );
 	add_arg("--version",0);
 	static struct fuse_operations wfuse_oper = {0};
-	fuse_main(wbfuse_argc,wbfuse_argv,&wfuse_oper);
+	fuse_main(wbfuse_argc,wbfuse_argv,&wfuse_oper,0);
     }
     exit(ERR_OK);
 }
@@ -206,6 +208,8 @@ static enumError CheckOptions ( int argc, char ** argv )
 	case GO_QUIET:		verbose = verbose > -1 ? -1 : verbose - 1; break;
 	case GO_VERBOSE:	verbose = verbose <  0 ?  0 : verbose + 1; break;
 	case GO_IO:		ScanIOMode(optarg); break;
+	case GO_THREADS:	err += ScanOptThreads(optarg); break;
+	case GO_FST_CACHE:	err += ScanOptFSTCache(optarg); break;
 
 	case GO_HELP_FUSE:	help_fuse_exit();
 	case GO_OPTION:		add_arg("-o",optarg); break;
@@ -215,6 +219,7 @@ static enumError CheckOptions ( int argc, char ** argv )
 	case GO_LAZY:		opt_lazy = true; break;
 	case GO_CREATE:		opt_create = true; break;
 	case GO_REMOUNT:	opt_remount = true; break;
+	case GO_PERF:		opt_perf = true; break;
       }
     }
  #ifdef DEBUG
@@ -250,6 +255,17 @@ static void unlock_mutex()
 ///////////////			struct SlotInfo_t		///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+typedef struct ReadStat_t
+{
+    u64			n_read;		// number of successful reads
+    u64			n_bytes;	// total number of read bytes
+    u64			n_splice;	// number of reads, that are spliced
+    u64			splice_bytes;	// number of spliced bytes
+
+} ReadStat_t;
+
+//-----------------------------------------------------------------------------
+
 typedef struct SlotInfo_t
 {
     char		id6[7];		// ID6 of image
@@ -257,6 +273,7 @@ typedef struct SlotInfo_t
     time_t		atime;		// atime of image
     time_t		mtime;		// mtime of image
     time_t		ctime;		// ctime of image
+    ReadStat_t		read_stat;	// read counters of closed disc files
 
 } SlotInfo_t;
 
@@ -280,10 +297,17 @@ typedef struct DiscFile_t
     wd_disc_t		* disc;		// NULL or disc pointer
     volatile WiiFst_t	* fst;		// NULL or collected files
 
+    u32			serial;		// unique serial number of the opened disc
+    pthread_mutex_t	io_mutex;	// serializes all reads from 'sf'
+    wd_read_func_t	read_func;	// original read function of 'disc'
+    void		* read_data;	// original data pointer of 'read_func'
+
     struct stat		stat_dir;	// template for directories
     struct stat		stat_file;	// template for regular files
     struct stat		stat_link;	// template for soft links
 
+    ReadStat_t		read_stat;	// read counters, updated atomically
+
 } DiscFile_t;
 
 #define MAX_DISC_FILES		 50
@@ -294,6 +318,120 @@ typedef struct DiscFile_t
 DiscFile_t dfile[MAX_DISC_FILES];
 int n_dfile = 0;
 
+static u32 disc_serial = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int locked_read_func
+(
+    void		* read_data,	// pointer to disc file
+    u32			offset4,	// offset/4 to read
+    u32			count,		// num of bytes to read
+    void		* iobuf		// destination buffer
+)
+{
+    // The super file and its caches are not thread safe => serialize the
+    // raw reads of each disc. Decryption is done outside of this lock.
+
+    DiscFile_t * df = read_data;
+    DASSERT(df);
+    DASSERT(df->read_func);
+
+    pthread_mutex_lock(&df->io_mutex);
+    const int stat = df->read_func(df->read_data,offset4,count,iobuf);
+    pthread_mutex_unlock(&df->io_mutex);
+    return stat;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void setup_disc_io ( DiscFile_t * df )
+{
+    // called with locked 'mutex'
+
+    DASSERT(df);
+    DASSERT(df->disc);
+
+    df->serial = ++disc_serial;
+    pthread_mutex_init(&df->io_mutex,0);
+
+    wd_disc_t * disc = df->disc;
+    df->read_func   = disc->read_func;
+    df->read_data   = disc->read_data;
+    disc->read_func = locked_read_func;
+    disc->read_data = df;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static enumError read_sf ( DiscFile_t * df, off_t off, void * buf, size_t size )
+{
+    DASSERT(df);
+    DASSERT(df->sf);
+
+    pthread_mutex_lock(&df->io_mutex);
+    const enumError err = ReadSF(df->sf,off,buf,size);
+    pthread_mutex_unlock(&df->io_mutex);
+    return err;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			thread read context		///////////////
+///////////////////////////////////////////////////////////////////////////////
+// FUSE calls the read functions from several threads. Each thread decrypts
+// the partition blocks with its own AES key and block cache.
+
+typedef struct ThreadReadCtx_t
+{
+    DiscFile_t		* df;		// disc file of the last read
+    u32			serial;		// serial number of 'df' at the last read
+    wd_read_ctx_t	ctx;		// read context of this thread
+
+} ThreadReadCtx_t;
+
+static pthread_key_t  read_ctx_key;
+static pthread_once_t read_ctx_once = PTHREAD_ONCE_INIT;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void free_read_ctx ( void * ptr )
+{
+    FREE(ptr);
+}
+
+//-----------------------------------------------------------------------------
+
+static void create_read_ctx_key()
+{
+    pthread_key_create(&read_ctx_key,free_read_ctx);
+}
+
+//-----------------------------------------------------------------------------
+
+static wd_read_ctx_t * get_read_ctx ( DiscFile_t * df )
+{
+    DASSERT(df);
+
+    pthread_once(&read_ctx_once,create_read_ctx_key);
+    ThreadReadCtx_t * trc = pthread_getspecific(read_ctx_key);
+    if (!trc)
+    {
+	trc = CALLOC(1,sizeof(*trc));
+	pthread_setspecific(read_ctx_key,trc);
+    }
+
+    // the cached partition pointers are only valid for the same disc
+    if ( trc->df != df || trc->serial != df->serial )
+    {
+	trc->df     = df;
+	trc->serial = df->serial;
+	wd_reset_read_ctx(&trc->ctx);
+    }
+
+    return &trc->ctx;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static DiscFile_t * get_disc_file ( uint slot )
@@ -338,9 +476,19 @@ static DiscFile_t * get_disc_file ( uint slot )
 	        ResetFST(fst);
 	        FREE(fst);
 	    }
+	    if ( slot_info && df->slot >= 0 )
+	    {
+		// keep the counters of the slot
+		ReadStat_t * rs = &slot_info[df->slot].read_stat;
+		rs->n_read	 += df->read_stat.n_read;
+		rs->n_bytes	 += df->read_stat.n_bytes;
+		rs->n_splice	 += df->read_stat.n_splice;
+		rs->splice_bytes += df->read_stat.splice_bytes;
+	    }
 	    ResetWBFS(df->wbfs);
 	    FREE(df->wbfs);
-	    memset(df,0,sizeof(df));
+	    pthread_mutex_destroy(&df->io_mutex);
+	    memset(df,0,sizeof(*df));
 	    n_dfile--;
 	}
 
@@ -352,7 +500,7 @@ static DiscFile_t * get_disc_file ( uint slot )
 
     if (found_df)
     {
-	memset(found_df,0,sizeof(found_df));
+	memset(found_df,0,sizeof(*found_df));
 	WBFS_t * wbfs = MALLOC(sizeof(*wbfs));
 	InitializeWBFS(wbfs);
 	enumError err = OpenWBFS(wbfs,source_file,false,true,0);
@@ -382,6 +530,7 @@ static DiscFile_t * get_disc_file ( uint slot )
 	    found_df->wbfs		= wbfs;
 	    found_df->sf		= wbfs->sf;
 	    found_df->disc		= disc;
+	    setup_disc_io(found_df);
 
 	    memcpy(&found_df->stat_dir, &stat_dir, sizeof(found_df->stat_dir ));
 	    memcpy(&found_df->stat_file,&stat_file,sizeof(found_df->stat_file));
@@ -710,6 +859,117 @@ static size_t print_part_info
 		);
 }
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			read statistics			///////////////
+///////////////////////////////////////////////////////////////////////////////
+// In performance mode, the reads of each disc are counted by the open disc
+// file without any lock. The counters are published by '/stats.txt'.
+
+static void count_read
+(
+    DiscFile_t		* df,		// disc file of the read
+    size_t		size,		// number of read bytes
+    bool		spliced		// true: data was spliced
+)
+{
+    DASSERT(df);
+    if (!opt_perf)
+	return;
+
+    ReadStat_t * rs = &df->read_stat;
+    __atomic_fetch_add(&rs->n_read,1,__ATOMIC_RELAXED);
+    __atomic_fetch_add(&rs->n_bytes,size,__ATOMIC_RELAXED);
+    if (spliced)
+    {
+	__atomic_fetch_add(&rs->n_splice,1,__ATOMIC_RELAXED);
+	__atomic_fetch_add(&rs->splice_bytes,size,__ATOMIC_RELAXED);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void add_read_stat ( ReadStat_t * rs, const DiscFile_t * df )
+{
+    // add the counters of an open disc file
+
+    DASSERT(rs);
+    DASSERT(df);
+    const ReadStat_t * ds = &df->read_stat;
+    rs->n_read		+= __atomic_load_n(&ds->n_read,__ATOMIC_RELAXED);
+    rs->n_bytes		+= __atomic_load_n(&ds->n_bytes,__ATOMIC_RELAXED);
+    rs->n_splice	+= __atomic_load_n(&ds->n_splice,__ATOMIC_RELAXED);
+    rs->splice_bytes	+= __atomic_load_n(&ds->splice_bytes,__ATOMIC_RELAXED);
+}
+
+//-----------------------------------------------------------------------------
+
+static char * print_read_stat
+(
+    char		* dest,		// destination buffer
+    char		* end,		// end of 'dest'
+    const ReadStat_t	* rs,		// counters to print
+    ccp			path		// path of the disc
+)
+{
+    if (!rs->n_read)
+	return dest;
+
+    const int len = snprintf(dest,end-dest,
+		"%9llu %13llu %8llu %14llu  %s\n",
+		rs->n_read, rs->n_bytes, rs->n_splice, rs->splice_bytes, path );
+    return len < end - dest ? dest + len : end - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+static char * print_read_stats
+(
+    size_t		* len		// not NULL: store length of result
+)
+{
+    // returns an alloced string
+
+    const size_t size = 100 + ( n_slots + 1 ) * 80;
+    char * buf = MALLOC(size);
+    char * end = buf + size;
+    char * dest = buf;
+    dest += snprintf(dest,end-dest,
+		"#   reads         bytes  splices  spliced bytes  disc\n");
+
+    // the mutex protects the disc files against closing
+    lock_mutex();
+
+    if ( is_iso && dfile->slot < 0 )
+    {
+	ReadStat_t rs = {0};
+	add_read_stat(&rs,dfile);
+	dest = print_read_stat(dest,end,&rs,"/iso");
+    }
+
+    int slot;
+    for ( slot = 0; slot < n_slots; slot++ )
+    {
+	ReadStat_t rs = slot_info[slot].read_stat;
+
+	const DiscFile_t * df;
+	for ( df = dfile; df < dfile + MAX_DISC_FILES; df++ )
+	    if ( df->used && df->slot == slot )
+		add_read_stat(&rs,df);
+
+	char path[30];
+	snprintf(path,sizeof(path),"/wbfs/slot/%u",slot);
+	dest = print_read_stat(dest,end,&rs,path);
+    }
+
+    unlock_mutex();
+
+    DASSERT( dest < end );
+    if (len)
+	*len = dest - buf;
+    return buf;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			analyze_path()			///////////////
@@ -721,6 +981,7 @@ typedef enum enumAnaPath
 
     AP_ROOT,
     AP_ROOT_INFO,
+    AP_ROOT_STATS,
 
     AP_ISO,
     AP_ISO_DISC,
@@ -763,6 +1024,7 @@ static AnaPath_t ana_path_tab_root[] =
     DEF_AP( AP_WBFS_INFO,	"/wbfs/info.txt" ),
     DEF_AP( AP_WBFS,		"/wbfs" ),
     DEF_AP( AP_ROOT_INFO,	"/info.txt" ),
+    DEF_AP( AP_ROOT_STATS,	"/stats.txt" ),
     {0,0,0}
 };
 
@@ -1116,6 +1378,17 @@ static int wfuse_getattr
 		return 0;
 	    }
 	    break;
+
+	case AP_ROOT_STATS:
+	    if ( opt_perf && !*subpath )
+	    {
+		size_t len;
+		FREE(print_read_stats(&len));
+		memcpy(st,&stat_file,sizeof(*st));
+		st->st_size = len;
+		return 0;
+	    }
+	    break;
 		
 	case AP_ISO:
 	    noTRACE(" -> AP_ISO, sub=%s\n",subpath);
@@ -1289,7 +1562,7 @@ static int wfuse_read_iso
 		{
 		    if ( size > fsize - offset )
 			 size = fsize - offset;
-		    return ReadSF(df->sf,offset,buf,size) ? -EIO : size;
+		    return read_sf(df,offset,buf,size) ? -EIO : size;
 		}
 	    }
 	    return 0;
@@ -1311,10 +1584,8 @@ static int wfuse_read_iso
 		    {
 			if ( size > file->size - offset )
 			     size = file->size - offset;
-			lock_mutex();
-			int stat = ReadFileFST(fst_part,file,offset,buf,size) ? -EIO : size;
-			unlock_mutex();
-			return stat;
+			return ReadFileFST( get_read_ctx(df), fst_part, file,
+						offset, buf, size ) ? -EIO : size;
 		    }
 		    return 0;
 		}
@@ -1345,18 +1616,32 @@ static int wfuse_read
     ccp subpath = analyze_path(&ap,path,ana_path_tab_root);
 
     char pbuf[INFO_SIZE];
+    int stat = -ENOENT;
 
     switch(ap)
     {
 	case AP_ROOT_INFO:
 	    if (!*subpath)
-		return copy_helper(buf,size,offset,pbuf,
+		stat = copy_helper(buf,size,offset,pbuf,
 					print_root_info(pbuf,sizeof(pbuf)));
 	    break;
 
+	case AP_ROOT_STATS:
+	    if ( opt_perf && !*subpath )
+	    {
+		size_t len;
+		char * text = print_read_stats(&len);
+		stat = copy_helper(buf,size,offset,text,len);
+		FREE(text);
+	    }
+	    break;
+
 	case AP_ISO:
-	    return wfuse_read_iso( subpath, buf, size, offset, info,
+	    stat = wfuse_read_iso( subpath, buf, size, offset, info,
 					dfile, pbuf,sizeof(pbuf) );
+	    if ( stat >= 0 )
+		count_read(dfile,stat,false);
+	    break;
 
 	case AP_WBFS_SLOT:
 	    if ( is_wbfs && *subpath )
@@ -1367,11 +1652,11 @@ static int wfuse_read
 		    DiscFile_t * df = get_disc_file(slot);
 		    if (df)
 		    {
-			const int stat
-			    = wfuse_read_iso( subpath, buf, size, offset, info,
+			stat = wfuse_read_iso( subpath, buf, size, offset, info,
 					df, pbuf,sizeof(pbuf) );
+			if ( stat >= 0 )
+			    count_read(df,stat,false);
 			free_disc_file(df);
-			return stat;
 		    }
 		}
 	    }
@@ -1379,7 +1664,7 @@ static int wfuse_read
 
 	case AP_WBFS_INFO:
 	    if (!*subpath)
-		return copy_helper(buf,size,offset,pbuf,
+		stat = copy_helper(buf,size,offset,pbuf,
 					print_wbfs_info(pbuf,sizeof(pbuf)));
 	    break;
 
@@ -1387,7 +1672,201 @@ static int wfuse_read
 	    break;
     }
 
-    return -ENOENT;
+    return stat;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			wfuse_read_buf()		///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if FUSE_VERSION >= 29
+
+// FUSE releases the result of read_buf() by free()
+// => never use the alloc tracer of MALLOC() for it
+
+#if TRACE_ALLOC_MODE > 1
+    #define FUSE_MALLOC(size) my_malloc(__FUNCTION__,__FILE__,__LINE__,size)
+#else
+    #define FUSE_MALLOC(size) my_malloc(size)
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int get_splice_fd
+(
+    DiscFile_t		* df,		// related disc file
+    off_t		offset,		// offset of 'disc.iso'
+    size_t		size,		// number of bytes to read
+    off_t		* fd_off	// store the file offset of the source here
+)
+{
+    // Return the file descriptor of the source, if 'disc.iso' is stored
+    // as a plain ISO image or as a single extent of a WBFS disc.
+    // Return -1 otherwise. The file descriptor of 'main_sf' is used,
+    // because it is valid until the file system is unmounted.
+
+    DASSERT(df);
+    DASSERT(df->sf);
+    DASSERT(fd_off);
+
+    const int fd = GetFD(&main_sf.f);
+    if ( fd < 0 || main_sf.f.split_used > 1 || !size )
+	return -1;
+
+    if ( df->sf == &main_sf && main_sf.iod.read_func == ReadISO )
+    {
+	if ( offset + size > main_sf.f.st.st_size )
+	    return -1;
+	*fd_off = offset;
+	return fd;
+    }
+
+    if ( is_wbfs && df->wbfs && df->sf->iod.read_func == ReadWBFS )
+    {
+	DASSERT(df->wbfs->disc);
+	DASSERT(df->wbfs->disc->header);
+	wbfs_t * w = df->wbfs->wbfs;
+	DASSERT(w);
+
+	const u32 bl = offset / w->wbfs_sec_sz;
+	const u32 bl_off = offset - (u64)bl * w->wbfs_sec_sz;
+	if ( bl >= w->n_wbfs_sec_per_disc || bl_off + size > w->wbfs_sec_sz )
+	    return -1;
+
+	const u32 wlba = ntohs(df->wbfs->disc->header->wlba_table[bl]);
+	if (!wlba)
+	    return -1;
+
+	*fd_off = (off_t)w->wbfs_sec_sz * wlba + bl_off;
+	return fd;
+    }
+
+    return -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int splice_disc_iso
+(
+    struct fuse_bufvec	** bufp,	// store the result here
+    size_t		size,		// size to read
+    off_t		offset,		// read offset
+    DiscFile_t		* df,		// related disc file
+    ccp			subpath		// path relative to the disc directory
+)
+{
+    // return 1 if spliced, 0 otherwise
+
+    DASSERT(bufp);
+    DASSERT(df);
+
+    enumAnaPath ap;
+    subpath = analyze_path(&ap,subpath,ana_path_tab_iso);
+    if ( ap != AP_ISO_DISC || is_fst || *subpath )
+	return 0;
+
+    const u64 fsize = get_iso_size(df);
+    if ( offset >= fsize )
+	return 0;
+    if ( size > fsize - offset )
+	 size = fsize - offset;
+
+    off_t fd_off;
+    const int fd = get_splice_fd(df,offset,size,&fd_off);
+    if ( fd < 0 )
+	return 0;
+
+    struct fuse_bufvec * bv = FUSE_MALLOC(sizeof(*bv));
+    *bv = (struct fuse_bufvec)FUSE_BUFVEC_INIT(size);
+    bv->buf[0].flags = FUSE_BUF_IS_FD | FUSE_BUF_FD_SEEK;
+    bv->buf[0].fd    = fd;
+    bv->buf[0].pos   = fd_off;
+    *bufp = bv;
+
+    count_read(df,size,true);
+    return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int wfuse_read_buf
+(
+    const char		* path,		// path to the file
+    struct fuse_bufvec	** bufp,	// store the result here
+    size_t		size,		// size to read
+    off_t		offset,		// read offset
+    fuse_file_info	* info		// fuse info
+)
+{
+    TRACE("##### wfuse_read_buf(%s,%llu+%zu)\n",path,(u64)offset,size);
+    DASSERT(bufp);
+
+    // only used in performance mode
+
+    enumAnaPath ap;
+    ccp subpath = analyze_path(&ap,path,ana_path_tab_root);
+    if ( ap == AP_ISO && is_iso )
+    {
+	if (splice_disc_iso(bufp,size,offset,dfile,subpath))
+	    return 0;
+    }
+    else if ( ap == AP_WBFS_SLOT && is_wbfs && *subpath )
+    {
+	const int slot = analyze_slot(&subpath,subpath);
+	if ( slot >= 0 )
+	{
+	    DiscFile_t * df = get_disc_file(slot);
+	    if (df)
+	    {
+		const int stat = splice_disc_iso(bufp,size,offset,df,subpath);
+		free_disc_file(df);
+		if (stat)
+		    return 0;
+	    }
+	}
+    }
+
+    //----- fall back to a memory buffer
+
+    char * buf = FUSE_MALLOC( size ? size : 1 );
+    const int stat = wfuse_read(path,buf,size,offset,info);
+    if ( stat < 0 )
+    {
+	my_free(buf);
+	return stat;
+    }
+
+    struct fuse_bufvec * bv = FUSE_MALLOC(sizeof(*bv));
+    *bv = (struct fuse_bufvec)FUSE_BUFVEC_INIT(stat);
+    bv->buf[0].mem = buf;
+    *bufp = bv;
+    return 0;
+}
+
+#endif // FUSE_VERSION >= 29
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			wfuse_open()			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static int wfuse_open
+(
+    const char		* path,		// path to the file
+    fuse_file_info	* info		// fuse info
+)
+{
+    TRACE("##### wfuse_open(%s)\n",path);
+    DASSERT(info);
+
+    enumAnaPath ap;
+    analyze_path(&ap,path,ana_path_tab_root);
+    if ( ap == AP_ROOT_STATS )
+	info->direct_io = 1; // the size changes with each read
+    else if (opt_perf)
+	info->keep_cache = 1;
+    return 0;
 }
 
 //
@@ -1704,6 +2183,8 @@ static int wfuse_readdir
 		if (is_wbfs)
 		    filler(fuse_buf,"wbfs",0,0);
 		filler(fuse_buf,"info.txt",0,0);
+		if (opt_perf)
+		    filler(fuse_buf,"stats.txt",0,0);
 	    }
 	    break;
 		
@@ -2098,6 +2579,7 @@ int main ( int argc, char ** argv )
 	dfile->slot		= -1;
 	dfile->sf		= &main_sf;
 	dfile->disc		= disc;
+	setup_disc_io(dfile);
 
 	memcpy(&dfile->stat_dir, &stat_dir, sizeof(dfile->stat_dir ));
 	memcpy(&dfile->stat_file,&stat_file,sizeof(dfile->stat_file));
@@ -2150,15 +2632,26 @@ int main ( int argc, char ** argv )
     static struct fuse_operations wfuse_oper =
     {
 	.getattr    = wfuse_getattr,
+	.open	    = wfuse_open,
 	.read	    = wfuse_read,
 	.readlink   = wfuse_readlink,
 	.readdir    = wfuse_readdir,
 	.destroy    = wfuse_destroy,
     };
 
+    if (opt_perf)
+    {
+	// the source is expected to be unchanged => cache as much as possible
+	add_arg("-o","attr_timeout=60,entry_timeout=60,max_readahead=4194304");
+ #if FUSE_VERSION >= 29
+	add_arg("-o","splice_write,splice_move");
+	wfuse_oper.read_buf = wfuse_read_buf;
+ #endif
+    }
+
     add_arg(mount_point,0);
     TRACE("CALL fuse_main(argc=%d\n",argc);
-    return fuse_main(wbfuse_argc,wbfuse_argv,&wfuse_oper);
+    return fuse_main(wbfuse_argc,wbfuse_argv,&wfuse_oper,0);
 }
 
 //
@@ -57,6 +57,7 @@
 #include "wiidisc.h"
 #include "lib-std.h"
 #include "lib-sf.h"
+#include "lib-thread.h"
 #include "titles.h"
 #include "iso-interface.h"
 #include "wbfs-interface.h"
@@ -1940,6 +1941,22 @@ static enumError cmd_id_long ( uint mode )
 ///////////////			command ID6			///////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+static void print_collected ( Iterator_t * it, WDiscListItem_t * item )
+{
+    ASSERT(it);
+    ASSERT(item);
+
+    if ( print_sections && scan_progress > 0 && !it->scan_progress )
+    {
+	printf("[progress:found]\n");
+	PrintSectWDiscListItem(stdout,item,0);
+	putchar('\n');
+	fflush(stdout);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 enumError exec_collect ( SuperFile_t * sf, Iterator_t * it )
 {
     ASSERT(sf);
@@ -1952,6 +1969,30 @@ enumError exec_collect ( SuperFile_t * sf, Iterator_t * it )
 
     WDiscList_t * wl = it->wlist;
     WDiscListItem_t * item = AppendWDiscList(wl,&wdi);
+    TRACE("WLIST: %d/%d\n",wl->used,wl->size);
+
+    item->used_blocks = wdi.used_blocks;
+    item->size_mib = (sf->f.fatt.size+MiB/2)/MiB;
+    wl->total_size_mib += item->size_mib;
+
+    item->ftype = sf->f.ftype;
+    if ( sf->f.ftype & FT_ID_WBFS && sf->wbfs && sf->wbfs->disc )
+    {
+	item->wbfs_slot = sf->wbfs->disc->slot;
+	item->wbfs_fragments = wbfs_get_disc_fragments(sf->wbfs->disc,0);
+    }
+    else
+    {
+	item->wbfs_slot = -1;
+	item->wbfs_fragments = 0;
+    }
+    CopyFileAttrib(&item->fatt,&sf->f.fatt);
+
+    ResetWDiscInfo(&wdi);
+
+    if (it->disc_cache)
+	InsertDiscCache(it->disc_cache,item,sf,it->real_path);
+
     if ( OptionUsed[OPT_REALPATH] )
     {
 	int len = strlen(it->real_path);
@@ -1973,35 +2014,44 @@ enumError exec_collect ( SuperFile_t * sf, Iterator_t * it )
 	item->fname = sf->f.fname;
 	sf->f.fname = EmptyString;
     }
-    TRACE("WLIST: %d/%d\n",wl->used,wl->size);
 
-    item->used_blocks = wdi.used_blocks;
-    item->size_mib = (sf->f.fatt.size+MiB/2)/MiB;
-    wl->total_size_mib += item->size_mib;
+    print_collected(it,item);
+    return ERR_OK;
+}
 
-    item->ftype = sf->f.ftype;
-    if ( sf->f.ftype & FT_ID_WBFS && sf->wbfs && sf->wbfs->disc )
-    {
-	item->wbfs_slot = sf->wbfs->disc->slot;
-	item->wbfs_fragments = wbfs_get_disc_fragments(sf->wbfs->disc,0);
-    }
-    else
-    {
-	item->wbfs_slot = -1;
-	item->wbfs_fragments = 0;
-    }
-    CopyFileAttrib(&item->fatt,&sf->f.fatt);
+//-----------------------------------------------------------------------------
 
-    ResetWDiscInfo(&wdi);
+static enumError exec_collect_cached
+	( Iterator_t * it, const WDiscListItem_t * src, ccp fname, ccp path )
+{
+    // same as exec_collect(), but for a disc of the disc info cache
 
-    if ( print_sections && scan_progress > 0 && !it->scan_progress )
+    ASSERT(it);
+    ASSERT(it->wlist);
+    ASSERT(src);
+    ASSERT(fname);
+
+    WDiscList_t * wl = it->wlist;
+    WDiscListItem_t * item = AppendWDiscListItem(wl,src);
+    wl->total_size_mib += item->size_mib;
+
+    if ( OptionUsed[OPT_REALPATH] )
     {
-	printf("[progress:found]\n");
-	PrintSectWDiscListItem(stdout,item,0);
-	putchar('\n');
-	fflush(stdout);
+	int len = strlen(it->real_path);
+	if ( it->real_filename && item->ftype & FT_A_WDISC )
+	{
+	    ccp slash = strrchr(it->real_path,'/');
+	    if (slash)
+		len = slash - it->real_path;
+	}
+	item->fname = MEMDUP(it->real_path,len);
     }
+    else if ( it->real_filename && path && *path )
+	item->fname = STRDUP(path);
+    else
+	item->fname = STRDUP(fname);
 
+    print_collected(it,item);
     return ERR_OK;
 }
 
@@ -2337,8 +2387,21 @@ static enumError cmd_list ( int long_level )
 
     it.scan_progress	= false;
 
+    DiscCache_t dcache;
+    InitializeDiscCache(&dcache);
+    const bool use_cache = !OptionUsed[OPT_NO_CACHE] && LoadDiscCache(&dcache);
+    if (use_cache)
+    {
+	it.disc_cache	= &dcache;
+	it.cache_func	= exec_collect_cached;
+    }
+
     enumError err = SourceIterator(&it,1,true,false);
     ResetIterator(&it);
+    SaveDiscCache(&dcache);
+    const uint n_hit  = dcache.n_hit;
+    const uint n_miss = dcache.n_miss;
+    ResetDiscCache(&dcache);
     if ( err > ERR_WARNING )
 	return err;
 
@@ -2492,10 +2555,57 @@ static enumError cmd_list ( int long_level )
     if (print_header)
 	printf("%.*s\n%s\n\n", max_name_wd, wd_sep_200, footer );
 
+    if ( use_cache && verbose > 0 )
+	printf("Disc info cache: %u hit%s, %u miss%s.\n\n",
+		n_hit, n_hit == 1 ? "" : "s",
+		n_miss, n_miss == 1 ? "" : "es" );
+
     ResetWDiscList(&wlist);
     return ERR_OK;
 }
 
+//-----------------------------------------------------------------------------
+
+static enumError cmd_clear_cache()
+{
+    DiscCache_t dcache;
+    InitializeDiscCache(&dcache);
+    if (!LoadDiscCache(&dcache))
+    {
+	ResetDiscCache(&dcache);
+	return ERROR0(ERR_WARNING,"The disc info cache is disabled.\n");
+    }
+
+    if (!first_param)
+    {
+	if ( testmode || verbose > 0 )
+	    printf("%sREMOVE %s\n", testmode ? "WOULD " : "", dcache.fname );
+	if ( !testmode && unlink(dcache.fname) && errno != ENOENT )
+	    ERROR1(ERR_REMOVE_FAILED,"Can't remove file: %s\n",dcache.fname);
+    }
+    else
+    {
+	uint count = 0;
+	ParamList_t * param;
+	for ( param = first_param; param; param = param->next )
+	{
+	    char real_path[PATH_MAX];
+	    if (!realpath(param->arg,real_path))
+		StringCopyS(real_path,sizeof(real_path),param->arg);
+	    count += RemoveDiscCache(&dcache,real_path);
+	}
+
+	if ( testmode || verbose > 0 )
+	    printf("%s%u entr%s of the disc info cache removed.\n",
+			testmode ? "WOULD: " : "", count, count == 1 ? "y" : "ies" );
+	if (!testmode)
+	    SaveDiscCache(&dcache);
+    }
+
+    ResetDiscCache(&dcache);
+    return ERR_OK;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			command FILES			///////////////
@@ -3728,6 +3838,7 @@ enumError exec_verify ( SuperFile_t * fi, Iterator_t * it )
     Verify_t ver;
     InitializeVerify(&ver,fi);
     ver.long_count = it->long_count;
+    ver.tpool = it->tpool;
     if ( opt_limit >= 0 )
     {
 	ver.max_err_msg = opt_limit;
@@ -3778,10 +3889,18 @@ static enumError cmd_verify()
     enumError err = SourceIterator(&it,0,false,true);
     if ( err <= ERR_WARNING )
     {
+	// one pool of worker threads for all discs
+	ThreadPool_t tpool;
+	InitializeThreadPool(&tpool,0);
+	it.tpool = &tpool;
+
 	it.func = exec_verify;
 	err = SourceIteratorCollected(&it,0,2,true);
 	if ( err == ERR_OK && it.diff_count )
 	    err = ERR_DIFFER;
+
+	it.tpool = 0;
+	ResetThreadPool(&tpool);
     }
     ResetIterator(&it);
     return err;
@@ -3877,6 +3996,11 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
 	case GO_LOGGING:	logging++; break;
 	case GO_ESC:		err += ScanEscapeChar(optarg) < 0; break;
 	case GO_IO:		ScanIOMode(optarg); break;
+	case GO_THREADS:	err += ScanOptThreads(optarg); break;
+	case GO_SCAN_THREADS:	err += ScanOptScanThreads(optarg); break;
+	case GO_IOBUF:		err += ScanOptIOBuf(optarg); break;
+	case GO_GCZ_CACHE:	err += ScanOptGCZCache(optarg); break;
+	case GO_FST_CACHE:	err += ScanOptFSTCache(optarg); break;
 	case GO_FORCE:		opt_force++; break;
 	case GO_DIRECT:		opt_direct++; break;
 
@@ -3978,6 +4102,8 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
 	case GO_ALIGN_WDF:	err += ScanOptAlignWDF(optarg,0); break;
 
 	case GO_WIA:		err += ScanOptCompression(true,optarg); break;
+	case GO_RVZ:		output_file_type = OFT_RVZ;
+				err += ScanOptCompression(false,optarg); break;
 	case GO_ISO:		output_file_type = OFT_PLAIN; break;
 	case GO_CISO:		output_file_type = OFT_CISO; break;
 	case GO_WBFS:		output_file_type = OFT_WBFS; break;
@@ -3997,6 +4123,7 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
 	case GO_TECHNICAL:	opt_technical++; break;
 	case GO_REALPATH:	break;
 	case GO_UNIQUE:	    	break;
+	case GO_NO_CACHE:	break;
 	case GO_NO_HEADER:	break;
 	case GO_NULL:		break;
 	case GO_OLD_STYLE:	print_old_style++; break;
@@ -4066,6 +4193,7 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
       }
     }
     NormalizeIdOptions();
+    err += CheckOptCompression();
     if ( OptionUsed[OPT_NO_HEADER] )
 	opt_show_mode &= ~SHOW_F_HEAD;
 
@@ -4141,6 +4269,7 @@ enumError CheckCommand ( int argc, char ** argv )
 	case CMD_EXCLUDE:	err = cmd_exclude(); break;
 	case CMD_TITLES:	err = cmd_titles(); break;
 	case CMD_GETTITLES:	err = cmd_gettitles(); break;
+	case CMD_CLEAR_CACHE:	err = cmd_clear_cache(); break;
 	case CMD_CERT:		err = cmd_cert(); break;
 	case CMD_CREATE:	err = cmd_create(); break;
 	case CMD_DOLPATCH:	err = cmd_dolpatch(); break;
@@ -1319,6 +1319,226 @@ static void test_hexdump ( int argc, char ** argv )
     }
 }
 
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			test_aes()			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static int test_aes ( int argc, char ** argv )
+{
+    // Compare the software and the AES-NI implementation
+    // and check both with a known answer (NIST SP 800-38A, F.2.1)
+
+    printf("\n*** test AES ***\n\n");
+
+    static const u8 kat_key[16] =
+	{ 0x2b,0x7e,0x15,0x16, 0x28,0xae,0xd2,0xa6,
+	  0xab,0xf7,0x15,0x88, 0x09,0xcf,0x4f,0x3c };
+    static const u8 kat_iv[16] =
+	{ 0x00,0x01,0x02,0x03, 0x04,0x05,0x06,0x07,
+	  0x08,0x09,0x0a,0x0b, 0x0c,0x0d,0x0e,0x0f };
+    static const u8 kat_plain[64] =
+	{ 0x6b,0xc1,0xbe,0xe2, 0x2e,0x40,0x9f,0x96, 0xe9,0x3d,0x7e,0x11, 0x73,0x93,0x17,0x2a,
+	  0xae,0x2d,0x8a,0x57, 0x1e,0x03,0xac,0x9c, 0x9e,0xb7,0x6f,0xac, 0x45,0xaf,0x8e,0x51,
+	  0x30,0xc8,0x1c,0x46, 0xa3,0x5c,0xe4,0x11, 0xe5,0xfb,0xc1,0x19, 0x1a,0x0a,0x52,0xef,
+	  0xf6,0x9f,0x24,0x45, 0xdf,0x4f,0x9b,0x17, 0xad,0x2b,0x41,0x7b, 0xe6,0x6c,0x37,0x10 };
+    static const u8 kat_cipher[64] =
+	{ 0x76,0x49,0xab,0xac, 0x81,0x19,0xb2,0x46, 0xce,0xe9,0x8e,0x9b, 0x12,0xe9,0x19,0x7d,
+	  0x50,0x86,0xcb,0x9b, 0x50,0x72,0x19,0xee, 0x95,0xdb,0x11,0x3a, 0x91,0x76,0x78,0xb2,
+	  0x73,0xbe,0xd6,0xb8, 0xe3,0xc1,0x74,0x3b, 0x71,0x16,0xe6,0x9e, 0x22,0x22,0x95,0x16,
+	  0x3f,0xf1,0xca,0xa1, 0x68,0x1f,0xac,0x09, 0x12,0x0e,0xca,0x30, 0x75,0x86,0xe1,0xa7 };
+
+    const bool have_hw = wd_aes_hw_available();
+    printf("AES-NI: %s\n\n", have_hw ? "available" : "not available" );
+
+    int failed = 0, mode;
+    for ( mode = 0; mode <= have_hw; mode++ )
+    {
+	wd_aes_hw_enable(mode);
+	ccp name = mode ? "AES-NI" : "software";
+
+	aes_key_t akey;
+	wd_aes_set_key(&akey,kat_key);
+
+	u8 buf[sizeof(kat_plain)];
+	wd_aes_encrypt(&akey,kat_iv,kat_plain,buf,sizeof(buf));
+	const bool enc_ok = !memcmp(buf,kat_cipher,sizeof(buf));
+	wd_aes_decrypt(&akey,kat_iv,kat_cipher,buf,sizeof(buf));
+	const bool dec_ok = !memcmp(buf,kat_plain,sizeof(buf));
+
+	printf("known answer test, %-8s: encrypt %s, decrypt %s\n",
+		name, enc_ok ? "ok" : "FAILED", dec_ok ? "ok" : "FAILED" );
+	if ( !enc_ok || !dec_ok )
+	    failed++;
+    }
+
+    if (have_hw)
+    {
+	const int N = argc > 1 ? strtoul(argv[1],0,0) : 1000;
+	u8 *plain  = MALLOC(WII_SECTOR_SIZE);
+	u8 *crypt1 = MALLOC(WII_SECTOR_SIZE);
+	u8 *crypt2 = MALLOC(WII_SECTOR_SIZE);
+	u8 *dec1   = MALLOC(WII_SECTOR_SIZE);
+	u8 *dec2   = MALLOC(WII_SECTOR_SIZE);
+	u8 key[WII_KEY_SIZE], iv[WII_KEY_SIZE];
+	aes_key_t akey;
+
+	int i, diff = 0;
+	for ( i = 0; i < N; i++ )
+	{
+	    RandomFill(key,sizeof(key));
+	    RandomFill(iv,sizeof(iv));
+	    RandomFill(plain,WII_SECTOR_SIZE);
+	    wd_aes_set_key(&akey,key);
+
+	    wd_aes_hw_enable(0);
+	    wd_aes_encrypt(&akey,iv,plain,crypt1,WII_SECTOR_SIZE);
+	    wd_aes_decrypt(&akey,iv,crypt1,dec1,WII_SECTOR_SIZE);
+
+	    wd_aes_hw_enable(1);
+	    wd_aes_encrypt(&akey,iv,plain,crypt2,WII_SECTOR_SIZE);
+	    wd_aes_decrypt(&akey,iv,crypt2,dec2,WII_SECTOR_SIZE);
+
+	    if ( memcmp(crypt1,crypt2,WII_SECTOR_SIZE)
+		|| memcmp(dec1,plain,WII_SECTOR_SIZE)
+		|| memcmp(dec2,plain,WII_SECTOR_SIZE) )
+	    {
+		diff++;
+	    }
+	}
+	printf("\nsoftware <-> AES-NI: %u/%u sectors of %u bytes differ\n",
+		diff, N, WII_SECTOR_SIZE );
+	if (diff)
+	    failed++;
+
+	for ( i = 0; i < 2; i++ )
+	{
+	    wd_aes_hw_enable(i);
+	    const int M = 2000;
+	    int j;
+	    u32 t = GetTimerMSec();
+	    for ( j = 0; j < M; j++ )
+		wd_aes_decrypt(&akey,iv,crypt1,dec1,WII_SECTOR_SIZE);
+	    t = GetTimerMSec() - t;
+	    printf("decrypt %-8s: %6u msec / %u sectors = %6llu nsec/sector\n",
+		i ? "AES-NI" : "software", t, M, (u64)t*1000000/M );
+	}
+
+	FREE(plain);
+	FREE(crypt1);
+	FREE(crypt2);
+	FREE(dec1);
+	FREE(dec2);
+    }
+
+    wd_aes_hw_enable(1);
+    printf("\n%s\n\n", failed ? "AES test FAILED!" : "AES test passed." );
+    return failed ? ERR_ERROR : ERR_OK;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////			test_sha1mb()			///////////////
+///////////////////////////////////////////////////////////////////////////////
+
+static int test_sha1mb ( int argc, char ** argv )
+{
+    // Compare all available multi buffer modes against WIT_SHA1()
+    // and measure the H0 calculation of a complete Wii group.
+
+    printf("\n*** test multi buffer SHA1 ***\n\n");
+
+    enum { MAX_BUF = 37, MAX_SIZE = 0x400 };
+    static const uint size_tab[] =
+	{ 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 160, 620, MAX_SIZE, 0 };
+
+    u8 *src = MALLOC(MAX_BUF*MAX_SIZE);
+    u8 ref[MAX_BUF][WII_HASH_SIZE], res[MAX_BUF][WII_HASH_SIZE];
+    const u8 *dlist[MAX_BUF];
+    u8 *mlist[MAX_BUF];
+
+    int failed = 0, mode;
+    for ( mode = SHA1MB_GENERIC; mode < SHA1MB__N; mode++ )
+    {
+	if (!WIT_SHA1_MB_Available(mode))
+	{
+	    printf("%-8s: not available\n",WIT_SHA1_MB_Name(mode));
+	    continue;
+	}
+	WIT_SHA1_MB_Mode(mode);
+
+	uint n_test = 0, n_diff = 0, n, i;
+	const uint *sptr;
+	for ( sptr = size_tab; sptr == size_tab || *sptr; sptr++ )
+	{
+	    const uint size = *sptr;
+	    for ( n = 1; n <= MAX_BUF; n++ )
+	    {
+		RandomFill(src,n*MAX_SIZE);
+		for ( i = 0; i < n; i++ )
+		{
+		    dlist[i] = src + i*MAX_SIZE;
+		    mlist[i] = res[i];
+		    WIT_SHA1(dlist[i],size,ref[i]);
+		}
+		SHA1_MB(dlist,size,mlist,n);
+		n_test++;
+		if (memcmp(ref,res,n*WII_HASH_SIZE))
+		    n_diff++;
+	    }
+	}
+	printf("%-8s: %u/%u tests failed\n",WIT_SHA1_MB_Name(mode),n_diff,n_test);
+	if (n_diff)
+	    failed++;
+    }
+    FREE(src);
+
+    //--- timing: H0 of a whole group
+
+    const int M = argc > 1 ? strtoul(argv[1],0,0) : 20;
+    enum { N_H0 = WII_GROUP_SECTORS * WII_N_ELEMENTS_H0 };
+    u8 *data = MALLOC(WII_GROUP_DATA_SIZE);
+    u8 *hash = MALLOC(N_H0*WII_HASH_SIZE);
+    const u8 **glist = MALLOC(N_H0*sizeof(*glist));
+    u8 **hlist = MALLOC(N_H0*sizeof(*hlist));
+    RandomFill(data,WII_GROUP_DATA_SIZE);
+
+    int i;
+    for ( i = 0; i < N_H0; i++ )
+    {
+	glist[i] = data + i*WII_H0_DATA_SIZE;
+	hlist[i] = hash + i*WII_HASH_SIZE;
+    }
+
+    printf("\n");
+    for ( mode = SHA1MB_GENERIC; mode < SHA1MB__N; mode++ )
+    {
+	if (!WIT_SHA1_MB_Available(mode))
+	    continue;
+	WIT_SHA1_MB_Mode(mode);
+
+	int j;
+	u32 t = GetTimerMSec();
+	for ( j = 0; j < M; j++ )
+	    SHA1_MB(glist,WII_H0_DATA_SIZE,hlist,N_H0);
+	t = GetTimerMSec() - t;
+	printf("H0 of group, %-8s: %6u msec / %u groups = %6llu usec/group\n",
+		WIT_SHA1_MB_Name(mode), t, M, (u64)t*1000/M );
+    }
+    WIT_SHA1_MB_Mode(SHA1MB_AUTO);
+
+    FREE(data);
+    FREE(hash);
+    FREE(glist);
+    FREE(hlist);
+
+    printf("\nactive mode: %s\n%s\n\n",
+		WIT_SHA1_MB_Name(WIT_SHA1_MB_Mode(-1)),
+		failed ? "SHA1 multi buffer test FAILED!"
+			: "SHA1 multi buffer test passed." );
+    return failed ? ERR_ERROR : ERR_OK;
+}
+
 //
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////			test_sha1()			///////////////
@@ -1846,6 +2066,8 @@ enum
     CMD_ALIGNED_IO,		// test_aligned_io(argc,argv);
     CMD_HEXDUMP,		// test_hexdump(argc,argv);
 
+    CMD_AES,			// test_aes(argc,argv);
+    CMD_SHA1MB,			// test_sha1mb(argc,argv);
     CMD_SHA1,			// test_sha1();
     CMD_BZIP2,			// test_bzip2(argc,argv);
     CMD_WIIMM,			// test_wiimm(argc,argv);
@@ -1868,6 +2090,8 @@ static const CommandTab_t CommandTab[] =
 	{ CMD_ALIGNED_IO,	"ALIGNEDIO",	"AIO",		0 },
 	{ CMD_HEXDUMP,		"HEXDUMP",	0,		0 },
 
+	{ CMD_AES,		"AES",		0,		0 },
+	{ CMD_SHA1MB,		"SHA1MB",	0,		0 },
  #ifdef HAVE_OPENSSL
 	{ CMD_SHA1,		"SHA1",		0,		0 },
  #endif
@@ -1960,6 +2184,8 @@ int main ( int argc, char ** argv )
 	case CMD_ALIGNED_IO:		test_aligned_io(argc,argv); break;
 	case CMD_HEXDUMP:		test_hexdump(argc,argv); break;
 
+	case CMD_AES:			return test_aes(argc,argv); break;
+	case CMD_SHA1MB:		return test_sha1mb(argc,argv); break;
  #ifdef HAVE_OPENSSL
 	case CMD_SHA1:			test_sha1(); break;
  #endif
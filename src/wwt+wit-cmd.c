@@ -232,6 +232,10 @@ enumError cmd_compr()
 		if ( compr == WD_COMPR_BZIP2 )
 		    fputs("not-supported=1\n",stdout);
 	     #endif
+	     #ifndef HAVE_ZSTD
+		if ( compr == WD_COMPR_ZSTD )
+		    fputs("not-supported=1\n",stdout);
+	     #endif
 	    }
 	}
 	putchar('\n');
@@ -297,6 +301,10 @@ enumError cmd_compr()
 	 #ifdef NO_BZIP2
 	    if ( !have_param && compr == WD_COMPR_BZIP2 )
 		continue; // ignore it
+	 #endif
+	 #ifndef HAVE_ZSTD
+	    if ( !have_param && compr == WD_COMPR_ZSTD )
+		continue; // ignore it
 	 #endif
 	    if ( compr == (wd_compression_t)-1 )
 		err_count++;
@@ -611,6 +619,12 @@ enumError cmd_test_options()
     print_val( "mem:",		opt_mem, 0 );
     GetMemLimit();
     print_val( "mem limit:",	opt_mem, 0 );
+    printf("  threads:     %16x = %12d, used=%u\n",
+			opt_threads, opt_threads, GetThreadCount() );
+    printf("  scan-threads:%16x = %12d, used=%u\n",
+			opt_scan_threads, opt_scan_threads, GetScanThreadCount() );
+    printf("  iobuf:       %16x = %12d, used=%u\n",
+			opt_iobuf_size, opt_iobuf_size, GetIOBufSize() );
 
     printf("  escape-char: %16x = %12d\n",escape_char,escape_char);
     printf("  print-time:  %16x = %12d\n",opt_print_time,opt_print_time);
@@ -624,6 +638,8 @@ enumError cmd_test_options()
     printf("  block-size:  %16x = %12d\n",opt_block_size,opt_block_size);
  #endif
     printf("  gcz-block:   %16x = %12d\n",opt_gcz_block_size,opt_gcz_block_size);
+    printf("  gcz-cache:   %16x = %12d\n",opt_gcz_cache,opt_gcz_cache);
+    printf("  fst-cache:   %16x = %12d\n",opt_fst_cache,opt_fst_cache);
     printf("  rdepth:      %16x = %12d\n",opt_recurse_depth,opt_recurse_depth);
     printf("  enc:         %16x = %12d\n",encoding,encoding);
     printf("  region:      %16x = %12d\n",opt_region,opt_region);
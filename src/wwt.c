@@ -55,6 +55,7 @@
 #include "version.h"
 #include "wiidisc.h"
 #include "lib-sf.h"
+#include "lib-thread.h"
 #include "titles.h"
 #include "wbfs-interface.h"
 
@@ -71,6 +72,7 @@ time_t opt_set_time	= 0;
 u64  opt_size		= 0;
 u32  opt_hss		= 0;
 u32  opt_wss		= 0;
+u32  opt_parallel	= 1;
 
 //
 ///////////////////////////////////////////////////////////////////////////////
@@ -1863,6 +1865,175 @@ enumError cmd_truncate()
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+enumError cmd_dedup ( bool rehydrate )
+{
+    if (verbose>=0)
+	print_title(stdout);
+
+    if (n_param)
+    {
+	opt_part++;
+	opt_all++;
+	ParamList_t * param;
+	for ( param = first_param; param; param = param->next )
+	    CreatePartitionInfo(param->arg,PS_PARAM);
+    }
+
+    enumError err = AnalyzePartitions(stdout,false,false);
+    if (err)
+	return err;
+
+    int wbfs_count = 0, wbfs_mod_count = 0;
+    const bool check_it	    = OptionUsed[OPT_NO_CHECK] == 0;
+    const bool ignore_check = OptionUsed[OPT_FORCE]    != 0;
+
+    WBFS_t wbfs;
+    InitializeWBFS(&wbfs);
+    PartitionInfo_t * info;
+    for ( err = GetFirstWBFS(&wbfs,&info,!testmode);
+	  !err && !SIGINT_level;
+	  err = GetNextWBFS(&wbfs,&info,!testmode) )
+    {
+	wbfs_count++;
+
+	if ( !info->is_checked && check_it )
+	{
+	    info->is_checked = true;
+	    if ( AutoCheckWBFS(&wbfs,ignore_check,1,0) > ERR_WARNING )
+	    {
+		ERROR0(ERR_WBFS_INVALID,"Ignore invalid WBFS: %s\n\n",info->path);
+		ResetWBFS(&wbfs);
+		continue;
+	    }
+	}
+
+	DedupWBFS_t dd;
+	const enumError stat = rehydrate
+			? RehydrateWBFS(&wbfs,&dd,testmode)
+			: DedupWBFS(&wbfs,&dd,testmode);
+	if ( stat == ERR_OK )
+	{
+	    const u32 used_blocks = rehydrate
+			? dd.used_blocks + dd.mod_blocks
+			: dd.used_blocks - dd.mod_blocks;
+	    const u32 mod_mib
+			= ( (u64)wbfs.wbfs->wbfs_sec_sz * dd.mod_blocks + MiB/2 ) / MiB;
+	    const double ratio
+			= used_blocks ? (double)dd.ref_blocks / used_blocks : 1.0;
+
+	    if (verbose>=0)
+	    {
+		if (rehydrate)
+		    printf(" - %s %u shared block%s (%u MiB): %s\n",
+			testmode ? "WOULD copy" : "Copied",
+			dd.mod_blocks, dd.mod_blocks == 1 ? "" : "s",
+			mod_mib, info->path );
+		else
+		    printf(" - %s %u block%s (%u MiB), dedup ratio %4.2f: %s\n",
+			testmode ? "WOULD release" : "Released",
+			dd.mod_blocks, dd.mod_blocks == 1 ? "" : "s",
+			mod_mib, ratio, info->path );
+	    }
+
+	    if ( verbose > 0 )
+		printf("   %u disc%s, %u block references,"
+			" %u -> %u used blocks, %u shared block%s before\n",
+			dd.n_disc, dd.n_disc == 1 ? "" : "s",
+			dd.ref_blocks, dd.used_blocks, used_blocks,
+			dd.shared_blocks, dd.shared_blocks == 1 ? "" : "s" );
+
+	    if ( dd.mod_blocks )
+		wbfs_mod_count++;
+	}
+	ResetWBFS(&wbfs);
+    }
+
+    if ( verbose >= 0 && wbfs_count > 1 )
+	printf("** %d of %d WBFS %s.\n",
+		wbfs_mod_count, wbfs_count,
+		rehydrate ? "rehydrated" : "deduplicated" );
+
+    return max_error;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+enumError cmd_defrag()
+{
+    if (verbose>=0)
+	print_title(stdout);
+
+    if (n_param)
+    {
+	opt_part++;
+	opt_all++;
+	ParamList_t * param;
+	for ( param = first_param; param; param = param->next )
+	    CreatePartitionInfo(param->arg,PS_PARAM);
+    }
+
+    enumError err = AnalyzePartitions(stdout,false,false);
+    if (err)
+	return err;
+
+    int wbfs_count = 0, wbfs_mod_count = 0;
+    const bool check_it	    = OptionUsed[OPT_NO_CHECK] == 0;
+    const bool ignore_check = OptionUsed[OPT_FORCE]    != 0;
+
+    WBFS_t wbfs;
+    InitializeWBFS(&wbfs);
+    PartitionInfo_t * info;
+    for ( err = GetFirstWBFS(&wbfs,&info,!testmode);
+	  !err && !SIGINT_level;
+	  err = GetNextWBFS(&wbfs,&info,!testmode) )
+    {
+	wbfs_count++;
+
+	if ( !info->is_checked && check_it )
+	{
+	    info->is_checked = true;
+	    if ( AutoCheckWBFS(&wbfs,ignore_check,1,0) > ERR_WARNING )
+	    {
+		ERROR0(ERR_WBFS_INVALID,"Ignore invalid WBFS: %s\n\n",info->path);
+		ResetWBFS(&wbfs);
+		continue;
+	    }
+	}
+
+	DefragWBFS_t df;
+	const enumError stat = DefragWBFS(&wbfs,&df,testmode);
+	if ( stat == ERR_OK )
+	{
+	    const u32 mod_mib
+		= ( (u64)wbfs.wbfs->wbfs_sec_sz * df.moved_blocks + MiB/2 ) / MiB;
+
+	    if (verbose>=0)
+		printf(" - %s %u disc%s (%u MiB), fragments %u -> %u: %s\n",
+			testmode ? "WOULD move" : "Moved",
+			df.moved_discs, df.moved_discs == 1 ? "" : "s",
+			mod_mib, df.frag_before, df.frag_after, info->path );
+
+	    if ( verbose > 0 )
+		printf("   %u disc%s, %u fragmented, %u can't be moved\n",
+			df.n_disc, df.n_disc == 1 ? "" : "s",
+			df.frag_discs, df.skipped_discs );
+
+	    if ( df.moved_discs )
+		wbfs_mod_count++;
+	}
+	ResetWBFS(&wbfs);
+    }
+
+    if ( verbose >= 0 && wbfs_count > 1 )
+	printf("** %d of %d WBFS defragmented.\n",
+		wbfs_mod_count, wbfs_count );
+
+    return max_error;
+}
+
+//
+///////////////////////////////////////////////////////////////////////////////
+
 static ID_DB_t sync_list;
 
 enumError exec_scan_id ( SuperFile_t * sf, Iterator_t * it )
@@ -2004,7 +2175,9 @@ static void count_jobs ( WBFS_t * w, Iterator_t * it, bool count_it )
 
 //-----------------------------------------------------------------------------
 
-enumError exec_add ( SuperFile_t * sf, Iterator_t * it )
+static AddWDiscQueue_t add_queue;
+
+static enumError exec_add_helper ( SuperFile_t * sf, Iterator_t * it )
 {
     ASSERT(sf);
     ASSERT(it);
@@ -2014,6 +2187,7 @@ enumError exec_add ( SuperFile_t * sf, Iterator_t * it )
 	return ERR_INTERRUPT;
 
     CopyPatchWbfsId(sf->f.id6_dest,sf->f.id6_dest);
+    FinishAddWDiscID(&add_queue,sf->f.id6_dest);
 
     // [[2do]] [rewrite] count_jobs() does most decicions
 
@@ -2126,7 +2300,11 @@ enumError exec_add ( SuperFile_t * sf, Iterator_t * it )
     {
 	sf->f.read_behind_eof	= verbose > 1 ? 1 : 2;
 
-	enumError err = AddWDisc(it->wbfs,sf,&part_selector);
+	// FST sources are composed on the fly and the WIA reader uses
+	// the global 'tempbuf' => no parallel import
+	enumError err = sf->fst || sf->wia || !sf->f.seek_allowed
+		? AddWDisc(it->wbfs,sf,&part_selector)
+		: StartAddWDisc(&add_queue,it->wbfs,sf,&part_selector);
 	if ( err > ERR_WARNING )
 	    return ERROR0(err,"Error while adding disc [%s] @%s\n",
 			sf->f.id6_dest, it->wbfs->sf->f.fname );
@@ -2137,6 +2315,17 @@ enumError exec_add ( SuperFile_t * sf, Iterator_t * it )
 
 //-----------------------------------------------------------------------------
 
+enumError exec_add ( SuperFile_t * sf, Iterator_t * it )
+{
+    // the WBFS is locked, because running import jobs write into it
+    LockAddWDiscQueue(&add_queue);
+    const enumError err = exec_add_helper(sf,it);
+    UnlockAddWDiscQueue(&add_queue);
+    return err;
+}
+
+//-----------------------------------------------------------------------------
+
 enumError cmd_add()
 {
     if (verbose>=0)
@@ -2203,6 +2392,7 @@ enumError cmd_add()
     WBFS_t wbfs;
     InitializeWBFS(&wbfs);
     PartitionInfo_t * info;
+    InitializeAddWDiscQueue(&add_queue, testmode ? 1 : opt_parallel );
 
     const uint n_wbfs = CountWBFS();
     if ( n_wbfs > 1 )
@@ -2301,6 +2491,13 @@ enumError cmd_add()
 	it.open_dev = wbfs.sf->f.st.st_dev;
 	it.open_ino = wbfs.sf->f.st.st_ino;
 	err = SourceIteratorCollected(&it,1,0,false);
+
+	// wait for and commit all running import jobs
+	LockAddWDiscQueue(&add_queue);
+	const enumError queue_err = FinishAddWDiscQueue(&add_queue);
+	UnlockAddWDiscQueue(&add_queue);
+	if ( !err && queue_err > ERR_WARNING )
+	    err = queue_err;
 	if (err)
 	    break;
 
@@ -2367,6 +2564,7 @@ enumError cmd_add()
 	SourceIteratorCollected(&it,0,0,false); // max_error is adjusted automatically!
     }
 
+    ResetAddWDiscQueue(&add_queue);
     ResetIterator(&it);
     ResetWBFS(&wbfs);
     return max_error;
@@ -3579,6 +3777,10 @@ enumError cmd_verify()
     ccp fail_verb = !remove ? "found" : free_slot_only ? "dropped" : "removed";
     char fail_buf[100];
 
+    // one pool of worker threads for all discs
+    ThreadPool_t tpool;
+    InitializeThreadPool(&tpool,0);
+
     for ( err = GetFirstWBFS(&wbfs,&info,remove);
 	  !err && !SIGINT_level;
 	  err = GetNextWBFS(&wbfs,&info,remove) )
@@ -3612,6 +3814,7 @@ enumError cmd_verify()
 		    ver.disc_total = disc_count;
 		    ver.fname = title;
 		    ver.indent = 2;
+		    ver.tpool = &tpool;
 		    if ( opt_limit >= 0 )
 		    {
 			ver.max_err_msg = opt_limit;
@@ -3670,6 +3873,7 @@ enumError cmd_verify()
 	}
     }
     ResetWBFS(&wbfs);
+    ResetThreadPool(&tpool);
 
     if ( verbose >= 1 )
 	printf("\n");
@@ -3913,6 +4117,11 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
 	case GO_LOGGING:	logging++; break;
 	case GO_ESC:		err += ScanEscapeChar(optarg) < 0; break;
 	case GO_IO:		ScanIOMode(optarg); break;
+	case GO_THREADS:	err += ScanOptThreads(optarg); break;
+	case GO_SCAN_THREADS:	err += ScanOptScanThreads(optarg); break;
+	case GO_IOBUF:		err += ScanOptIOBuf(optarg); break;
+	case GO_GCZ_CACHE:	err += ScanOptGCZCache(optarg); break;
+	case GO_FST_CACHE:	err += ScanOptFSTCache(optarg); break;
 	case GO_DIRECT:		opt_direct++; break;
 
 	case GO_TITLES:		AtFileHelper(optarg,0,0,AddTitleFile); break;
@@ -4017,6 +4226,8 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
 	case GO_ALIGN_WDF:	err += ScanOptAlignWDF(optarg,0); break;
 
 	case GO_WIA:		err += ScanOptCompression(true,optarg); break;
+	case GO_RVZ:		output_file_type = OFT_RVZ;
+				err += ScanOptCompression(false,optarg); break;
 	case GO_ISO:		output_file_type = OFT_PLAIN; break;
 	case GO_CISO:		output_file_type = OFT_CISO; break;
 	case GO_WBFS:		output_file_type = OFT_WBFS; break;
@@ -4065,6 +4276,12 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
 		err++;
 	    break;
 
+	case GO_PARALLEL:
+	    if (ScanSizeOptU32(&opt_parallel,optarg,1,0,
+				"parallel",0,MAX_THREADS,0,0,true))
+		err++;
+	    break;
+
 	case GO_PMODE:
 	    {
 		const int new_pmode = ScanPrefixMode(optarg);
@@ -4125,6 +4342,7 @@ enumError CheckOptions ( int argc, char ** argv, bool is_env )
       }
     }
     NormalizeIdOptions();
+    err += CheckOptCompression();
     if ( OptionUsed[OPT_NO_HEADER] )
 	opt_show_mode &= ~SHOW_F_HEAD;
 
@@ -4218,6 +4436,9 @@ enumError CheckCommand ( int argc, char ** argv )
 	case CMD_EDIT:		err = cmd_edit(); break;
 	case CMD_PHANTOM:	err = cmd_phantom(); break;
 	case CMD_TRUNCATE:	err = cmd_truncate(); break;
+	case CMD_DEDUP:		err = cmd_dedup(false); break;
+	case CMD_REHYDRATE:	err = cmd_dedup(true); break;
+	case CMD_DEFRAG:	err = cmd_defrag(); break;
 
 	case CMD_ADD:		err = cmd_add(); break;
 	case CMD_UPDATE:	err = cmd_update(); break;
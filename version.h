@@ -0,0 +1,40 @@
+
+//---------------------------------"
+// This file is generated by make."
+// Any changes will be lost!"
+//---------------------------------"
+
+#define TOOLSET_SHORT	"WIT"
+#define TOOLSET_LONG	"Wiimms ISO Tools"
+#define WIT_SHORT	"wit"
+#define WIT_LONG	"Wiimms ISO Tool"
+#define WWT_SHORT	"wwt"
+#define WWT_LONG	"Wiimms WBFS Tool"
+#define WDF_SHORT	"wdf"
+#define WDF_LONG	"Wiimms WDF Tool"
+#define WFUSE_SHORT	"wfuse"
+#define WFUSE_LONG	"Wiimms FUSE Tool"
+#define AUTHOR		"Dirk Clemens"
+
+#define VERSION		"2.40a"
+#define VERSION_NUM	"2.40a"
+#define BETA_VERSION	0
+
+#define REVISION	"0"
+#define REVISION_NUM	0
+#define REVISION_NEXT	0
+
+#define BINTIME		1792312766
+#define DATE		"2026-10-18"
+#define TIME		"08:39:26"
+#define DATETIME	"2026-10-18 08:39:26"
+
+#define INSTALL_PATH	"/usr/local"
+#define SHARE_PATH	"/usr/local/share/wit"
+#define WIN_INSTALL_PATH "Wiimm/WIT"
+
+#define URI_REPOS	"http://opensvn.wiimm.de/wii/trunk/wiimms-iso-tools//"
+#define URI_VIEWVC	"http://wit.wiimm.de/r/viewvc/"
+#define URI_HOME	"http://wit.wiimm.de/"
+#define URI_DOWNLOAD	"http://wit.wiimm.de/download"
+